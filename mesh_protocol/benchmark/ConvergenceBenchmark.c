@@ -0,0 +1,291 @@
+/* Copyright (c) 2022-23 California Institute of Technology (Caltech).
+ * U.S. Government sponsorship acknowledged.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Caltech nor its operating division,
+ *   the Jet Propulsion Laboratory, nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Open Source License Approved by Caltech/JPL
+ *
+ * APACHE LICENSE, VERSION 2.0
+ * - Text version: https://www.apache.org/licenses/LICENSE-2.0.txt
+ * - SPDX short identifier: Apache-2.0
+ * - OSI Approved License: https://opensource.org/licenses/Apache-2.0
+ */
+
+
+/** @file ConvergenceBenchmark.c
+*   @brief Measures how fast the protocol forms a network and reaches the slot goal on a library of standard topologies
+*
+*   Usage: convergence_benchmark [-s numSeeds] [-f firstSeed] [-n numNodes] [-d durationTics] [-j numThreads] 
+*                                [-b baselineFile] [-w baselineFile] [-t tolerance]
+*
+*   Runs every topology of the library (clique, line, ring, grid, star, merge and hidden, see Sweep.h) with numSeeds seeds 
+*   and prints the distribution of every metric over the seeds. By default, every topology has as many nodes as slots fit 
+*   into a frame of the default config (divided by slotGoal), so that all nodes can reach the slot goal. The metrics are:
+*   - connected: time until all nodes were connected to the same network
+*   - firstSlot: time until every node had its first own slot
+*   - allGoals: time until every node had slotGoal own slots
+*   - releases: number of own slots that were released or expired
+*   - switches: number of times a node joined a different network
+*   Times only include the runs that reached the milestone; "reached" counts them.
+*
+*   -w writes the medians and the number of runs that reached every milestone to a baseline file. -b compares a run with 
+*   such a file and exits with 1 if a median is larger than the baseline by more than the tolerance (default 0.1, i.e. 10%, 
+*   plus one tic or count) or if fewer runs reached a milestone, so that regressions in convergence speed fail like tests.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+
+#include "../include/Sweep.h"
+
+#define NUM_METRICS 5
+#define LINE_LENGTH 256
+
+static const SweepTopology topologies[] = {
+  TOPOLOGY_CLIQUE, TOPOLOGY_LINE, TOPOLOGY_RING, TOPOLOGY_GRID, TOPOLOGY_STAR, TOPOLOGY_MERGE, TOPOLOGY_HIDDEN
+};
+
+#define NUM_LIBRARY_TOPOLOGIES ((int32_t) (sizeof(topologies) / sizeof(topologies[0])))
+
+static const char *metricNames[NUM_METRICS] = {"connected", "firstSlot", "allGoals", "releases", "switches"};
+
+/** The first metrics are times, which are -1 if a run never reached the milestone */
+#define NUM_TIME_METRICS 3
+
+/**
+* numRuns: number of runs of the topology
+* numReached: number of runs in which the metric has a value (always numRuns for counts)
+* mean, p10, median, p90, max: distribution of the values of the runs that reached the milestone
+*/
+typedef struct MetricSummaryStruct {
+  int32_t numRuns;
+  int32_t numReached;
+  double mean;
+  int64_t p10;
+  int64_t median;
+  int64_t p90;
+  int64_t max;
+} MetricSummaryStruct;
+
+static int64_t getMetric(SweepResult result, int metric) {
+  switch (metric) {
+    case 0:
+      return result->networkFormationTime;
+    case 1:
+      return result->firstSlotTime;
+    case 2:
+      return result->slotGoalTime;
+    case 3:
+      return (int64_t) result->numSlotReleases;
+    default:
+      return (int64_t) result->numNetworkSwitches;
+  };
+};
+
+static int compareValues(const void *a, const void *b) {
+  int64_t x = *(const int64_t *) a;
+  int64_t y = *(const int64_t *) b;
+  return (x > y) - (x < y);
+};
+
+static int64_t percentile(int64_t *sorted, int32_t num, int32_t percent) {
+  // nearest rank
+  int32_t rank = (percent * num + 99) / 100;
+  return sorted[(rank > 0) ? rank - 1 : 0];
+};
+
+static void summarize(SweepResultStruct *results, int32_t numRuns, int metric, MetricSummaryStruct *summary) {
+  int64_t *values = calloc(numRuns, sizeof(int64_t));
+  int32_t num = 0;
+  double sum = 0;
+  for (int32_t i = 0; i < numRuns; ++i) {
+    int64_t value = getMetric(&results[i], metric);
+    if (metric < NUM_TIME_METRICS && value < 0) {
+      continue;
+    };
+    values[num++] = value;
+    sum += value;
+  };
+  qsort(values, num, sizeof(int64_t), compareValues);
+
+  memset(summary, 0, sizeof(MetricSummaryStruct));
+  summary->numRuns = numRuns;
+  summary->numReached = num;
+  if (num > 0) {
+    summary->mean = sum / num;
+    summary->p10 = percentile(values, num, 10);
+    summary->median = percentile(values, num, 50);
+    summary->p90 = percentile(values, num, 90);
+    summary->max = values[num - 1];
+  };
+  free(values);
+};
+
+static bool findBaseline(FILE *baseline, const char *topology, const char *metric, int64_t *median, int32_t *numReached) {
+  char line[LINE_LENGTH];
+  rewind(baseline);
+  while (fgets(line, sizeof(line), baseline) != NULL) {
+    char lineTopology[LINE_LENGTH], lineMetric[LINE_LENGTH];
+    long long lineMedian;
+    int lineReached;
+    if (line[0] == '#' || sscanf(line, "%255s %255s %lld %d", lineTopology, lineMetric, &lineMedian, &lineReached) != 4) {
+      continue;
+    };
+    if (strcmp(lineTopology, topology) == 0 && strcmp(lineMetric, metric) == 0) {
+      *median = lineMedian;
+      *numReached = lineReached;
+      return true;
+    };
+  };
+  return false;
+};
+
+int main(int argc, char *argv[]) {
+  int32_t numSeeds = 20;
+  uint32_t firstSeed = 1;
+  int16_t numNodes = 0;
+  int64_t duration = 200000;
+  int16_t numThreads = 0;
+  const char *baselineName = NULL;
+  const char *writeName = NULL;
+  double tolerance = 0.1;
+
+  int option;
+  while ((option = getopt(argc, argv, "s:f:n:d:j:b:w:t:")) != -1) {
+    switch (option) {
+      case 's':
+        numSeeds = atoi(optarg);
+        break;
+      case 'f':
+        firstSeed = (uint32_t) strtoul(optarg, NULL, 10);
+        break;
+      case 'n':
+        numNodes = atoi(optarg);
+        break;
+      case 'd':
+        duration = atoll(optarg);
+        break;
+      case 'j':
+        numThreads = atoi(optarg);
+        break;
+      case 'b':
+        baselineName = optarg;
+        break;
+      case 'w':
+        writeName = optarg;
+        break;
+      case 't':
+        tolerance = atof(optarg);
+        break;
+      default:
+        fprintf(stderr, "usage: %s [-s numSeeds] [-f firstSeed] [-n numNodes] [-d durationTics] [-j numThreads] "
+          "[-b baselineFile] [-w baselineFile] [-t tolerance]\n", argv[0]);
+        return 1;
+    };
+  };
+  Config defaultConfig = Config_Create();
+  if (numNodes == 0) {
+    // as many nodes as can reach the slot goal within one frame
+    numNodes = (int16_t) (defaultConfig->frameLength / defaultConfig->slotLength / defaultConfig->slotGoal);
+    numNodes = (numNodes > MAX_NUM_NODES) ? MAX_NUM_NODES : numNodes;
+  };
+  if (numSeeds < 1 || numNodes < 2 || numNodes > MAX_NUM_NODES) {
+    fprintf(stderr, "at least one seed and between 2 and %d nodes\n", MAX_NUM_NODES);
+    return 1;
+  };
+
+  FILE *baseline = NULL;
+  if (baselineName != NULL && (baseline = fopen(baselineName, "r")) == NULL) {
+    fprintf(stderr, "cannot open %s\n", baselineName);
+    return 1;
+  };
+  FILE *output = NULL;
+  if (writeName != NULL && (output = fopen(writeName, "w")) == NULL) {
+    fprintf(stderr, "cannot open %s\n", writeName);
+    return 1;
+  };
+
+  uint32_t *seeds = calloc(numSeeds, sizeof(uint32_t));
+  for (int32_t i = 0; i < numSeeds; ++i) {
+    seeds[i] = firstSeed + i;
+  };
+
+  // the scenarios of a topology are consecutive, one per seed
+  int32_t numScenarios = 0;
+  SweepScenarioStruct *scenarios = Sweep_CreateScenarioMatrix(&seeds[0], numSeeds, &numNodes, 1, (SweepTopology *) &topologies[0], 
+    NUM_LIBRARY_TOPOLOGIES, defaultConfig, 1, 1.0, 1.5, duration, &numScenarios);
+  SweepResultStruct *results = calloc(numScenarios, sizeof(SweepResultStruct));
+  Sweep_Run(scenarios, numScenarios, results, numThreads);
+
+  if (output != NULL) {
+    fprintf(output, "# topology metric median numReached (%" PRId32 " seeds from %" PRIu32 ", %" PRId16 " nodes, %" PRId64 
+      " tics)\n", numSeeds, firstSeed, numNodes, duration);
+  };
+  printf("%-8s %-10s %8s %10s %10s %10s %10s %10s\n", "topology", "metric", "reached", "mean", "p10", "median", "p90", "max");
+
+  int32_t numRegressions = 0;
+  for (int32_t t = 0; t < NUM_LIBRARY_TOPOLOGIES; ++t) {
+    const char *topologyName = Sweep_GetTopologyName(topologies[t]);
+    for (int metric = 0; metric < NUM_METRICS; ++metric) {
+      MetricSummaryStruct summary;
+      summarize(&results[t * numSeeds], numSeeds, metric, &summary);
+      printf("%-8s %-10s %4" PRId32 "/%-3" PRId32 " %10.1f %10" PRId64 " %10" PRId64 " %10" PRId64 " %10" PRId64, topologyName, 
+        metricNames[metric], summary.numReached, summary.numRuns, summary.mean, summary.p10, summary.median, summary.p90, 
+        summary.max);
+
+      if (output != NULL) {
+        fprintf(output, "%s %s %" PRId64 " %" PRId32 "\n", topologyName, metricNames[metric], summary.median, summary.numReached);
+      };
+
+      int64_t baselineMedian;
+      int32_t baselineReached;
+      if (baseline != NULL && findBaseline(baseline, topologyName, metricNames[metric], &baselineMedian, &baselineReached)) {
+        if (summary.numReached < baselineReached || summary.median > baselineMedian * (1 + tolerance) + 1) {
+          printf("  REGRESSION (baseline: median %" PRId64 ", reached %" PRId32 ")", baselineMedian, baselineReached);
+          ++numRegressions;
+        };
+      };
+      printf("\n");
+    };
+  };
+
+  if (baseline != NULL) {
+    printf("%" PRId32 " regressions\n", numRegressions);
+    fclose(baseline);
+  };
+  if (output != NULL) {
+    fclose(output);
+  };
+  free(defaultConfig);
+  free(seeds);
+  free(scenarios);
+  free(results);
+  return (numRegressions > 0) ? 1 : 0;
+};
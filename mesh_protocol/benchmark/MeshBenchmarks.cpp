@@ -0,0 +1,265 @@
+/* Copyright (c) 2022-23 California Institute of Technology (Caltech).
+ * U.S. Government sponsorship acknowledged.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Caltech nor its operating division,
+ *   the Jet Propulsion Laboratory, nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Open Source License Approved by Caltech/JPL
+ *
+ * APACHE LICENSE, VERSION 2.0
+ * - Text version: https://www.apache.org/licenses/LICENSE-2.0.txt
+ * - SPDX short identifier: Apache-2.0
+ * - OSI Approved License: https://opensource.org/licenses/Apache-2.0
+ */
+
+
+/** @file MeshBenchmarks.cpp
+*   @brief Microbenchmarks (Google Benchmark) of the SlotMap and StateActions functions that run every tic or on every ping
+*
+*   NUM_SLOTS and MAX_NUM_NODES are compile time constants, so CMakeLists.txt builds one executable per setting 
+*   (mesh_benchmarks_<NUM_SLOTS>x<MAX_NUM_NODES>). Every benchmark runs on a node of a Simulator whose slot maps and 
+*   neighborhood are filled like those of a node in a dense network: about half of the slots are occupied in one of the 
+*   slot maps, some are colliding, a few are free and the node has own and pending slots.
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+extern "C" {
+#include "../include/Simulator.h"
+#include "../include/Node.h"
+#include "../include/SlotMap.h"
+#include "../include/StateActions.h"
+#include "../include/TimeKeeping.h"
+#include "../include/Neighborhood.h"
+#include "../include/Message.h"
+#include "../include/Config.h"
+}
+
+class SlotMapFixture : public benchmark::Fixture {
+ public:
+  void SetUp(const ::benchmark::State &) override {
+    sim = Simulator_Create(1, 42);
+    Simulator_AddNode(sim, 1, 0, 0, 0);
+    Simulator_Step(sim);
+    node = Simulator_GetNode(sim, 0);
+
+    // a frame holds all NUM_SLOTS slots
+    node->config->frameLength = NUM_SLOTS * node->config->slotLength;
+    node->timeKeeping->frameStartSet = true;
+    node->timeKeeping->frameStartTime = 0;
+    sim->localTimes[0] = 10 * node->config->frameLength;
+
+    fillNeighborhood();
+    fillSlotMaps();
+    ping = createPing();
+  }
+
+  void TearDown(const ::benchmark::State &) override {
+    Message_Destroy(ping);
+    Simulator_Destroy(sim);
+  }
+
+  /** every other node of the network is a recently seen neighbor */
+  void fillNeighborhood() {
+    Neighborhood neighborhood = node->neighborhood;
+    neighborhood->numOneHopNeighbors = MAX_NUM_NODES - 1;
+    for (int i = 0; i < MAX_NUM_NODES - 1; ++i) {
+      neighborhood->oneHopNeighbors[i] = (int8_t) (i + 2);
+      neighborhood->oneHopNeighborsLastSeen[i] = sim->localTimes[0] - i;
+      neighborhood->oneHopNeighborsLastRanging[i] = sim->localTimes[0] - 10 * i;
+      neighborhood->oneHopNeighborsJoinedTime[i] = 0;
+      neighborhood->oneHopNeighborsLastDistance[i] = 1.0;
+    };
+    Neighborhood_RescheduleTimers(node);
+  }
+
+  int8_t neighborId(int slotIdx) {
+    return (int8_t) (2 + slotIdx % (MAX_NUM_NODES - 1));
+  }
+
+  void fillSlotMaps() {
+    SlotMap slotMap = node->slotMap;
+    int64_t recently = sim->localTimes[0] - 1;
+    for (int s = 0; s < NUM_SLOTS; ++s) {
+      // one hop: every fourth slot is occupied by a neighbor, some are colliding
+      SlotStatus_Set(&slotMap->oneHopSlotsStatus, s, (s % 4 == 0) ? OCCUPIED : ((s % 8 == 3) ? COLLIDING : FREE));
+      slotMap->oneHopSlotsIds[s] = (s % 4 == 0) ? neighborId(s) : 0;
+      slotMap->oneHopSlotsLastUpdated[s] = recently;
+
+      // two hop: the slots in between are occupied by nodes two hops away
+      SlotStatus_Set(&slotMap->twoHopSlotsStatus, s, (s % 4 == 2) ? OCCUPIED : FREE);
+      slotMap->twoHopSlotsIds[s] = (s % 4 == 2) ? neighborId(s + 1) : 0;
+      slotMap->twoHopSlotsLastUpdated[s] = recently;
+
+      // three hop: a few more slots are occupied three hops away; slots s % 8 == 7 remain free
+      SlotStatus_Set(&slotMap->threeHopSlotsStatus, s, (s % 8 == 5) ? OCCUPIED : FREE);
+      slotMap->threeHopSlotsIds[s] = (s % 8 == 5) ? neighborId(s + 2) : 0;
+      slotMap->threeHopSlotsLastUpdated[s] = recently;
+    };
+
+    // own slots are the slots s % 4 == 1 (slot numbers start at 1)
+    slotMap->numOwnSlots = 0;
+    for (int s = 1; s < NUM_SLOTS && slotMap->numOwnSlots < MAX_NUM_OWN_SLOTS; s += 4) {
+      slotMap->ownSlots[slotMap->numOwnSlots++] = (SlotNum) (s + 1);
+    };
+    slotMap->numPendingSlots = 0;
+    SlotMap_RebuildMasks(node);
+    if (NUM_SLOTS > 7) {
+      int8_t neighbors[1] = {2};
+      SlotMap_AddPendingSlot(node, 8, &neighbors[0], 1);
+    };
+  }
+
+  /** ping of a neighbor whose slot maps partly disagree with the ones of the node */
+  Message createPing() {
+    Message msg = Message_Create(PING);
+    msg->senderId = 2;
+    for (int s = 0; s < NUM_SLOTS; ++s) {
+      SlotStatus_Set(&msg->oneHopSlotStatus, s, (s % 3 == 0) ? OCCUPIED : ((s % 6 == 1) ? COLLIDING : FREE));
+      msg->oneHopSlotIds[s] = (s % 3 == 0) ? neighborId(s) : 0;
+      SlotStatus_Set(&msg->twoHopSlotStatus, s, (s % 3 == 1) ? OCCUPIED : FREE);
+      msg->twoHopSlotIds[s] = (s % 3 == 1) ? neighborId(s + 3) : 0;
+    };
+    return msg;
+  }
+
+  Simulator sim;
+  Node node;
+  Message ping;
+};
+
+BENCHMARK_DEFINE_F(SlotMapFixture, ClearToSend)(benchmark::State &state) {
+  // visit every slot of the frame
+  int64_t frameStart = sim->localTimes[0];
+  int s = 0;
+  for (auto _ : state) {
+    sim->localTimes[0] = frameStart + s * node->config->slotLength;
+    s = (s + 1) % NUM_SLOTS;
+    benchmark::DoNotOptimize(SlotMap_ClearToSend(node));
+  };
+}
+BENCHMARK_REGISTER_F(SlotMapFixture, ClearToSend);
+
+BENCHMARK_DEFINE_F(SlotMapFixture, GetReservableSlot)(benchmark::State &state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(SlotMap_GetReservableSlot(node));
+  };
+}
+BENCHMARK_REGISTER_F(SlotMapFixture, GetReservableSlot);
+
+BENCHMARK_DEFINE_F(SlotMapFixture, CalculateNextOwnOrPendingSlotNum)(benchmark::State &state) {
+  // visit every slot of the frame
+  int64_t frameStart = sim->localTimes[0];
+  int s = 0;
+  for (auto _ : state) {
+    sim->localTimes[0] = frameStart + s * node->config->slotLength;
+    s = (s + 1) % NUM_SLOTS;
+    benchmark::DoNotOptimize(SlotMap_CalculateNextOwnOrPendingSlotNum(node, (SlotNum) (s + 1)));
+  };
+}
+BENCHMARK_REGISTER_F(SlotMapFixture, CalculateNextOwnOrPendingSlotNum);
+
+BENCHMARK_DEFINE_F(SlotMapFixture, SlotIsFree)(benchmark::State &state) {
+  // query every slot of the frame
+  for (auto _ : state) {
+    for (SlotNum slot = 1; slot <= NUM_SLOTS; ++slot) {
+      benchmark::DoNotOptimize(SlotMap_SlotIsFree(node, slot));
+    };
+  };
+}
+BENCHMARK_REGISTER_F(SlotMapFixture, SlotIsFree);
+
+BENCHMARK_DEFINE_F(SlotMapFixture, SlotIsColliding)(benchmark::State &state) {
+  // query every slot of the frame
+  for (auto _ : state) {
+    for (SlotNum slot = 1; slot <= NUM_SLOTS; ++slot) {
+      benchmark::DoNotOptimize(SlotMap_SlotIsColliding(node, slot));
+    };
+  };
+}
+BENCHMARK_REGISTER_F(SlotMapFixture, SlotIsColliding);
+
+BENCHMARK_DEFINE_F(SlotMapFixture, OwnNetworkExists)(benchmark::State &state) {
+  // no other node has reserved a slot, so the own slots are compared with the reported colliding slots
+  for (int s = 0; s < NUM_SLOTS; ++s) {
+    if (SlotStatus_Get(&node->slotMap->oneHopSlotsStatus, s) == OCCUPIED) {
+      SlotStatus_Set(&node->slotMap->oneHopSlotsStatus, s, FREE);
+      node->slotMap->oneHopSlotsIds[s] = 0;
+    };
+  };
+  SlotMap_RebuildMasks(node);
+  SlotNum collidingSlots[NUM_SLOTS];
+  int16_t numCollidingSlots = 0;
+  for (SlotNum slot = 1; slot <= NUM_SLOTS; slot += 2) {
+    collidingSlots[numCollidingSlots++] = slot;
+  };
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(SlotMap_OwnNetworkExists(node, &collidingSlots[0], numCollidingSlots));
+  };
+}
+BENCHMARK_REGISTER_F(SlotMapFixture, OwnNetworkExists);
+
+BENCHMARK_DEFINE_F(SlotMapFixture, UpdateTwoHopSlotMap)(benchmark::State &state) {
+  // updateMultiHopSlotMap with the one hop slot map of the ping
+  for (auto _ : state) {
+    SlotMap_UpdateTwoHopSlotMap(node, ping);
+    benchmark::ClobberMemory();
+  };
+}
+BENCHMARK_REGISTER_F(SlotMapFixture, UpdateTwoHopSlotMap);
+
+BENCHMARK_DEFINE_F(SlotMapFixture, UpdateThreeHopSlotMap)(benchmark::State &state) {
+  // updateMultiHopSlotMap with the two hop slot map of the ping
+  for (auto _ : state) {
+    SlotMap_UpdateThreeHopSlotMap(node, ping);
+    benchmark::ClobberMemory();
+  };
+}
+BENCHMARK_REGISTER_F(SlotMapFixture, UpdateThreeHopSlotMap);
+
+BENCHMARK_DEFINE_F(SlotMapFixture, ListeningConnectedTimeTicAction)(benchmark::State &state) {
+  // the local time does not advance, so no slot or neighbor expires and every iteration does the same work
+  for (auto _ : state) {
+    StateActions_ListeningConnectedTimeTicAction(node);
+    benchmark::ClobberMemory();
+  };
+}
+BENCHMARK_REGISTER_F(SlotMapFixture, ListeningConnectedTimeTicAction);
+
+int main(int argc, char **argv) {
+  benchmark::AddCustomContext("NUM_SLOTS", std::to_string(NUM_SLOTS));
+  benchmark::AddCustomContext("MAX_NUM_NODES", std::to_string(MAX_NUM_NODES));
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  };
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
@@ -0,0 +1,96 @@
+/* Copyright (c) 2022-23 California Institute of Technology (Caltech).
+ * U.S. Government sponsorship acknowledged.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Caltech nor its operating division,
+ *   the Jet Propulsion Laboratory, nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Open Source License Approved by Caltech/JPL
+ *
+ * APACHE LICENSE, VERSION 2.0
+ * - Text version: https://www.apache.org/licenses/LICENSE-2.0.txt
+ * - SPDX short identifier: Apache-2.0
+ * - OSI Approved License: https://opensource.org/licenses/Apache-2.0
+ */
+
+
+/** @file MessagePoolBenchmark.c
+*   @brief Counts the heap allocations of messages per simulated second
+*
+*   Usage: message_pool_benchmark [durationTics] [seed]
+*
+*   Runs the simulator on a clique and on a line of MAX_NUM_NODES nodes and compares the number of messages that are 
+*   allocated on the heap per simulated second:
+*   - before: one Message_Create for every transmission (copy of the driver) and one for every delivered message 
+*     (copy per receiver) or collision, which is what the simulation did before the transmit ring and the message pool
+*   - after: messages that had to be allocated because the message pool of the simulator was empty
+*   One time tic is one millisecond, as on the DWM1001.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../include/Simulator.h"
+
+#define TICS_PER_SIMULATED_SECOND 1000
+
+static void runTopology(const char *name, double radioRange, int64_t duration, uint32_t seed) {
+  Simulator sim = Simulator_Create(MAX_NUM_NODES, seed);
+  Simulator_SetRadioRange(sim, radioRange);
+  Simulator_SetIdleSkipping(sim, true);
+  for (int16_t i = 0; i < MAX_NUM_NODES; ++i) {
+    Simulator_AddNode(sim, (int8_t) (i + 1), i, 0, 0);
+  };
+
+  clock_t start = clock();
+  Simulator_RunUntil(sim, duration);
+  double elapsed = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+  uint64_t numTransmissions = 0;
+  for (int type = PING; type <= RESULT; ++type) {
+    numTransmissions += sim->stats.numTransmissions[type];
+  };
+  uint64_t allocationsBefore = numTransmissions + sim->stats.numDelivered + sim->stats.numCollisions;
+  uint64_t allocationsAfter = sim->messagePool->numHeapAllocations;
+  double simulatedSeconds = (double) duration / TICS_PER_SIMULATED_SECOND;
+
+  printf("%-8s %12" PRIu64 " %12" PRIu64 " %16.2f %16.2f %10.3f\n", name, numTransmissions, sim->messagePool->numAcquired, 
+    allocationsBefore / simulatedSeconds, allocationsAfter / simulatedSeconds, elapsed);
+
+  Simulator_Destroy(sim);
+};
+
+int main(int argc, char *argv[]) {
+  int64_t duration = (argc > 1) ? atoll(argv[1]) : 2000000;
+  uint32_t seed = (argc > 2) ? (uint32_t) strtoul(argv[2], NULL, 10) : 1;
+
+  printf("%-8s %12s %12s %16s %16s %10s\n", "topology", "transmitted", "acquired", "allocs/s before", "allocs/s after", "cpu [s]");
+  runTopology("clique", 2.0 * MAX_NUM_NODES, duration, seed);
+  runTopology("line", 1.5, duration, seed);
+
+  return 0;
+};
@@ -0,0 +1,304 @@
+/* Copyright (c) 2022-23 California Institute of Technology (Caltech).
+ * U.S. Government sponsorship acknowledged.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Caltech nor its operating division,
+ *   the Jet Propulsion Laboratory, nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Open Source License Approved by Caltech/JPL
+ *
+ * APACHE LICENSE, VERSION 2.0
+ * - Text version: https://www.apache.org/licenses/LICENSE-2.0.txt
+ * - SPDX short identifier: Apache-2.0
+ * - OSI Approved License: https://opensource.org/licenses/Apache-2.0
+ */
+
+
+/** @file RangingThroughputBenchmark.c
+*   @brief Measures fresh distance measurements per node per second on the standard topologies
+*
+*   Usage: ranging_throughput_benchmark [-s numSeeds] [-f firstSeed] [-n numNodes] [-d durationTics] [-l linkFile]
+*
+*   Runs every topology of the library of convergence_benchmark with numSeeds seeds and counts, for every link (poller and 
+*   neighbor), the completed POLL, RESPONSE, FINAL, RESULT exchanges, i.e. the calls of Neighborhood_UpdateRanging of the 
+*   poller. The staleness of a link is the time between two consecutive measurements of the link. A ranging timed out if 
+*   RangingManager_HasRangingTimedOut sent the poller from RANGING_LISTEN back to listening. The slot utilization is the 
+*   number of own slots of all nodes per slot of a frame, averaged over the duration (above 1 with spatial reuse).
+*
+*   Writes one CSV row per topology (aggregated over all seeds) to stdout; -l writes one CSV row per link and seed to 
+*   linkFile. One time tic is one millisecond, as on the DWM1001.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+
+#include "../include/Sweep.h"
+#include "../include/Node.h"
+#include "../include/StateMachine.h"
+#include "../include/Neighborhood.h"
+
+#define TICS_PER_SIMULATED_SECOND 1000
+
+static const SweepTopology topologies[] = {
+  TOPOLOGY_CLIQUE, TOPOLOGY_LINE, TOPOLOGY_RING, TOPOLOGY_GRID, TOPOLOGY_STAR, TOPOLOGY_MERGE, TOPOLOGY_HIDDEN
+};
+
+#define NUM_LIBRARY_TOPOLOGIES ((int32_t) (sizeof(topologies) / sizeof(topologies[0])))
+
+/**
+* values: the values (grows as needed)
+* num: number of values
+* capacity: number of values that fit into values
+*/
+typedef struct ValuesStruct {
+  int64_t *values;
+  int32_t num;
+  int32_t capacity;
+} ValuesStruct;
+
+/**
+* numRangings: number of completed exchanges
+* lastMeasurement: simulation time of the last measurement; -1 before the first one
+* lastRangingTime: value of oneHopNeighborsLastRanging of the poller after the last tic
+* staleness: times between two consecutive measurements
+*/
+typedef struct LinkStruct {
+  uint64_t numRangings;
+  int64_t lastMeasurement;
+  int64_t lastRangingTime;
+  ValuesStruct staleness;
+} LinkStruct;
+
+/**
+* numRangings: completed exchanges of all runs
+* numTimeouts: ranging timeouts of all runs
+* numLinksRanged: number of links with at least one measurement in all runs
+* ownSlotTics: sum of the number of own slots of all nodes over all tics of all runs
+* staleness: staleness of all links of all runs
+*/
+typedef struct TopologySummaryStruct {
+  uint64_t numRangings;
+  uint64_t numTimeouts;
+  int32_t numLinksRanged;
+  double ownSlotTics;
+  ValuesStruct staleness;
+} TopologySummaryStruct;
+
+static void addValue(ValuesStruct *values, int64_t value) {
+  if (values->num == values->capacity) {
+    values->capacity = (values->capacity == 0) ? 64 : 2 * values->capacity;
+    values->values = realloc(values->values, values->capacity * sizeof(int64_t));
+  };
+  values->values[values->num++] = value;
+};
+
+static int compareValues(const void *a, const void *b) {
+  int64_t x = *(const int64_t *) a;
+  int64_t y = *(const int64_t *) b;
+  return (x > y) - (x < y);
+};
+
+static int64_t percentile(ValuesStruct *values, int32_t percent) {
+  // nearest rank; sorts the values
+  if (values->num == 0) {
+    return -1;
+  };
+  qsort(values->values, values->num, sizeof(int64_t), compareValues);
+  int32_t rank = (percent * values->num + 99) / 100;
+  return values->values[(rank > 0) ? rank - 1 : 0];
+};
+
+static void recordRangings(Simulator sim, LinkStruct links[MAX_NUM_NODES][MAX_NUM_NODES], int64_t tic) {
+  // a new measurement changes the last ranging time of the neighbor at the poller; a neighbor that was (re)added has 0
+  for (int16_t i = 0; i < sim->numNodes; ++i) {
+    Neighborhood neighborhood = Simulator_GetNode(sim, i)->neighborhood;
+    for (int8_t j = 0; j < neighborhood->numOneHopNeighbors; ++j) {
+      int16_t neighborIdx = Simulator_FindNode(sim, neighborhood->oneHopNeighbors[j]);
+      LinkStruct *link = &links[i][neighborIdx];
+      int64_t lastRangingTime = neighborhood->oneHopNeighborsLastRanging[j];
+      if (lastRangingTime > 0 && lastRangingTime != link->lastRangingTime) {
+        ++link->numRangings;
+        if (link->lastMeasurement >= 0) {
+          addValue(&link->staleness, tic - link->lastMeasurement);
+        };
+        link->lastMeasurement = tic;
+      };
+      link->lastRangingTime = lastRangingTime;
+    };
+  };
+};
+
+static void runScenario(SweepScenario scenario, TopologySummaryStruct *summary, FILE *linkFile) {
+  static LinkStruct links[MAX_NUM_NODES][MAX_NUM_NODES];
+  memset(links, 0, sizeof(links));
+  for (int16_t i = 0; i < MAX_NUM_NODES; ++i) {
+    for (int16_t j = 0; j < MAX_NUM_NODES; ++j) {
+      links[i][j].lastMeasurement = -1;
+    };
+  };
+
+  Simulator sim = Sweep_CreateSimulator(scenario);
+  while (Simulator_GetTime(sim) < scenario->duration) {
+    int64_t nextChange = Sweep_UpdateTopology(sim, scenario);
+    int64_t tic = Simulator_GetTime(sim);
+
+    // same as Simulator_Advance, but a TIME_TIC that ends RANGING_LISTEN can only be a timeout
+    Simulator_BeginTic(sim);
+    for (int16_t i = 0; i < sim->numNodes; ++i) {
+      if (!sim->isOn[i]) {
+        continue;
+      };
+      Node node = Simulator_GetNode(sim, i);
+      int stateBefore = StateMachine_GetState(node);
+      StateMachine_Run(node, TIME_TIC, NULL);
+      Simulator_TransmitSentMessages(sim, i);
+      if (stateBefore == RANGING_LISTEN && StateMachine_GetState(node) == LISTENING_CONNECTED) {
+        ++summary->numTimeouts;
+      };
+    };
+    Simulator_EndTic(sim);
+    Simulator_SkipIdleTics(sim, nextChange);
+    recordRangings(sim, links, tic);
+
+    // the own slots only change in the executed tic, so they hold until the next one
+    int64_t elapsed = Simulator_GetTime(sim) - tic;
+    for (int16_t i = 0; i < sim->numNodes; ++i) {
+      summary->ownSlotTics += (double) Simulator_GetNode(sim, i)->slotMap->numOwnSlots * elapsed;
+    };
+  };
+
+  double seconds = (double) scenario->duration / TICS_PER_SIMULATED_SECOND;
+  for (int16_t i = 0; i < sim->numNodes; ++i) {
+    for (int16_t j = 0; j < sim->numNodes; ++j) {
+      LinkStruct *link = &links[i][j];
+      summary->numRangings += link->numRangings;
+      summary->numLinksRanged += (link->numRangings > 0) ? 1 : 0;
+      for (int32_t k = 0; k < link->staleness.num; ++k) {
+        addValue(&summary->staleness, link->staleness.values[k]);
+      };
+
+      if (linkFile != NULL && link->numRangings > 0) {
+        fprintf(linkFile, "%s,%" PRIu32 ",%d,%d,%" PRIu64 ",%.3f,%" PRId64 ",%" PRId64 ",%" PRId64 "\n", 
+          Sweep_GetTopologyName(scenario->topology), scenario->seed, Simulator_GetNode(sim, i)->id, 
+          Simulator_GetNode(sim, j)->id, link->numRangings, link->numRangings / seconds, percentile(&link->staleness, 50), 
+          percentile(&link->staleness, 90), percentile(&link->staleness, 100));
+      };
+      free(link->staleness.values);
+    };
+  };
+
+  Simulator_Destroy(sim);
+};
+
+int main(int argc, char *argv[]) {
+  int32_t numSeeds = 20;
+  uint32_t firstSeed = 1;
+  int16_t numNodes = 0;
+  int64_t duration = 200000;
+  FILE *linkFile = NULL;
+
+  int option;
+  while ((option = getopt(argc, argv, "s:f:n:d:l:")) != -1) {
+    switch (option) {
+      case 's':
+        numSeeds = atoi(optarg);
+        break;
+      case 'f':
+        firstSeed = (uint32_t) strtoul(optarg, NULL, 10);
+        break;
+      case 'n':
+        numNodes = atoi(optarg);
+        break;
+      case 'd':
+        duration = atoll(optarg);
+        break;
+      case 'l':
+        if ((linkFile = fopen(optarg, "w")) == NULL) {
+          fprintf(stderr, "cannot open %s\n", optarg);
+          return 1;
+        };
+        break;
+      default:
+        fprintf(stderr, "usage: %s [-s numSeeds] [-f firstSeed] [-n numNodes] [-d durationTics] [-l linkFile]\n", argv[0]);
+        return 1;
+    };
+  };
+
+  Config defaultConfig = Config_Create();
+  int32_t slotsPerFrame = (int32_t) (defaultConfig->frameLength / defaultConfig->slotLength);
+  if (numNodes == 0) {
+    // as many nodes as can reach the slot goal within one frame (same as convergence_benchmark)
+    numNodes = (int16_t) (slotsPerFrame / defaultConfig->slotGoal);
+    numNodes = (numNodes > MAX_NUM_NODES) ? MAX_NUM_NODES : numNodes;
+  };
+  if (numSeeds < 1 || numNodes < 2 || numNodes > MAX_NUM_NODES || duration < 1) {
+    fprintf(stderr, "at least one seed, one tic and between 2 and %d nodes\n", MAX_NUM_NODES);
+    return 1;
+  };
+
+  if (linkFile != NULL) {
+    fprintf(linkFile, "topology,seed,node,neighbor,rangings,rangingsPerSecond,stalenessP50,stalenessP90,stalenessMax\n");
+  };
+  printf("topology,numNodes,seeds,durationTics,rangingsPerNodePerSecond,rangingsPerLinkPerSecond,linksRanged,"
+    "timeoutsPerNodePerSecond,stalenessP50,stalenessP90,stalenessP99,stalenessMax,slotUtilization\n");
+
+  for (int32_t t = 0; t < NUM_LIBRARY_TOPOLOGIES; ++t) {
+    TopologySummaryStruct summary;
+    memset(&summary, 0, sizeof(summary));
+
+    for (int32_t s = 0; s < numSeeds; ++s) {
+      SweepScenarioStruct scenario;
+      memset(&scenario, 0, sizeof(scenario));
+      scenario.id = t * numSeeds + s;
+      scenario.seed = firstSeed + s;
+      scenario.numNodes = numNodes;
+      scenario.topology = topologies[t];
+      scenario.spacing = 1.0;
+      scenario.radioRange = 1.5;
+      scenario.duration = duration;
+      scenario.config = *defaultConfig;
+      runScenario(&scenario, &summary, linkFile);
+    };
+
+    double nodeSeconds = (double) numNodes * numSeeds * duration / TICS_PER_SIMULATED_SECOND;
+    double linkSeconds = (double) summary.numLinksRanged * duration / TICS_PER_SIMULATED_SECOND;
+    printf("%s,%" PRId16 ",%" PRId32 ",%" PRId64 ",%.4f,%.4f,%.2f,%.4f,%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%.4f\n", 
+      Sweep_GetTopologyName(topologies[t]), numNodes, numSeeds, duration, summary.numRangings / nodeSeconds, 
+      (summary.numLinksRanged > 0) ? summary.numRangings / linkSeconds : 0, (double) summary.numLinksRanged / numSeeds, 
+      summary.numTimeouts / nodeSeconds, percentile(&summary.staleness, 50), percentile(&summary.staleness, 90), 
+      percentile(&summary.staleness, 99), percentile(&summary.staleness, 100), 
+      summary.ownSlotTics / ((double) slotsPerFrame * numSeeds * duration));
+    free(summary.staleness.values);
+  };
+
+  if (linkFile != NULL) {
+    fclose(linkFile);
+  };
+  free(defaultConfig);
+  return 0;
+};
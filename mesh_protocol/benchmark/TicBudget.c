@@ -0,0 +1,347 @@
+/* Copyright (c) 2022-23 California Institute of Technology (Caltech).
+ * U.S. Government sponsorship acknowledged.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Caltech nor its operating division,
+ *   the Jet Propulsion Laboratory, nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Open Source License Approved by Caltech/JPL
+ *
+ * APACHE LICENSE, VERSION 2.0
+ * - Text version: https://www.apache.org/licenses/LICENSE-2.0.txt
+ * - SPDX short identifier: Apache-2.0
+ * - OSI Approved License: https://opensource.org/licenses/Apache-2.0
+ */
+
+
+/** @file TicBudget.c
+*   @brief Counts the instructions of every StateMachine_Run call and checks them against a per-tic budget
+*
+*   Usage: tic_budget [-t topologies] [-n numNodes] [-s numSeeds] [-d durationTics] [-b budget] [-m perf|trap] [-a]
+*
+*   On the DWM1001 (nRF52832, 64 MHz Cortex-M4F), the timer interrupt only sets timetic_flag; the main loop then runs 
+*   StateMachine_Run, which must finish within one tic of 1 ms (64000 cycles), otherwise tics are lost. This tool runs 
+*   the protocol core in the simulator on the given topologies (default: clique, line and merge, see Sweep.h) and counts 
+*   the user space instructions of every StateMachine_Run call on the host, separately for TURN_ON, INCOMING_MSG and 
+*   TIME_TIC. It prints the count, the percentiles and the maximum per event and exits with 1 if any call needed more 
+*   instructions than the budget (default 32000, half of a tic, as host instructions are only a proxy for the cycles of 
+*   the Cortex-M4 and the radio driver needs time as well).
+*
+*   The instructions are counted with the hardware counter of the CPU (perf_event_open) if it is available; otherwise, 
+*   on x86-64 Linux, by single stepping with the trap flag (exact, but about 100000 instructions per second). 
+*   StateMachine_Run is wrapped with the linker (--wrap), so the protocol and the simulator are not changed. If neither 
+*   counter is available, the tool exits with TIC_BUDGET_SKIPPED, which ctest reports as a skipped test.
+*   By default, idle tics are skipped (see Simulator_SetIdleSkipping), so the TIME_TIC percentiles are those of the tics 
+*   in which a node does something; -a runs every tic.
+*/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <signal.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include <ucontext.h>
+
+#include "../include/Sweep.h"
+#include "../include/StateMachine.h"
+
+#define NUM_EVENTS (TIME_TIC + 1)
+#define MAX_TOPOLOGIES 16
+/** Exit code if no instruction counter is available (SKIP_RETURN_CODE of the tic_budget test) */
+#define TIC_BUDGET_SKIPPED 77
+
+/** Trap flag of the x86 flags register */
+#define TRAP_FLAG 0x100
+
+typedef enum CounterMode {
+  COUNTER_PERF, COUNTER_TRAP
+} CounterMode;
+
+/**
+* values: the values (grows as needed)
+* num: number of values
+* capacity: number of values that fit into values
+*/
+typedef struct ValuesStruct {
+  uint64_t *values;
+  int64_t num;
+  int64_t capacity;
+} ValuesStruct;
+
+static const char *eventNames[NUM_EVENTS] = {"TURN_ON", "INCOMING_MSG", "TIME_TIC"};
+
+static CounterMode mode;
+static int perfFd = -1;
+static volatile uint64_t numSteps;
+static volatile bool stepping;
+static uint64_t overhead;
+static bool measuring;
+static ValuesStruct samples[NUM_EVENTS];
+
+void __real_StateMachine_Run(Node node, Events event, Message msg);
+
+static bool openPerfCounter(void) {
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.size = sizeof(attr);
+  attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  perfFd = (int) syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+  return perfFd >= 0;
+};
+
+static void onTrap(int signal, siginfo_t *info, void *context) {
+  (void) signal;
+  (void) info;
+  // every instruction that is executed with the trap flag set ends up here; keep the flag until stepping is turned off
+  ucontext_t *userContext = (ucontext_t *) context;
+  ++numSteps;
+  #if defined(__x86_64__)
+  if (stepping) {
+    userContext->uc_mcontext.gregs[REG_EFL] |= TRAP_FLAG;
+  } else {
+    userContext->uc_mcontext.gregs[REG_EFL] &= ~TRAP_FLAG;
+  };
+  #endif
+};
+
+static bool installTrapCounter(void) {
+  #if defined(__x86_64__)
+  struct sigaction action;
+  memset(&action, 0, sizeof(action));
+  action.sa_sigaction = onTrap;
+  action.sa_flags = SA_SIGINFO;
+  return sigaction(SIGTRAP, &action, NULL) == 0;
+  #else
+  return false;
+  #endif
+};
+
+static inline uint64_t startCounting(void) {
+  if (mode == COUNTER_PERF) {
+    uint64_t value = 0;
+    if (read(perfFd, &value, sizeof(value)) != sizeof(value)) {
+      return 0;
+    };
+    return value;
+  };
+
+  numSteps = 0;
+  stepping = true;
+  #if defined(__x86_64__)
+  __asm__ volatile("pushfq; orq %0, (%%rsp); popfq" : : "i" (TRAP_FLAG) : "memory", "cc");
+  #endif
+  return 0;
+};
+
+static inline uint64_t stopCounting(uint64_t start) {
+  if (mode == COUNTER_PERF) {
+    uint64_t value = 0;
+    if (read(perfFd, &value, sizeof(value)) != sizeof(value)) {
+      return 0;
+    };
+    return value - start;
+  };
+
+  // the trap after this store clears the trap flag
+  stepping = false;
+  return numSteps;
+};
+
+static void addValue(ValuesStruct *values, uint64_t value) {
+  if (values->num == values->capacity) {
+    values->capacity = (values->capacity == 0) ? 1024 : 2 * values->capacity;
+    values->values = realloc(values->values, values->capacity * sizeof(uint64_t));
+  };
+  values->values[values->num++] = value;
+};
+
+static int compareValues(const void *a, const void *b) {
+  uint64_t x = *(const uint64_t *) a;
+  uint64_t y = *(const uint64_t *) b;
+  return (x > y) - (x < y);
+};
+
+static uint64_t percentile(ValuesStruct *values, int32_t percent) {
+  // nearest rank; the values must be sorted
+  int64_t rank = (percent * values->num + 99) / 100;
+  return values->values[(rank > 0) ? rank - 1 : 0];
+};
+
+void __wrap_StateMachine_Run(Node node, Events event, Message msg) {
+  if (!measuring) {
+    __real_StateMachine_Run(node, event, msg);
+    return;
+  };
+
+  // nested calls are part of the outer one
+  measuring = false;
+  uint64_t start = startCounting();
+  __real_StateMachine_Run(node, event, msg);
+  uint64_t count = stopCounting(start);
+  measuring = true;
+
+  addValue(&samples[event], (count > overhead) ? count - overhead : 0);
+};
+
+static void calibrate(void) {
+  // instructions of starting and stopping the counter without anything in between
+  overhead = UINT64_MAX;
+  for (int i = 0; i < 16; ++i) {
+    uint64_t start = startCounting();
+    uint64_t count = stopCounting(start);
+    overhead = (count < overhead) ? count : overhead;
+  };
+};
+
+static void runScenario(SweepScenario scenario, bool skipIdle) {
+  Simulator sim = Sweep_CreateSimulator(scenario);
+  Simulator_SetIdleSkipping(sim, skipIdle);
+
+  measuring = true;
+  while (Simulator_GetTime(sim) < scenario->duration) {
+    int64_t nextChange = Sweep_UpdateTopology(sim, scenario);
+    Simulator_Advance(sim, nextChange);
+  };
+  measuring = false;
+
+  Simulator_Destroy(sim);
+};
+
+int main(int argc, char *argv[]) {
+  SweepTopology topologies[MAX_TOPOLOGIES] = {TOPOLOGY_CLIQUE, TOPOLOGY_LINE, TOPOLOGY_MERGE};
+  int32_t numTopologies = 3;
+  int16_t numNodes = 4;
+  int32_t numSeeds = 1;
+  int64_t duration = 60000;
+  uint64_t budget = 32000;
+  bool skipIdle = true;
+  const char *modeName = NULL;
+
+  int option;
+  while ((option = getopt(argc, argv, "t:n:s:d:b:m:a")) != -1) {
+    switch (option) {
+      case 't':
+        numTopologies = 0;
+        for (char *token = strtok(optarg, ","); token != NULL && numTopologies < MAX_TOPOLOGIES; token = strtok(NULL, ",")) {
+          if (!Sweep_ParseTopology(token, &topologies[numTopologies])) {
+            fprintf(stderr, "unknown topology %s\n", token);
+            return 1;
+          };
+          ++numTopologies;
+        };
+        break;
+      case 'n':
+        numNodes = atoi(optarg);
+        break;
+      case 's':
+        numSeeds = atoi(optarg);
+        break;
+      case 'd':
+        duration = atoll(optarg);
+        break;
+      case 'b':
+        budget = strtoull(optarg, NULL, 10);
+        break;
+      case 'm':
+        modeName = optarg;
+        break;
+      case 'a':
+        skipIdle = false;
+        break;
+      default:
+        fprintf(stderr, "usage: %s [-t topologies] [-n numNodes] [-s numSeeds] [-d durationTics] [-b budget] [-m perf|trap] [-a]\n", 
+          argv[0]);
+        return 1;
+    };
+  };
+  if (numTopologies < 1 || numSeeds < 1 || numNodes < 1 || numNodes > MAX_NUM_NODES) {
+    fprintf(stderr, "at least one topology and seed and between 1 and %d nodes\n", MAX_NUM_NODES);
+    return 1;
+  };
+
+  // prefer the hardware counter, as single stepping is slow
+  if ((modeName == NULL || strcmp(modeName, "perf") == 0) && openPerfCounter()) {
+    mode = COUNTER_PERF;
+  } else if ((modeName == NULL || strcmp(modeName, "trap") == 0) && installTrapCounter()) {
+    mode = COUNTER_TRAP;
+  } else {
+    fprintf(stderr, "no instruction counter available (%s)\n", (modeName != NULL) ? modeName : "perf and trap");
+    return TIC_BUDGET_SKIPPED;
+  };
+  calibrate();
+
+  Config defaultConfig = Config_Create();
+  for (int32_t t = 0; t < numTopologies; ++t) {
+    for (int32_t s = 0; s < numSeeds; ++s) {
+      SweepScenarioStruct scenario;
+      memset(&scenario, 0, sizeof(scenario));
+      scenario.seed = 1 + s;
+      scenario.numNodes = numNodes;
+      scenario.topology = topologies[t];
+      scenario.spacing = 1.0;
+      scenario.radioRange = 1.5;
+      scenario.duration = duration;
+      scenario.config = *defaultConfig;
+      runScenario(&scenario, skipIdle);
+    };
+  };
+  free(defaultConfig);
+
+  printf("counter: %s (overhead %" PRIu64 " instructions), budget: %" PRIu64 " instructions per call\n", 
+    (mode == COUNTER_PERF) ? "perf" : "trap", overhead, budget);
+  printf("%-12s %10s %10s %10s %10s %10s %8s\n", "event", "calls", "p50", "p90", "p99", "max", "budget");
+
+  bool exceeded = false;
+  for (int event = 0; event < NUM_EVENTS; ++event) {
+    ValuesStruct *values = &samples[event];
+    if (values->num == 0) {
+      printf("%-12s %10d\n", eventNames[event], 0);
+      continue;
+    };
+    qsort(values->values, values->num, sizeof(uint64_t), compareValues);
+    uint64_t max = values->values[values->num - 1];
+    printf("%-12s %10" PRId64 " %10" PRIu64 " %10" PRIu64 " %10" PRIu64 " %10" PRIu64 " %7.1f%%%s\n", eventNames[event], 
+      values->num, percentile(values, 50), percentile(values, 90), percentile(values, 99), max, 100.0 * max / budget, 
+      (max > budget) ? "  EXCEEDED" : "");
+    exceeded = exceeded || (max > budget);
+    free(values->values);
+  };
+
+  if (perfFd >= 0) {
+    close(perfFd);
+  };
+  return exceeded ? 1 : 0;
+};
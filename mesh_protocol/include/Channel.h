@@ -0,0 +1,203 @@
+/* Copyright (c) 2022-23 California Institute of Technology (Caltech).
+ * U.S. Government sponsorship acknowledged.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Caltech nor its operating division,
+ *   the Jet Propulsion Laboratory, nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Open Source License Approved by Caltech/JPL
+ *
+ * APACHE LICENSE, VERSION 2.0
+ * - Text version: https://www.apache.org/licenses/LICENSE-2.0.txt
+ * - SPDX short identifier: Apache-2.0
+ * - OSI Approved License: https://opensource.org/licenses/Apache-2.0
+ */
+
+
+/** @file Channel.h
+*   @brief Overlap and capture model of the radio channel at every receiver of the simulation
+*
+*   Every transmission that reaches a receiver is a reception interval [start, end). The active receptions of a receiver 
+*   are kept sorted by their end time, so the next reception to end is always the first one. Starting or ending a 
+*   reception shifts the sorted array with memmove and takes O(n) in the number of receptions that currently reach the 
+*   receiver. The receiver locks onto the first reception of a busy period (the time during which at least one 
+*   reception is active); every reception that starts while the receiver is busy overlaps it.
+*
+*   Without capture, an overlapped busy period ends in a single COLLISION when its last reception ends (the behavior of 
+*   functionId 6 of the MatlabWrapper). With capture enabled, the locked reception is still decoded if its received power 
+*   is at least captureThreshold dB above the strongest reception that overlapped it.
+*/ 
+
+#ifndef CHANNEL_H
+#define CHANNEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+typedef struct ChannelStruct * Channel;
+typedef struct ChannelReceiverStruct * ChannelReceiver;
+typedef struct ChannelReceptionStruct * ChannelReception;
+
+/** What a receiver gets when one of its receptions ends */
+typedef enum ChannelRxResult {
+  CHANNEL_RX_NONE,       // nothing (yet); the busy period goes on or its message was already delivered
+  CHANNEL_RX_MESSAGE,    // the locked reception was decoded
+  CHANNEL_RX_COLLISION,  // the busy period is over and overlapping receptions could not be decoded
+  CHANNEL_RX_LOST        // the busy period is over and the receiver transmitted itself during it
+} ChannelRxResult;
+
+/**
+* txId: ID of the transmission that is received
+* start, end: reception interval [start, end)
+* power: received power in dB
+*/
+typedef struct ChannelReceptionStruct {
+  uint64_t txId;
+  int64_t start;
+  int64_t end;
+  double power;
+} ChannelReceptionStruct;
+
+/**
+* active: receptions that currently reach the receiver, sorted by end time
+* numActive: number of elements in active
+* activeCapacity: allocated size of active
+* lockedTxId: ID of the transmission the receiver locked onto at the beginning of the busy period
+* lockedPower: received power of the locked transmission in dB
+* maxInterference: power of the strongest reception that overlapped the locked one in dB; -INFINITY if there was none
+* overlapped: whether another reception overlapped the locked one
+* lost: whether the receiver transmitted during the busy period
+* delivered: whether the message of the locked reception was already delivered
+*/
+typedef struct ChannelReceiverStruct {
+  ChannelReceptionStruct *active;
+  int32_t numActive;
+  int32_t activeCapacity;
+
+  uint64_t lockedTxId;
+  double lockedPower;
+  double maxInterference;
+  bool overlapped;
+  bool lost;
+  bool delivered;
+} ChannelReceiverStruct;
+
+/**
+* receivers: state of every receiver
+* numReceivers: number of elements in receivers
+* captureEnabled: whether the capture rule is applied
+* captureThreshold: minimum difference in dB between the locked reception and the strongest overlapping one for capture
+* pathLossExponent: exponent of the log-distance path loss model used by Channel_ReceivedPower
+* numOverlaps: number of receptions that started while the receiver was busy
+* numCaptures: number of overlapped receptions that were decoded because of the capture rule
+*/
+typedef struct ChannelStruct {
+  ChannelReceiverStruct *receivers;
+  int16_t numReceivers;
+
+  bool captureEnabled;
+  double captureThreshold;
+  double pathLossExponent;
+
+  uint64_t numOverlaps;
+  uint64_t numCaptures;
+} ChannelStruct;
+
+/** Constructor
+* @param numReceivers is the number of receivers (nodes) of the simulation
+*/
+Channel Channel_Create(int16_t numReceivers);
+
+/** Destructor
+* @param self is the Channel struct
+*/
+void Channel_Destroy(Channel self);
+
+/** Copy constructor; the copy has the same receptions and settings but no memory in common with the original
+* @param self is the Channel struct that is copied
+*/
+Channel Channel_Clone(Channel self);
+
+/** Enable or disable the capture rule
+* @param self is the Channel struct
+* @param enabled is true if the capture rule should be applied
+* @param threshold is the minimum power difference in dB for the locked reception to be decoded despite overlaps
+* @param pathLossExponent is the exponent of the path loss model (2 in free space)
+*/
+void Channel_SetCapture(Channel self, bool enabled, double threshold, double pathLossExponent);
+
+/** Received power at a distance from the sender according to a log-distance path loss model
+* @param self is the Channel struct
+* @param distance is the distance between sender and receiver
+* return received power in dB relative to the power at a distance of 1
+*/
+double Channel_ReceivedPower(Channel self, double distance);
+
+/** A transmission starts to reach a receiver
+* @param self is the Channel struct
+* @param receiverIdx is the index of the receiver
+* @param txId is the unique ID of the transmission
+* @param start is the time the reception starts
+* @param end is the time the reception ends
+* @param power is the received power in dB
+* return true if the receiver locks onto this reception (it was idle before), false if the reception overlaps others
+*/
+bool Channel_StartReception(Channel self, int16_t receiverIdx, uint64_t txId, int64_t start, int64_t end, double power);
+
+/** A reception ends
+* @param self is the Channel struct
+* @param receiverIdx is the index of the receiver
+* @param txId is the ID of the transmission
+* @param end is the end time the reception was started with
+* return what the receiver gets (see ChannelRxResult)
+*/
+ChannelRxResult Channel_EndReception(Channel self, int16_t receiverIdx, uint64_t txId, int64_t end);
+
+/** The receiver starts to transmit itself; everything it is currently receiving is lost
+* @param self is the Channel struct
+* @param receiverIdx is the index of the receiver
+*/
+void Channel_AbortReceptions(Channel self, int16_t receiverIdx);
+
+/** Return if a receiver is currently reached by any transmission
+* @param self is the Channel struct
+* @param receiverIdx is the index of the receiver
+*/
+bool Channel_IsBusy(Channel self, int16_t receiverIdx);
+
+/** Number of active receptions of a receiver that are still going on at a point in time; a reception that would start 
+*   at that time overlaps all of them
+* @param self is the Channel struct
+* @param receiverIdx is the index of the receiver
+* @param time is the point in time
+* return number of active receptions of the receiver that end after time
+*/
+int32_t Channel_CountOverlaps(Channel self, int16_t receiverIdx, int64_t time);
+
+#endif
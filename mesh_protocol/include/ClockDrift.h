@@ -0,0 +1,114 @@
+/* Copyright (c) 2022-23 California Institute of Technology (Caltech).
+ * U.S. Government sponsorship acknowledged.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Caltech nor its operating division,
+ *   the Jet Propulsion Laboratory, nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Open Source License Approved by Caltech/JPL
+ *
+ * APACHE LICENSE, VERSION 2.0
+ * - Text version: https://www.apache.org/licenses/LICENSE-2.0.txt
+ * - SPDX short identifier: Apache-2.0
+ * - OSI Approved License: https://opensource.org/licenses/Apache-2.0
+ */
+
+
+/** @file ClockDrift.h
+*   @brief Drift of the crystal of a simulated node
+*
+*   The rate of a clock deviates from the nominal rate by a few parts per million (ppm). The model adds up a constant
+*   offset (tolerance of the crystal), a random walk (aging, noise) and a slow sinusoidal variation (temperature). The rate 
+*   only changes every updateInterval tics; in between, the Simulator advances the local time with a fixed-point increment
+*   (see CLOCK_DRIFT_FRACTION_BITS), i.e. without any branching per tic.
+*/ 
+
+#ifndef CLOCK_DRIFT_H
+#define CLOCK_DRIFT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+
+/** Number of fractional bits of the sub-tic part of the local times of drifting clocks */
+#define CLOCK_DRIFT_FRACTION_BITS 32
+
+/** Value that is never reached by the time of the next update (rate does not change) */
+#define CLOCK_DRIFT_NO_UPDATE INT64_MAX
+
+typedef struct ClockDriftStruct * ClockDrift;
+
+/**
+* offsetPpm: constant deviation of the rate
+* randomWalkPpm: standard deviation of the change of the random walk with every update
+* variationPpm: amplitude of the slow variation
+* variationPeriod: period of the slow variation in time tics
+* updateInterval: time tics between two updates of the rate; 0 if the rate is constant
+* walkPpm: current value of the random walk
+* ratePpm: current deviation of the rate (offset + random walk + variation)
+* randomState: state of the random numbers of the random walk
+* nextUpdate: simulation time of the next update of the rate
+*/
+typedef struct ClockDriftStruct {
+  double offsetPpm;
+  double randomWalkPpm;
+  double variationPpm;
+  int64_t variationPeriod;
+  int64_t updateInterval;
+
+  double walkPpm;
+  double ratePpm;
+  uint32_t randomState;
+  int64_t nextUpdate;
+} ClockDriftStruct;
+
+/** Set up the model and its rate at a time
+* @param self is the ClockDrift struct
+* @param offsetPpm is the constant deviation of the rate (positive values make the clock run fast)
+* @param randomWalkPpm is the standard deviation of the random walk per update
+* @param variationPpm is the amplitude of the slow variation
+* @param variationPeriod is the period of the slow variation in time tics (ignored if variationPpm is 0)
+* @param updateInterval is the number of time tics between two updates of the rate; 0 keeps the rate at offsetPpm
+* @param seed is the seed of the random walk
+* @param time is the current simulation time
+*/
+void ClockDrift_Init(ClockDrift self, double offsetPpm, double randomWalkPpm, double variationPpm, int64_t variationPeriod, 
+  int64_t updateInterval, uint32_t seed, int64_t time);
+
+/** Update the rate if its next update is due
+* @param self is the ClockDrift struct
+* @param time is the current simulation time
+* return true if the rate was updated
+*/
+bool ClockDrift_Update(ClockDrift self, int64_t time);
+
+/** Get the increment of the local time per tic as fixed-point value
+* @param self is the ClockDrift struct
+* return (1 + ratePpm / 1e6) - 1 in units of 2^-CLOCK_DRIFT_FRACTION_BITS tics
+*/
+int64_t ClockDrift_GetIncrement(ClockDrift self);
+
+#endif
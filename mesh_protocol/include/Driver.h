@@ -47,7 +47,9 @@
 #include <string.h>
 #include <inttypes.h>
 #include "Node.h"
+#include "Message.h"
 #include "ProtocolClock.h"
+#include "Trace.h"
 
 #include "TimeKeeping.h" // debugging
 
@@ -55,7 +57,24 @@
 #include "mex.h"
 #endif
 
+/** number of messages a node can send before the simulation environment has to take them from its transmit ring */
+#define DRIVER_TX_RING_SIZE 4
+
 typedef struct DriverStruct * Driver;
+typedef struct DriverTxRingStruct * DriverTxRing;
+
+/** Fixed-size queue that the simulation driver writes sent messages to; owned by the simulation environment (MatlabWrapper or Simulator)
+* msgs: messages that were sent and not yet taken by the simulation environment
+* head: index of the oldest message in msgs
+* count: number of messages in the ring
+* numDropped: number of messages that were dropped because the ring was full
+*/
+typedef struct DriverTxRingStruct {
+  MessageStruct msgs[DRIVER_TX_RING_SIZE];
+  uint8_t head;
+  uint8_t count;
+  uint32_t numDropped;
+} DriverTxRingStruct;
 
 typedef struct DriverStruct{
   bool * txFinishedFlag;
@@ -65,10 +84,11 @@ typedef struct DriverStruct{
   uint16_t rx_antenna_delay;
 
   // only for simulation
-  /** address where sent messages are written to by this driver */
-  Message * msgOutAddress;
+  /** ring that sent messages are written to by this driver */
+  DriverTxRing txRing;
   
-  /** flag read by MatlabWrapper to determine whether message has been sent and needs to send to MATLAB */
+  /** flag read by MatlabWrapper to determine whether message has been sent and needs to send to MATLAB; 
+  *   stays set as long as there are messages in txRing */
   bool sentMessage; 
 
   int64_t lastTxStartTime;
@@ -116,11 +136,22 @@ void Driver_TransmitFinal(Node node, Message msg);
 */
 void Driver_TransmitResult(Node node, Message msg);
 
-/** Set the address where this driver writes sent messages to so external code can read them (instead of actually sending them via UWB, as this is a simulation driver)
+/** Set the ring this driver writes sent messages to so external code can read them (instead of actually sending them via UWB, as this is a simulation driver)
 * @param node is the Node struct of the node that should perform this action
-* @param msgOutAddress is the address of the message that the driver should write messages to
+* @param txRing is the ring the driver should write messages to; if NULL, sent messages are discarded
+*/
+void Driver_SetTxRing(Node node, DriverTxRing txRing);
+
+/** Get the oldest message in a transmit ring without removing it
+* @param txRing is the transmit ring
+* return the oldest message or NULL if the ring is empty; only valid until Driver_TxRingPop is called
+*/
+Message Driver_TxRingPeek(DriverTxRing txRing);
+
+/** Remove the oldest message from a transmit ring
+* @param txRing is the transmit ring
 */
-void Driver_SetOutMsgAddress(Node node, Message *msgOutAddress);
+void Driver_TxRingPop(DriverTxRing txRing);
 
 /** Return if driver is currently receiving a transmission
 * @param node is the Node struct of the node that should perform this action
@@ -0,0 +1,94 @@
+/* Copyright (c) 2022-23 California Institute of Technology (Caltech).
+ * U.S. Government sponsorship acknowledged.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Caltech nor its operating division,
+ *   the Jet Propulsion Laboratory, nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Open Source License Approved by Caltech/JPL
+ *
+ * APACHE LICENSE, VERSION 2.0
+ * - Text version: https://www.apache.org/licenses/LICENSE-2.0.txt
+ * - SPDX short identifier: Apache-2.0
+ * - OSI Approved License: https://opensource.org/licenses/Apache-2.0
+ */
+
+
+/** @file Footprint.h
+*   @brief Static RAM footprint of the protocol structs of one node
+*
+*   On the DWM1001 (64 KB SRAM), main.c allocates one instance of every protocol struct and one MessageStruct on the 
+*   stack, because the heap is not sufficient for the constructors. FOOTPRINT_NODE_SIZE is the sum of the protocol 
+*   structs of this host-side tree, i.e. their layouts here and not the allocation of the firmware: it includes structs 
+*   the firmware does not have (e.g. TimerWheelStruct), which the firmware's own check leaves out. It depends on 
+*   NUM_SLOTS, MAX_NUM_NODES, MAX_NUM_PENDING_SLOTS and MAX_NUM_COLLISIONS_RECORDED (see Constants.h).
+*   Footprint.c checks at compile time that it does not exceed FOOTPRINT_NODE_BUDGET, which every target can set 
+*   (-DFOOTPRINT_NODE_BUDGET=<bytes>). The sizes are those of the compiler that builds the target, so on a 64 bit host 
+*   they are larger than on the Cortex-M4 (pointers have 8 instead of 4 bytes).
+*   The memory_footprint tool prints the sizes for the settings in MESH_FOOTPRINT_SETTINGS (see CMakeLists.txt).
+*/ 
+
+#ifndef FOOTPRINT_H
+#define FOOTPRINT_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "Node.h"
+#include "StateMachine.h"
+#include "Scheduler.h"
+#include "ProtocolClock.h"
+#include "TimeKeeping.h"
+#include "NetworkManager.h"
+#include "MessageHandler.h"
+#include "SlotMap.h"
+#include "Neighborhood.h"
+#include "TimerWheel.h"
+#include "RangingManager.h"
+#include "LCG.h"
+#include "Config.h"
+#include "Driver.h"
+#include "Message.h"
+
+/** Bytes that the protocol structs of one node may use (a quarter of the SRAM of the DWM1001; the rest is needed by 
+* the SDK, the DW1000 driver and the stack frames) */
+#ifndef FOOTPRINT_NODE_BUDGET
+#define FOOTPRINT_NODE_BUDGET 16384
+#endif
+
+/** Bytes of the protocol structs of one node, with the host-side struct layouts (not the firmware allocation) */
+#define FOOTPRINT_NODE_SIZE (sizeof(struct NodeStruct) + sizeof(struct StateMachineStruct) \
+  + sizeof(struct SchedulerStruct) + sizeof(struct ProtocolClockStruct) + sizeof(struct TimeKeepingStruct) \
+  + sizeof(struct NetworkManagerStruct) + sizeof(struct MessageHandlerStruct) + sizeof(struct SlotMapStruct) \
+  + sizeof(struct NeighborhoodStruct) + sizeof(struct TimerWheelStruct) + sizeof(struct RangingManagerStruct) + sizeof(struct LCGStruct) \
+  + sizeof(struct ConfigStruct) + sizeof(struct DriverStruct) + sizeof(struct MessageStruct))
+
+/** Print the compile time constants, the size of every protocol struct, FOOTPRINT_NODE_SIZE and FOOTPRINT_NODE_BUDGET
+* @param file is the file the report is written to
+*/
+void Footprint_Print(FILE *file);
+
+#endif
@@ -100,12 +100,26 @@ bool GuardConditions_SendingConToListeningConAllowed(Node node);
 */
 bool GuardConditions_RangingPollAllowed(Node node);
 
+/** Determine the earliest time in the current slot at which sending a POLL message is allowed
+* @param node is the Node struct of this node
+* return Local time from which GuardConditions_RangingPollAllowed() is true until the end of the current slot, unless a message 
+*   changes the state of this node before; NODE_NO_DEADLINE if it is not allowed in the rest of the current slot
+*/
+int64_t GuardConditions_EarliestRangingPollTime(Node node);
+
 /** Determine whether going to IDLE (duty cycle) is allowed
 * @param node is the Node struct of this node
 * return Whether transition is allowed
 */
 bool GuardConditions_IdleingAllowed(Node node);
 
+/** Determine the earliest time in the current slot at which going to IDLE is allowed
+* @param node is the Node struct of this node
+* return Local time from which GuardConditions_IdleingAllowed() is true until the end of the current slot, unless a message 
+*   or an expiring timer changes the state of this node before; NODE_NO_DEADLINE if it is not allowed in the current slot
+*/
+int64_t GuardConditions_EarliestIdleingTime(Node node);
+
 /** Determine whether returning out of IDLE is allowed on receiving a message
 * @param node is the Node struct of this node
 * @param msg is the incoming message
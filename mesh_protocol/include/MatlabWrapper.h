@@ -46,6 +46,11 @@
 *   It also checks whether all nodes have reserved enough slots, if slots collide and if all neighbors are in the same network; otherwise
 *   the simulation continues until a timeout is reached, which then terminates the simulation as "FAILED"
 *
+*   Instead of calling the state machine of every node for every time tic from MATLAB, functionId 20 advances all nodes by 
+*   a number of time tics inside C (see Wrapper_AdvanceTics) and returns all messages that were sent in that time at once.
+*   MATLAB then only has to provide which nodes are in range of each other as a connectivity matrix.
+*   Likewise, functionId 21 returns the state of all nodes at once (see Snapshot.h).
+*
 */ 
 
 #ifndef MATLAB_WRAPPER_H
@@ -70,13 +75,16 @@
 #include "Config.h"
 #include "Util.h"
 #include "Message.h"
+#include "Driver.h"
+#include "Snapshot.h"
  
 typedef struct WrapperStruct * Wrapper;
+typedef struct WrapperSentMessagesStruct * WrapperSentMessages;
 
 /**
 * nodes: array of all node structs in the simulation
 * ids: array of ids of the nodes in the simulation
-* outmMsg: array that messages are put in that a node sent; space for one message per node
+* txRings: transmit rings that the drivers write sent messages to; one per node
 * txFinished: array of txFinished flags for every node
 * isReceiving: array of isReceiving flags for every node; determined and set by MATLAB
 * numNodes: number of nodes in the simulation
@@ -85,11 +93,19 @@ typedef struct WrapperStruct * Wrapper;
 * initialRandomSeeds: array that holds the initial random seeds of every node that were created by MATLAB
 * clockSkew: array that holds the clockSkew of every node
 * lastSkewTime: array that holds the last time an additional tic was added or skipped because of the clock skew for every node
+* txMsg: message that is currently on the channel for every node (only used by Wrapper_AdvanceTics); NULL if there is none;
+*   acquired from messagePool with one reference for the transmission and one for every node it reaches
+* txReaches: txReaches[s][r] is true if the current transmission of node s reaches node r
+* numActiveRx: number of transmissions that currently reach a node
+* rxCollided: whether the current reception of a node has been overlapped by another transmission
+* rxLost: whether the current reception of a node was aborted because the node transmitted itself
+* rxTimestamp: local time of the receiving node when the preamble of the current reception arrived
+* messagePool: pool for all messages that are delivered to the nodes
 */
 typedef struct WrapperStruct{
   Node nodes[MAX_NUM_NODES];
   int8_t ids[MAX_NUM_NODES];
-  Message outMsg[MAX_NUM_NODES];
+  DriverTxRingStruct txRings[MAX_NUM_NODES];
   bool txFinished[MAX_NUM_NODES];
   bool isReceiving[MAX_NUM_NODES];
 
@@ -102,8 +118,39 @@ typedef struct WrapperStruct{
   int clockSkew[MAX_NUM_NODES]; // add an additional or skip a tic every x tics
   int64_t lastSkewTime[MAX_NUM_NODES]; 
 
+  Message txMsg[MAX_NUM_NODES];
+  bool txReaches[MAX_NUM_NODES][MAX_NUM_NODES];
+  int8_t numActiveRx[MAX_NUM_NODES];
+  bool rxCollided[MAX_NUM_NODES];
+  bool rxLost[MAX_NUM_NODES];
+  int64_t rxTimestamp[MAX_NUM_NODES];
+
+  MessagePool messagePool;
+
 } WrapperStruct;
 
+/**
+* msg: copy of the message that was sent
+* sendTime: local time of the sending node when the message was sent
+* tic: time tic of the batch (starting at 0) in which the message was sent
+*/
+typedef struct WrapperSentMessageStruct {
+  MessageStruct msg;
+  int64_t sendTime;
+  int64_t tic;
+} WrapperSentMessageStruct;
+
+/**
+* elements: array of all messages sent during a call of Wrapper_AdvanceTics, in the order they were sent
+* num: number of elements
+* capacity: allocated size of elements
+*/
+typedef struct WrapperSentMessagesStruct {
+  WrapperSentMessageStruct *elements;
+  int32_t num;
+  int32_t capacity;
+} WrapperSentMessagesStruct;
+
 /** Add a node to the simulation
 * @param wrapper is the MatlabWrapper of the simulation
 * @param node is the Node struct of the node that should be added
@@ -117,4 +164,17 @@ int8_t Wrapper_AddNode(Wrapper wrapper, Node node);
 */
 int8_t Wrapper_GetNumNodes(Wrapper wrapper);
 
+/** Advance all nodes of the simulation by a number of time tics
+*   Does the same as calling functionIds 3, 4, 6 and 9 from MATLAB for every node and every time tic: 
+*   finished transmissions are delivered to all nodes that were in range (or a COLLISION message if transmissions overlapped), 
+*   the state machine of every node that is turned on is run with TIME_TIC and the local times are incremented (including clock skew).
+*   A transmission ends when the local time of the sender reaches the start time of the transmission plus its MessageSizes.
+* @param wrapper is the MatlabWrapper of the simulation
+* @param numTics is the number of time tics to advance
+* @param connectivity is a column-major numNodes x numNodes matrix; element (r, s) is true if node r receives the messages of node s;
+*   NULL if all nodes are in range of each other
+* @param sent is the list all messages that were sent are appended to
+*/
+void Wrapper_AdvanceTics(Wrapper wrapper, int64_t numTics, const bool *connectivity, WrapperSentMessages sent);
+
 #endif
@@ -41,6 +41,7 @@
 
 #include "Constants.h"
 #include "Node.h"
+#include "SlotStatus.h"
 
 /** Types a message can have */
 enum MessageTypes {
@@ -57,6 +58,7 @@ enum MessageSizes {
 };
 
 typedef struct MessageStruct * Message;
+typedef struct MessagePoolStruct * MessagePool;
 typedef enum MessageTypes MessageTypes;
 typedef enum MessageSizes MessageSizes;
 
@@ -69,15 +71,16 @@ typedef enum MessageSizes MessageSizes;
 * networkId: ID of the network the sending node belongs to
 * networkAge: age of the network the sending node belongs to as calculated by the sending node (in time tics)
 * timeSinceFrameStart: time tics since beginning of the current frame as counted by the sending node 
-* oneHopSlotStatus: array of the status of each slot as directly perceived ("one hop") by the sending node; see enum "SlotOccupancy" in SlotMap.h for possible values
+* oneHopSlotStatus: status of each slot as directly perceived ("one hop") by the sending node, packed into 2 bits per slot (see SlotStatus.h)
 * oneHopSlotIds: array of the ID of nodes occupying each slot; 0 if slot is FREE
-* twoHopSlotStatus: array of the status of each slot as reported by neighbors ("two hop") of the sending node; see enum "SlotOccupancy" in SlotMap.h for possible values
+* twoHopSlotStatus: status of each slot as reported by neighbors ("two hop") of the sending node, packed into 2 bits per slot (see SlotStatus.h)
 * twoHopSlotIds: array of the ID of nodes reported occupying each slot; 0 if slot is FREE
 * collisionTimes: array of "number of time tics before the sending time of the message" at which collisions were received; used to report collisions to nodes in other networks
 *   (cause their slots are likely shifted) or when the sending node does not belong to a network yet
 * numCollisions: size of the collision times array
 * multiHopStatus: can either hold oneHopSlotStatus or twoHopSlotStatus; only used internally and not set by the nodes
 * multiHopIds: can either hold oneHopSlotIds or twoHopSlotIds; only used internally and not set by the nodes
+* refCount: number of references to a message that was acquired from a MessagePool; not part of the message content
 */
 typedef struct MessageStruct {
   MessageTypes type;
@@ -87,9 +90,9 @@ typedef struct MessageStruct {
   uint8_t networkId;
   int64_t networkAge;                 // network age at time of sending (not at completion of the message - therefore arrival of preamble is used later)
   int64_t timeSinceFrameStart;
-  int oneHopSlotStatus[NUM_SLOTS];
+  SlotStatusArray oneHopSlotStatus;
   int8_t oneHopSlotIds[NUM_SLOTS];
-  int twoHopSlotStatus[NUM_SLOTS];
+  SlotStatusArray twoHopSlotStatus;
   int8_t twoHopSlotIds[NUM_SLOTS];
   int64_t collisionTimes[MAX_NUM_COLLISIONS_RECORDED];  // used to report collisions to foreign networks (contains time since the collision happened, so it is independent of slot synchronization)
   int8_t numCollisions;               // number of collision times actually contained in the message
@@ -101,10 +104,33 @@ typedef struct MessageStruct {
   uint32_t frame_len;
 
   // used internally to hold two- or three-hop maps:
-  int *multiHopStatus; // this is only a pointer to one of the other arrays, not an array itself
+  SlotStatusArray *multiHopStatus; // this is only a pointer to one of the other arrays, not an array itself
   int8_t *multiHopIds;
+
+  uint16_t refCount;
 } MessageStruct;
 
+/** number of messages in the pool of the MatlabWrapper: one on the channel for every node plus the message that is being delivered */
+#define MESSAGE_POOL_SIZE (MAX_NUM_NODES + 1)
+
+/** Fixed-size pool of messages for the simulation; messages are reference counted, so one message can be delivered to several receivers
+* msgs: storage of the pooled messages
+* nextFree: for every free message, the index of the next free message (free list); -1 ends the list
+* freeHead: index of the first free message; -1 if all messages are in use
+* capacity: number of messages in msgs
+* numAcquired: number of messages that were acquired
+* numHeapAllocations: number of messages that had to be allocated on the heap because the pool was empty
+*/
+typedef struct MessagePoolStruct {
+  MessageStruct *msgs;
+  int16_t *nextFree;
+  int16_t freeHead;
+  int16_t capacity;
+
+  uint64_t numAcquired;
+  uint64_t numHeapAllocations;
+} MessagePoolStruct;
+
 /** Constructor
 * @param t is the type of the message to be created
 */
@@ -114,4 +140,38 @@ Message Message_Create(MessageTypes t);
 * Messages need to be destroyed at certain points, otherwise memory will leak
 */
 void Message_Destroy(Message self);
+
+/** Constructor of a message pool
+* @param capacity is the number of messages in the pool
+*/
+MessagePool MessagePool_Create(int16_t capacity);
+
+/** Destructor of a message pool; all messages of the pool must have been released
+* @param pool is the MessagePool struct
+*/
+void MessagePool_Destroy(MessagePool pool);
+
+/** Take an empty message from a pool (or from the heap if the pool is empty); the reference count of the message is 1
+* @param pool is the MessagePool struct
+* @param t is the type of the message
+* return the message
+*/
+Message Message_Acquire(MessagePool pool, MessageTypes t);
+
+/** Add a reference to a message that was acquired from a pool
+* @param self is the message
+*/
+void Message_Retain(Message self);
+
+/** Remove a reference to a message that was acquired from a pool; the message is returned to the pool when no reference is left
+* @param pool is the MessagePool struct the message was acquired from
+* @param self is the message
+*/
+void Message_Release(MessagePool pool, Message self);
+
+/** Copy the content of a message to another message; the reference count of the destination is not changed
+* @param dst is the message that is written to
+* @param src is the message that is copied
+*/
+void Message_CopyContent(Message dst, Message src);
 #endif
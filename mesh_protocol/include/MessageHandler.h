@@ -53,6 +53,7 @@
 #include "ProtocolClock.h"
 #include "Neighborhood.h"
 #include "Scheduler.h"
+#include "Trace.h"
 
 #ifdef SIMULATION
 #include "mex.h"
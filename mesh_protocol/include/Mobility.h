@@ -0,0 +1,187 @@
+/* Copyright (c) 2022-23 California Institute of Technology (Caltech).
+ * U.S. Government sponsorship acknowledged.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Caltech nor its operating division,
+ *   the Jet Propulsion Laboratory, nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Open Source License Approved by Caltech/JPL
+ *
+ * APACHE LICENSE, VERSION 2.0
+ * - Text version: https://www.apache.org/licenses/LICENSE-2.0.txt
+ * - SPDX short identifier: Apache-2.0
+ * - OSI Approved License: https://opensource.org/licenses/Apache-2.0
+ */
+
+
+/** @file Mobility.h
+*   @brief Movement of simulated nodes over time
+*
+*   Every node has a mobility model that gives its position at any simulation time: static (the position it was added with),
+*   random waypoint (move to a random point in an area with a random speed, pause, repeat) or a path of timed waypoints 
+*   (scripted, or replayed from a GPS/odometry file) between which the position is interpolated linearly.
+*
+*   Positions are only looked up for times that do not decrease, so every model keeps a cursor and a lookup is constant time.
+*   The Simulator only asks for the positions when it needs them (when a transmission starts or a ranging result is 
+*   delivered) and moves the nodes in its SpatialGrid, which only relinks the nodes whose cell changed.
+*
+*   Positions are in the unit of the radio range, times in time tics and speeds in position units per time tic.
+*/ 
+
+#ifndef MOBILITY_H
+#define MOBILITY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+typedef struct MobilityStruct * Mobility;
+typedef struct MobilityNodeStruct * MobilityNode;
+typedef struct MobilityWaypointStruct * MobilityWaypoint;
+
+enum MobilityModels {
+  MOBILITY_STATIC = 0,
+  MOBILITY_RANDOM_WAYPOINT = 1,
+  MOBILITY_PATH = 2
+};
+
+typedef enum MobilityModels MobilityModels;
+
+/**
+* time: simulation time at which the node is at the waypoint
+* x, y: position of the waypoint
+*/
+typedef struct MobilityWaypointStruct {
+  int64_t time;
+  double x;
+  double y;
+} MobilityWaypointStruct;
+
+/**
+* model: mobility model of the node
+* minX, minY, maxX, maxY: area the waypoints are drawn from (random waypoint)
+* minSpeed, maxSpeed: range the speed of every leg is drawn from (random waypoint)
+* pauseTime: time the node stays at a waypoint before it moves on (random waypoint)
+* randomState: state of the random numbers of the node (random waypoint)
+* from, to: start and end of the current leg; the node waits at to until the time of from of the next leg (random waypoint)
+* pauseUntil: time at which the next leg starts (random waypoint)
+* path: waypoints ordered by time (path)
+* numWaypoints: number of elements in path
+* pathCapacity: allocated size of path
+* cursor: index of the last waypoint that is not later than the last time that was looked up (path)
+*/
+typedef struct MobilityNodeStruct {
+  MobilityModels model;
+
+  double minX;
+  double minY;
+  double maxX;
+  double maxY;
+  double minSpeed;
+  double maxSpeed;
+  int64_t pauseTime;
+  uint32_t randomState;
+  MobilityWaypointStruct from;
+  MobilityWaypointStruct to;
+  int64_t pauseUntil;
+
+  MobilityWaypointStruct *path;
+  int32_t numWaypoints;
+  int32_t pathCapacity;
+  int32_t cursor;
+} MobilityNodeStruct;
+
+/**
+* capacity: maximum number of nodes
+* nodes: mobility model of every node; all nodes are static in the beginning
+* numMoving: number of nodes that are not static
+* seed: seed from which the random numbers of every node are derived
+*/
+typedef struct MobilityStruct {
+  int16_t capacity;
+  MobilityNodeStruct *nodes;
+  int16_t numMoving;
+  uint32_t seed;
+} MobilityStruct;
+
+/** Constructor
+* @param capacity is the maximum number of nodes (the capacity of the Simulator)
+* @param seed is the seed of the random waypoints
+*/
+Mobility Mobility_Create(int16_t capacity, uint32_t seed);
+
+/** Destructor
+* @param self is the Mobility struct
+*/
+void Mobility_Destroy(Mobility self);
+
+/** Let a node move between random waypoints in an area
+* @param self is the Mobility struct
+* @param nodeIdx is the index of the node in the Simulator
+* @param x, y is the position of the node at time 0
+* @param minX, minY, maxX, maxY is the area the waypoints are drawn from
+* @param minSpeed, maxSpeed is the range of the speed of every leg (must be greater than 0)
+* @param pauseTime is the time the node stays at every waypoint
+*/
+void Mobility_SetRandomWaypoint(Mobility self, int16_t nodeIdx, double x, double y, double minX, double minY, double maxX, 
+  double maxY, double minSpeed, double maxSpeed, int64_t pauseTime);
+
+/** Let a node follow a path of timed waypoints; before the first and after the last waypoint, the node stays there
+* @param self is the Mobility struct
+* @param nodeIdx is the index of the node in the Simulator
+* @param waypoints is an array of waypoints (copied; they do not need to be ordered by time)
+* @param numWaypoints is the number of elements in waypoints
+*/
+void Mobility_SetPath(Mobility self, int16_t nodeIdx, const MobilityWaypointStruct *waypoints, int32_t numWaypoints);
+
+/** Read the paths of nodes from a text file (e.g. converted GPS or odometry logs)
+*   Every line holds one waypoint as "nodeIdx time x y", separated by spaces or commas; lines starting with # are ignored.
+*   The waypoints are added to the paths of the nodes, which become MOBILITY_PATH nodes.
+* @param self is the Mobility struct
+* @param file is the file to read
+* return number of waypoints that were read, or -1 if a line could not be parsed
+*/
+int32_t Mobility_ReadPaths(Mobility self, FILE *file);
+
+/** Check if a node moves
+* @param self is the Mobility struct
+* @param nodeIdx is the index of the node in the Simulator
+* return true if the model of the node is not static
+*/
+bool Mobility_IsMoving(Mobility self, int16_t nodeIdx);
+
+/** Get the position of a node at a time
+* @param self is the Mobility struct
+* @param nodeIdx is the index of the node in the Simulator
+* @param time is the simulation time; must not be lower than the time of the last call for this node
+* @param x, y is set to the position (not changed for static nodes)
+*/
+void Mobility_GetPosition(Mobility self, int16_t nodeIdx, int64_t time, double *x, double *y);
+
+#endif
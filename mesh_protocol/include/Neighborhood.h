@@ -49,6 +49,8 @@
 #include "ProtocolClock.h"
 #include "Util.h"
 #include "Config.h"
+#include "Trace.h"
+#include "TimerWheel.h"
 
 #ifdef SIMULATION
 #include "mex.h"
@@ -96,6 +98,13 @@ int8_t Neighborhood_GetOneHopNeighbors(Node node, int8_t *buffer, int8_t size);
 */
 void Neighborhood_RemoveAbsentNeighbors(Node node);
 
+/** Schedule the timers of all neighbors again
+* @param node is the Node struct of this node
+*
+* Only needed if the arrays of the neighborhood were changed without the Neighborhood functions (e.g. in tests and benchmarks)
+*/
+void Neighborhood_RescheduleTimers(Node node);
+
 /** Update the time of the last ranging with the neighbor
 * @param node is the Node struct of this node
 * @param id is the ID of the neighbor whose value should be updated
@@ -112,6 +121,13 @@ void Neighborhood_UpdateRanging(Node node, int8_t id, int64_t updateTime, double
 */
 int8_t Neighborhood_GetNextRangingNeighbor(Node node);
 
+/** Get the time at which ranging with the next neighbor is due
+* @param node is the Node struct of this node
+* return local time from which Neighborhood_GetNextRangingNeighbor() returns a neighbor;
+* returns NODE_NO_DEADLINE if there are no neighbors
+*/
+int64_t Neighborhood_GetNextRangingTime(Node node);
+
 /** Get the neighbor that was the last to join the neighborhood
 * @param node is the Node struct of this node
 * return ID of the neighbor that joined the neighborhood last 
@@ -65,6 +65,14 @@ typedef struct NeighborhoodStruct * Neighborhood;
 typedef struct RangingManagerStruct * RangingManager;
 typedef struct LCGStruct * LCG;
 typedef struct ConfigStruct * Config;
+typedef struct TraceWriterStruct * TraceWriter;
+typedef struct TimerWheelStruct * TimerWheel;
+
+/** Number of a slot in a frame (1 to NUM_SLOTS); 16 bits wide, so that frames can have more than 127 slots */
+typedef int16_t SlotNum;
+
+/** Returned by Node_NextDeadline() if no time tic will change the state of the node */
+#define NODE_NO_DEADLINE INT64_MAX
 
 /**
 * id: ID of this node (must be unique among all nodes whose networks could ever get in range of each other) 
@@ -79,6 +87,8 @@ typedef struct ConfigStruct * Config;
 * rangingManager: struct that holds the data of the RangingManager
 * lcg: struct that holds the data of the LCG
 * config: struct that holds the data of the Config
+* trace: writer for the binary event trace of this node (see Trace.h); NULL if the node is not traced
+* timerWheel: struct that holds the timers of the slot maps, pending and own slots and neighbors (see TimerWheel.h)
 */
 typedef struct NodeStruct{
   int8_t id;
@@ -94,6 +104,8 @@ typedef struct NodeStruct{
   RangingManager rangingManager;
   LCG lcg;
   Config config;
+  TraceWriter trace;
+  TimerWheel timerWheel;
 } NodeStruct;
 
 /** Constructor */
@@ -171,4 +183,26 @@ void Node_SetLCG(Node self, LCG lcg);
 */
 void Node_SetConfig(Node self, Config config);
 
+/** Sets the TraceWriter the node writes its trace records to
+* @param self is the Node struct
+* @param trace is the TraceWriter struct; NULL to stop tracing
+*/
+void Node_SetTrace(Node self, TraceWriter trace);
+
+/** Sets the TimerWheel struct as a property of the Node struct
+* @param self is the Node struct
+* @param timerWheel is the TimerWheel struct
+*/
+void Node_SetTimerWheel(Node self, TimerWheel timerWheel);
+
+/** Get the earliest local time at which a time tic can change the state of the node
+* @param node is the Node struct of the node that should perform this action
+* return local time (as returned by ProtocolClock_GetLocalTime) of the next tic that may do something; the current local time if the
+*   next tic has to be executed; NODE_NO_DEADLINE if only an incoming message or the end of an ongoing transmission can change the state
+*
+* Time tics before the deadline do not change the node (including its random number generator), so a simulation may skip them as long as
+* no message is delivered to the node in the meantime. The deadline is conservative, i.e. the tic at the deadline may still do nothing.
+*/
+int64_t Node_NextDeadline(Node node);
+
 #endif
@@ -0,0 +1,162 @@
+/* Copyright (c) 2022-23 California Institute of Technology (Caltech).
+ * U.S. Government sponsorship acknowledged.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Caltech nor its operating division,
+ *   the Jet Propulsion Laboratory, nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Open Source License Approved by Caltech/JPL
+ *
+ * APACHE LICENSE, VERSION 2.0
+ * - Text version: https://www.apache.org/licenses/LICENSE-2.0.txt
+ * - SPDX short identifier: Apache-2.0
+ * - OSI Approved License: https://opensource.org/licenses/Apache-2.0
+ */
+
+
+/** @file ParallelStepper.h
+*   @brief Runs the nodes of one large simulation on several threads, with the same result as Simulator_Step
+*
+*   The nodes are split into contiguous index ranges, one per thread. Within a tic, every thread runs the TIME_TIC of its 
+*   nodes; the messages they send stay in the transmit ring of the node (one writer, read by the main thread only after 
+*   all threads have met at the barrier at the end of the tic). The main thread then puts the messages on the channel in 
+*   the order of the node indices, exactly as the sequential loop does.
+*
+*   Nodes only interact through transmissions, but carrier sense (see Driver_IsReceiving) takes effect in the tic in which a 
+*   transmission starts, so the lookahead between nodes is zero and the windows are one tic long. A node that was run 
+*   before a transmission of a node with a lower index reached it in the same tic may have seen a different isReceiving
+*   flag than in the sequential loop; the state it had before the tic is restored and its TIME_TIC is run again in order. 
+*   Only nodes in range of a sender in the very tic it starts sending are run again, so the number of reruns grows with 
+*   the density of the topology: in sparse topologies most of the work runs in parallel, while in dense ones (e.g. a 
+*   large clique) reruns are common and most tics are run again.
+*
+*   The trace of a simulation is written in the order of the sequential loop; while a trace writer is set, the steps are 
+*   therefore run on the calling thread only.
+*/ 
+
+#ifndef PARALLEL_STEPPER_H
+#define PARALLEL_STEPPER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#include "Simulator.h"
+
+typedef struct ParallelStepperStruct * ParallelStepper;
+typedef struct ParallelWorkerStruct * ParallelWorker;
+typedef struct ParallelNodeBackupStruct * ParallelNodeBackup;
+
+/**
+* thread: the thread of the worker (not used for worker 0, which is the calling thread)
+* stepper: the stepper the worker belongs to
+* idx: index of the worker; its nodes are the idx-th of numWorkers contiguous ranges of node indices
+* sense: phase of the barrier this worker waits for
+*/
+typedef struct ParallelWorkerStruct {
+  pthread_t thread;
+  ParallelStepper stepper;
+  int16_t idx;
+  int sense;
+} ParallelWorkerStruct;
+
+/** State of a node before its TIME_TIC, everything a TIME_TIC can change (the Config is only read) */
+typedef struct ParallelNodeBackupStruct {
+  StateMachineStruct stateMachine;
+  SchedulerStruct scheduler;
+  TimeKeepingStruct timeKeeping;
+  NetworkManagerStruct networkManager;
+  SlotMapStruct slotMap;
+  NeighborhoodStruct neighborhood;
+  TimerWheelStruct timerWheel;
+  RangingManagerStruct rangingManager;
+  LCGStruct lcg;
+  ProtocolClockStruct clock;
+  DriverStruct driver;
+  uint8_t txRingHead;
+  uint8_t txRingCount;
+  uint32_t txRingNumDropped;
+} ParallelNodeBackupStruct;
+
+/**
+* sim: the simulation that is stepped
+* workers: all workers; worker 0 runs on the thread that calls ParallelStepper_Step
+* numWorkers: number of workers
+* backups: state of every node before its last TIME_TIC
+* rerun: whether the TIME_TIC of a node has to be run again in the current tic
+* nodesInRange: buffer for the indices of the nodes in range of a sender
+* barrierCount: number of workers that have not reached the barrier yet
+* barrierSense: phase of the barrier; flips when the last worker has reached it
+* stop: tells the workers to exit after the next barrier
+* numTics: number of tics that were run in parallel
+* numReruns: number of TIME_TICs that had to be run again
+*/
+typedef struct ParallelStepperStruct {
+  Simulator sim;
+  ParallelWorkerStruct *workers;
+  int16_t numWorkers;
+
+  ParallelNodeBackupStruct *backups;
+  bool *rerun;
+  int16_t *nodesInRange;
+
+  int barrierCount;
+  int barrierSense;
+  int stop;
+
+  uint64_t numTics;
+  uint64_t numReruns;
+} ParallelStepperStruct;
+
+/** Constructor; starts the worker threads
+* @param sim is the simulation that is stepped; nodes may still be added to it later
+* @param numThreads is the number of threads including the calling thread; 0 uses one thread per online CPU core
+*/
+ParallelStepper ParallelStepper_Create(Simulator sim, int16_t numThreads);
+
+/** Destructor; stops the worker threads (the simulation is not destroyed)
+* @param self is the ParallelStepper struct
+*/
+void ParallelStepper_Destroy(ParallelStepper self);
+
+/** Same as Simulator_Step, with the TIME_TICs of the nodes run on all threads
+* @param self is the ParallelStepper struct
+*/
+void ParallelStepper_Step(ParallelStepper self);
+
+/** Same as Simulator_Advance, with the TIME_TICs of the nodes run on all threads
+* @param self is the ParallelStepper struct
+* @param endTime is the simulation time beyond which no tics are skipped
+*/
+void ParallelStepper_Advance(ParallelStepper self, int64_t endTime);
+
+/** Same as Simulator_RunUntil, with the TIME_TICs of the nodes run on all threads
+* @param self is the ParallelStepper struct
+* @param endTime is the simulation time at which to stop (exclusive)
+*/
+void ParallelStepper_RunUntil(ParallelStepper self, int64_t endTime);
+
+#endif
@@ -79,6 +79,18 @@ RangingManager RangingManager_Create();
 */
 bool RangingManager_HasRangingTimedOut(Node node);
 
+/** Get the time at which the other node took too long to respond to the last ranging message
+* @param node is the Node struct of the node that should perform this action
+* return local time from which the ranging has timed out (even if the slot of the ranging has not ended yet)
+*/
+int64_t RangingManager_GetTimeOutTime(Node node);
+
+/** Determine if the slot in which the last ranging message was sent has ended
+* @param node is the Node struct of the node that should perform this action
+* return true if the current slot is not the slot in which the last ranging message was sent; false otherwise
+*/
+bool RangingManager_HasRangingSlotEnded(Node node);
+
 /** Save a ranging message as the last incoming ranging message
 * @param node is the Node struct of the node that should perform this action
 * @param msg is the message to be saved as lastIncomingRangingMsg 
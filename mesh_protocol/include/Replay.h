@@ -0,0 +1,176 @@
+/* Copyright (c) 2022-23 California Institute of Technology (Caltech).
+ * U.S. Government sponsorship acknowledged.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Caltech nor its operating division,
+ *   the Jet Propulsion Laboratory, nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Open Source License Approved by Caltech/JPL
+ *
+ * APACHE LICENSE, VERSION 2.0
+ * - Text version: https://www.apache.org/licenses/LICENSE-2.0.txt
+ * - SPDX short identifier: Apache-2.0
+ * - OSI Approved License: https://opensource.org/licenses/Apache-2.0
+ */
+
+
+/** @file Replay.h
+*   @brief Replays the recorded EVAL output of a node of the DWM1001-DEV implementation against the protocol core
+*
+*   The DWM1001-DEV firmware prints one line for every ping it sends or receives and every ranging result it sends or receives
+*   over UART if EVAL is set (see DWM1001_Constants.h):
+*     TX PING <own id> 0 <local time> <slot> <ping number>
+*     RX PING <sender id> 0 <timestamp> <slot> <ping number> [<ping content>]
+*     TX DIST <partner id> <distance> <local time> <slot> 0
+*     RX DIST <partner id> <distance> <timestamp> <slot> 0
+*   With EVAL_REPLAY also set, received pings include their content (network ID, network age, time since frame start, one-hop
+*   status and IDs, two-hop status and IDs of every slot) and received ranging messages are printed as well:
+*     RX POLL|RESP|FINAL <sender id> 0 <timestamp> <slot> 0
+*
+*   A replay runs a single node of a Simulator with the ID and the random seed of the recorded node (RANDOM_SEED of
+*   IndividualNodeConfig.h), delivers the recorded messages to it at the local time they were received (timestamp plus air time)
+*   and skips all time tics in between in which the node would not do anything. The pings and ranging results the node sends
+*   are then compared against the recorded ones.
+*
+*   Received pings without their content cannot be replayed; they are skipped and counted (see numIncomplete).
+*   Other lines of the output are ignored, so the UART output can be used as it is.
+*/ 
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Node.h"
+#include "Message.h"
+#include "Simulator.h"
+
+typedef struct ReplayStruct * Replay;
+typedef struct ReplayEventStruct * ReplayEvent;
+
+/** Recorded events; the TX events are what the node is expected to produce, the RX events are fed to it */
+typedef enum ReplayEventTypes {
+  REPLAY_TX_PING = 0,
+  REPLAY_TX_DIST = 1,
+  REPLAY_RX_PING = 2,
+  REPLAY_RX_DIST = 3,
+  REPLAY_RX_POLL = 4,
+  REPLAY_RX_RESPONSE = 5,
+  REPLAY_RX_FINAL = 6
+} ReplayEventTypes;
+
+/**
+* type: type of the event
+* peerId: ID of the other node (sender of a received message or ranging partner); the own ID for TX PING
+* localTime: local time at which a message was sent; timestamp (arrival of the preamble) of a received message
+* slotNum: slot in which the event happened as calculated by the node
+* complete: whether a received message can be replayed (received pings need their content)
+* msg: message that is delivered to the node for RX events; type and distance for TX events
+*/
+typedef struct ReplayEventStruct {
+  ReplayEventTypes type;
+  int8_t peerId;
+  int64_t localTime;
+  SlotNum slotNum;
+  bool complete;
+  MessageStruct msg;
+} ReplayEventStruct;
+
+/**
+* nodeId: ID of the recorded node
+* sim: simulation with the replayed node as its only node
+* txLog: everything the replayed node sent
+* events: all recorded events in the order of the recording
+* numEvents: number of events
+* eventCapacity: allocated size of events
+* nextEvent: index of the next event that has not been replayed yet
+* numIncomplete: number of received messages that could not be replayed
+*/
+typedef struct ReplayStruct {
+  int8_t nodeId;
+  Simulator sim;
+  SimulatorTxLogStruct txLog;
+
+  ReplayEventStruct *events;
+  int32_t numEvents;
+  int32_t eventCapacity;
+  int32_t nextEvent;
+  int32_t numIncomplete;
+} ReplayStruct;
+
+/** Constructor
+* @param nodeId is the ID of the recorded node (NODE_ID)
+* @param seed is the random seed of the recorded node (RANDOM_SEED)
+*/
+Replay Replay_Create(int8_t nodeId, uint32_t seed);
+
+/** Destructor
+* @param self is the Replay struct
+*/
+void Replay_Destroy(Replay self);
+
+/** Parse one line of the recorded output
+* @param line is the line
+* @param event is filled with the recorded event
+* return true if the line is a recorded event, false if it is some other output
+*/
+bool Replay_ParseLine(const char *line, ReplayEvent event);
+
+/** Parse one line of the recorded output and add it to the recording if it is an event
+* @param self is the Replay struct
+* @param line is the line
+* return true if the line is a recorded event
+*/
+bool Replay_AddLine(Replay self, const char *line);
+
+/** Add all events of a recorded output
+* @param self is the Replay struct
+* @param file is the recorded output
+* return number of events that were added
+*/
+int32_t Replay_AddFile(Replay self, FILE *file);
+
+/** Run the node until a local time, delivering all recorded messages that arrived before
+* @param self is the Replay struct
+* @param localTime is the local time up to which the node is run
+*/
+void Replay_RunUntil(Replay self, int64_t localTime);
+
+/** Compare the messages the node sent with the recorded ones
+*   The n-th ping (result) the node sent is compared with the n-th recorded TX PING (TX DIST).
+* @param self is the Replay struct
+* @param untilLocalTime only recorded and replayed messages sent before this time are compared
+* @param tolerance is the difference in time tics up to which two messages are considered to be sent at the same time
+* @param out is where differences are printed to; NULL to only count them
+* return number of differences
+*/
+int32_t Replay_Diff(Replay self, int64_t untilLocalTime, int64_t tolerance, FILE *out);
+
+#endif
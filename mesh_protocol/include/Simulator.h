@@ -0,0 +1,525 @@
+/* Copyright (c) 2022-23 California Institute of Technology (Caltech).
+ * U.S. Government sponsorship acknowledged.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Caltech nor its operating division,
+ *   the Jet Propulsion Laboratory, nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Open Source License Approved by Caltech/JPL
+ *
+ * APACHE LICENSE, VERSION 2.0
+ * - Text version: https://www.apache.org/licenses/LICENSE-2.0.txt
+ * - SPDX short identifier: Apache-2.0
+ * - OSI Approved License: https://opensource.org/licenses/Apache-2.0
+ */
+
+
+/** @file Simulator.h
+*   @brief Native discrete-event simulation of a network of nodes
+*
+*   Replaces the per-tic MATLAB loop around the MatlabWrapper: the simulator owns the nodes, their local times and 
+*   an event queue of ongoing transmissions and runs the state machines directly. Messages that the simulation Driver 
+*   writes to its transmit ring are put on the channel for their air time (see MessageSizes) and are delivered to all nodes 
+*   that are in range of the sender when the transmission ends. If two transmissions overlap at a receiver, the receiver
+*   gets a COLLISION message instead (same as functionId 6 of the MatlabWrapper).
+*
+*   All time values are in time tics. The simulation time is a global time; every node has its own local time that starts 
+*   counting at zero when the node is turned on and that may be skewed (see Simulator_SetClockSkew) or drift (see 
+*   Simulator_SetClockDrift).
+*
+*   The whole state of a simulation (all nodes, their local times and the transmissions on the channel) can be copied
+*   with Simulator_Fork or written to a checkpoint file, so that a network that has converged once can be continued with
+*   different parameters without simulating the warm-up again.
+*/ 
+
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "Node.h"
+#include "StateMachine.h"
+#include "Scheduler.h"
+#include "ProtocolClock.h"
+#include "TimeKeeping.h"
+#include "NetworkManager.h"
+#include "MessageHandler.h"
+#include "SlotMap.h"
+#include "Neighborhood.h"
+#include "RangingManager.h"
+#include "LCG.h"
+#include "Config.h"
+#include "Driver.h"
+#include "Message.h"
+#include "Snapshot.h"
+#include "SpatialGrid.h"
+#include "Channel.h"
+#include "Trace.h"
+#include "Mobility.h"
+#include "ClockDrift.h"
+#include "TimerWheel.h"
+
+#define SIMULATOR_CHECKPOINT_MAGIC "MCKP"
+#define SIMULATOR_CHECKPOINT_VERSION 4
+
+typedef struct SimulatorStruct * Simulator;
+typedef struct TransmissionStruct * Transmission;
+typedef struct SimulatorTxRecordStruct * SimulatorTxRecord;
+typedef struct SimulatorTxLogStruct * SimulatorTxLog;
+
+/**
+* id: unique ID of the transmission (see Channel.h)
+* msg: copy of the message that was sent; acquired from the message pool of the simulator, with one reference for the transmission
+*   and one for every receiver that has not got the message yet
+* senderIdx: index of the sending node in the simulator
+* startTime: simulation time at which the transmission started (arrival of the preamble, neglecting ToF)
+* endTime: simulation time at which the transmission is complete and the message is delivered
+* receivers: indices of all nodes that were in range and listening when the transmission started
+* numReceivers: number of elements in receivers
+*/
+typedef struct TransmissionStruct {
+  uint64_t id;
+  Message msg;
+  int16_t senderIdx;
+  int64_t startTime;
+  int64_t endTime;
+  int16_t *receivers;
+  int16_t numReceivers;
+} TransmissionStruct;
+
+/**
+* time: simulation time at which the event is due
+* seq: sequence number to order events that are due at the same time (first in, first out)
+* tx: transmission that ends at this time
+*/
+typedef struct SimEventStruct {
+  int64_t time;
+  uint64_t seq;
+  Transmission tx;
+} SimEventStruct;
+
+/**
+* numTransmissions: number of messages put on the channel, per MessageTypes
+* numDelivered: number of messages delivered to a receiver without collision
+* numCollisions: number of COLLISION messages delivered to receivers
+* numCaptures: number of messages delivered although they were overlapped by a weaker transmission (see Simulator_SetCapture)
+* numLost: number of receptions that were aborted because the receiver started to transmit itself
+*/
+typedef struct SimulatorStatsStruct {
+  uint64_t numTransmissions[RESULT + 1];
+  uint64_t numDelivered;
+  uint64_t numCollisions;
+  uint64_t numCaptures;
+  uint64_t numLost;
+} SimulatorStatsStruct;
+
+/**
+* time: simulation time at which the transmission started
+* senderIdx: index of the sending node in the simulator
+* type: type of the message
+* recipientId: recipient of the message (only for POLL, RESPONSE, FINAL and RESULT)
+* networkId: network ID in the message
+* distance: distance in the message (only for RESULT)
+*/
+typedef struct SimulatorTxRecordStruct {
+  int64_t time;
+  int16_t senderIdx;
+  MessageTypes type;
+  int8_t recipientId;
+  uint8_t networkId;
+  double distance;
+} SimulatorTxRecordStruct;
+
+/**
+* elements: all transmissions since the log was set, in the order they started
+* num: number of elements
+* capacity: allocated size of elements
+*/
+typedef struct SimulatorTxLogStruct {
+  SimulatorTxRecordStruct *elements;
+  int32_t num;
+  int32_t capacity;
+} SimulatorTxLogStruct;
+
+/**
+* magic: SIMULATOR_CHECKPOINT_MAGIC (without terminating zero)
+* version: SIMULATOR_CHECKPOINT_VERSION
+* nodeStateSize: size of the state of one node in bytes; checkpoints of builds with other constants (e.g. NUM_SLOTS) are rejected
+* messageSize: size of a MessageStruct in bytes
+*/
+typedef struct SimulatorCheckpointHeaderStruct {
+  char magic[4];
+  uint16_t version;
+  uint32_t nodeStateSize;
+  uint32_t messageSize;
+} SimulatorCheckpointHeaderStruct;
+
+/**
+* capacity: maximum number of nodes in the simulation
+* numNodes: number of nodes in the simulation
+* time: current simulation time
+* nodes: array of all node structs in the simulation
+* txRings: transmit rings the drivers write sent messages to; one per node
+* messagePool: pool for the messages on the channel and the messages delivered to the nodes
+* txFinished: array of txFinished flags for every node
+* isReceiving: array of isReceiving flags for every node; set by the simulator
+* localTimes: array that holds the local time of every node
+* clockSkew: add an additional (positive value) or skip (negative value) a tic every |clockSkew| tics; 0 means no skew
+* lastSkewTime: last local time an additional tic was added or skipped because of the clock skew
+* drifts: drift model of the clock of every node (only used if clockSkew is 0)
+* driftIncrement: deviation of the clock of every node per tic, in units of 2^-CLOCK_DRIFT_FRACTION_BITS tics
+* driftFraction: fraction of a tic every clock has gained (in the same unit); always in [0, 2^CLOCK_DRIFT_FRACTION_BITS)
+* nextDriftUpdate: earliest simulation time at which the rate of a drifting clock changes
+* turnOnTimes: simulation time at which a node is turned on
+* isOn: whether a node was already turned on
+* posX, posY: position of every node
+* radioRange: maximum distance between two nodes that can receive each other's messages
+* grid: spatial index over the positions of the nodes with cells as big as radioRange
+* nodesInRange: buffer for the indices of the nodes in range of a sender
+* channel: keeps track of the transmissions that currently reach every node and decides what a node receives
+* nextTxId: ID for the next transmission
+* rxTimestamp: local time of the receiving node when the preamble of the current reception arrived
+* events: binary min-heap of pending events, ordered by time and seq
+* numEvents: number of events in the heap
+* eventCapacity: allocated size of the heap
+* nextEventSeq: sequence number for the next event
+* seedState: state used to derive the initial random seed of every node from the simulation seed
+* stats: counters of what happened on the channel
+* idleSkipping: whether Simulator_RunUntil skips time tics in which no node would do anything (see Simulator_SetIdleSkipping)
+* trace: writer all nodes write their trace records to; NULL if the simulation is not traced
+* txLog: list every transmission is appended to; NULL if transmissions are not logged
+* mobility: gives the positions of the moving nodes; NULL if all nodes are static
+* positionsTime: simulation time the positions of the moving nodes were last updated for; -1 if never
+*/
+typedef struct SimulatorStruct {
+  int16_t capacity;
+  int16_t numNodes;
+  int64_t time;
+
+  Node *nodes;
+  DriverTxRingStruct *txRings;
+  MessagePool messagePool;
+  bool *txFinished;
+  bool *isReceiving;
+  int64_t *localTimes;
+  int *clockSkew;
+  int64_t *lastSkewTime;
+  ClockDriftStruct *drifts;
+  int64_t *driftIncrement;
+  int64_t *driftFraction;
+  int64_t nextDriftUpdate;
+  int64_t *turnOnTimes;
+  bool *isOn;
+
+  double *posX;
+  double *posY;
+  double radioRange;
+  SpatialGrid grid;
+  int16_t *nodesInRange;
+
+  Channel channel;
+  uint64_t nextTxId;
+  int64_t *rxTimestamp;
+
+  SimEventStruct *events;
+  int32_t numEvents;
+  int32_t eventCapacity;
+  uint64_t nextEventSeq;
+
+  uint32_t seedState;
+  SimulatorStatsStruct stats;
+
+  bool idleSkipping;
+  TraceWriter trace;
+  SimulatorTxLog txLog;
+
+  Mobility mobility;
+  int64_t positionsTime;
+} SimulatorStruct;
+
+/** Constructor
+* @param capacity is the maximum number of nodes that can be added to the simulation
+* @param seed is the seed from which the initial random seeds of all nodes are derived
+*/
+Simulator Simulator_Create(int16_t capacity, uint32_t seed);
+
+/** Destructor; also destroys all nodes of the simulation
+* @param self is the Simulator struct
+*/
+void Simulator_Destroy(Simulator self);
+
+/** Create a new node and add it to the simulation
+* @param self is the Simulator struct
+* @param id is the ID of the new node (must be unique and not 0)
+* @param x is the x position of the new node
+* @param y is the y position of the new node
+* @param turnOnTime is the simulation time at which the node is turned on
+* return index of the node in the simulation or -1 if the simulation is full
+*/
+int16_t Simulator_AddNode(Simulator self, int8_t id, double x, double y, int64_t turnOnTime);
+
+/** Move a node to a new position; takes effect for transmissions that start afterwards
+* @param self is the Simulator struct
+* @param nodeIdx is the index of the node
+* @param x is the new x position of the node
+* @param y is the new y position of the node
+*/
+void Simulator_MoveNode(Simulator self, int16_t nodeIdx, double x, double y);
+
+/** Let nodes move according to their mobility model (see Mobility.h)
+*   The positions of the moving nodes are updated whenever they are needed, i.e. when a transmission starts or a ranging
+*   result is delivered. The Mobility struct is not destroyed by the simulator and is not copied by Simulator_Fork.
+* @param self is the Simulator struct
+* @param mobility is the Mobility struct (with the same node indices as the simulator); NULL to stop moving the nodes
+*/
+void Simulator_SetMobility(Simulator self, Mobility mobility);
+
+/** Move all moving nodes to their positions at the current simulation time
+* @param self is the Simulator struct
+*/
+void Simulator_UpdatePositions(Simulator self);
+
+/** Set the maximum distance at which nodes can receive each other's messages
+* @param self is the Simulator struct
+* @param range is the radio range (same unit as the positions)
+*/
+void Simulator_SetRadioRange(Simulator self, double range);
+
+/** Set the clock skew of a node
+* @param self is the Simulator struct
+* @param nodeIdx is the index of the node
+* @param skew adds an additional tic (if positive) or skips a tic (if negative) every |skew| tics; 0 disables the skew
+*/
+void Simulator_SetClockSkew(Simulator self, int16_t nodeIdx, int skew);
+
+/** Let the clock of a node drift (see ClockDrift.h); replaces the clock skew of the node
+*   The local time advances by 1 + ratePpm / 1e6 tics per tic; the fraction of a tic is carried over, so the local time 
+*   still advances in whole tics (by 0, 1 or 2 per tic).
+* @param self is the Simulator struct
+* @param nodeIdx is the index of the node
+* @param offsetPpm is the constant deviation of the rate (positive values make the clock run fast)
+* @param randomWalkPpm is the standard deviation of the random walk of the rate per update
+* @param variationPpm is the amplitude of a slow, temperature-like sinusoidal variation of the rate
+* @param variationPeriod is the period of the variation in time tics
+* @param updateInterval is the number of time tics between two updates of the rate; 0 keeps the rate at offsetPpm
+*/
+void Simulator_SetClockDrift(Simulator self, int16_t nodeIdx, double offsetPpm, double randomWalkPpm, double variationPpm, 
+  int64_t variationPeriod, int64_t updateInterval);
+
+/** Read the clock drift of nodes from a text file
+*   Every line holds "nodeIdx offsetPpm [randomWalkPpm variationPpm variationPeriod updateInterval]", separated by spaces or
+*   commas (missing values are 0); lines starting with # are ignored. See Simulator_SetClockDrift.
+* @param self is the Simulator struct
+* @param file is the file to read
+* return number of nodes that were configured, or -1 if a line could not be parsed
+*/
+int32_t Simulator_ReadClockDrifts(Simulator self, FILE *file);
+
+/** Get the true offset of the local clock of a node, i.e. the local time minus the time since the node was turned on
+* @param self is the Simulator struct
+* @param nodeIdx is the index of the node
+* return offset in time tics (including the fraction of a tic of drifting clocks); 0 if the node is off
+*/
+double Simulator_GetClockOffset(Simulator self, int16_t nodeIdx);
+
+/** Enable or disable skipping of idle time tics
+* @param self is the Simulator struct
+* @param enabled is true if Simulator_RunUntil should skip idle tics
+*
+* When enabled, Simulator_RunUntil advances the local times of all nodes directly to the earliest deadline of any node
+* (see Node_NextDeadline), the next end of a transmission or the next time a node is turned on. The skipped tics would not have 
+* changed any node, so the result of the simulation is the same as without skipping.
+*/
+void Simulator_SetIdleSkipping(Simulator self, bool enabled);
+
+/** Enable or disable the capture effect; disabled by default, i.e. overlapping transmissions always collide
+*   With capture enabled, a node still receives the transmission it locked onto (the first one of a busy period) if its 
+*   received power is at least thresholdDb above the strongest transmission that overlapped it. The received power
+*   falls off with the distance to the sender (log-distance path loss).
+* @param self is the Simulator struct
+* @param enabled is whether capture is enabled
+* @param thresholdDb is the minimum difference in received power in dB
+* @param pathLossExponent is the path loss exponent (2 for free space)
+*/
+void Simulator_SetCapture(Simulator self, bool enabled, double thresholdDb, double pathLossExponent);
+
+/** Let all nodes (including the ones that are added later) write their trace records to a TraceWriter
+*   Records are only written if tracing is compiled in (see Trace.h). The writer is not destroyed by the simulator.
+* @param self is the Simulator struct
+* @param trace is the TraceWriter struct; NULL to stop tracing
+*/
+void Simulator_SetTrace(Simulator self, TraceWriter trace);
+
+/** Append every transmission that starts from now on to a list
+* @param self is the Simulator struct
+* @param txLog is the list (the elements are reallocated when needed, so it can start empty); NULL to stop logging
+*/
+void Simulator_SetTxLog(Simulator self, SimulatorTxLog txLog);
+
+/** Check if two nodes can receive each other's messages
+* @param self is the Simulator struct
+* @param idxA is the index of the first node
+* @param idxB is the index of the second node
+* return true if the nodes are in range of each other
+*/
+bool Simulator_NodesInRange(Simulator self, int16_t idxA, int16_t idxB);
+
+/** Get the distance between two nodes
+* @param self is the Simulator struct
+* @param idxA is the index of the first node
+* @param idxB is the index of the second node
+* return the euclidean distance between the nodes
+*/
+double Simulator_GetDistance(Simulator self, int16_t idxA, int16_t idxB);
+
+/** Get the index of a node by its ID
+* @param self is the Simulator struct
+* @param id is the ID of the node
+* return index of the node or -1 if there is no node with that ID
+*/
+int16_t Simulator_FindNode(Simulator self, int8_t id);
+
+/** Get the true current distance between a node and one of its neighbors (ground truth for oneHopNeighborsLastDistance)
+* @param self is the Simulator struct
+* @param nodeIdx is the index of the node
+* @param neighborId is the ID of the neighbor
+* @param distance is set to the distance at the current simulation time
+* return false if there is no node with the ID neighborId
+*/
+bool Simulator_GetTrueDistance(Simulator self, int16_t nodeIdx, int8_t neighborId, double *distance);
+
+/** Advance the simulation by one time tic
+* @param self is the Simulator struct
+*
+* Turns on nodes that are due, delivers all transmissions that end now, runs a TIME_TIC on every node that is on
+* and increments the local times
+*/
+void Simulator_Step(Simulator self);
+
+/** First part of Simulator_Step: turn on the nodes that are due and deliver all transmissions that end now
+*   Simulator_BeginTic, a TIME_TIC on every node that is on (each followed by Simulator_TransmitSentMessages) and 
+*   Simulator_EndTic together are the same as Simulator_Step; they are only needed by other engines (see ParallelStepper.h)
+* @param self is the Simulator struct
+*/
+void Simulator_BeginTic(Simulator self);
+
+/** Last part of Simulator_Step: increment the local times of all nodes that are on and the simulation time
+* @param self is the Simulator struct
+*/
+void Simulator_EndTic(Simulator self);
+
+/** Put all messages a node has written to its transmit ring on the channel
+* @param self is the Simulator struct
+* @param senderIdx is the index of the node
+*/
+void Simulator_TransmitSentMessages(Simulator self, int16_t senderIdx);
+
+/** Skip the following tics in which no node would do anything (see Simulator_SetIdleSkipping)
+* @param self is the Simulator struct
+* @param endTime is the simulation time beyond which no tics are skipped
+*/
+void Simulator_SkipIdleTics(Simulator self, int64_t endTime);
+
+/** Run the simulation until a certain simulation time is reached
+* @param self is the Simulator struct
+* @param endTime is the simulation time at which to stop (exclusive)
+*
+* If idle skipping is enabled, only the tics at which something can happen are executed
+*/
+void Simulator_RunUntil(Simulator self, int64_t endTime);
+
+/** Execute the next time tic and skip the following idle tics (if idle skipping is enabled)
+* @param self is the Simulator struct
+* @param endTime is the simulation time beyond which no tics are skipped
+*
+* The nodes only change in the executed tic, so callers that check the state of the nodes after every call see every change
+*/
+void Simulator_Advance(Simulator self, int64_t endTime);
+
+/** Get the current simulation time
+* @param self is the Simulator struct
+* return the simulation time
+*/
+int64_t Simulator_GetTime(Simulator self);
+
+/** Deliver a message to a node that did not come from another node of the simulation (e.g. a recorded message)
+*   The message is delivered right away, i.e. before the time tics of the current simulation time are run, and the node
+*   may answer it. The message is not counted in the stats.
+* @param self is the Simulator struct
+* @param nodeIdx is the index of the receiving node
+* @param msg is the message; not modified by the simulator
+*/
+void Simulator_DeliverMessage(Simulator self, int16_t nodeIdx, Message msg);
+
+/** Get a node of the simulation
+* @param self is the Simulator struct
+* @param nodeIdx is the index of the node
+* return the Node struct or NULL if there is no node with that index
+*/
+Node Simulator_GetNode(Simulator self, int16_t nodeIdx);
+
+/** Copy the state of all nodes into a snapshot (row i holds node index i)
+* @param self is the Simulator struct
+* @param snapshot is the Snapshot struct; its arrays must have at least as many rows as nodes in the simulation
+*/
+void Simulator_Snapshot(Simulator self, Snapshot snapshot);
+
+/** Copy a simulation; the copy continues exactly like the original would, but shares no memory with it
+*   The nodes of the copy can be changed (e.g. their Config) to branch one warmed-up network into several variants.
+*   The trace writer and transmission log are not copied; the copy starts without them.
+* @param self is the Simulator struct
+* return the new Simulator struct; must be destroyed with Simulator_Destroy
+*/
+Simulator Simulator_Fork(Simulator self);
+
+/** Write the state of a simulation to a checkpoint file
+*   The file holds the same state that Simulator_Fork copies, in the byte order and struct layout of the machine that
+*   wrote it; it can only be loaded by a build with the same constants.
+* @param self is the Simulator struct
+* @param file is the file the checkpoint is written to (opened in binary mode)
+* return true if the checkpoint was written completely
+*/
+bool Simulator_SaveCheckpoint(Simulator self, FILE *file);
+
+/** Create a simulation from a checkpoint file
+* @param file is the file the checkpoint is read from (opened in binary mode)
+* return the new Simulator struct, or NULL if the file is not a valid checkpoint (other header, ends early, or a node 
+* index, message type or reception out of range)
+*/
+Simulator Simulator_LoadCheckpoint(FILE *file);
+
+/** Get the air time of a message
+* @param type is the type of the message
+* return the time it takes to transmit a message of this type in time tics (see MessageSizes)
+*/
+int64_t Simulator_GetAirTime(MessageTypes type);
+
+#endif
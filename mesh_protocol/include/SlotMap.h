@@ -59,18 +59,56 @@
 #include "Util.h"
 #include "Config.h"
 #include "RandomNumbers.h"
+#include "Trace.h"
+#include "SlotStatus.h"
+#include "TimerWheel.h"
 
 #ifdef SIMULATION
 #include "mex.h"
 #endif
 
-enum SlotOccupancy {
-  FREE, OCCUPIED, COLLIDING
-};
-
 typedef struct SlotMapStruct * SlotMap;
 
-typedef enum SlotOccupancy SlotOccupancy;
+
+/** Number of 64 bit words of a SlotMask; chosen at compile time, so that there is one bit for every slot */
+#define SLOT_MASK_WORDS ((NUM_SLOTS + 63) / 64)
+
+/** Bit set with one bit per slot; bit i of word w stands for slot number 64 * w + i + 1 */
+typedef struct SlotMask {
+  uint64_t words[SLOT_MASK_WORDS];
+} SlotMask;
+
+/** Bit sets of one slot map; they are kept in sync with the status and ID arrays of the slot map by the SlotMap functions 
+* (call SlotMap_RebuildMasks after changing the arrays directly)
+*
+* free: slots that are FREE
+* occupied: slots that are OCCUPIED
+* colliding: slots that are COLLIDING
+* occupiedByThisNode: slots that are OCCUPIED by this node (subset of occupied)
+*/
+typedef struct SlotMasksStruct {
+  SlotMask free;
+  SlotMask occupied;
+  SlotMask colliding;
+  SlotMask occupiedByThisNode;
+} SlotMasksStruct;
+
+/** Bit sets combined from all three slot maps and the own and pending slots; they are updated by the SlotMap functions
+* that change a slot, so that the guard conditions and the scheduler only have to look them up
+*
+* occupiedByOtherNodes: slots that are OCCUPIED by another node in any slot map
+* freeForThisNode: slots that are FREE or OCCUPIED by this node in all three slot maps
+* colliding: slots that are COLLIDING in any slot map and not occupied by another node
+* reservable: slots this node can reserve (freeForThisNode or colliding)
+* clearToSend: slots this node can send in (reservable, own or pending)
+*/
+typedef struct CombinedSlotMasksStruct {
+  SlotMask occupiedByOtherNodes;
+  SlotMask freeForThisNode;
+  SlotMask colliding;
+  SlotMask reservable;
+  SlotMask clearToSend;
+} CombinedSlotMasksStruct;
 
 /** 
 * ONE HOP SLOT MAP
@@ -78,10 +116,11 @@ typedef enum SlotOccupancy SlotOccupancy;
 * The one hop slot map of this node is included in its pings, so other nodes can update their two hop slot maps based on it (to make sure they do not reserve
 * slots that are already reserved anywhere in their two hop neighborhood, as these can lead to collisions of pings and ranging messages)
 *
-* oneHopSlotsStatus: status of the slots as directly perceived by this node (FREE: no one hop neighbor uses the slot;
+* oneHopSlotsStatus: status of the slots as directly perceived by this node, packed into 2 bits per slot (FREE: no one hop neighbor uses the slot;
 *   OCCUPIED: one neighbor has reserved the slot; COLLIDING: a collision was received in this slot, so more than one neighbor wanted to use it)
 * oneHopSlotsIds: IDs of the node that uses the corresponding slot; 0 if slot is FREE or COLLIDING
 * oneHopSlotsLastUpdated: last time a ping was received in an OCCUPIED slot or a collision was perceived in a COLLIDING slot
+* oneHopSlotsMasks: the status of the slots as bit sets, so that the slot maps can be combined with a few bit operations
 *
 * TWO HOP SLOT MAP
 * Two hop means nodes that are neighbors of one hop neighbors, but not the neighbors themselves; this includes this node, as it is a neighbor of its neighbors;
@@ -92,6 +131,7 @@ typedef enum SlotOccupancy SlotOccupancy;
 * twoHopSlotsStatus: same as oneHopSlotsStatus, only for two hop neighbors
 * twoHopSlotsIds: same as oneHopSlotsIds, only for two hop neighbors
 * twoHopSlotsLastUpdated: same as oneHopSlotsLastUpdated, only for two hop neighbors
+* twoHopSlotsMasks: same as oneHopSlotsMasks, only for two hop neighbors
 *
 * THREE HOP SLOT MAP
 * Three hop means nodes that are neighbors of two hop neighbors of this node
@@ -101,6 +141,7 @@ typedef enum SlotOccupancy SlotOccupancy;
 * threeHopSlotsStatus: same as oneHopSlotsStatus, only for three hop neighbors
 * threeHopSlotsIds: same as oneHopSlotsIds, only for three hop neighbors
 * threeHopSlotsLastUpdated: same as oneHopSlotsLastUpdated, only for three hop neighbors
+* threeHopSlotsMasks: same as oneHopSlotsMasks, only for three hop neighbors
 *
 * pendingSlots: array of slots that this node reserved but that were not acknowledged yet; 
 * numPendingSlots: number of pending slots of this node
@@ -110,45 +151,69 @@ typedef enum SlotOccupancy SlotOccupancy;
 * pendingSlotAcknowledgedBy: contains neighbors that have acknowledged the corresponding slot
 * ownSlots: array of slots this node reserved that were acknowledged 
 * numOwnSlots: number of own slots of this node
+* pendingSlotsMask, ownSlotsMask: pending and own slots as bit sets
+* combinedMasks: the slot maps and the own and pending slots combined into the bit sets that are queried on every tic
 * collisionTimes: local times when this node received collisions; deleted regularly if older than one frame; 
 * used to signal collisions to other nodes when this node is not in a network and therefore does not know slot numbers of colliding slots
 * numCollisionsRecorded: number of collisions in collisionTimes 
 * lastReservationTime: local time of the last time another node tried to reserve a slot (used for duty cycling)
 */
 typedef struct SlotMapStruct {
-  int oneHopSlotsStatus[NUM_SLOTS];
+  SlotStatusArray oneHopSlotsStatus;
   int8_t oneHopSlotsIds[NUM_SLOTS];
   int64_t oneHopSlotsLastUpdated[NUM_SLOTS];
+  SlotMasksStruct oneHopSlotsMasks;
 
-  int twoHopSlotsStatus[NUM_SLOTS];
+  SlotStatusArray twoHopSlotsStatus;
   int8_t twoHopSlotsIds[NUM_SLOTS];
   int64_t twoHopSlotsLastUpdated[NUM_SLOTS];
+  SlotMasksStruct twoHopSlotsMasks;
 
-  int threeHopSlotsStatus[NUM_SLOTS];
+  SlotStatusArray threeHopSlotsStatus;
   int8_t threeHopSlotsIds[NUM_SLOTS];
   int64_t threeHopSlotsLastUpdated[NUM_SLOTS];
+  SlotMasksStruct threeHopSlotsMasks;
 
-  int8_t pendingSlots[MAX_NUM_PENDING_SLOTS];
+  SlotNum pendingSlots[MAX_NUM_PENDING_SLOTS];
   int8_t numPendingSlots;
   int8_t pendingSlotsNeighbors[MAX_NUM_PENDING_SLOTS][MAX_NUM_NODES - 1]; // for every pending slot: IDs of neighbors at the time the slot was added (neighbors that need to acknowledge)
   int64_t localTimePendingSlotAdded[MAX_NUM_PENDING_SLOTS];
   int8_t pendingSlotAcknowledgedBy[MAX_NUM_PENDING_SLOTS][MAX_NUM_NODES - 1];
 
-  int8_t ownSlots[MAX_NUM_OWN_SLOTS];
+  SlotNum ownSlots[MAX_NUM_OWN_SLOTS];
   int8_t numOwnSlots;
 
+  SlotMask pendingSlotsMask;
+  SlotMask ownSlotsMask;
+  CombinedSlotMasksStruct combinedMasks;
+
   int64_t lastReservationTime;
 } SlotMapStruct;
 
 /** Constructor */
 SlotMap SlotMap_Create();
 
+/** Recompute the bit sets of all slot maps and of the own and pending slots from the arrays and schedule their timers again
+* @param node is the Node struct of the node that should perform this action
+*
+* Only needed if the arrays of the slot map were changed without the SlotMap functions (e.g. in tests and benchmarks)
+*/
+void SlotMap_RebuildMasks(Node node);
+
+/** Check the combined bit sets against the bit sets of the three slot maps and the own and pending slots
+* @param node is the Node struct of the node that should perform this action
+* return true if every combined bit set equals the one computed from scratch; false otherwise
+*
+* Builds with SLOT_MAP_CHECK defined (debug builds and the tests) run this check on every query of the combined bit sets
+*/
+bool SlotMap_CombinedMasksAreConsistent(Node node);
+
 /** Update the one hop slot map of this node based on information in a ping of another node
 * @param node is the Node struct of the node that should perform this action
 * @param msg is a ping message from another node
 * @param currentSlot is the current slot at the time this message was received  
 */
-void SlotMap_UpdateOneHopSlotMap(Node node, Message msg, int8_t currentSlot);
+void SlotMap_UpdateOneHopSlotMap(Node node, Message msg, SlotNum currentSlot);
 
 /** Update the two hop slot map of this node based on information in a ping of another node
 * @param node is the Node struct of the node that should perform this action
@@ -168,7 +233,13 @@ void SlotMap_UpdateThreeHopSlotMap(Node node, Message msg);
 * @param size is the size of the buffer (to avoid illegal memory access)
 * return true if buffer contains the status; false if it failed
 */
-bool SlotMap_GetOneHopSlotMapStatus(Node node, int *buffer, int8_t size);
+bool SlotMap_GetOneHopSlotMapStatus(Node node, int *buffer, int16_t size);
+
+/** Get the one hop status of all slots packed into 2 bits per slot, as it is sent in pings
+* @param node is the Node struct of the node that should perform this action
+* @param buffer is a pointer to the packed array where the status should be stored
+*/
+void SlotMap_GetOneHopSlotMapPackedStatus(Node node, SlotStatusArray *buffer);
 
 /** Get the one hop IDs of all slots
 * @param node is the Node struct of the node that should perform this action
@@ -176,7 +247,7 @@ bool SlotMap_GetOneHopSlotMapStatus(Node node, int *buffer, int8_t size);
 * @param size is the size of the buffer (to avoid illegal memory access)
 * return true if buffer contains the Ids; false if it failed
 */
-bool SlotMap_GetOneHopSlotMapIds(Node node, int8_t *buffer, int8_t size);
+bool SlotMap_GetOneHopSlotMapIds(Node node, int8_t *buffer, int16_t size);
 
 /** Get the one hop last updated time of all slots
 * @param node is the Node struct of the node that should perform this action
@@ -184,7 +255,7 @@ bool SlotMap_GetOneHopSlotMapIds(Node node, int8_t *buffer, int8_t size);
 * @param size is the size of the buffer (to avoid illegal memory access)
 * return true if buffer contains the times; false if it failed
 */
-bool SlotMap_GetOneHopSlotMapLastUpdated(Node node, int64_t *buffer, int8_t size);
+bool SlotMap_GetOneHopSlotMapLastUpdated(Node node, int64_t *buffer, int16_t size);
 
 /** Get the two hop status of all slots
 * @param node is the Node struct of the node that should perform this action
@@ -192,7 +263,13 @@ bool SlotMap_GetOneHopSlotMapLastUpdated(Node node, int64_t *buffer, int8_t size
 * @param size is the size of the buffer (to avoid illegal memory access)
 * return true if buffer contains the status; false if it failed
 */
-bool SlotMap_GetTwoHopSlotMapStatus(Node node, int *buffer, int8_t size);
+bool SlotMap_GetTwoHopSlotMapStatus(Node node, int *buffer, int16_t size);
+
+/** Get the two hop status of all slots packed into 2 bits per slot, as it is sent in pings
+* @param node is the Node struct of the node that should perform this action
+* @param buffer is a pointer to the packed array where the status should be stored
+*/
+void SlotMap_GetTwoHopSlotMapPackedStatus(Node node, SlotStatusArray *buffer);
 
 /** Get the two hop IDs of all slots
 * @param node is the Node struct of the node that should perform this action
@@ -200,7 +277,7 @@ bool SlotMap_GetTwoHopSlotMapStatus(Node node, int *buffer, int8_t size);
 * @param size is the size of the buffer (to avoid illegal memory access)
 * return true if buffer contains the IDs; false if it failed
 */
-bool SlotMap_GetTwoHopSlotMapIds(Node node, int8_t *buffer, int8_t size);
+bool SlotMap_GetTwoHopSlotMapIds(Node node, int8_t *buffer, int16_t size);
 
 /** Get the three hop status of all slots
 * @param node is the Node struct of the node that should perform this action
@@ -208,7 +285,7 @@ bool SlotMap_GetTwoHopSlotMapIds(Node node, int8_t *buffer, int8_t size);
 * @param size is the size of the buffer (to avoid illegal memory access)
 * return true if buffer contains the status; false if it failed
 */
-bool SlotMap_GetThreeHopSlotMapStatus(Node node, int *buffer, int8_t size);
+bool SlotMap_GetThreeHopSlotMapStatus(Node node, int *buffer, int16_t size);
 
 /** Get the three hop IDs of all slots
 * @param node is the Node struct of the node that should perform this action
@@ -216,7 +293,7 @@ bool SlotMap_GetThreeHopSlotMapStatus(Node node, int *buffer, int8_t size);
 * @param size is the size of the buffer (to avoid illegal memory access)
 * return true if buffer contains the IDs; false if it failed
 */
-bool SlotMap_GetThreeHopSlotMapIds(Node node, int8_t *buffer, int8_t size);
+bool SlotMap_GetThreeHopSlotMapIds(Node node, int8_t *buffer, int16_t size);
 
 /** Checks if own slots are reported as colliding or occupied by a different node in a ping message of another node
 * @param node is the Node struct of the node that should perform this action
@@ -225,7 +302,7 @@ bool SlotMap_GetThreeHopSlotMapIds(Node node, int8_t *buffer, int8_t size);
 * @param size is the size of the buffer (to avoid illegal memory access)
 * return number of colliding own slots
 */
-int8_t SlotMap_CheckOwnSlotsForCollisions(Node node, Message msg, int8_t *buffer, int8_t size);
+int8_t SlotMap_CheckOwnSlotsForCollisions(Node node, Message msg, SlotNum *buffer, int16_t size);
 
 /** Checks if pending slots are reported as colliding or occupied by a different node in a ping message of another node
 * @param node is the Node struct of the node that should perform this action
@@ -234,7 +311,7 @@ int8_t SlotMap_CheckOwnSlotsForCollisions(Node node, Message msg, int8_t *buffer
 * @param size is the size of the buffer (to avoid illegal memory access)
 * return number of colliding pending slots
 */
-int8_t SlotMap_CheckPendingSlotsForCollisions(Node node, Message msg, int8_t *buffer, int8_t size);
+int8_t SlotMap_CheckPendingSlotsForCollisions(Node node, Message msg, SlotNum *buffer, int16_t size);
 
 /** Check if this node has reserved enough slots
 * @param node is the Node struct of the node that should perform this action
@@ -248,14 +325,14 @@ bool SlotMap_SlotReservationGoalMet(Node node);
 *
 * If there are more than one reservable slots, one of them is chosen randomly
 */
-int8_t SlotMap_GetReservableSlot(Node node);
+SlotNum SlotMap_GetReservableSlot(Node node);
 
 /** Calculate the slot number of either the next own or pending slot, whichever comes first
 * @param node is the Node struct of the node that should perform this action
 * @param currentSlot is the slot number of the current slot
 * return slot number of the next own or pending slot or -1 if there are no own and pending slots
 */
-int8_t SlotMap_CalculateNextOwnOrPendingSlotNum(Node node, int8_t currentSlot);
+SlotNum SlotMap_CalculateNextOwnOrPendingSlotNum(Node node, SlotNum currentSlot);
 
 /** Update pending slots based on a ping message from another node
 * @param node is the Node struct of the node that should perform this action
@@ -273,14 +350,14 @@ void SlotMap_UpdatePendingSlotAcks(Node node, Message msg);
 * @param arraySize is the size of the array (to avoid illegal memory access)
 * returns true if the slot was added or false if it could not be added (maximum number of pending slots reached)
 */
-bool SlotMap_AddPendingSlot(Node node, int8_t slotNum, int8_t *neighborsArray, int8_t neighborsArraySize);
+bool SlotMap_AddPendingSlot(Node node, SlotNum slotNum, int8_t *neighborsArray, int8_t neighborsArraySize);
 
 /** Change pending slot to own slot
 * @param node is the Node struct of the node that should perform this action
 * @param slotNum is the number of the pending slot that should be made an own slot
 * return true if the slot was added to own or false if the slot was not a pending slot
 */
-bool SlotMap_ChangePendingToOwn(Node node, int8_t slotNum);
+bool SlotMap_ChangePendingToOwn(Node node, SlotNum slotNum);
 
 /** Check if the network created by this node was actually successfully created
 * @param node is the Node struct of the node that should perform this action
@@ -291,7 +368,7 @@ bool SlotMap_ChangePendingToOwn(Node node, int8_t slotNum);
 * Checks if all own slots are colliding and no other node reserved a slot, which means this node cannot be 
 * sure that the network really exists (meaning any other node actually received a message from this node)
 */
-bool SlotMap_OwnNetworkExists(Node node, int8_t *collidingSlots, int8_t collidingSlotsSize);
+bool SlotMap_OwnNetworkExists(Node node, SlotNum *collidingSlots, int16_t collidingSlotsSize);
 
 /** Checks if this slot can be used to send a ping
 * @param node is the Node struct of the node that should perform this action
@@ -307,7 +384,7 @@ bool SlotMap_ClearToSend(Node node);
 * 
 * Check is based on all informations in the slot maps
 */
-bool SlotMap_SlotIsFree(Node node, int8_t slotNum);
+bool SlotMap_SlotIsFree(Node node, SlotNum slotNum);
 
 /** Checks if a slot is free for this node in a three hop neighborhood
 * @param node is the Node struct of the node that should perform this action
@@ -317,7 +394,7 @@ bool SlotMap_SlotIsFree(Node node, int8_t slotNum);
 * "free for this node" means the slot can either be free or being reported occupied by this node in
 * any of the slot maps; it is then also fine for this node to use the slot
 */
-bool SlotMap_SlotIsFreeForThisNode(Node node, int8_t slotNum);
+bool SlotMap_SlotIsFreeForThisNode(Node node, SlotNum slotNum);
 
 /** Checks if a slot is colliding in a three hop neighborhood
 * @param node is the Node struct of the node that should perform this action
@@ -326,7 +403,7 @@ bool SlotMap_SlotIsFreeForThisNode(Node node, int8_t slotNum);
 *
 * Check is based on all informations in the slot maps
 */
-bool SlotMap_SlotIsColliding(Node node, int8_t slotNum);
+bool SlotMap_SlotIsColliding(Node node, SlotNum slotNum);
 
 /** Get all pending slots of this node that were acknowledged
 * @param node is the Node struct of the node that should perform this action
@@ -334,7 +411,7 @@ bool SlotMap_SlotIsColliding(Node node, int8_t slotNum);
 * @param size is the size of the buffer (to avoid illegal memory access)
 * return the number of acknowledged pending slots or -1 if buffer is too small
 */
-int8_t SlotMap_GetAcknowledgedPendingSlots(Node node, int8_t *buffer, int8_t size);
+int8_t SlotMap_GetAcknowledgedPendingSlots(Node node, SlotNum *buffer, int16_t size);
 
 /** Get all pending slots of this node
 * @param node is the Node struct of the node that should perform this action
@@ -342,7 +419,7 @@ int8_t SlotMap_GetAcknowledgedPendingSlots(Node node, int8_t *buffer, int8_t siz
 * @param size is the size of the buffer (to avoid illegal memory access)
 * return the number of pending slots
 */
-int8_t SlotMap_GetPendingSlots(Node node, int8_t *buffer, int8_t size);
+int8_t SlotMap_GetPendingSlots(Node node, SlotNum *buffer, int16_t size);
 
 /** Get all own slots of this node
 * @param node is the Node struct of the node that should perform this action
@@ -350,7 +427,7 @@ int8_t SlotMap_GetPendingSlots(Node node, int8_t *buffer, int8_t size);
 * @param size is the size of the buffer (to avoid illegal memory access)
 * return the number of own slots
 */
-int8_t SlotMap_GetOwnSlots(Node node, int8_t *buffer, int8_t size);
+int8_t SlotMap_GetOwnSlots(Node node, SlotNum *buffer, int16_t size);
 
 /** Remove all collisions from collisionTimes that are older than a certain period of time
 * @param node is the Node struct of the node that should perform this action
@@ -366,27 +443,27 @@ int64_t SlotMap_GetLastReservationTime(Node node);
 * @param node is the Node struct of the node that should perform this action
 * @param slotNum is the number of the slot to be checked
 */
-bool SlotMap_IsOwnSlot(Node node, int8_t slotNum);
+bool SlotMap_IsOwnSlot(Node node, SlotNum slotNum);
 
 /** Check if slot is pending slot
 * @param node is the Node struct of the node that should perform this action
 * @param slotNum is the number of the slot to be checked
 */
-bool SlotMap_IsPendingSlot(Node node, int8_t slotNum);
+bool SlotMap_IsPendingSlot(Node node, SlotNum slotNum);
 
 /** Remove slot from own slots
 * @param node is the Node struct of the node that should perform this action
 * @param slotNum is the number of the slot to be removed
 * return true if slot was released or false if it was not an own slot
 */
-bool SlotMap_ReleaseOwnSlot(Node node, int8_t slotNum);
+bool SlotMap_ReleaseOwnSlot(Node node, SlotNum slotNum);
 
 /** Remove slot from pending slots
 * @param node is the Node struct of the node that should perform this action
 * @param slotNum is the number of the slot to be removed
 * return true if slot was released or false if it was not a pending slot
 */
-bool SlotMap_ReleasePendingSlot(Node node, int8_t slotNum);
+bool SlotMap_ReleasePendingSlot(Node node, SlotNum slotNum);
 
 /** Remove all expired slots from one hop slot map
 * @param node is the Node struct of the node that should perform this action
@@ -415,7 +492,7 @@ void SlotMap_RemoveExpiredSlotsFromThreeHopSlotMap(Node node);
 * @param size is the size of the buffer (to avoid illegal memory access)
 * return number of removed pending slots
 */
-int16_t SlotMap_RemoveExpiredPendingSlots(Node node, int8_t *buffer, int8_t size);
+int16_t SlotMap_RemoveExpiredPendingSlots(Node node, SlotNum *buffer, int16_t size);
 
 /** Remove all expired own slots
 * @param node is the Node struct of the node that should perform this action
@@ -423,7 +500,7 @@ int16_t SlotMap_RemoveExpiredPendingSlots(Node node, int8_t *buffer, int8_t size
 * @param size is the size of the buffer (to avoid illegal memory access)
 * return number of removed own slots
 */
-int16_t SlotMap_RemoveExpiredOwnSlots(Node node, int8_t *buffer, int8_t size);
+int16_t SlotMap_RemoveExpiredOwnSlots(Node node, SlotNum *buffer, int16_t size);
 
 /** Extend timeouts of slots after the node has slept
 * @param node is the Node struct of the node that should perform this action
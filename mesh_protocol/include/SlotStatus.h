@@ -0,0 +1,89 @@
+/* Copyright (c) 2022-23 California Institute of Technology (Caltech).
+ * U.S. Government sponsorship acknowledged.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Caltech nor its operating division,
+ *   the Jet Propulsion Laboratory, nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Open Source License Approved by Caltech/JPL
+ *
+ * APACHE LICENSE, VERSION 2.0
+ * - Text version: https://www.apache.org/licenses/LICENSE-2.0.txt
+ * - SPDX short identifier: Apache-2.0
+ * - OSI Approved License: https://opensource.org/licenses/Apache-2.0
+ */
+
+/** @file SlotStatus.h
+*   @brief Status of the slots of a slot map, packed into 2 bits per slot
+*
+*   A slot can only be FREE, OCCUPIED or COLLIDING, so the status of four slots fits into one byte. The packed arrays 
+*   hold the slot maps of a node and the slot maps that are sent in every ping. The accessors are defined in this 
+*   header, so that they can be inlined into the loops over all slots.
+*/
+
+#ifndef SLOT_STATUS_H
+#define SLOT_STATUS_H
+
+#include <stdint.h>
+
+#include "Constants.h"
+
+enum SlotOccupancy {
+  FREE, OCCUPIED, COLLIDING
+};
+
+typedef enum SlotOccupancy SlotOccupancy;
+
+/** Number of bytes of a SlotStatusArray (four slots per byte) */
+#define SLOT_STATUS_BYTES ((NUM_SLOTS + 3) / 4)
+
+/** Status of every slot of a frame; the status of slot index i (slot number - 1) is in bits 2 * (i % 4) and 
+* 2 * (i % 4) + 1 of byte i / 4; FREE is 0, so an array that is set to zero has all slots FREE
+*/
+typedef struct SlotStatusArray {
+  uint8_t bytes[SLOT_STATUS_BYTES];
+} SlotStatusArray;
+
+/** Get the status of a slot
+* @param statuses is the packed status of all slots
+* @param slotIdx is the index of the slot (slot number - 1)
+* return the status of the slot
+*/
+static inline SlotOccupancy SlotStatus_Get(const SlotStatusArray *statuses, int16_t slotIdx) {
+  return (SlotOccupancy) ((statuses->bytes[slotIdx / 4] >> (2 * (slotIdx % 4))) & 0x3);
+};
+
+/** Set the status of a slot
+* @param statuses is the packed status of all slots
+* @param slotIdx is the index of the slot (slot number - 1)
+* @param status is the new status of the slot
+*/
+static inline void SlotStatus_Set(SlotStatusArray *statuses, int16_t slotIdx, SlotOccupancy status) {
+  int shift = 2 * (slotIdx % 4);
+  statuses->bytes[slotIdx / 4] = (uint8_t) ((statuses->bytes[slotIdx / 4] & ~(0x3 << shift)) | ((status & 0x3) << shift));
+};
+
+#endif
@@ -0,0 +1,114 @@
+/* Copyright (c) 2022-23 California Institute of Technology (Caltech).
+ * U.S. Government sponsorship acknowledged.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Caltech nor its operating division,
+ *   the Jet Propulsion Laboratory, nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Open Source License Approved by Caltech/JPL
+ *
+ * APACHE LICENSE, VERSION 2.0
+ * - Text version: https://www.apache.org/licenses/LICENSE-2.0.txt
+ * - SPDX short identifier: Apache-2.0
+ * - OSI Approved License: https://opensource.org/licenses/Apache-2.0
+ */
+
+
+/** @file Snapshot.h
+*   @brief Copies the state of all nodes of a simulation into contiguous arrays at once
+*
+*   Instead of asking every node for every value separately (e.g. functionIds 11 - 19 of the MatlabWrapper), a snapshot
+*   holds one array per value with one row per node. Arrays with more than one value per node (slots and slot maps) are 
+*   stored column-major like MATLAB matrices: the value of column c of node i is at index i + c * numNodes.
+*   The arrays are allocated by the caller (or by Snapshot_Create), so they can directly point to the data of mxArrays.
+*/ 
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "Node.h"
+#include "StateMachine.h"
+#include "ProtocolClock.h"
+#include "NetworkManager.h"
+#include "TimeKeeping.h"
+#include "SlotMap.h"
+
+typedef struct SnapshotStruct * Snapshot;
+
+/**
+* numNodes: number of rows of all arrays
+* state: state of every node (see States in StateMachine.h)
+* localTime: local time of every node
+* networkId: ID of the network of every node
+* networkAge: network age of every node as calculated by the node
+* currentSlot: current slot number of every node
+* ownSlots: numNodes x MAX_NUM_OWN_SLOTS; own slots of every node, 0 if unused
+* pendingSlots: numNodes x MAX_NUM_PENDING_SLOTS; pending slots of every node, 0 if unused
+* oneHopSlotsStatus, twoHopSlotsStatus, threeHopSlotsStatus: numNodes x NUM_SLOTS; slot maps of every node
+* oneHopSlotsIds, twoHopSlotsIds, threeHopSlotsIds: numNodes x NUM_SLOTS; IDs in the slot maps of every node
+*/
+typedef struct SnapshotStruct {
+  int16_t numNodes;
+
+  int8_t *state;
+  int64_t *localTime;
+  uint8_t *networkId;
+  int64_t *networkAge;
+  SlotNum *currentSlot;
+
+  SlotNum *ownSlots;
+  SlotNum *pendingSlots;
+
+  int32_t *oneHopSlotsStatus;
+  int8_t *oneHopSlotsIds;
+  int32_t *twoHopSlotsStatus;
+  int8_t *twoHopSlotsIds;
+  int32_t *threeHopSlotsStatus;
+  int8_t *threeHopSlotsIds;
+} SnapshotStruct;
+
+/** Constructor; allocates all arrays
+* @param numNodes is the number of rows of all arrays
+*/
+Snapshot Snapshot_Create(int16_t numNodes);
+
+/** Destructor; frees all arrays (only use for snapshots created with Snapshot_Create)
+* @param self is the Snapshot struct
+*/
+void Snapshot_Destroy(Snapshot self);
+
+/** Copy the state of nodes into the arrays of a snapshot
+* @param self is the Snapshot struct; its arrays must have at least numNodes rows
+* @param nodes is the array of nodes
+* @param numNodes is the number of nodes; row i of the snapshot holds the state of nodes[i]
+*/
+void Snapshot_Fill(Snapshot self, Node *nodes, int16_t numNodes);
+
+#endif
@@ -0,0 +1,129 @@
+/* Copyright (c) 2022-23 California Institute of Technology (Caltech).
+ * U.S. Government sponsorship acknowledged.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Caltech nor its operating division,
+ *   the Jet Propulsion Laboratory, nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Open Source License Approved by Caltech/JPL
+ *
+ * APACHE LICENSE, VERSION 2.0
+ * - Text version: https://www.apache.org/licenses/LICENSE-2.0.txt
+ * - SPDX short identifier: Apache-2.0
+ * - OSI Approved License: https://opensource.org/licenses/Apache-2.0
+ */
+
+
+/** @file SpatialGrid.h
+*   @brief Uniform grid over the positions of the simulated nodes to find all nodes within radio range of a sender
+*
+*   The plane is divided into square cells; every node is linked into the list of the cell its position falls in. Cells 
+*   are stored in a hash table, so the extent of the deployment does not need to be known. A range query only looks at 
+*   the cells that overlap the square around the query position, which is close to constant time if the cell size is 
+*   about the radio range. Moving a node only relinks it if it changes its cell.
+*/ 
+
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <math.h>
+
+typedef struct SpatialGridStruct * SpatialGrid;
+
+/**
+* capacity: maximum number of nodes in the grid
+* numNodes: number of nodes in the grid; nodes are identified by their index 0 ... numNodes - 1
+* cellSize: edge length of a cell
+* posX, posY: position of every node
+* cellX, cellY: cell coordinates of every node
+* next: next node in the same bucket for every node; -1 ends the list
+* prev: previous node in the same bucket for every node; -1 if the node is the first one
+* buckets: first node of every bucket of the hash table; -1 if the bucket is empty
+* numBuckets: size of the hash table (power of two)
+*/
+typedef struct SpatialGridStruct {
+  int16_t capacity;
+  int16_t numNodes;
+  double cellSize;
+
+  double *posX;
+  double *posY;
+  int32_t *cellX;
+  int32_t *cellY;
+  int16_t *next;
+  int16_t *prev;
+
+  int16_t *buckets;
+  int32_t numBuckets;
+} SpatialGridStruct;
+
+/** Constructor
+* @param capacity is the maximum number of nodes in the grid
+* @param cellSize is the edge length of a cell; should be about the radio range
+*/
+SpatialGrid SpatialGrid_Create(int16_t capacity, double cellSize);
+
+/** Destructor
+* @param self is the SpatialGrid struct
+*/
+void SpatialGrid_Destroy(SpatialGrid self);
+
+/** Change the cell size and re-sort all nodes into the new cells
+* @param self is the SpatialGrid struct
+* @param cellSize is the new edge length of a cell
+*/
+void SpatialGrid_SetCellSize(SpatialGrid self, double cellSize);
+
+/** Add a node to the grid
+* @param self is the SpatialGrid struct
+* @param x is the x position of the node
+* @param y is the y position of the node
+* return index of the node or -1 if the grid is full
+*/
+int16_t SpatialGrid_Insert(SpatialGrid self, double x, double y);
+
+/** Move a node to a new position
+* @param self is the SpatialGrid struct
+* @param nodeIdx is the index of the node
+* @param x is the new x position of the node
+* @param y is the new y position of the node
+*/
+void SpatialGrid_Move(SpatialGrid self, int16_t nodeIdx, double x, double y);
+
+/** Find all nodes within a distance of a node (excluding the node itself)
+* @param self is the SpatialGrid struct
+* @param nodeIdx is the index of the node
+* @param range is the maximum distance
+* @param buffer is the array the indices of the nodes found are written to, in ascending order
+* @param size is the size of buffer
+* return number of nodes found
+*/
+int16_t SpatialGrid_QueryRange(SpatialGrid self, int16_t nodeIdx, double range, int16_t *buffer, int16_t size);
+
+#endif
@@ -49,6 +49,7 @@
 #include "GuardConditions.h"
 #include "Driver.h"
 #include "RangingManager.h"
+#include "Trace.h"
 
 #include "Message.h" // TESTING ONLY
 
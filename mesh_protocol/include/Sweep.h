@@ -0,0 +1,207 @@
+/* Copyright (c) 2022-23 California Institute of Technology (Caltech).
+ * U.S. Government sponsorship acknowledged.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Caltech nor its operating division,
+ *   the Jet Propulsion Laboratory, nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Open Source License Approved by Caltech/JPL
+ *
+ * APACHE LICENSE, VERSION 2.0
+ * - Text version: https://www.apache.org/licenses/LICENSE-2.0.txt
+ * - SPDX short identifier: Apache-2.0
+ * - OSI Approved License: https://opensource.org/licenses/Apache-2.0
+ */
+
+
+/** @file Sweep.h
+*   @brief Runs many independent simulation scenarios (seeds x topologies x configs) on a pool of threads
+*
+*   Every scenario creates its own Simulator, so scenarios do not share any state and can run in parallel. 
+*   The scenarios are split evenly between the worker threads; a worker that has run out of scenarios steals 
+*   half of the remaining scenarios of another worker, so that long and short scenarios balance out.
+*   The result of every scenario is written to the row with the same index, so the output does not depend on 
+*   the number of threads or on the order in which the scenarios were run.
+*/ 
+
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "Simulator.h"
+#include "Config.h"
+
+typedef struct SweepScenarioStruct * SweepScenario;
+typedef struct SweepResultStruct * SweepResult;
+
+enum SweepTopology {
+  TOPOLOGY_LINE = 0,    // nodes on a line, spacing apart
+  TOPOLOGY_GRID = 1,    // nodes on a square grid, spacing apart
+  TOPOLOGY_RANDOM = 2,  // nodes uniformly distributed in a square with the same area as the grid
+  TOPOLOGY_CLIQUE = 3,  // nodes on a circle with a diameter of half the radio range, so all nodes are in range of each other
+  TOPOLOGY_RING = 4,    // nodes on a regular polygon with sides of 0.9 radio ranges, so only adjacent nodes are in range
+  TOPOLOGY_STAR = 5,    // one hub with the other nodes 0.9 radio ranges around it; the outer nodes are hidden from each other 
+                        // for up to 6 nodes
+  TOPOLOGY_MERGE = 6,   // two cliques that are out of range of each other; after half of the duration, the second one is moved 
+                        // so that the two overlap
+  TOPOLOGY_HIDDEN = 7,  // two rows of nodes 0.9 radio ranges apart; diagonal nodes and the outer nodes of a row are hidden from 
+                        // each other although they share a neighbor
+  NUM_TOPOLOGIES = 8
+};
+
+typedef enum SweepTopology SweepTopology;
+
+/**
+* id: number of the scenario (index in the scenario matrix)
+* seed: seed of the Simulator
+* numNodes: number of nodes in the scenario
+* topology: how the nodes are placed
+* spacing: distance between neighboring nodes (line and grid) 
+* radioRange: radio range of the Simulator
+* duration: number of time tics the scenario is simulated
+* configIdx: index of the config variant (only used to label the result)
+* config: config that every node of the scenario uses
+*/
+typedef struct SweepScenarioStruct {
+  int32_t id;
+  uint32_t seed;
+  int16_t numNodes;
+  SweepTopology topology;
+  double spacing;
+  double radioRange;
+  int64_t duration;
+  int16_t configIdx;
+  ConfigStruct config;
+} SweepScenarioStruct;
+
+/**
+* scenarioId: id of the scenario the result belongs to
+* networkFormationTime: first simulation time at which all nodes were connected to the same network; -1 if never
+* firstSlotTime: first simulation time at which every node had at least one own slot; -1 if never
+* slotGoalTime: first simulation time at which all nodes had reserved slotGoal slots; -1 if never
+* numCollisions: number of collisions that nodes received
+* numRangings: number of completed rangings (delivered RESULT messages)
+* numPings: number of pings that were sent
+* numSlotReleases: number of times a node lost one of its own slots (released or expired)
+* numNetworkSwitches: number of times a node joined a network other than the last one it was connected to
+*/
+typedef struct SweepResultStruct {
+  int32_t scenarioId;
+  int64_t networkFormationTime;
+  int64_t firstSlotTime;
+  int64_t slotGoalTime;
+  uint64_t numCollisions;
+  uint64_t numRangings;
+  uint64_t numPings;
+  uint64_t numSlotReleases;
+  uint64_t numNetworkSwitches;
+} SweepResultStruct;
+
+/** Build the scenario matrix from all combinations of the given values
+* @param seeds is an array of simulation seeds
+* @param numSeeds is the number of elements in seeds
+* @param nodeCounts is an array of numbers of nodes
+* @param numNodeCounts is the number of elements in nodeCounts
+* @param topologies is an array of topologies
+* @param numTopologies is the number of elements in topologies
+* @param configs is an array of config variants
+* @param numConfigs is the number of elements in configs
+* @param spacing is the spacing of all scenarios
+* @param radioRange is the radio range of all scenarios
+* @param duration is the duration of all scenarios in time tics
+* @param numScenarios is set to the number of scenarios that were created
+* return array of scenarios (to be freed by the caller)
+*/
+SweepScenarioStruct *Sweep_CreateScenarioMatrix(uint32_t *seeds, int32_t numSeeds, int16_t *nodeCounts, int32_t numNodeCounts, 
+  SweepTopology *topologies, int32_t numTopologies, ConfigStruct *configs, int32_t numConfigs, double spacing, double radioRange, 
+  int64_t duration, int32_t *numScenarios);
+
+/** Get the name of a topology, as used on the command line
+* @param topology is the topology
+* return name of the topology (e.g. "line"); NULL if the topology does not exist
+*/
+const char *Sweep_GetTopologyName(SweepTopology topology);
+
+/** Find a topology by its name
+* @param name is the name of the topology (see Sweep_GetTopologyName)
+* @param topology is set to the topology if it was found
+* return true if the topology exists; false otherwise
+*/
+bool Sweep_ParseTopology(const char *name, SweepTopology *topology);
+
+/** Set a field of a config by name
+* @param config is the Config struct that should be changed
+* @param key is the name of the field (e.g. "slotLength")
+* @param value is the new value
+* return true if the field exists; false otherwise
+*/
+bool Sweep_SetConfigValue(Config config, const char *key, int64_t value);
+
+/** Create the Simulator of a scenario with all nodes placed according to the topology (idle skipping is enabled)
+* @param scenario is the scenario
+* return the Simulator (to be destroyed by the caller)
+*/
+Simulator Sweep_CreateSimulator(SweepScenario scenario);
+
+/** Move the nodes of topologies that change over time (TOPOLOGY_MERGE) if the change is due
+* @param sim is the Simulator of the scenario (see Sweep_CreateSimulator)
+* @param scenario is the scenario
+* return next simulation time at which the topology changes; the duration of the scenario if it does not change anymore
+*
+* Call this before every tic and do not skip idle tics beyond the returned time
+*/
+int64_t Sweep_UpdateTopology(Simulator sim, SweepScenario scenario);
+
+/** Simulate a single scenario
+* @param scenario is the scenario that should be simulated
+* @param result is where the result of the scenario is written to
+*/
+void Sweep_RunScenario(SweepScenario scenario, SweepResult result);
+
+/** Simulate all scenarios on a pool of worker threads
+* @param scenarios is an array of scenarios
+* @param numScenarios is the number of elements in scenarios
+* @param results is an array with space for numScenarios results; the result of scenarios[i] is written to results[i]
+* @param numThreads is the number of worker threads; 0 uses one thread per online CPU core
+*/
+void Sweep_Run(SweepScenarioStruct *scenarios, int32_t numScenarios, SweepResultStruct *results, int16_t numThreads);
+
+/** Write the CSV header of the result rows
+* @param file is the file to write to
+*/
+void Sweep_WriteHeader(FILE *file);
+
+/** Write the result of a scenario as one CSV row
+* @param file is the file to write to
+* @param scenario is the scenario the result belongs to
+* @param result is the result of the scenario
+*/
+void Sweep_WriteRow(FILE *file, SweepScenario scenario, SweepResult result);
+
+#endif
@@ -107,13 +107,13 @@ void TimeKeeping_ResetTime(Node node);
 * @param time is the time for which the slot should be calculated
 * return calculated slot
 */
-uint8_t TimeKeeping_CalculateOwnSlotAtTime(Node node, int64_t time);
+SlotNum TimeKeeping_CalculateOwnSlotAtTime(Node node, int64_t time);
 
 /** Calculate the number of the slot the node is currently in
 * @param node is the Node struct of the node that should perform this action
 * return the number of the current slot
 */
-uint8_t TimeKeeping_CalculateCurrentSlotNum(Node node);
+SlotNum TimeKeeping_CalculateCurrentSlotNum(Node node);
 
 /** Calculate the number of the frame the node is currently in
 * @param node is the Node struct of the node that should perform this action
@@ -126,7 +126,7 @@ uint64_t TimeKeeping_CalculateCurrentFrameNum(Node node);
 * @param slotNum is the slot whose next beginning should be calculated
 * return the local time of the next beginning of the queried slot
 */
-int64_t TimeKeeping_CalculateNextStartOfSlot(Node node, uint8_t slotNum);
+int64_t TimeKeeping_CalculateNextStartOfSlot(Node node, SlotNum slotNum);
 
 /** Calculate the network age of a node whose ping message was received in time tics
 * @param node is the Node struct of the node that should perform this action
@@ -180,4 +180,10 @@ int64_t TimeKeeping_GetLastTimeIdled(Node node);
 */
 bool TimeKeeping_IsAutoCycleWakeupTime(Node node);
 
+/** Calculate the time until the node should wake up from idleing when in auto duty cycle
+* @param node is the Node struct of the node that should perform this action
+* return time until the network age is the next multiple of the sleep time; 0 if the node should wake up now
+*/
+int64_t TimeKeeping_CalculateTimeUntilWakeup(Node node);
+
 #endif
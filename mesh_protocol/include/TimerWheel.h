@@ -0,0 +1,141 @@
+/* Copyright (c) 2022-23 California Institute of Technology (Caltech).
+ * U.S. Government sponsorship acknowledged.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Caltech nor its operating division,
+ *   the Jet Propulsion Laboratory, nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Open Source License Approved by Caltech/JPL
+ *
+ * APACHE LICENSE, VERSION 2.0
+ * - Text version: https://www.apache.org/licenses/LICENSE-2.0.txt
+ * - SPDX short identifier: Apache-2.0
+ * - OSI Approved License: https://opensource.org/licenses/Apache-2.0
+ */
+
+/** @file TimerWheel.h
+*   @brief Hierarchical timer wheel for the timeouts of the slot maps, pending and own slots and neighbors of a node
+*
+*   Every slot of the slot maps, every pending and own slot and every neighbor has a timer that is scheduled at the time it 
+*   expires. Instead of visiting all of them with every tic, a node only pops the timers whose bucket has been reached, so the 
+*   cost of a tic does not depend on the number of slots or neighbors. The wheel has TIMER_WHEEL_LEVELS levels of 
+*   TIMER_WHEEL_BUCKETS buckets each; a bucket of level l covers TIMER_WHEEL_BUCKETS^l tics. A timer is put into the bucket of 
+*   the lowest level that reaches its expiration time and fires when the start of the bucket is reached, i.e. never late but 
+*   possibly early. The owner of a timer therefore checks whether it has really expired and schedules it again if not.
+*/ 
+
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "Constants.h"
+
+/** Number of levels of the wheel and number of buckets per level (one bit of a uint32_t per bucket) */
+#define TIMER_WHEEL_LEVELS 4
+#define TIMER_WHEEL_BUCKET_BITS 5
+#define TIMER_WHEEL_BUCKETS (1 << TIMER_WHEEL_BUCKET_BITS)
+
+/** Index of the first timer of each group of timers of a node; the timer of a slot is the first timer plus the slot index,
+*   the timer of a pending or own slot or a neighbor is the first timer plus the index in the respective array */
+#define TIMER_WHEEL_ONE_HOP_SLOTS 0
+#define TIMER_WHEEL_TWO_HOP_SLOTS (TIMER_WHEEL_ONE_HOP_SLOTS + NUM_SLOTS)
+#define TIMER_WHEEL_THREE_HOP_SLOTS (TIMER_WHEEL_TWO_HOP_SLOTS + NUM_SLOTS)
+#define TIMER_WHEEL_PENDING_SLOTS (TIMER_WHEEL_THREE_HOP_SLOTS + NUM_SLOTS)
+#define TIMER_WHEEL_OWN_SLOTS (TIMER_WHEEL_PENDING_SLOTS + MAX_NUM_PENDING_SLOTS)
+#define TIMER_WHEEL_NEIGHBORS (TIMER_WHEEL_OWN_SLOTS + MAX_NUM_OWN_SLOTS)
+#define TIMER_WHEEL_NUM_TIMERS (TIMER_WHEEL_NEIGHBORS + MAX_NUM_NODES - 1)
+
+/** Number of lists of the wheel: one per bucket and one for the timers that have fired but were not popped yet */
+#define TIMER_WHEEL_NUM_LISTS (TIMER_WHEEL_LEVELS * TIMER_WHEEL_BUCKETS + 1)
+
+/** Returned by TimerWheel_NextFireTime() if no timer is scheduled, or if a timer has already fired */
+#define TIMER_WHEEL_NO_TIMER INT64_MAX
+#define TIMER_WHEEL_FIRED INT64_MIN
+
+typedef struct TimerWheelStruct * TimerWheel;
+
+/**
+* next, prev: doubly linked circular lists of the timers in the buckets; the entries after the timers are the heads of the lists,
+*   next of a timer is -1 if it is not scheduled
+* list: list each timer is in, so that scheduling a timer into the bucket it is already in does not touch the lists
+* nonEmpty: for every level, one bit per bucket that holds at least one timer
+* cursor: local time up to which the buckets have fired
+*/
+typedef struct TimerWheelStruct {
+  int16_t next[TIMER_WHEEL_NUM_TIMERS + TIMER_WHEEL_NUM_LISTS];
+  int16_t prev[TIMER_WHEEL_NUM_TIMERS + TIMER_WHEEL_NUM_LISTS];
+  uint8_t list[TIMER_WHEEL_NUM_TIMERS];
+  uint32_t nonEmpty[TIMER_WHEEL_LEVELS];
+  int64_t cursor;
+} TimerWheelStruct;
+
+/** Constructor */
+TimerWheel TimerWheel_Create();
+
+/** Schedule a timer (again), replacing its previous expiration time
+* @param self is the TimerWheel struct
+* @param timer is the index of the timer (see TIMER_WHEEL_ONE_HOP_SLOTS etc.)
+* @param expirationTime is the first local time at which the timer has expired
+*/
+void TimerWheel_Schedule(TimerWheel self, int16_t timer, int64_t expirationTime);
+
+/** Remove a timer from the wheel (does nothing if it is not scheduled)
+* @param self is the TimerWheel struct
+* @param timer is the index of the timer
+*/
+void TimerWheel_Cancel(TimerWheel self, int16_t timer);
+
+/** Check if a timer is scheduled
+* @param self is the TimerWheel struct
+* @param timer is the index of the timer
+* return true if the timer is in the wheel (also if it has fired but was not popped yet)
+*/
+bool TimerWheel_IsScheduled(TimerWheel self, int16_t timer);
+
+/** Fire all buckets up to the current time and remove the fired timers of a group from the wheel
+* @param self is the TimerWheel struct
+* @param now is the current local time
+* @param firstTimer is the index of the first timer of the group
+* @param numTimers is the number of timers of the group
+* @param buffer is a pointer to the buffer the indices of the fired timers are written to (at least numTimers elements)
+* return number of fired timers of the group
+*
+* A timer may fire before its expiration time; the caller has to check its timeout and schedule the timer again if it has not 
+* expired yet. If the local time went backwards, the buckets that are ambiguous for the new time fire as well.
+*/
+int16_t TimerWheel_PopExpired(TimerWheel self, int64_t now, int16_t firstTimer, int16_t numTimers, int16_t *buffer);
+
+/** Get the earliest local time at which a timer fires
+* @param self is the TimerWheel struct
+* return start time of the first non-empty bucket; TIMER_WHEEL_FIRED if a timer has fired but was not popped yet; 
+*   TIMER_WHEEL_NO_TIMER if no timer is scheduled
+*/
+int64_t TimerWheel_NextFireTime(TimerWheel self);
+
+#endif
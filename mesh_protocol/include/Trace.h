@@ -0,0 +1,176 @@
+/* Copyright (c) 2022-23 California Institute of Technology (Caltech).
+ * U.S. Government sponsorship acknowledged.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Caltech nor its operating division,
+ *   the Jet Propulsion Laboratory, nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Open Source License Approved by Caltech/JPL
+ *
+ * APACHE LICENSE, VERSION 2.0
+ * - Text version: https://www.apache.org/licenses/LICENSE-2.0.txt
+ * - SPDX short identifier: Apache-2.0
+ * - OSI Approved License: https://opensource.org/licenses/Apache-2.0
+ */
+
+
+/** @file Trace.h
+*   @brief Binary event trace of the protocol core
+*
+*   Every node can write fixed-size binary records of what it does (state changes, sent and received messages, slot reservations,
+*   releases and expiries, joins and ranging results) to a TraceWriter. The writer buffers the records and writes them to a file
+*   in large blocks; the file can be converted to text with the mesh_trace_decode tool.
+*
+*   Tracing is only compiled in if TRACE is defined (cmake -DMESH_TRACE=ON); otherwise TRACE_RECORD expands to nothing.
+*   When compiled in, a node only writes records if a writer was set with Node_SetTrace.
+*
+*   File format: a TraceHeaderStruct followed by TraceRecordStructs, all in the byte order of the machine that wrote the trace.
+*/ 
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Node.h"
+
+#define TRACE_MAGIC "MTRC"
+#define TRACE_VERSION 2
+
+/** Number of records that are buffered before they are written to the file */
+#define TRACE_BUFFER_SIZE 4096
+
+/** Types of trace records; the meaning of arg0, arg1 and value depends on the type */
+typedef enum TraceRecordTypes {
+  TRACE_STATE_CHANGE = 0,   // arg0: previous state, arg1: new state (see States in StateMachine.h)
+  TRACE_TX = 1,             // arg0: message type, arg1: recipient ID, value: network ID
+  TRACE_RX = 2,             // arg0: message type, arg1: sender ID, value: network ID
+  TRACE_SLOT_PENDING = 3,   // value: slot number that the node tries to reserve
+  TRACE_SLOT_RESERVED = 4,  // value: slot number that became an own slot
+  TRACE_SLOT_RELEASED = 5,  // arg1: 1 if it was an own slot, 0 if it was pending, value: slot number
+  TRACE_SLOT_EXPIRED = 6,   // arg1: 1 if it was an own slot, 0 if it was pending, value: slot number
+  TRACE_JOIN = 7,           // arg1: ID of the node whose network was joined, value: network ID
+  TRACE_RANGING_RESULT = 8, // arg1: ID of the ranging partner, value: distance in millimeters
+  TRACE_NUM_RECORD_TYPES = 9
+} TraceRecordTypes;
+
+/**
+* magic: TRACE_MAGIC (without terminating zero)
+* version: TRACE_VERSION
+* recordSize: size of one record in bytes
+*/
+typedef struct TraceHeaderStruct {
+  char magic[4];
+  uint16_t version;
+  uint16_t recordSize;
+} TraceHeaderStruct;
+
+/**
+* localTime: local time of the node when the record was written
+* value: depends on type
+* type: see TraceRecordTypes
+* nodeId: ID of the node that wrote the record
+* arg0, arg1: depend on type
+*/
+typedef struct TraceRecordStruct {
+  int64_t localTime;
+  int32_t value;
+  uint8_t type;
+  int8_t nodeId;
+  int8_t arg0;
+  int8_t arg1;
+} TraceRecordStruct;
+
+/**
+* file: file the records are written to
+* buffer: records that were not written to the file yet
+* numBuffered: number of records in buffer
+* numRecords: number of records written in total (including the buffered ones)
+*/
+typedef struct TraceWriterStruct {
+  FILE *file;
+  TraceRecordStruct buffer[TRACE_BUFFER_SIZE];
+  int32_t numBuffered;
+  uint64_t numRecords;
+} TraceWriterStruct;
+
+#ifdef TRACE
+#define TRACE_RECORD(node, type, arg0, arg1, value) \
+  do { \
+    if ((node)->trace != NULL) { \
+      Trace_Record((node), (type), (arg0), (arg1), (value)); \
+    }; \
+  } while (0)
+#else
+#define TRACE_RECORD(node, type, arg0, arg1, value) do { } while (0)
+#endif
+
+/** Constructor; creates the file and writes the header
+* @param path is the path of the trace file
+* return the TraceWriter, or NULL if the file could not be created
+*/
+TraceWriter TraceWriter_Create(const char *path);
+
+/** Destructor; writes the remaining records and closes the file
+* @param self is the TraceWriter struct
+*/
+void TraceWriter_Destroy(TraceWriter self);
+
+/** Append a record
+* @param self is the TraceWriter struct
+* @param record is the record that is copied into the buffer
+*/
+void TraceWriter_Write(TraceWriter self, const TraceRecordStruct *record);
+
+/** Write all buffered records to the file
+* @param self is the TraceWriter struct
+*/
+void TraceWriter_Flush(TraceWriter self);
+
+/** Write a record for a node to the writer of the node; use TRACE_RECORD instead of calling this directly
+* @param node is the Node struct of the node that writes the record
+* @param type is the type of the record
+* @param arg0, arg1, value depend on the type (see TraceRecordTypes)
+*/
+void Trace_Record(Node node, TraceRecordTypes type, int8_t arg0, int8_t arg1, int32_t value);
+
+/** Read the header of a trace file and check if it is valid
+* @param file is the trace file, positioned at its start
+* return true if the header is valid
+*/
+bool Trace_ReadHeader(FILE *file);
+
+/** Get the name of a record type
+* @param type is the type of the record
+* return name of the type, or "UNKNOWN"
+*/
+const char *Trace_GetTypeName(uint8_t type);
+
+#endif
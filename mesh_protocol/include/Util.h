@@ -54,6 +54,14 @@
 */
 int16_t Util_Int8tArrayFindElement(int8_t *array, int8_t element, int16_t arraySize);
 
+/** Find index of an element in an int16_t array
+* @param array is a pointer to the int16_t-array that should be searched
+* @param element is the int16_t element that should be found in the array
+* @param arraySize is the size of the array (to avoid illegal memory access)
+* return index of the element in the array or -1 if the array does not contain the element
+*/
+int16_t Util_Int16tArrayFindElement(int16_t *array, int16_t element, int16_t arraySize);
+
 /** Get intersection of two int8_t arrays
 * @param array1 is a pointer to the first int8_t-array; array must be sorted
 * @param size1 is the size of the first array (to avoid illegal memory access)
@@ -75,6 +83,12 @@ int16_t Util_IntersectSortedInt8tArrays(int8_t *array1, int8_t size1, int8_t *ar
 */
 void Util_SortInt8tArray(int8_t *array, int8_t arraySize, int8_t *sorted);
 
+/** Sort an int16_t array in ascending order in place
+* @param array is a pointer to the array that should be sorted
+* @param arraySize is the size of the array
+*/
+void Util_SortInt16tArray(int16_t *array, int16_t arraySize);
+
 /** Find the index of the smallest value in an int8_t array
 * @param array is a pointer to the int8_t-array that should be searched
 * @param arraySize is the size of the array (to avoid illegal memory access)
@@ -0,0 +1,219 @@
+/* Copyright (c) 2022-23 California Institute of Technology (Caltech).
+ * U.S. Government sponsorship acknowledged.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Caltech nor its operating division,
+ *   the Jet Propulsion Laboratory, nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Open Source License Approved by Caltech/JPL
+ *
+ * APACHE LICENSE, VERSION 2.0
+ * - Text version: https://www.apache.org/licenses/LICENSE-2.0.txt
+ * - SPDX short identifier: Apache-2.0
+ * - OSI Approved License: https://opensource.org/licenses/Apache-2.0
+ */
+
+#include "../include/Channel.h"
+
+static int32_t firstEndingAfter(ChannelReceiver receiver, int64_t time);
+static void resetBusyPeriod(ChannelReceiver receiver);
+
+Channel Channel_Create(int16_t numReceivers) {
+  Channel self = calloc(1, sizeof(ChannelStruct));
+  self->numReceivers = numReceivers;
+  self->receivers = calloc(numReceivers, sizeof(ChannelReceiverStruct));
+  for (int16_t i = 0; i < numReceivers; ++i) {
+    resetBusyPeriod(&self->receivers[i]);
+  };
+
+  self->captureEnabled = false;
+  self->captureThreshold = INFINITY;
+  self->pathLossExponent = 2.0;
+
+  self->numOverlaps = 0;
+  self->numCaptures = 0;
+
+  return self;
+};
+
+void Channel_Destroy(Channel self) {
+  for (int16_t i = 0; i < self->numReceivers; ++i) {
+    free(self->receivers[i].active);
+  };
+  free(self->receivers);
+  free(self);
+};
+
+Channel Channel_Clone(Channel self) {
+  Channel clone = calloc(1, sizeof(ChannelStruct));
+  *clone = *self;
+  clone->receivers = calloc(self->numReceivers, sizeof(ChannelReceiverStruct));
+  for (int16_t i = 0; i < self->numReceivers; ++i) {
+    clone->receivers[i] = self->receivers[i];
+    clone->receivers[i].active = NULL;
+    if (self->receivers[i].activeCapacity > 0) {
+      clone->receivers[i].active = calloc(self->receivers[i].activeCapacity, sizeof(ChannelReceptionStruct));
+      memcpy(clone->receivers[i].active, self->receivers[i].active, self->receivers[i].numActive * sizeof(ChannelReceptionStruct));
+    };
+  };
+  return clone;
+};
+
+void Channel_SetCapture(Channel self, bool enabled, double threshold, double pathLossExponent) {
+  self->captureEnabled = enabled;
+  self->captureThreshold = threshold;
+  self->pathLossExponent = pathLossExponent;
+};
+
+double Channel_ReceivedPower(Channel self, double distance) {
+  // nodes at the same position would have infinite power
+  double d = (distance > 0.01) ? distance : 0.01;
+  return -10.0 * self->pathLossExponent * log10(d);
+};
+
+bool Channel_StartReception(Channel self, int16_t receiverIdx, uint64_t txId, int64_t start, int64_t end, double power) {
+  ChannelReceiver receiver = &self->receivers[receiverIdx];
+
+  bool locked = (receiver->numActive == 0);
+  if (locked) {
+    resetBusyPeriod(receiver);
+    receiver->lockedTxId = txId;
+    receiver->lockedPower = power;
+  } else {
+    // the new reception overlaps the locked one (the locked one is active for the whole busy period or was already decoded)
+    receiver->overlapped = true;
+    if (power > receiver->maxInterference) {
+      receiver->maxInterference = power;
+    };
+    ++self->numOverlaps;
+  };
+
+  if (receiver->numActive == receiver->activeCapacity) {
+    receiver->activeCapacity = (receiver->activeCapacity > 0) ? (2 * receiver->activeCapacity) : 4;
+    receiver->active = realloc(receiver->active, receiver->activeCapacity * sizeof(ChannelReceptionStruct));
+  };
+
+  // insert sorted by end time; receptions with the same end time stay in the order they started
+  int32_t pos = firstEndingAfter(receiver, end);
+  memmove(&receiver->active[pos + 1], &receiver->active[pos], (receiver->numActive - pos) * sizeof(ChannelReceptionStruct));
+  receiver->active[pos].txId = txId;
+  receiver->active[pos].start = start;
+  receiver->active[pos].end = end;
+  receiver->active[pos].power = power;
+  ++receiver->numActive;
+
+  return locked;
+};
+
+ChannelRxResult Channel_EndReception(Channel self, int16_t receiverIdx, uint64_t txId, int64_t end) {
+  ChannelReceiver receiver = &self->receivers[receiverIdx];
+
+  // find the reception among the ones with the same end time
+  int32_t idx = -1;
+  for (int32_t i = firstEndingAfter(receiver, end - 1); i < receiver->numActive && receiver->active[i].end == end; ++i) {
+    if (receiver->active[i].txId == txId) {
+      idx = i;
+      break;
+    };
+  };
+  if (idx == -1) {
+    return CHANNEL_RX_NONE;
+  };
+
+  memmove(&receiver->active[idx], &receiver->active[idx + 1], (receiver->numActive - idx - 1) * sizeof(ChannelReceptionStruct));
+  --receiver->numActive;
+
+  if (txId == receiver->lockedTxId && !receiver->lost && !receiver->delivered) {
+    if (!receiver->overlapped) {
+      receiver->delivered = true;
+    } else if (self->captureEnabled && (receiver->lockedPower - receiver->maxInterference) >= self->captureThreshold) {
+      receiver->delivered = true;
+      ++self->numCaptures;
+    };
+  };
+
+  if (receiver->numActive > 0) {
+    // the busy period goes on; a decoded locked reception is delivered right away
+    if (txId == receiver->lockedTxId && receiver->delivered && !receiver->lost) {
+      return CHANNEL_RX_MESSAGE;
+    };
+    return CHANNEL_RX_NONE;
+  };
+
+  // end of the busy period
+  ChannelRxResult result;
+  if (receiver->lost) {
+    result = CHANNEL_RX_LOST;
+  } else if (txId == receiver->lockedTxId && receiver->delivered) {
+    result = CHANNEL_RX_MESSAGE;
+  } else if (receiver->delivered) {
+    result = CHANNEL_RX_NONE;
+  } else {
+    result = CHANNEL_RX_COLLISION;
+  };
+  resetBusyPeriod(receiver);
+  return result;
+};
+
+void Channel_AbortReceptions(Channel self, int16_t receiverIdx) {
+  ChannelReceiver receiver = &self->receivers[receiverIdx];
+  if (receiver->numActive > 0) {
+    receiver->lost = true;
+  };
+};
+
+bool Channel_IsBusy(Channel self, int16_t receiverIdx) {
+  return (self->receivers[receiverIdx].numActive > 0);
+};
+
+int32_t Channel_CountOverlaps(Channel self, int16_t receiverIdx, int64_t time) {
+  ChannelReceiver receiver = &self->receivers[receiverIdx];
+  return receiver->numActive - firstEndingAfter(receiver, time);
+};
+
+static int32_t firstEndingAfter(ChannelReceiver receiver, int64_t time) {
+  // binary search for the first reception with end > time
+  int32_t low = 0;
+  int32_t high = receiver->numActive;
+  while (low < high) {
+    int32_t mid = low + (high - low) / 2;
+    if (receiver->active[mid].end > time) {
+      high = mid;
+    } else {
+      low = mid + 1;
+    };
+  };
+  return low;
+};
+
+static void resetBusyPeriod(ChannelReceiver receiver) {
+  receiver->lockedTxId = UINT64_MAX;
+  receiver->lockedPower = -INFINITY;
+  receiver->maxInterference = -INFINITY;
+  receiver->overlapped = false;
+  receiver->lost = false;
+  receiver->delivered = false;
+};
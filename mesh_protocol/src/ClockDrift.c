@@ -0,0 +1,100 @@
+/* Copyright (c) 2022-23 California Institute of Technology (Caltech).
+ * U.S. Government sponsorship acknowledged.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Caltech nor its operating division,
+ *   the Jet Propulsion Laboratory, nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Open Source License Approved by Caltech/JPL
+ *
+ * APACHE LICENSE, VERSION 2.0
+ * - Text version: https://www.apache.org/licenses/LICENSE-2.0.txt
+ * - SPDX short identifier: Apache-2.0
+ * - OSI Approved License: https://opensource.org/licenses/Apache-2.0
+ */
+
+#include "../include/ClockDrift.h"
+
+static void computeRate(ClockDrift self, int64_t time);
+static double gaussian(uint32_t *state);
+static double uniform(uint32_t *state);
+
+void ClockDrift_Init(ClockDrift self, double offsetPpm, double randomWalkPpm, double variationPpm, int64_t variationPeriod, 
+  int64_t updateInterval, uint32_t seed, int64_t time) {
+
+  self->offsetPpm = offsetPpm;
+  self->randomWalkPpm = randomWalkPpm;
+  self->variationPpm = variationPpm;
+  self->variationPeriod = variationPeriod;
+  self->updateInterval = updateInterval;
+
+  self->walkPpm = 0;
+  // xorshift must not start at 0
+  self->randomState = (seed != 0) ? seed : 1;
+  self->nextUpdate = (updateInterval > 0) ? (time + updateInterval) : CLOCK_DRIFT_NO_UPDATE;
+  computeRate(self, time);
+};
+
+bool ClockDrift_Update(ClockDrift self, int64_t time) {
+  if (time < self->nextUpdate) {
+    return false;
+  };
+
+  // one step of the random walk per update, also if updates were missed
+  while (self->nextUpdate <= time) {
+    self->walkPpm += self->randomWalkPpm * gaussian(&self->randomState);
+    self->nextUpdate += self->updateInterval;
+  };
+  computeRate(self, time);
+  return true;
+};
+
+int64_t ClockDrift_GetIncrement(ClockDrift self) {
+  return (int64_t) llround(self->ratePpm * 1e-6 * (double) (1LL << CLOCK_DRIFT_FRACTION_BITS));
+};
+
+static void computeRate(ClockDrift self, int64_t time) {
+  double variation = 0;
+  if (self->variationPpm != 0 && self->variationPeriod > 0) {
+    variation = self->variationPpm * sin(2 * M_PI * (double) (time % self->variationPeriod) / (double) self->variationPeriod);
+  };
+  self->ratePpm = self->offsetPpm + self->walkPpm + variation;
+};
+
+static double gaussian(uint32_t *state) {
+  // Box-Muller; the first uniform value must not be 0
+  double u1 = (uniform(state) * 4294967295.0 + 1.0) / 4294967296.0;
+  double u2 = uniform(state);
+  return sqrt(-2 * log(u1)) * cos(2 * M_PI * u2);
+};
+
+static double uniform(uint32_t *state) {
+  // xorshift32
+  *state ^= *state << 13;
+  *state ^= *state >> 17;
+  *state ^= *state << 5;
+  return (double) *state / 4294967296.0;
+};
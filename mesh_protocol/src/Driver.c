@@ -40,6 +40,8 @@
 
 // simulation driver!
 
+static void pushToTxRing(Node node, Message msg);
+
 Driver Driver_Create(bool *txFinishedFlag, bool *isReceiving) {
   // allocate memory for the Driver struct
   Driver self = calloc(1, sizeof(DriverStruct));
@@ -63,17 +65,13 @@ void Driver_TransmitPing(Node node, Message msg) {
 #endif 
 
   /** This simulation driver "transmits" messages by sending them to MATLAB.
-  *   This is done by writing the message to a specific address in memory that is later read by the MatlabWrapper. 
+  *   This is done by writing the message to a ring in memory that is later read by the MatlabWrapper (or the Simulator). 
   *   The message that was created by the MessageHandler is copied here so that the MessageHandler can free the memory 
   *   as it would do when a real driver had sent the message over UWB; that way, the implementation details of the driver
   *   can be hidden from the MessageHandler.
   */
   
-  Message newMsg = Message_Create(PING);
-  memcpy(newMsg, msg, sizeof(MessageStruct));
-
-  *node->driver->msgOutAddress = newMsg;
-  node->driver->sentMessage = true;
+  pushToTxRing(node, msg);
 };
 
 void Driver_TransmitPoll(Node node, Message msg) {
@@ -83,11 +81,7 @@ void Driver_TransmitPoll(Node node, Message msg) {
 
   /** See description in Driver_TransmitPing */
 
-  Message newMsg = Message_Create(POLL);
-  memcpy(newMsg, msg, sizeof(MessageStruct));
-
-  *node->driver->msgOutAddress = newMsg;
-  node->driver->sentMessage = true;
+  pushToTxRing(node, msg);
 };
 
 void Driver_TransmitResponse(Node node, Message msg) {
@@ -97,11 +91,7 @@ void Driver_TransmitResponse(Node node, Message msg) {
 
   /** See description in Driver_TransmitPing */
 
-  Message newMsg = Message_Create(RESPONSE);
-  memcpy(newMsg, msg, sizeof(MessageStruct));
-
-  *node->driver->msgOutAddress = newMsg;
-  node->driver->sentMessage = true;
+  pushToTxRing(node, msg);
 };
 
 void Driver_TransmitFinal(Node node, Message msg) {
@@ -111,11 +101,7 @@ void Driver_TransmitFinal(Node node, Message msg) {
 
   /** See description in Driver_TransmitPing */
 
-  Message newMsg = Message_Create(FINAL);
-  memcpy(newMsg, msg, sizeof(MessageStruct));
-
-  *node->driver->msgOutAddress = newMsg;
-  node->driver->sentMessage = true;
+  pushToTxRing(node, msg);
 };
 
 void Driver_TransmitResult(Node node, Message msg) {
@@ -125,16 +111,27 @@ void Driver_TransmitResult(Node node, Message msg) {
 
   /** See description in Driver_TransmitPing */
 
-  Message newMsg = Message_Create(RESULT);
-  memcpy(newMsg, msg, sizeof(MessageStruct));
+  pushToTxRing(node, msg);
+};
+
+void Driver_SetTxRing(Node node, DriverTxRing txRing) {
+  /** The ring that is used to deliver the message back to MATLAB in simulation */
+  node->driver->txRing = txRing;
+};
 
-  *node->driver->msgOutAddress = newMsg;
-  node->driver->sentMessage = true;
+Message Driver_TxRingPeek(DriverTxRing txRing) {
+  if (txRing->count == 0) {
+    return NULL;
+  };
+  return &txRing->msgs[txRing->head];
 };
 
-void Driver_SetOutMsgAddress(Node node, Message *msgOutAddress) {
-  /** The address that is used to deliver the message back to MATLAB in simulation */
-  node->driver->msgOutAddress = msgOutAddress;
+void Driver_TxRingPop(DriverTxRing txRing) {
+  if (txRing->count == 0) {
+    return;
+  };
+  txRing->head = (txRing->head + 1) % DRIVER_TX_RING_SIZE;
+  --txRing->count;
 };
 
 bool Driver_IsReceiving(Node node) {
@@ -148,3 +145,47 @@ bool Driver_GetMessageSentFlag(Node node) {
 void Driver_SetMessageSentFlag(Node node, bool value) {
   node->driver->sentMessage = value;
 };
+
+static void pushToTxRing(Node node, Message msg) {
+  node->driver->sentMessage = true;
+  TRACE_RECORD(node, TRACE_TX, msg->type, msg->recipientId, msg->networkId);
+
+  DriverTxRing txRing = node->driver->txRing;
+  if (txRing == NULL) {
+    return;
+  };
+
+  if (txRing->count == DRIVER_TX_RING_SIZE) {
+    // the simulation environment did not take the messages in time; drop the new message instead of overwriting one
+    ++txRing->numDropped;
+#ifdef SIMULATION
+    mexPrintf("%" PRId64 ": Node %" PRIu8 " dropped message, transmit ring is full\n", ProtocolClock_GetLocalTime(node->clock), node->id);
+#endif
+    return;
+  };
+
+  // copy the message in place; only the collision times that are actually used are copied and the pointers, 
+  // which point into the message of the MessageHandler, are not copied at all
+  Message slot = &txRing->msgs[(txRing->head + txRing->count) % DRIVER_TX_RING_SIZE];
+  slot->type = msg->type;
+  slot->senderId = msg->senderId;
+  slot->recipientId = msg->recipientId;
+  slot->timestamp = msg->timestamp;
+  slot->networkId = msg->networkId;
+  slot->networkAge = msg->networkAge;
+  slot->timeSinceFrameStart = msg->timeSinceFrameStart;
+  slot->oneHopSlotStatus = msg->oneHopSlotStatus;
+  memcpy(slot->oneHopSlotIds, msg->oneHopSlotIds, sizeof(slot->oneHopSlotIds));
+  slot->twoHopSlotStatus = msg->twoHopSlotStatus;
+  memcpy(slot->twoHopSlotIds, msg->twoHopSlotIds, sizeof(slot->twoHopSlotIds));
+  slot->numCollisions = (msg->numCollisions > 0 && msg->numCollisions <= MAX_NUM_COLLISIONS_RECORDED) ? msg->numCollisions : 0;
+  memcpy(slot->collisionTimes, msg->collisionTimes, slot->numCollisions * sizeof(int64_t));
+  slot->distance = msg->distance;
+  slot->pingNum = msg->pingNum;
+  slot->rx_buffer = NULL;
+  slot->frame_len = 0;
+  slot->multiHopStatus = NULL;
+  slot->multiHopIds = NULL;
+
+  ++txRing->count;
+};
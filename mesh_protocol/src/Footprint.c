@@ -0,0 +1,82 @@
+/* Copyright (c) 2022-23 California Institute of Technology (Caltech).
+ * U.S. Government sponsorship acknowledged.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Caltech nor its operating division,
+ *   the Jet Propulsion Laboratory, nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Open Source License Approved by Caltech/JPL
+ *
+ * APACHE LICENSE, VERSION 2.0
+ * - Text version: https://www.apache.org/licenses/LICENSE-2.0.txt
+ * - SPDX short identifier: Apache-2.0
+ * - OSI Approved License: https://opensource.org/licenses/Apache-2.0
+ */
+
+
+#include "../include/Footprint.h"
+
+_Static_assert(FOOTPRINT_NODE_SIZE <= FOOTPRINT_NODE_BUDGET, 
+  "the protocol structs of a node exceed FOOTPRINT_NODE_BUDGET; reduce NUM_SLOTS or MAX_NUM_NODES or raise the budget");
+
+/**
+* name: name of the struct
+* size: sizeof the struct
+*/
+typedef struct FootprintEntryStruct {
+  const char *name;
+  size_t size;
+} FootprintEntryStruct;
+
+#define FOOTPRINT_ENTRY(name) {#name, sizeof(struct name)}
+
+static const FootprintEntryStruct entries[] = {
+  FOOTPRINT_ENTRY(NodeStruct),
+  FOOTPRINT_ENTRY(StateMachineStruct),
+  FOOTPRINT_ENTRY(SchedulerStruct),
+  FOOTPRINT_ENTRY(ProtocolClockStruct),
+  FOOTPRINT_ENTRY(TimeKeepingStruct),
+  FOOTPRINT_ENTRY(NetworkManagerStruct),
+  FOOTPRINT_ENTRY(MessageHandlerStruct),
+  FOOTPRINT_ENTRY(SlotMapStruct),
+  FOOTPRINT_ENTRY(NeighborhoodStruct),
+  FOOTPRINT_ENTRY(TimerWheelStruct),
+  FOOTPRINT_ENTRY(RangingManagerStruct),
+  FOOTPRINT_ENTRY(LCGStruct),
+  FOOTPRINT_ENTRY(ConfigStruct),
+  FOOTPRINT_ENTRY(DriverStruct),
+  FOOTPRINT_ENTRY(MessageStruct)
+};
+
+void Footprint_Print(FILE *file) {
+  fprintf(file, "NUM_SLOTS=%d MAX_NUM_NODES=%d MAX_NUM_PENDING_SLOTS=%d MAX_NUM_COLLISIONS_RECORDED=%d\n", 
+    NUM_SLOTS, MAX_NUM_NODES, MAX_NUM_PENDING_SLOTS, MAX_NUM_COLLISIONS_RECORDED);
+  for (size_t i = 0; i < sizeof(entries) / sizeof(entries[0]); ++i) {
+    fprintf(file, "  %-22s %8zu\n", entries[i].name, entries[i].size);
+  };
+  fprintf(file, "  %-22s %8zu (budget %zu, %.1f%%)\n", "total", (size_t) FOOTPRINT_NODE_SIZE, (size_t) FOOTPRINT_NODE_BUDGET, 
+    100.0 * FOOTPRINT_NODE_SIZE / FOOTPRINT_NODE_BUDGET);
+};
@@ -88,26 +88,27 @@ bool GuardConditions_ListeningConToListeningUncAllowed(Node node) {
     return true;
   };
 
-  int8_t ownSlotBuffer[MAX_NUM_OWN_SLOTS];
-  int8_t pendingSlotBuffer[MAX_NUM_PENDING_SLOTS];
+  SlotNum ownSlotBuffer[MAX_NUM_OWN_SLOTS];
+  SlotNum pendingSlotBuffer[MAX_NUM_PENDING_SLOTS];
   int8_t numOwn = SlotMap_GetOwnSlots(node, &ownSlotBuffer[0], MAX_NUM_OWN_SLOTS);
   int8_t numPending = SlotMap_GetPendingSlots(node, &pendingSlotBuffer[0], MAX_NUM_PENDING_SLOTS);
 
-  bool otherNodeHasReservedASlot = false;
-  for (int i = 0; i < NUM_SLOTS; ++i) {
-    if (node->slotMap->oneHopSlotsStatus[i] == OCCUPIED)
-     otherNodeHasReservedASlot = true;
-  };
-
   /** It is also allowed to transition to unconnected if this slot does not have own or pending slots (no slot acknowledged)
   *   AND if the current network was started by this node AND if no other node has reserved a slot; this likely means that no 
   *   other node has received the initial ping of this node that was supposed to start a new network (because it collided or because 
   *   no other node was in range)
   */
-  if (!((numOwn > 0)  || (numPending > 0)) && node->networkManager->currentNetworkStartedByThisNode && !otherNodeHasReservedASlot)
-    return true;
+  if ((numOwn > 0) || (numPending > 0) || !node->networkManager->currentNetworkStartedByThisNode) {
+    return false;
+  };
 
-  return false;
+  for (int i = 0; i < NUM_SLOTS; ++i) {
+    if (SlotStatus_Get(&node->slotMap->oneHopSlotsStatus, i) == OCCUPIED) {
+      return false;
+    };
+  };
+
+  return true;
 };
 
 bool GuardConditions_SendingConToListeningConAllowed(Node node) {
@@ -117,74 +118,88 @@ bool GuardConditions_SendingConToListeningConAllowed(Node node) {
 
 bool GuardConditions_RangingPollAllowed(Node node) {
   /** Guard condition for transition from connected listening to sending a poll message */
+  int64_t localTime = ProtocolClock_GetLocalTime(node->clock);
+  return (GuardConditions_EarliestRangingPollTime(node) <= localTime);
+};
 
-  uint8_t currentSlotNum = TimeKeeping_CalculateCurrentSlotNum(node);
+int64_t GuardConditions_EarliestRangingPollTime(Node node) {
+  SlotNum currentSlotNum = TimeKeeping_CalculateCurrentSlotNum(node);
   bool isOwnSlot = SlotMap_IsOwnSlot(node, currentSlotNum);
 
   // if it is not this node's slot it cannot send a poll message
   if (!isOwnSlot) {
-    return false;
+    return NODE_NO_DEADLINE;
   };
 
-  // get the neighbor that should be done ranging with next
-  int8_t nextNeighbor = Neighborhood_GetNextRangingNeighbor(node);
-  if (nextNeighbor == -1) {
-    // if this node has no neighbors at all or no neighbors that ranging is due with, sending another poll is not allowed
-    return false;
+  // ranging is due with the neighbor that was not ranged for the longest time
+  int64_t rangingTime = Neighborhood_GetNextRangingTime(node);
+  if (rangingTime == NODE_NO_DEADLINE) {
+    // if this node has no neighbors at all, sending a poll is not allowed
+    return NODE_NO_DEADLINE;
   };
-    
+
   int64_t remainingTime = TimeKeeping_GetTimeRemainingInCurrentSlot(node);
   int64_t nextScheduledTime = Scheduler_GetTimeOfNextSchedule(node);
   int64_t localTime = ProtocolClock_GetLocalTime(node->clock);
   // only do ranging if no ping is scheduled in this slot (i.e. has already been sent)
-  if (nextScheduledTime > (localTime + remainingTime)) {
-    // check if remaining time in this slot is enough to do ranging
-    // just assume ranging takes as long as the time out
-    int64_t rangingDuration = node->config->rangingTimeOut;
-
-    // make sure the node will not violate the guard period
-    if (remainingTime > (rangingDuration + node->config->guardPeriodLength))
-      return true;
+  if (nextScheduledTime <= (localTime + remainingTime)) {
+    return NODE_NO_DEADLINE;
   };
 
-  return false;
+  if (rangingTime < localTime) {
+    rangingTime = localTime;
+  };
+  // check if the time that remains in this slot when ranging is due is enough to do ranging;
+  // just assume ranging takes as long as the time out
+  int64_t rangingDuration = node->config->rangingTimeOut;
+  int64_t remainingTimeAtRanging = remainingTime - (rangingTime - localTime);
+
+  // make sure the node will not violate the guard period
+  if (remainingTimeAtRanging > (rangingDuration + node->config->guardPeriodLength)) {
+    return rangingTime;
+  };
+
+  return NODE_NO_DEADLINE;
 };
 
 bool GuardConditions_IdleingAllowed(Node node) {
   /** Guard condition for transition to idle */
+  int64_t localTime = ProtocolClock_GetLocalTime(node->clock);
+  return (GuardConditions_EarliestIdleingTime(node) <= localTime);
+};
 
+int64_t GuardConditions_EarliestIdleingTime(Node node) {
   // no idleing when number of sleep frames was set to smaller than one
   if (node->config->sleepFrames < 1) {
-    return false;
+    return NODE_NO_DEADLINE;
   };
 
-  int8_t currentSlotNum = TimeKeeping_CalculateCurrentSlotNum(node);
+  SlotNum currentSlotNum = TimeKeeping_CalculateCurrentSlotNum(node);
   // only start idleing at the beginning of a frame, i.e. in the first slot
   if (currentSlotNum != 1) {
-    return false;
+    return NODE_NO_DEADLINE;
   };
 
-  int8_t ownSlots[MAX_NUM_OWN_SLOTS];
+  SlotNum ownSlots[MAX_NUM_OWN_SLOTS];
   int8_t numOwnSlots = SlotMap_GetOwnSlots(node, &ownSlots[0], MAX_NUM_OWN_SLOTS);
   // don't idle when slot goal not met (i.e. this node has not reserved enough nodes yet)
   if (numOwnSlots != node->config->slotGoal) {
-    return false;
+    return NODE_NO_DEADLINE;
   };
 
   int64_t lastTimeIdled = TimeKeeping_GetLastTimeIdled(node);
   int64_t localTime = ProtocolClock_GetLocalTime(node->clock);
   // only idle if last idleing was more than two frames ago
   int8_t minNumFrames = 2;
-  if (localTime - lastTimeIdled < minNumFrames * node->config->frameLength) {
-    return false;
-  };  
+  int64_t idleTime = lastTimeIdled + minNumFrames * node->config->frameLength;
 
   // don't idle if a new neighbor joined within the last frame, unless it is already present in the slot maps 
   // (i.e. it was already in the network and likely only changed its position)
   int64_t lastJoinedTime = Neighborhood_GetTimeWhenNewestNeighborJoined(node);
   int8_t newestNeighborId = Neighborhood_GetNewestNeighbor(node);
 
-  if (localTime - lastJoinedTime <= node->config->frameLength) {
+  int64_t joinedFrameEnd = lastJoinedTime + node->config->frameLength + 1;
+  if (joinedFrameEnd > idleTime && joinedFrameEnd > localTime) {
     int8_t oneHopSlotIds[NUM_SLOTS]; 
     SlotMap_GetOneHopSlotMapIds(node, &oneHopSlotIds[0], NUM_SLOTS);
     int8_t twoHopSlotIds[NUM_SLOTS]; 
@@ -198,18 +213,18 @@ bool GuardConditions_IdleingAllowed(Node node) {
     
     bool neighborIsNew = (notInOneHopSlotMap && notInTwoHopSlotMap && notInThreeHopSlotMap);
     if (neighborIsNew) {
-      return false;
+      idleTime = joinedFrameEnd;
     };
   };
 
   // don't idle if there were reservations in the last frame (to make sure these are acknowledged at least once before idleing)
   int64_t lastReservationTime = SlotMap_GetLastReservationTime(node);
-  if (localTime - lastReservationTime <= node->config->frameLength) {
-    return false;
+  if (lastReservationTime + node->config->frameLength + 1 > idleTime) {
+    idleTime = lastReservationTime + node->config->frameLength + 1;
   };
 
-  // if all conditions were met, idleing is allowed
-  return true;
+  // if all conditions are met from then on, idleing is allowed
+  return (idleTime > localTime) ? idleTime : localTime;
 };
 
 bool GuardConditions_IdleToListeningConAllowedIncomingMsg(Node node, Message msg) {
@@ -237,7 +252,7 @@ bool GuardConditions_IdleToListeningConAllowedIncomingMsg(Node node, Message msg
 
   bool sendingNodeDoesNotHaveSlot = (notInOneHopSlotMap && notInTwoHopSlotMap && notInThreeHopSlotMap);
 
-  int8_t ownSlots[MAX_NUM_OWN_SLOTS];
+  SlotNum ownSlots[MAX_NUM_OWN_SLOTS];
   int8_t numOwnSlots = SlotMap_GetOwnSlots(node, &ownSlots[0], MAX_NUM_OWN_SLOTS);
 
   // node should stop idleing if either:
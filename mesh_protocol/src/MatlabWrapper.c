@@ -7,6 +7,7 @@
 Wrapper init(uint32_t seed) {
   Wrapper self = calloc(1, sizeof(WrapperStruct));
   self->numNodes = 0;
+  self->messagePool = MessagePool_Create(MESSAGE_POOL_SIZE);
 
   for(int i = 0; i < (MAX_NUM_NODES); ++i) {
       self->localTimes[i] = 0;
@@ -45,7 +46,7 @@ int8_t Wrapper_GetNumNodes(Wrapper wrapper) {
   return wrapper->numNodes;
 };
 
-Node createNode(int16_t id, Message *msgOut, bool *txFinished, bool *isReceiving, int64_t *localTime, uint32_t seed) {
+Node createNode(int16_t id, DriverTxRing txRing, bool *txFinished, bool *isReceiving, int64_t *localTime, uint32_t seed) {
   // create all the structs that hold the data of the node
   Node node = Node_Create();
   StateMachine stateMachine = StateMachine_Create();
@@ -60,10 +61,11 @@ Node createNode(int16_t id, Message *msgOut, bool *txFinished, bool *isReceiving
   LCG lcg = LCG_Create(seed);
   Config config = Config_Create();
   Driver driver = Driver_Create(txFinished, isReceiving);
+  TimerWheel timerWheel = TimerWheel_Create();
 
   // set the structs as pointers for the Node struct, so we only have to pass around the Node struct
   Node_SetDriver(node, driver);
-  Driver_SetOutMsgAddress(node, msgOut);
+  Driver_SetTxRing(node, txRing);
 
   Node_SetStateMachine(node, stateMachine);
   Node_SetScheduler(node, scheduler);
@@ -76,6 +78,7 @@ Node createNode(int16_t id, Message *msgOut, bool *txFinished, bool *isReceiving
   Node_SetRangingManager(node, rangingManager);
   Node_SetLCG(node, lcg);
   Node_SetConfig(node, config);
+  Node_SetTimerWheel(node, timerWheel);
 
   node->id = id;
   return node;
@@ -104,6 +107,233 @@ void turnOnNode(Node node) {
   StateMachine_Run(node, TURN_ON, NULL);
 };
 
+/** get the air time of a message in time tics */
+static MessageSizes getMessageSize(MessageTypes type) {
+  switch (type) {
+    case PING: ;
+      return PING_SIZE;
+    case POLL: ;
+      return POLL_SIZE;
+    case RESPONSE: ;
+      return RESPONSE_SIZE;
+    case FINAL: ;
+      return FINAL_SIZE;
+    case RESULT: ;
+      return RESULT_SIZE;
+    default: ;
+      return 0;
+  };
+};
+
+/** check if a node is in range of a sending node; a NULL connectivity matrix means every node is in range */
+static bool inRange(Wrapper wrapper, const bool *connectivity, int16_t receiverIdx, int16_t senderIdx) {
+  if (connectivity == NULL) {
+    return true;
+  };
+  return connectivity[receiverIdx + senderIdx * wrapper->numNodes];
+};
+
+static void startTransmission(Wrapper wrapper, const bool *connectivity, int16_t senderIdx, Message msg, int64_t tic, WrapperSentMessages sent);
+static void abortTransmission(Wrapper wrapper, int16_t senderIdx);
+
+/** put the messages a node just sent on the channel and append copies to the list of sent messages */
+static void handleSentMessage(Wrapper wrapper, const bool *connectivity, int16_t senderIdx, int64_t tic, WrapperSentMessages sent) {
+  Node node = wrapper->nodes[senderIdx];
+  if (!node->driver->sentMessage) {
+    return;
+  };
+  node->driver->sentMessage = false;
+
+  Message msg;
+  while ((msg = Driver_TxRingPeek(node->driver->txRing)) != NULL) {
+    startTransmission(wrapper, connectivity, senderIdx, msg, tic, sent);
+    Driver_TxRingPop(node->driver->txRing);
+  };
+};
+
+/** put a message on the channel and append a copy to the list of sent messages */
+static void startTransmission(Wrapper wrapper, const bool *connectivity, int16_t senderIdx, Message msg, int64_t tic, WrapperSentMessages sent) {
+  Node node = wrapper->nodes[senderIdx];
+  int64_t localTime = ProtocolClock_GetLocalTime(node->clock);
+
+  if (sent->num == sent->capacity) {
+    sent->capacity = (sent->capacity > 0) ? (2 * sent->capacity) : 64;
+    sent->elements = realloc(sent->elements, sent->capacity * sizeof(WrapperSentMessageStruct));
+  };
+  memcpy(&sent->elements[sent->num].msg, msg, sizeof(MessageStruct));
+  sent->elements[sent->num].sendTime = localTime;
+  sent->elements[sent->num].tic = tic;
+  ++sent->num;
+
+  // record the time when the message was sent to be able to signal when the transmission is over
+  *node->driver->txFinishedFlag = false;
+  wrapper->lastTxStartTimes[senderIdx] = localTime;
+  wrapper->lastTxMsgSize[senderIdx] = getMessageSize(msg->type);
+
+  // a node cannot receive while it is transmitting, so a reception that is currently going on is lost
+  if (wrapper->numActiveRx[senderIdx] > 0) {
+    wrapper->rxLost[senderIdx] = true;
+  };
+
+  if (wrapper->txMsg[senderIdx] != NULL) {
+    // the previous transmission of the node has not ended yet (e.g. two messages in one tic); it is cut off
+    abortTransmission(wrapper, senderIdx);
+  };
+  wrapper->txMsg[senderIdx] = Message_Acquire(wrapper->messagePool, msg->type);
+  Message_CopyContent(wrapper->txMsg[senderIdx], msg);
+
+  // every node that is in range, turned on and not transmitting itself starts receiving the transmission
+  for (int16_t i = 0; i < wrapper->numNodes; ++i) {
+    wrapper->txReaches[senderIdx][i] = false;
+
+    if (i == senderIdx || StateMachine_GetState(wrapper->nodes[i]) == OFF || !wrapper->txFinished[i]) {
+      continue;
+    };
+    if (!inRange(wrapper, connectivity, i, senderIdx)) {
+      continue;
+    };
+
+    if (wrapper->numActiveRx[i] == 0) {
+      // first transmission that reaches the node; remember when its preamble arrived
+      wrapper->rxCollided[i] = false;
+      wrapper->rxLost[i] = false;
+      wrapper->rxTimestamp[i] = ProtocolClock_GetLocalTime(wrapper->nodes[i]->clock);
+    } else {
+      // transmissions overlap at this node
+      wrapper->rxCollided[i] = true;
+    };
+
+    ++wrapper->numActiveRx[i];
+    wrapper->isReceiving[i] = true;
+    wrapper->txReaches[senderIdx][i] = true;
+    Message_Retain(wrapper->txMsg[senderIdx]);
+  };
+};
+
+/** deliver a transmission that just ended to a node it reached */
+static void deliver(Wrapper wrapper, const bool *connectivity, int16_t receiverIdx, Message txMsg, int64_t tic, WrapperSentMessages sent) {
+  --wrapper->numActiveRx[receiverIdx];
+  if (wrapper->numActiveRx[receiverIdx] > 0) {
+    // other transmissions are still reaching this node; it will get a collision when the last one ends
+    return;
+  };
+  wrapper->isReceiving[receiverIdx] = false;
+
+  if (wrapper->rxLost[receiverIdx]) {
+    return;
+  };
+
+  Message msg;
+  if (wrapper->rxCollided[receiverIdx]) {
+    msg = Message_Acquire(wrapper->messagePool, COLLISION);
+  } else {
+    // all receivers get the same message, only the timestamp is set before every delivery
+    msg = txMsg;
+    Message_Retain(msg);
+  };
+  msg->timestamp = wrapper->rxTimestamp[receiverIdx];
+
+  runStateMachineIncomingMsg(wrapper->nodes[receiverIdx], msg);
+  Message_Release(wrapper->messagePool, msg);
+
+  // the receiver may answer right away (e.g. a response to a poll)
+  handleSentMessage(wrapper, connectivity, receiverIdx, tic, sent);
+};
+
+/** signal the end of a transmission to the sender and deliver it to all nodes it reached */
+static void endTransmission(Wrapper wrapper, const bool *connectivity, int16_t senderIdx, int64_t tic, WrapperSentMessages sent) {
+  Message msg = wrapper->txMsg[senderIdx];
+  wrapper->txMsg[senderIdx] = NULL;
+
+  for (int16_t i = 0; i < wrapper->numNodes; ++i) {
+    if (!wrapper->txReaches[senderIdx][i]) {
+      continue;
+    };
+    wrapper->txReaches[senderIdx][i] = false;
+    deliver(wrapper, connectivity, i, msg, tic, sent);
+    Message_Release(wrapper->messagePool, msg);
+  };
+
+  Message_Release(wrapper->messagePool, msg);
+};
+
+/** cut off a transmission before its end; the nodes it reached stop receiving it and cannot decode their busy period, 
+* like Channel_AbortReceptions does for the receptions of a node in the Simulator */
+static void abortTransmission(Wrapper wrapper, int16_t senderIdx) {
+  Message msg = wrapper->txMsg[senderIdx];
+  wrapper->txMsg[senderIdx] = NULL;
+
+  for (int16_t i = 0; i < wrapper->numNodes; ++i) {
+    if (!wrapper->txReaches[senderIdx][i]) {
+      continue;
+    };
+    wrapper->txReaches[senderIdx][i] = false;
+    --wrapper->numActiveRx[i];
+    if (wrapper->numActiveRx[i] == 0) {
+      wrapper->isReceiving[i] = false;
+    } else {
+      // the other transmissions that still reach the node overlapped a message that cannot be decoded
+      wrapper->rxCollided[i] = true;
+    };
+    Message_Release(wrapper->messagePool, msg);
+  };
+
+  Message_Release(wrapper->messagePool, msg);
+};
+
+/** increment the local time of a node; same as functionId 9 */
+static void incrementLocalTime(Wrapper wrapper, int16_t nodeIdx) {
+  ++(wrapper->localTimes[nodeIdx]);
+
+  // check if the local time must be skewed (clock skew)
+  if (wrapper->clockSkew[nodeIdx] != 0 && wrapper->localTimes[nodeIdx] == (wrapper->lastSkewTime[nodeIdx] + abs(wrapper->clockSkew[nodeIdx]))) {
+    wrapper->lastSkewTime[nodeIdx] = wrapper->localTimes[nodeIdx];
+
+    if (wrapper->clockSkew[nodeIdx] > 0) {
+      // add an additional tic
+      ++(wrapper->localTimes[nodeIdx]);
+    } else {
+      // skip one tic
+      --(wrapper->localTimes[nodeIdx]);
+    };
+  };
+};
+
+void Wrapper_AdvanceTics(Wrapper wrapper, int64_t numTics, const bool *connectivity, WrapperSentMessages sent) {
+  for (int64_t tic = 0; tic < numTics; ++tic) {
+    // first check for every node if a prior transmission is finished now, so all messages of this tic are delivered 
+    // before any state machine runs
+    for (int16_t i = 0; i < wrapper->numNodes; ++i) {
+      int64_t localTime = ProtocolClock_GetLocalTime(wrapper->nodes[i]->clock);
+      int64_t txFinishedTime = (wrapper->lastTxStartTimes[i] + wrapper->lastTxMsgSize[i]);
+
+      if (localTime >= txFinishedTime && (wrapper->lastTxStartTimes[i] != -1)) {
+        *wrapper->nodes[i]->driver->txFinishedFlag = true;
+        if (wrapper->txMsg[i] != NULL) {
+          endTransmission(wrapper, connectivity, i, tic, sent);
+        };
+      };
+    };
+
+    // run the state machines of all nodes that are turned on
+    for (int16_t i = 0; i < wrapper->numNodes; ++i) {
+      if (StateMachine_GetState(wrapper->nodes[i]) == OFF) {
+        continue;
+      };
+      runStateMachineTimeTic(wrapper->nodes[i]);
+      handleSentMessage(wrapper, connectivity, i, tic, sent);
+    };
+
+    // increment the local times (must be done after TIME_TIC)
+    for (int16_t i = 0; i < wrapper->numNodes; ++i) {
+      if (StateMachine_GetState(wrapper->nodes[i]) == OFF) {
+        continue;
+      };
+      incrementLocalTime(wrapper, i);
+    };
+  };
+};
+
 /** this is the function that will be executed when in MATLAB the mex-file is called */
 void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
   
@@ -164,7 +394,7 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
 
     // call function
     int8_t numNodes = Wrapper_GetNumNodes(wrapper);
-    Node node = createNode(id, &wrapper->outMsg[numNodes], &wrapper->txFinished[numNodes], &wrapper->isReceiving[numNodes], &wrapper->localTimes[numNodes], wrapper->initialRandomSeeds[numNodes]);
+    Node node = createNode(id, &wrapper->txRings[numNodes], &wrapper->txFinished[numNodes], &wrapper->isReceiving[numNodes], &wrapper->localTimes[numNodes], wrapper->initialRandomSeeds[numNodes]);
     Wrapper_AddNode(wrapper, node);
     plhs[0] = mxCreateDoubleScalar(Wrapper_GetNumNodes(wrapper));
 
@@ -204,7 +434,7 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
 
     // convert message the node may have sent into Matlab message struct that can be returned
     // if no message was sent, the type will later be set to -1 to signal this to MATLAB
-    Message msg = *node->driver->msgOutAddress;
+    Message msg = Driver_TxRingPeek(node->driver->txRing);
 
     // assign field names
     char *fieldnames[11];
@@ -269,7 +499,7 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
       int32_t *dataOneHopSlotStatus; 
       dataOneHopSlotStatus = mxCalloc(NUM_SLOTS, sizeof(int32_t));
       for (int elem = 0; elem < NUM_SLOTS; ++elem) {
-        dataOneHopSlotStatus[elem] = msg->oneHopSlotStatus[elem];
+        dataOneHopSlotStatus[elem] = SlotStatus_Get(&msg->oneHopSlotStatus, elem);
       };
 
       int8_t *dataOneHopSlotIds; 
@@ -281,7 +511,7 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
       int32_t *dataTwoHopSlotStatus; 
       dataTwoHopSlotStatus = mxCalloc(NUM_SLOTS, sizeof(int32_t));
       for (int elem = 0; elem < NUM_SLOTS; ++elem) {
-        dataTwoHopSlotStatus[elem] = msg->twoHopSlotStatus[elem];
+        dataTwoHopSlotStatus[elem] = SlotStatus_Get(&msg->twoHopSlotStatus, elem);
       };
 
       int8_t *dataTwoHopSlotIds; 
@@ -328,12 +558,12 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
           break;
       };
 
-      // set the sentMessage flag to false again
-      node->driver->sentMessage = false;
+      // remove the message from the transmit ring
+      // (the content of the message has been copied to an mxStruct, so it is not needed anymore)
+      Driver_TxRingPop(node->driver->txRing);
 
-      // free the memory of the message 
-      // (the content of the message has been copied to an mxStruct, so this memory can be free'd safely)
-      free(*node->driver->msgOutAddress);
+      // the sentMessage flag stays set if the node sent more messages that will be returned by the next calls
+      node->driver->sentMessage = (node->driver->txRing->count > 0);
 
     } else {
       // set type of message to -1 to signal that no message was sent
@@ -394,7 +624,7 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
 
     // create a new msg out of the values that can be fed into the state machine
     int mtype = (int) *type;
-    Message msg = Message_Create(mtype);
+    Message msg = Message_Acquire(wrapper->messagePool, mtype);
 
     msg->senderId = (int8_t) *senderId;
     msg->timestamp = (int64_t) *timestamp;
@@ -404,17 +634,17 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
     msg->recipientId = (int8_t) *recipientId;
 
     for (mwSize i = 0; i < NUM_SLOTS; ++i) {
-      msg->oneHopSlotStatus[i] = oneHopSlotStatusValues[i];
+      SlotStatus_Set(&msg->oneHopSlotStatus, i, (SlotOccupancy) oneHopSlotStatusValues[i]);
       msg->oneHopSlotIds[i] = oneHopSlotIdsValues[i];
-      msg->twoHopSlotStatus[i] = twoHopSlotStatusValues[i];
+      SlotStatus_Set(&msg->twoHopSlotStatus, i, (SlotOccupancy) twoHopSlotStatusValues[i]);
       msg->twoHopSlotIds[i] = twoHopSlotIdsValues[i];
     };
 
     // run the state machine
     runStateMachineIncomingMsg(nodeReceiving, msg);
 
-    // free the memory of the message
-    Message_Destroy(msg);
+    // return the message to the pool
+    Message_Release(wrapper->messagePool, msg);
 
 
   /** TURN ON A NODE */
@@ -461,11 +691,14 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
     Node nodeReceiving = wrapper->nodes[nodeIdxReceiving];
 
     // create a COLLISION message
-    Message msg = Message_Create(COLLISION);
+    Message msg = Message_Acquire(wrapper->messagePool, COLLISION);
 
     // run the state machine
     runStateMachineIncomingMsg(nodeReceiving, msg);
 
+    // return the message to the pool
+    Message_Release(wrapper->messagePool, msg);
+
 
 
 
@@ -613,13 +846,13 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
     Node node = wrapper->nodes[nodeIdx];
 
     // get own slots and add them as an output argument
-    plhs[0] = mxCreateNumericMatrix(1,MAX_NUM_OWN_SLOTS,mxINT8_CLASS,mxREAL);
+    plhs[0] = mxCreateNumericMatrix(1,MAX_NUM_OWN_SLOTS,mxINT16_CLASS,mxREAL);
 
-    int8_t ownSlots[MAX_NUM_OWN_SLOTS];
+    SlotNum ownSlots[MAX_NUM_OWN_SLOTS];
     int8_t numOwn = SlotMap_GetOwnSlots(node, &ownSlots[0], MAX_NUM_OWN_SLOTS);
 
-    int8_t *dataOwnSlots; 
-    dataOwnSlots = mxCalloc(MAX_NUM_OWN_SLOTS, sizeof(int8_t));
+    int16_t *dataOwnSlots; 
+    dataOwnSlots = mxCalloc(MAX_NUM_OWN_SLOTS, sizeof(int16_t));
 
     for (int elem = 0; elem < numOwn; ++elem) {
       dataOwnSlots[elem] = ownSlots[elem];
@@ -866,7 +1099,7 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
       int32_t *dataOneHopSlotStatus; 
       dataOneHopSlotStatus = mxCalloc(NUM_SLOTS, sizeof(int32_t));
       for (int elem = 0; elem < NUM_SLOTS; ++elem) {
-        dataOneHopSlotStatus[elem] = node->slotMap->oneHopSlotsStatus[elem];
+        dataOneHopSlotStatus[elem] = SlotStatus_Get(&node->slotMap->oneHopSlotsStatus, elem);
       };
 
       int8_t *dataOneHopSlotIds; 
@@ -878,7 +1111,7 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
       int32_t *dataTwoHopSlotStatus; 
       dataTwoHopSlotStatus = mxCalloc(NUM_SLOTS, sizeof(int32_t));
       for (int elem = 0; elem < NUM_SLOTS; ++elem) {
-        dataTwoHopSlotStatus[elem] = node->slotMap->twoHopSlotsStatus[elem];
+        dataTwoHopSlotStatus[elem] = SlotStatus_Get(&node->slotMap->twoHopSlotsStatus, elem);
       };
 
       int8_t *dataTwoHopSlotIds; 
@@ -890,7 +1123,7 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
       int32_t *dataThreeHopSlotStatus; 
       dataThreeHopSlotStatus = mxCalloc(NUM_SLOTS, sizeof(int32_t));
       for (int elem = 0; elem < NUM_SLOTS; ++elem) {
-        dataThreeHopSlotStatus[elem] = node->slotMap->threeHopSlotsStatus[elem];
+        dataThreeHopSlotStatus[elem] = SlotStatus_Get(&node->slotMap->threeHopSlotsStatus, elem);
       };
 
       int8_t *dataThreeHopSlotIds; 
@@ -938,5 +1171,168 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
 
       // add the current slot num as an output argument
       plhs[0] = mxCreateDoubleScalar(TimeKeeping_CalculateCurrentSlotNum(node));
+
+
+
+
+    /** ADVANCE ALL NODES BY A NUMBER OF TIME TICS
+    *   Runs functionIds 3, 4, 6 and 9 for all nodes and the given number of time tics inside C (see Wrapper_AdvanceTics)
+    *   and returns all messages that were sent as one struct array (same fields as functionId 3 plus the local time of 
+    *   the sender when it sent the message and the tic of the batch in which it was sent); the struct array is empty 
+    *   if no message was sent.
+    *   The optional connectivity matrix is a numNodes x numNodes logical or double matrix; element (r, s) is nonzero if 
+    *   node r receives the messages of node s. If it is omitted or empty, all nodes are in range of each other.
+    */
+    } else if (functionId ==  20) { // advance all nodes
+      // check number of inputs and outputs
+      if(nrhs != 3 && nrhs != 4) {
+          mexErrMsgIdAndTxt("MyToolbox:arrayProduct:nrhs", "Three or four inputs required (function to call, wrapper address, number of time tics, connectivity matrix).");
+      };
+
+      // get the pointer to the wrapper
+      Wrapper wrapper;
+      wrapper = (long long) mxGetScalar(prhs[1]);
+
+      int64_t numTics;
+      numTics = mxGetScalar(prhs[2]);
+
+      // convert the connectivity matrix to an array of bools (column-major like in MATLAB)
+      bool connectivity[MAX_NUM_NODES * MAX_NUM_NODES];
+      bool *connectivityPtr = NULL;
+      if (nrhs == 4 && !mxIsEmpty(prhs[3])) {
+        if (mxGetM(prhs[3]) != wrapper->numNodes || mxGetN(prhs[3]) != wrapper->numNodes) {
+          mexErrMsgIdAndTxt("MyToolbox:arrayProduct:nrhs", "Connectivity matrix must be of size numNodes x numNodes.");
+        };
+
+        int32_t numElements = wrapper->numNodes * wrapper->numNodes;
+        if (mxIsLogical(prhs[3])) {
+          mxLogical *values = mxGetLogicals(prhs[3]);
+          for (int32_t elem = 0; elem < numElements; ++elem) {
+            connectivity[elem] = values[elem];
+          };
+        } else {
+          double *values = mxGetPr(prhs[3]);
+          for (int32_t elem = 0; elem < numElements; ++elem) {
+            connectivity[elem] = (values[elem] != 0);
+          };
+        };
+        connectivityPtr = &connectivity[0];
+      };
+
+      // run the simulation
+      WrapperSentMessagesStruct sent = {NULL, 0, 0};
+      Wrapper_AdvanceTics(wrapper, numTics, connectivityPtr, &sent);
+
+      // convert all sent messages into one Matlab struct array
+      const char *fieldnames[13] = {"type", "senderId", "timestamp", "networkId", "networkAge", "timeSinceFrameStart", 
+        "oneHopSlotStatus", "oneHopSlotIds", "twoHopSlotStatus", "twoHopSlotIds", "recipientId", "sendTime", "tic"};
+      plhs[0] = mxCreateStructMatrix(1, sent.num, 13, fieldnames);
+
+      for (int32_t idx = 0; idx < sent.num; ++idx) {
+        Message msg = &sent.elements[idx].msg;
+
+        mxArray *oneHopSlotStatus = mxCreateNumericMatrix(1,NUM_SLOTS,mxINT32_CLASS,mxREAL);
+        mxArray *oneHopSlotIds = mxCreateNumericMatrix(1,NUM_SLOTS,mxINT8_CLASS,mxREAL);
+        mxArray *twoHopSlotStatus = mxCreateNumericMatrix(1,NUM_SLOTS,mxINT32_CLASS,mxREAL);
+        mxArray *twoHopSlotIds = mxCreateNumericMatrix(1,NUM_SLOTS,mxINT8_CLASS,mxREAL);
+
+        mxInt32 *dataOneHopSlotStatus = mxGetInt32s(oneHopSlotStatus);
+        mxInt8 *dataOneHopSlotIds = mxGetInt8s(oneHopSlotIds);
+        mxInt32 *dataTwoHopSlotStatus = mxGetInt32s(twoHopSlotStatus);
+        mxInt8 *dataTwoHopSlotIds = mxGetInt8s(twoHopSlotIds);
+        for (int elem = 0; elem < NUM_SLOTS; ++elem) {
+          dataOneHopSlotStatus[elem] = SlotStatus_Get(&msg->oneHopSlotStatus, elem);
+          dataOneHopSlotIds[elem] = msg->oneHopSlotIds[elem];
+          dataTwoHopSlotStatus[elem] = SlotStatus_Get(&msg->twoHopSlotStatus, elem);
+          dataTwoHopSlotIds[elem] = msg->twoHopSlotIds[elem];
+        };
+
+        mxSetFieldByNumber(plhs[0],idx,0, mxCreateDoubleScalar(msg->type));
+        mxSetFieldByNumber(plhs[0],idx,1, mxCreateDoubleScalar(msg->senderId));
+        mxSetFieldByNumber(plhs[0],idx,2, mxCreateDoubleScalar(msg->timestamp));
+        mxSetFieldByNumber(plhs[0],idx,3, mxCreateDoubleScalar(msg->networkId));
+        mxSetFieldByNumber(plhs[0],idx,4, mxCreateDoubleScalar(msg->networkAge));
+        mxSetFieldByNumber(plhs[0],idx,5, mxCreateDoubleScalar(msg->timeSinceFrameStart));
+        mxSetFieldByNumber(plhs[0],idx,6, oneHopSlotStatus);
+        mxSetFieldByNumber(plhs[0],idx,7, oneHopSlotIds);
+        mxSetFieldByNumber(plhs[0],idx,8, twoHopSlotStatus);
+        mxSetFieldByNumber(plhs[0],idx,9, twoHopSlotIds);
+        mxSetFieldByNumber(plhs[0],idx,10, mxCreateDoubleScalar(msg->recipientId));
+        mxSetFieldByNumber(plhs[0],idx,11, mxCreateDoubleScalar(sent.elements[idx].sendTime));
+        mxSetFieldByNumber(plhs[0],idx,12, mxCreateDoubleScalar(sent.elements[idx].tic));
+      };
+
+      free(sent.elements);
+
+
+
+
+    /** GET A SNAPSHOT OF ALL NODES
+    *   Returns one struct with the state of all nodes (see Snapshot.h); every field is a matrix with one row per node 
+    *   (in the order the nodes were created), so the state of all nodes only takes one call instead of one call per 
+    *   node and value (functionIds 11 - 19).
+    */
+    } else if (functionId ==  21) { // get snapshot
+      // check number of inputs and outputs
+      if(nrhs != 2) {
+          mexErrMsgIdAndTxt("MyToolbox:arrayProduct:nrhs", "Two inputs required (function to call, wrapper address).");
+      };
+
+      // get the pointer to the wrapper
+      Wrapper wrapper;
+      wrapper = (long long) mxGetScalar(prhs[1]);
+
+      int16_t numNodes = wrapper->numNodes;
+
+      const char *fieldnames[13] = {"state", "localTime", "networkId", "networkAge", "currentSlot", "ownSlots", "pendingSlots", 
+        "oneHopStatus", "oneHopIds", "twoHopStatus", "twoHopIds", "threeHopStatus", "threeHopIds"};
+      plhs[0] = mxCreateStructMatrix(1, 1, 13, fieldnames);
+
+      mxArray *state = mxCreateNumericMatrix(numNodes,1,mxINT8_CLASS,mxREAL);
+      mxArray *localTime = mxCreateNumericMatrix(numNodes,1,mxINT64_CLASS,mxREAL);
+      mxArray *networkId = mxCreateNumericMatrix(numNodes,1,mxUINT8_CLASS,mxREAL);
+      mxArray *networkAge = mxCreateNumericMatrix(numNodes,1,mxINT64_CLASS,mxREAL);
+      mxArray *currentSlot = mxCreateNumericMatrix(numNodes,1,mxINT16_CLASS,mxREAL);
+      mxArray *ownSlots = mxCreateNumericMatrix(numNodes,MAX_NUM_OWN_SLOTS,mxINT16_CLASS,mxREAL);
+      mxArray *pendingSlots = mxCreateNumericMatrix(numNodes,MAX_NUM_PENDING_SLOTS,mxINT16_CLASS,mxREAL);
+      mxArray *oneHopSlotStatus = mxCreateNumericMatrix(numNodes,NUM_SLOTS,mxINT32_CLASS,mxREAL);
+      mxArray *oneHopSlotIds = mxCreateNumericMatrix(numNodes,NUM_SLOTS,mxINT8_CLASS,mxREAL);
+      mxArray *twoHopSlotStatus = mxCreateNumericMatrix(numNodes,NUM_SLOTS,mxINT32_CLASS,mxREAL);
+      mxArray *twoHopSlotIds = mxCreateNumericMatrix(numNodes,NUM_SLOTS,mxINT8_CLASS,mxREAL);
+      mxArray *threeHopSlotStatus = mxCreateNumericMatrix(numNodes,NUM_SLOTS,mxINT32_CLASS,mxREAL);
+      mxArray *threeHopSlotIds = mxCreateNumericMatrix(numNodes,NUM_SLOTS,mxINT8_CLASS,mxREAL);
+
+      // let the snapshot write directly into the data of the mxArrays (MATLAB matrices are column-major as well)
+      SnapshotStruct snapshot;
+      snapshot.numNodes = numNodes;
+      snapshot.state = mxGetInt8s(state);
+      snapshot.localTime = mxGetInt64s(localTime);
+      snapshot.networkId = mxGetUint8s(networkId);
+      snapshot.networkAge = mxGetInt64s(networkAge);
+      snapshot.currentSlot = mxGetInt16s(currentSlot);
+      snapshot.ownSlots = mxGetInt16s(ownSlots);
+      snapshot.pendingSlots = mxGetInt16s(pendingSlots);
+      snapshot.oneHopSlotsStatus = mxGetInt32s(oneHopSlotStatus);
+      snapshot.oneHopSlotsIds = mxGetInt8s(oneHopSlotIds);
+      snapshot.twoHopSlotsStatus = mxGetInt32s(twoHopSlotStatus);
+      snapshot.twoHopSlotsIds = mxGetInt8s(twoHopSlotIds);
+      snapshot.threeHopSlotsStatus = mxGetInt32s(threeHopSlotStatus);
+      snapshot.threeHopSlotsIds = mxGetInt8s(threeHopSlotIds);
+
+      Snapshot_Fill(&snapshot, &wrapper->nodes[0], numNodes);
+
+      mxSetFieldByNumber(plhs[0],0,0, state);
+      mxSetFieldByNumber(plhs[0],0,1, localTime);
+      mxSetFieldByNumber(plhs[0],0,2, networkId);
+      mxSetFieldByNumber(plhs[0],0,3, networkAge);
+      mxSetFieldByNumber(plhs[0],0,4, currentSlot);
+      mxSetFieldByNumber(plhs[0],0,5, ownSlots);
+      mxSetFieldByNumber(plhs[0],0,6, pendingSlots);
+      mxSetFieldByNumber(plhs[0],0,7, oneHopSlotStatus);
+      mxSetFieldByNumber(plhs[0],0,8, oneHopSlotIds);
+      mxSetFieldByNumber(plhs[0],0,9, twoHopSlotStatus);
+      mxSetFieldByNumber(plhs[0],0,10, twoHopSlotIds);
+      mxSetFieldByNumber(plhs[0],0,11, threeHopSlotStatus);
+      mxSetFieldByNumber(plhs[0],0,12, threeHopSlotIds);
   };
 };
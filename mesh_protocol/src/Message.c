@@ -38,6 +38,8 @@
 
 #include "../include/Message.h"
 
+#include <string.h>
+
 // constructor and destructor dynamically allocate memory and are therefore not used on hardware
 
 Message Message_Create(MessageTypes t) {
@@ -51,3 +53,69 @@ Message Message_Create(MessageTypes t) {
 void Message_Destroy(Message self) {
   free(self);
 };
+
+MessagePool MessagePool_Create(int16_t capacity) {
+  MessagePool pool = calloc(1, sizeof(MessagePoolStruct));
+  pool->capacity = capacity;
+  pool->msgs = calloc(capacity, sizeof(MessageStruct));
+  pool->nextFree = calloc(capacity, sizeof(int16_t));
+
+  // all messages are free in the beginning
+  for (int16_t i = 0; i < capacity; ++i) {
+    pool->nextFree[i] = (i + 1 < capacity) ? (i + 1) : -1;
+  };
+  pool->freeHead = (capacity > 0) ? 0 : -1;
+
+  return pool;
+};
+
+void MessagePool_Destroy(MessagePool pool) {
+  free(pool->msgs);
+  free(pool->nextFree);
+  free(pool);
+};
+
+Message Message_Acquire(MessagePool pool, MessageTypes t) {
+  ++pool->numAcquired;
+
+  Message self;
+  if (pool->freeHead != -1) {
+    int16_t idx = pool->freeHead;
+    pool->freeHead = pool->nextFree[idx];
+    self = &pool->msgs[idx];
+    memset(self, 0, sizeof(MessageStruct));
+  } else {
+    // pool is empty; fall back to the heap so the simulation can go on
+    ++pool->numHeapAllocations;
+    self = calloc(1, sizeof(MessageStruct));
+  };
+
+  self->type = t;
+  self->refCount = 1;
+  return self;
+};
+
+void Message_Retain(Message self) {
+  ++self->refCount;
+};
+
+void Message_Release(MessagePool pool, Message self) {
+  --self->refCount;
+  if (self->refCount > 0) {
+    return;
+  };
+
+  if (self >= pool->msgs && self < (pool->msgs + pool->capacity)) {
+    int16_t idx = self - pool->msgs;
+    pool->nextFree[idx] = pool->freeHead;
+    pool->freeHead = idx;
+  } else {
+    free(self);
+  };
+};
+
+void Message_CopyContent(Message dst, Message src) {
+  uint16_t refCount = dst->refCount;
+  memcpy(dst, src, sizeof(MessageStruct));
+  dst->refCount = refCount;
+};
@@ -147,7 +147,7 @@ void MessageHandler_SendPing(Node node) {
   // transmit message via driver
   Driver_TransmitPing(node, msg);
 
-  int8_t currentSlot = TimeKeeping_CalculateCurrentSlotNum(node);
+  SlotNum currentSlot = TimeKeeping_CalculateCurrentSlotNum(node);
   bool isOwn = SlotMap_IsOwnSlot(node, currentSlot);
   bool isPending = SlotMap_IsPendingSlot(node, currentSlot);
 
@@ -219,6 +219,7 @@ static void joinNetwork(Node node, Message msg) {
   // set the network status and ID
   NetworkManager_SetNetworkStatus(node, CONNECTED);
   NetworkManager_SetNetworkId(node, msg->networkId);
+  TRACE_RECORD(node, TRACE_JOIN, 0, msg->senderId, msg->networkId);
   int64_t networkAge = TimeKeeping_CalculateNetworkAgeFromMsg(node, msg);
 
   // save the age of the network at the time when this node joined
@@ -232,16 +233,18 @@ static void joinNetwork(Node node, Message msg) {
   TimeKeeping_SetFrameStartTimeForLastPreamble(node, msg);
 
   // release possible own and pending slots when joining a new network, because these are not valid anymore
-  int8_t ownSlotsBuffer[NUM_SLOTS];
+  SlotNum ownSlotsBuffer[NUM_SLOTS];
   int8_t numOwn = SlotMap_GetOwnSlots(node, &ownSlotsBuffer[0], NUM_SLOTS);
   for (int i = 0; i < numOwn; ++i) {
     SlotMap_ReleaseOwnSlot(node, ownSlotsBuffer[i]);
+    TRACE_RECORD(node, TRACE_SLOT_RELEASED, 0, 1, ownSlotsBuffer[i]);
   };
 
-  int8_t pendingSlotsBuffer[NUM_SLOTS];
+  SlotNum pendingSlotsBuffer[NUM_SLOTS];
   int8_t numPending = SlotMap_GetPendingSlots(node, &pendingSlotsBuffer[0], NUM_SLOTS);
   for (int i = 0; i < numPending; ++i) {
     SlotMap_ReleasePendingSlot(node, pendingSlotsBuffer[i]);
+    TRACE_RECORD(node, TRACE_SLOT_RELEASED, 0, 0, pendingSlotsBuffer[i]);
   };
 
 #if DEBUG_VERBOSE
@@ -254,46 +257,48 @@ static void updateSlots(Node node, Message msg) {
   SlotMap_UpdatePendingSlotAcks(node, msg);
   
   // add pending slots that were acknowledged by all required nodes to own slots
-  int8_t acknowledgedPendingSlots[MAX_NUM_PENDING_SLOTS];
+  SlotNum acknowledgedPendingSlots[MAX_NUM_PENDING_SLOTS];
   int8_t numAcked = SlotMap_GetAcknowledgedPendingSlots(node, &acknowledgedPendingSlots[0], MAX_NUM_PENDING_SLOTS);
   for(int i = 0; i < numAcked; ++i) {
     SlotMap_ChangePendingToOwn(node, acknowledgedPendingSlots[i]);
   };
   
   // check if own slots were reported as colliding by the sending node
-  int8_t collidingOwnSlots[MAX_NUM_OWN_SLOTS];
+  SlotNum collidingOwnSlots[MAX_NUM_OWN_SLOTS];
   int8_t numCollidingOwn = SlotMap_CheckOwnSlotsForCollisions(node, msg, &collidingOwnSlots[0], MAX_NUM_OWN_SLOTS);
 
   // release colliding own slots
   for (int i = 0; i < numCollidingOwn; ++i) {
   #ifdef SIMULATION
-    mexPrintf("Node %" PRIu8 " releases own slot %" PRId8 "\n", node->id, collidingOwnSlots[i]);
+    mexPrintf("Node %" PRIu8 " releases own slot %" PRId16 "\n", node->id, collidingOwnSlots[i]);
   #endif
     SlotMap_ReleaseOwnSlot(node, collidingOwnSlots[i]);
+    TRACE_RECORD(node, TRACE_SLOT_RELEASED, 0, 1, collidingOwnSlots[i]);
   };
 
   // check if pending slots were reported as colliding by the sending node
-  int8_t collidingPendingSlots[MAX_NUM_PENDING_SLOTS];
+  SlotNum collidingPendingSlots[MAX_NUM_PENDING_SLOTS];
   int8_t numCollidingPending = SlotMap_CheckPendingSlotsForCollisions(node, msg, &collidingPendingSlots[0], MAX_NUM_PENDING_SLOTS);
   // release colliding pending slots
   for (int i = 0; i < numCollidingPending; ++i) {
   #ifdef SIMULATION
-    mexPrintf("Node %" PRIu8 " releases pending slot %" PRId8 "\n", node->id, collidingPendingSlots[i]);
+    mexPrintf("Node %" PRIu8 " releases pending slot %" PRId16 "\n", node->id, collidingPendingSlots[i]);
   #endif
     SlotMap_ReleasePendingSlot(node, collidingPendingSlots[i]);
+    TRACE_RECORD(node, TRACE_SLOT_RELEASED, 0, 0, collidingPendingSlots[i]);
   };
 
   // update the internal slot maps of this nodes with the information in the message
-  uint8_t currentSlot = TimeKeeping_CalculateCurrentSlotNum(node);
+  SlotNum currentSlot = TimeKeeping_CalculateCurrentSlotNum(node);
   SlotMap_UpdateOneHopSlotMap(node, msg, currentSlot);
   
   SlotMap_UpdateTwoHopSlotMap(node, msg);
   SlotMap_UpdateThreeHopSlotMap(node, msg);
 
   // cancel the next schedule if the corresponding slot was released 
-  int8_t nextScheduledSlot = Scheduler_GetSlotOfNextSchedule(node);
-  int16_t idxCollidingOwn = Util_Int8tArrayFindElement(&collidingOwnSlots[0], nextScheduledSlot, numCollidingOwn);
-  int16_t idxCollidingPending = Util_Int8tArrayFindElement(&collidingPendingSlots[0], nextScheduledSlot, numCollidingPending);
+  SlotNum nextScheduledSlot = Scheduler_GetSlotOfNextSchedule(node);
+  int16_t idxCollidingOwn = Util_Int16tArrayFindElement(&collidingOwnSlots[0], nextScheduledSlot, numCollidingOwn);
+  int16_t idxCollidingPending = Util_Int16tArrayFindElement(&collidingPendingSlots[0], nextScheduledSlot, numCollidingPending);
 
   bool nextScheduledIsCollidingOwn = false;
   bool nextScheduledIsCollidingPending = false;
@@ -313,11 +318,11 @@ static bool createPingMessage(Node node, Message msg) {
   msg->senderId = node->id;
 
   // add one hop and two hop slot maps to the message so receiving nodes 
-  // get information about their two and three hop neighbors
-  SlotMap_GetOneHopSlotMapStatus(node, &msg->oneHopSlotStatus[0], NUM_SLOTS);
+  // get information about their two and three hop neighbors; the status is copied packed (2 bits per slot) as it is stored
+  SlotMap_GetOneHopSlotMapPackedStatus(node, &msg->oneHopSlotStatus);
   SlotMap_GetOneHopSlotMapIds(node, &msg->oneHopSlotIds[0], NUM_SLOTS);
 
-  SlotMap_GetTwoHopSlotMapStatus(node, &msg->twoHopSlotStatus[0], NUM_SLOTS);
+  SlotMap_GetTwoHopSlotMapPackedStatus(node, &msg->twoHopSlotStatus);
   SlotMap_GetTwoHopSlotMapIds(node, &msg->twoHopSlotIds[0], NUM_SLOTS);
 
   // add the time since the start of the current frame to the message so receiving nodes can synchronize
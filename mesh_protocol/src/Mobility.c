@@ -0,0 +1,251 @@
+/* Copyright (c) 2022-23 California Institute of Technology (Caltech).
+ * U.S. Government sponsorship acknowledged.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Caltech nor its operating division,
+ *   the Jet Propulsion Laboratory, nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Open Source License Approved by Caltech/JPL
+ *
+ * APACHE LICENSE, VERSION 2.0
+ * - Text version: https://www.apache.org/licenses/LICENSE-2.0.txt
+ * - SPDX short identifier: Apache-2.0
+ * - OSI Approved License: https://opensource.org/licenses/Apache-2.0
+ */
+
+#include "../include/Mobility.h"
+
+static void setModel(Mobility self, int16_t nodeIdx, MobilityModels model);
+static void appendWaypoint(MobilityNode node, int64_t time, double x, double y);
+static int compareWaypoints(const void *a, const void *b);
+static void nextLeg(MobilityNode node);
+static void interpolate(MobilityWaypoint from, MobilityWaypoint to, int64_t time, double *x, double *y);
+static double uniform(uint32_t *state, double min, double max);
+
+Mobility Mobility_Create(int16_t capacity, uint32_t seed) {
+  Mobility self = calloc(1, sizeof(MobilityStruct));
+  self->capacity = capacity;
+  self->nodes = calloc(capacity, sizeof(MobilityNodeStruct));
+  self->numMoving = 0;
+  self->seed = seed;
+
+  for (int16_t i = 0; i < capacity; ++i) {
+    self->nodes[i].model = MOBILITY_STATIC;
+  };
+  return self;
+};
+
+void Mobility_Destroy(Mobility self) {
+  for (int16_t i = 0; i < self->capacity; ++i) {
+    free(self->nodes[i].path);
+  };
+  free(self->nodes);
+  free(self);
+};
+
+void Mobility_SetRandomWaypoint(Mobility self, int16_t nodeIdx, double x, double y, double minX, double minY, double maxX, 
+  double maxY, double minSpeed, double maxSpeed, int64_t pauseTime) {
+
+  setModel(self, nodeIdx, MOBILITY_RANDOM_WAYPOINT);
+  MobilityNode node = &self->nodes[nodeIdx];
+  node->minX = minX;
+  node->minY = minY;
+  node->maxX = maxX;
+  node->maxY = maxY;
+  node->minSpeed = minSpeed;
+  node->maxSpeed = maxSpeed;
+  node->pauseTime = pauseTime;
+
+  // every node gets its own sequence, so the movement does not depend on the order of the lookups (xorshift must not start at 0)
+  node->randomState = (self->seed ^ (0x9E3779B9u * (uint32_t) (nodeIdx + 1))) | 1u;
+
+  // the node starts its first leg right away
+  node->to.time = 0;
+  node->to.x = x;
+  node->to.y = y;
+  node->pauseUntil = 0;
+  nextLeg(node);
+};
+
+void Mobility_SetPath(Mobility self, int16_t nodeIdx, const MobilityWaypointStruct *waypoints, int32_t numWaypoints) {
+  setModel(self, nodeIdx, MOBILITY_PATH);
+  MobilityNode node = &self->nodes[nodeIdx];
+  node->numWaypoints = 0;
+  node->cursor = 0;
+  for (int32_t i = 0; i < numWaypoints; ++i) {
+    appendWaypoint(node, waypoints[i].time, waypoints[i].x, waypoints[i].y);
+  };
+  qsort(node->path, node->numWaypoints, sizeof(MobilityWaypointStruct), compareWaypoints);
+};
+
+int32_t Mobility_ReadPaths(Mobility self, FILE *file) {
+  char line[256];
+  int32_t numRead = 0;
+
+  while (fgets(line, sizeof(line), file) != NULL) {
+    if (line[0] == '#' || strspn(line, " \t\r\n") == strlen(line)) {
+      continue;
+    };
+
+    // commas are treated like spaces, so CSV files can be read as well
+    for (char *c = line; *c != '\0'; ++c) {
+      if (*c == ',') {
+        *c = ' ';
+      };
+    };
+
+    int nodeIdx;
+    long long time;
+    double x, y;
+    if (sscanf(line, "%d %lld %lf %lf", &nodeIdx, &time, &x, &y) != 4 || nodeIdx < 0 || nodeIdx >= self->capacity) {
+      return -1;
+    };
+
+    if (self->nodes[nodeIdx].model != MOBILITY_PATH) {
+      setModel(self, nodeIdx, MOBILITY_PATH);
+      self->nodes[nodeIdx].numWaypoints = 0;
+    };
+    appendWaypoint(&self->nodes[nodeIdx], time, x, y);
+    ++numRead;
+  };
+
+  // the files do not need to be ordered by time
+  for (int16_t i = 0; i < self->capacity; ++i) {
+    MobilityNode node = &self->nodes[i];
+    if (node->model == MOBILITY_PATH) {
+      qsort(node->path, node->numWaypoints, sizeof(MobilityWaypointStruct), compareWaypoints);
+      node->cursor = 0;
+    };
+  };
+  return numRead;
+};
+
+bool Mobility_IsMoving(Mobility self, int16_t nodeIdx) {
+  return (self->nodes[nodeIdx].model != MOBILITY_STATIC);
+};
+
+void Mobility_GetPosition(Mobility self, int16_t nodeIdx, int64_t time, double *x, double *y) {
+  MobilityNode node = &self->nodes[nodeIdx];
+
+  switch (node->model) {
+    case MOBILITY_RANDOM_WAYPOINT:
+      while (time >= node->pauseUntil) {
+        nextLeg(node);
+      };
+      interpolate(&node->from, &node->to, time, x, y);
+      return;
+
+    case MOBILITY_PATH:
+      if (node->numWaypoints == 0) {
+        return;
+      };
+      if (time < node->path[node->cursor].time) {
+        // only happens if the time went back (or before the first waypoint); start over
+        node->cursor = 0;
+      };
+      while (node->cursor + 1 < node->numWaypoints && node->path[node->cursor + 1].time <= time) {
+        ++node->cursor;
+      };
+      if (node->cursor + 1 == node->numWaypoints || time < node->path[node->cursor].time) {
+        // after the last or before the first waypoint
+        *x = node->path[node->cursor].x;
+        *y = node->path[node->cursor].y;
+        return;
+      };
+      interpolate(&node->path[node->cursor], &node->path[node->cursor + 1], time, x, y);
+      return;
+
+    default:
+      return;
+  };
+};
+
+static void setModel(Mobility self, int16_t nodeIdx, MobilityModels model) {
+  bool wasMoving = Mobility_IsMoving(self, nodeIdx);
+  self->nodes[nodeIdx].model = model;
+  self->numMoving += (model != MOBILITY_STATIC) - wasMoving;
+};
+
+static void appendWaypoint(MobilityNode node, int64_t time, double x, double y) {
+  if (node->numWaypoints == node->pathCapacity) {
+    node->pathCapacity = (node->pathCapacity > 0) ? (2 * node->pathCapacity) : 16;
+    node->path = realloc(node->path, node->pathCapacity * sizeof(MobilityWaypointStruct));
+  };
+
+  MobilityWaypoint waypoint = &node->path[node->numWaypoints];
+  waypoint->time = time;
+  waypoint->x = x;
+  waypoint->y = y;
+  ++node->numWaypoints;
+};
+
+static int compareWaypoints(const void *a, const void *b) {
+  int64_t timeA = ((const MobilityWaypointStruct *) a)->time;
+  int64_t timeB = ((const MobilityWaypointStruct *) b)->time;
+  return (timeA > timeB) - (timeA < timeB);
+};
+
+static void nextLeg(MobilityNode node) {
+  // the new leg starts where the last one ended, when the pause is over
+  node->from.time = node->pauseUntil;
+  node->from.x = node->to.x;
+  node->from.y = node->to.y;
+
+  node->to.x = uniform(&node->randomState, node->minX, node->maxX);
+  node->to.y = uniform(&node->randomState, node->minY, node->maxY);
+  double speed = uniform(&node->randomState, node->minSpeed, node->maxSpeed);
+  double length = hypot(node->to.x - node->from.x, node->to.y - node->from.y);
+
+  // every leg takes at least one tic, so the lookup always makes progress
+  int64_t duration = (int64_t) ceil(length / speed);
+  node->to.time = node->from.time + ((duration > 0) ? duration : 1);
+  node->pauseUntil = node->to.time + node->pauseTime;
+};
+
+static void interpolate(MobilityWaypoint from, MobilityWaypoint to, int64_t time, double *x, double *y) {
+  if (time >= to->time || to->time <= from->time) {
+    *x = to->x;
+    *y = to->y;
+    return;
+  };
+  if (time <= from->time) {
+    *x = from->x;
+    *y = from->y;
+    return;
+  };
+
+  double fraction = (double) (time - from->time) / (double) (to->time - from->time);
+  *x = from->x + fraction * (to->x - from->x);
+  *y = from->y + fraction * (to->y - from->y);
+};
+
+static double uniform(uint32_t *state, double min, double max) {
+  // xorshift32, same generator as the random placement of the sweep runner
+  *state ^= *state << 13;
+  *state ^= *state >> 17;
+  *state ^= *state << 5;
+  return min + (max - min) * ((double) *state / 4294967296.0);
+};
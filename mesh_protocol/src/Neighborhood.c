@@ -39,6 +39,7 @@
 #include "../include/Neighborhood.h"
 
 static bool removeNeighbor(Node node, int8_t neighborId);
+static void scheduleNeighborTimer(Node node, int16_t idx);
 
 Neighborhood Neighborhood_Create() {
   Neighborhood self = calloc(1, sizeof(NeighborhoodStruct));
@@ -69,9 +70,11 @@ void Neighborhood_AddOrUpdateOneHopNeighbor(Node node, int8_t id) {
     node->neighborhood->oneHopNeighborsLastRanging[currentNumNeighbors] = 0;
 
     ++node->neighborhood->numOneHopNeighbors;
+    scheduleNeighborTimer(node, currentNumNeighbors);
   } else {
     // already in array, so update last seen
     node->neighborhood->oneHopNeighborsLastSeen[idx] = localTime;
+    scheduleNeighborTimer(node, idx);
   };
 };
 
@@ -93,11 +96,23 @@ void Neighborhood_RemoveAbsentNeighbors(Node node) {
   int8_t numAbsentNeighbors = 0;
   int64_t localTime = ProtocolClock_GetLocalTime(node->clock);
   
+  // only the neighbors whose timers have fired are checked, in the order of the neighbors array; a timer may fire early, 
+  // so it is scheduled again if the neighbor is not absent yet
+  int16_t firedTimers[MAX_NUM_NODES - 1];
+  int16_t numFired = TimerWheel_PopExpired(node->timerWheel, localTime, TIMER_WHEEL_NEIGHBORS, MAX_NUM_NODES - 1, &firedTimers[0]);
+  Util_SortInt16tArray(&firedTimers[0], numFired);
+
   // find absent neighbors (neighbors that have not been seen for a time longer than the absentNeighborTimeOut)
-  for(int i = 0; i < node->neighborhood->numOneHopNeighbors; ++i) {
+  for(int k = 0; k < numFired; ++k) {
+    int i = firedTimers[k] - TIMER_WHEEL_NEIGHBORS;
+    if (i >= node->neighborhood->numOneHopNeighbors) {
+      continue;
+    };
     if(localTime > (node->neighborhood->oneHopNeighborsLastSeen[i] + node->config->absentNeighborTimeOut)) {
       absentNeighbors[numAbsentNeighbors] = node->neighborhood->oneHopNeighbors[i];
       ++numAbsentNeighbors;
+    } else {
+      scheduleNeighborTimer(node, i);
     };
   };
 
@@ -108,15 +123,30 @@ void Neighborhood_RemoveAbsentNeighbors(Node node) {
 
 };
 
+void Neighborhood_RescheduleTimers(Node node) {
+  for (int16_t i = 0; i < (MAX_NUM_NODES - 1); ++i) {
+    if (i < node->neighborhood->numOneHopNeighbors) {
+      scheduleNeighborTimer(node, i);
+    } else {
+      TimerWheel_Cancel(node->timerWheel, TIMER_WHEEL_NEIGHBORS + i);
+    };
+  };
+};
+
 void Neighborhood_UpdateRanging(Node node, int8_t id, int64_t updateTime, double distance) {
   // update the time when the last time ranging was done with this particular neighbor
 
   // find the index of the neighbor in the array
   int16_t idx = Util_Int8tArrayFindElement(&node->neighborhood->oneHopNeighbors[0], id, node->neighborhood->numOneHopNeighbors);
+  if (idx == -1) {
+    // the result is from a node that is not (or no longer) a one hop neighbor
+    return;
+  };
   // update time
   node->neighborhood->oneHopNeighborsLastRanging[idx] = updateTime;
   // update distance
   node->neighborhood->oneHopNeighborsLastDistance[idx] = distance;
+  TRACE_RECORD(node, TRACE_RANGING_RESULT, 0, id, (int32_t) (distance * 1000.0));
 };
 
 int8_t Neighborhood_GetNextRangingNeighbor(Node node) {
@@ -126,10 +156,9 @@ int8_t Neighborhood_GetNextRangingNeighbor(Node node) {
   };
 
   int16_t minIdx = Util_Int64tFindIdxOfMinimumInArray(&node->neighborhood->oneHopNeighborsLastRanging[0], node->neighborhood->numOneHopNeighbors);
-  int64_t lastRangingTime = node->neighborhood->oneHopNeighborsLastRanging[minIdx]; 
 
   int64_t localTime = ProtocolClock_GetLocalTime(node->clock);
-  if (localTime < (lastRangingTime + node->config->rangingRefreshTime)) {
+  if (localTime < Neighborhood_GetNextRangingTime(node)) {
     // last ranging was too recent, so return -1 to indicate that no poll should be sent
     return -1;
   };
@@ -137,6 +166,17 @@ int8_t Neighborhood_GetNextRangingNeighbor(Node node) {
   return node->neighborhood->oneHopNeighbors[minIdx];
 };
 
+int64_t Neighborhood_GetNextRangingTime(Node node) {
+  if (node->neighborhood->numOneHopNeighbors == 0) {
+    return NODE_NO_DEADLINE;
+  };
+
+  // ranging is due when the oldest ranging value is older than the refresh time
+  int16_t minIdx = Util_Int64tFindIdxOfMinimumInArray(&node->neighborhood->oneHopNeighborsLastRanging[0], node->neighborhood->numOneHopNeighbors);
+  int64_t lastRangingTime = node->neighborhood->oneHopNeighborsLastRanging[minIdx];
+  return lastRangingTime + node->config->rangingRefreshTime;
+};
+
 int8_t Neighborhood_GetNewestNeighbor(Node node) {
   // find index of the neighbor that was added last
   int16_t idxNewestNeighbor = Util_Int64tFindIdxOfMaximumInArray(&node->neighborhood->oneHopNeighborsJoinedTime[0], node->neighborhood->numOneHopNeighbors);
@@ -176,6 +216,15 @@ static bool removeNeighbor(Node node, int8_t neighborId) {
   node->neighborhood->oneHopNeighborsLastSeen[idx] = node->neighborhood->oneHopNeighborsLastSeen[newNumNeighbors];
   node->neighborhood->oneHopNeighborsLastRanging[idx] = node->neighborhood->oneHopNeighborsLastRanging[newNumNeighbors];
   node->neighborhood->oneHopNeighborsLastDistance[idx] = node->neighborhood->oneHopNeighborsLastDistance[newNumNeighbors];
+  TimerWheel_Cancel(node->timerWheel, TIMER_WHEEL_NEIGHBORS + newNumNeighbors);
+  if (idx < newNumNeighbors) {
+    scheduleNeighborTimer(node, idx);
+  };
 
   return true;
 };
+
+static void scheduleNeighborTimer(Node node, int16_t idx) {
+  TimerWheel_Schedule(node->timerWheel, TIMER_WHEEL_NEIGHBORS + idx, 
+    node->neighborhood->oneHopNeighborsLastSeen[idx] + node->config->absentNeighborTimeOut + 1);
+};
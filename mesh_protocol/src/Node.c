@@ -37,6 +37,25 @@
  */
 
 #include "../include/Node.h"
+#include "../include/StateMachine.h"
+#include "../include/Scheduler.h"
+#include "../include/ProtocolClock.h"
+#include "../include/TimeKeeping.h"
+#include "../include/NetworkManager.h"
+#include "../include/SlotMap.h"
+#include "../include/Neighborhood.h"
+#include "../include/RangingManager.h"
+#include "../include/Config.h"
+#include "../include/Driver.h"
+#include "../include/TimerWheel.h"
+#include "../include/GuardConditions.h"
+
+static int64_t listeningUnconnectedDeadline(Node node, int64_t localTime);
+static int64_t listeningConnectedDeadline(Node node, int64_t localTime);
+static int64_t idleDeadline(Node node, int64_t localTime);
+static int64_t rangingListenDeadline(Node node, int64_t localTime);
+static int64_t nextSlotBoundary(Node node, int64_t localTime);
+static int64_t earliest(int64_t deadline, int64_t candidate);
 
 Node Node_Create() {
   Node self = calloc(1, sizeof(NodeStruct));
@@ -90,7 +109,122 @@ void Node_SetLCG(Node self, LCG lcg) {
 void Node_SetConfig(Node self, Config config) {
   self->config = config;
 };
-  
-  
 
+void Node_SetTrace(Node self, TraceWriter trace) {
+  self->trace = trace;
+};
+
+void Node_SetTimerWheel(Node self, TimerWheel timerWheel) {
+  self->timerWheel = timerWheel;
+};
+
+int64_t Node_NextDeadline(Node node) {
+  // the deadlines are derived from the same guard conditions and timeouts that the state machine evaluates with a tic
+  int64_t localTime = ProtocolClock_GetLocalTime(node->clock);
+  if (node->clock->timeIsFixed) {
+    return localTime;
+  };
+
+  switch (node->stateMachine->state) {
+    case OFF:
+      // only TURN_ON changes the state
+      return NODE_NO_DEADLINE;
+    case LISTENING_UNCONNECTED:
+      return listeningUnconnectedDeadline(node, localTime);
+    case LISTENING_CONNECTED:
+      return listeningConnectedDeadline(node, localTime);
+    case IDLE:
+      return idleDeadline(node, localTime);
+    case RANGING_LISTEN:
+      return rangingListenDeadline(node, localTime);
+    case SENDING_UNCONNECTED:
+    case SENDING_CONNECTED:
+    case RANGING_POLL:
+    case RANGING_RESPONSE:
+    case RANGING_FINAL:
+    case RANGING_RESULT:
+      // these states only wait for the transmission to finish (or send as soon as it has finished)
+      if (!*node->driver->txFinishedFlag) {
+        return NODE_NO_DEADLINE;
+      };
+      return localTime;
+    default:
+      return localTime;
+  };
+};
 
+static int64_t listeningUnconnectedDeadline(Node node, int64_t localTime) {
+  int64_t timeNextSchedule = Scheduler_GetTimeOfNextSchedule(node);
+
+  if (timeNextSchedule == -1) {
+    // the initial ping is scheduled as soon as the wait time is over
+    int64_t earliestPingTime = node->config->initialWaitTime + node->timeKeeping->lastResetAt;
+    return (earliestPingTime > localTime) ? earliestPingTime : localTime;
+  };
+
+  // a missed schedule is cancelled with the next tic
+  return (timeNextSchedule > localTime) ? timeNextSchedule : localTime;
+};
+
+static int64_t listeningConnectedDeadline(Node node, int64_t localTime) {
+  // a new ping is scheduled or a missed one is cancelled with the next tic
+  int64_t timeNextSchedule = Scheduler_GetTimeOfNextSchedule(node);
+  if (timeNextSchedule == -1 || timeNextSchedule <= localTime) {
+    return localTime;
+  };
+
+  // transition back to unconnected is evaluated with every tic
+  if (GuardConditions_ListeningConToListeningUncAllowed(node)) {
+    return localTime;
+  };
+
+  // the next ping and the next slot boundary (sending, ranging and idleing depend on the current slot)
+  int64_t deadline = timeNextSchedule;
+  deadline = earliest(deadline, nextSlotBoundary(node, localTime));
+
+  // expiration of slots in the slot maps, of pending and own slots and of absent neighbors (a timer that fires early only 
+  // costs a tic that does nothing)
+  int64_t fireTime = TimerWheel_NextFireTime(node->timerWheel);
+  if (fireTime <= localTime) {
+    return localTime;
+  };
+  deadline = earliest(deadline, fireTime);
+
+  // ranging and idleing within the current slot
+  deadline = earliest(deadline, GuardConditions_EarliestRangingPollTime(node));
+  deadline = earliest(deadline, GuardConditions_EarliestIdleingTime(node));
+
+  return deadline;
+};
+
+static int64_t idleDeadline(Node node, int64_t localTime) {
+  return localTime + TimeKeeping_CalculateTimeUntilWakeup(node);
+};
+
+static int64_t rangingListenDeadline(Node node, int64_t localTime) {
+  // ranging times out after the timeout or when the slot the ranging started in has ended
+  if (RangingManager_HasRangingSlotEnded(node)) {
+    return localTime;
+  };
+
+  int64_t deadline = RangingManager_GetTimeOutTime(node);
+  deadline = earliest(deadline, nextSlotBoundary(node, localTime));
+  return (deadline > localTime) ? deadline : localTime;
+};
+
+static int64_t nextSlotBoundary(Node node, int64_t localTime) {
+  if (!node->timeKeeping->frameStartSet) {
+    return NODE_NO_DEADLINE;
+  };
+
+  int32_t slotLength = node->config->slotLength;
+  int64_t timeInSlot = (localTime - node->timeKeeping->frameStartTime) % slotLength;
+  if (timeInSlot < 0) {
+    timeInSlot += slotLength;
+  };
+  return localTime + ((slotLength - timeInSlot) % slotLength);
+};
+
+static int64_t earliest(int64_t deadline, int64_t candidate) {
+  return (candidate < deadline) ? candidate : deadline;
+};
@@ -0,0 +1,272 @@
+/* Copyright (c) 2022-23 California Institute of Technology (Caltech).
+ * U.S. Government sponsorship acknowledged.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Caltech nor its operating division,
+ *   the Jet Propulsion Laboratory, nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Open Source License Approved by Caltech/JPL
+ *
+ * APACHE LICENSE, VERSION 2.0
+ * - Text version: https://www.apache.org/licenses/LICENSE-2.0.txt
+ * - SPDX short identifier: Apache-2.0
+ * - OSI Approved License: https://opensource.org/licenses/Apache-2.0
+ */
+
+#include "../include/ParallelStepper.h"
+
+#include <sched.h>
+#include <unistd.h>
+
+/** Number of times a worker checks the barrier before it gives up its time slice */
+#define PARALLEL_SPIN_COUNT 1000
+
+static void *workerMain(void *arg);
+static void runTimeTics(ParallelWorker worker);
+static void commitTimeTics(ParallelStepper self);
+static void protectReceivers(ParallelStepper self, int16_t senderIdx);
+static void backupNode(ParallelStepper self, int16_t nodeIdx);
+static void restoreNode(ParallelStepper self, int16_t nodeIdx);
+static void barrierWait(ParallelStepper self, ParallelWorker worker);
+
+ParallelStepper ParallelStepper_Create(Simulator sim, int16_t numThreads) {
+  if (numThreads < 1) {
+    numThreads = sysconf(_SC_NPROCESSORS_ONLN);
+  };
+  if (numThreads < 1) {
+    numThreads = 1;
+  };
+
+  ParallelStepper self = calloc(1, sizeof(ParallelStepperStruct));
+  self->sim = sim;
+  self->numWorkers = numThreads;
+  self->workers = calloc(numThreads, sizeof(ParallelWorkerStruct));
+  self->backups = calloc(sim->capacity, sizeof(ParallelNodeBackupStruct));
+  self->rerun = calloc(sim->capacity, sizeof(bool));
+  self->nodesInRange = calloc(sim->capacity, sizeof(int16_t));
+
+  self->barrierCount = numThreads;
+  self->barrierSense = 0;
+  self->stop = 0;
+  self->numTics = 0;
+  self->numReruns = 0;
+
+  for (int16_t i = 0; i < numThreads; ++i) {
+    self->workers[i].stepper = self;
+    self->workers[i].idx = i;
+    self->workers[i].sense = 0;
+  };
+
+  // worker 0 is the thread that calls ParallelStepper_Step
+  for (int16_t i = 1; i < numThreads; ++i) {
+    pthread_create(&self->workers[i].thread, NULL, workerMain, &self->workers[i]);
+  };
+
+  return self;
+};
+
+void ParallelStepper_Destroy(ParallelStepper self) {
+  if (self->numWorkers > 1) {
+    // release the workers from the barrier at the start of the next tic
+    __atomic_store_n(&self->stop, 1, __ATOMIC_RELEASE);
+    barrierWait(self, &self->workers[0]);
+    for (int16_t i = 1; i < self->numWorkers; ++i) {
+      pthread_join(self->workers[i].thread, NULL);
+    };
+  };
+
+  free(self->workers);
+  free(self->backups);
+  free(self->rerun);
+  free(self->nodesInRange);
+  free(self);
+};
+
+void ParallelStepper_Step(ParallelStepper self) {
+  Simulator sim = self->sim;
+  if (self->numWorkers == 1 || sim->trace != NULL) {
+    Simulator_Step(sim);
+    return;
+  };
+
+  Simulator_BeginTic(sim);
+
+  // the workers start with the first barrier and have run all their nodes when they reach the second one
+  barrierWait(self, &self->workers[0]);
+  runTimeTics(&self->workers[0]);
+  barrierWait(self, &self->workers[0]);
+
+  commitTimeTics(self);
+  Simulator_EndTic(sim);
+  ++self->numTics;
+};
+
+void ParallelStepper_Advance(ParallelStepper self, int64_t endTime) {
+  ParallelStepper_Step(self);
+  if (self->sim->idleSkipping) {
+    Simulator_SkipIdleTics(self->sim, endTime);
+  };
+};
+
+void ParallelStepper_RunUntil(ParallelStepper self, int64_t endTime) {
+  while (Simulator_GetTime(self->sim) < endTime) {
+    ParallelStepper_Advance(self, endTime);
+  };
+};
+
+static void *workerMain(void *arg) {
+  ParallelWorker worker = (ParallelWorker) arg;
+  ParallelStepper self = worker->stepper;
+
+  while (true) {
+    barrierWait(self, worker);
+    if (__atomic_load_n(&self->stop, __ATOMIC_ACQUIRE)) {
+      break;
+    };
+    runTimeTics(worker);
+    barrierWait(self, worker);
+  };
+  return NULL;
+};
+
+static void runTimeTics(ParallelWorker worker) {
+  ParallelStepper self = worker->stepper;
+  Simulator sim = self->sim;
+
+  // contiguous ranges keep the nodes of a worker in its own cache lines
+  int16_t numNodes = sim->numNodes;
+  int16_t begin = (int16_t) (((int32_t) numNodes * worker->idx) / self->numWorkers);
+  int16_t end = (int16_t) (((int32_t) numNodes * (worker->idx + 1)) / self->numWorkers);
+
+  for (int16_t i = begin; i < end; ++i) {
+    self->rerun[i] = false;
+    if (!sim->isOn[i]) {
+      continue;
+    };
+    backupNode(self, i);
+    StateMachine_Run(sim->nodes[i], TIME_TIC, NULL);
+  };
+};
+
+static void commitTimeTics(ParallelStepper self) {
+  Simulator sim = self->sim;
+
+  // same order as the sequential loop; a node sees the transmissions of all nodes with a lower index
+  for (int16_t i = 0; i < sim->numNodes; ++i) {
+    if (!sim->isOn[i]) {
+      continue;
+    };
+
+    if (self->rerun[i]) {
+      StateMachine_Run(sim->nodes[i], TIME_TIC, NULL);
+      ++self->numReruns;
+    };
+
+    if (Driver_GetMessageSentFlag(sim->nodes[i])) {
+      protectReceivers(self, i);
+      Simulator_TransmitSentMessages(sim, i);
+    };
+  };
+};
+
+static void protectReceivers(ParallelStepper self, int16_t senderIdx) {
+  Simulator sim = self->sim;
+
+  // the nodes that will start receiving (same condition as in the Simulator) and have not had their turn yet;
+  // their state is restored before the transmission starts, so that they also get the same rxTimestamp
+  Simulator_UpdatePositions(sim);
+  int16_t numInRange = SpatialGrid_QueryRange(sim->grid, senderIdx, sim->radioRange, self->nodesInRange, sim->numNodes);
+  for (int16_t k = 0; k < numInRange; ++k) {
+    int16_t i = self->nodesInRange[k];
+    if (i <= senderIdx || self->rerun[i] || !sim->isOn[i] || !sim->txFinished[i]) {
+      continue;
+    };
+    restoreNode(self, i);
+    self->rerun[i] = true;
+  };
+};
+
+static void backupNode(ParallelStepper self, int16_t nodeIdx) {
+  Node node = self->sim->nodes[nodeIdx];
+  DriverTxRing txRing = &self->sim->txRings[nodeIdx];
+  ParallelNodeBackup backup = &self->backups[nodeIdx];
+
+  backup->stateMachine = *node->stateMachine;
+  backup->scheduler = *node->scheduler;
+  backup->timeKeeping = *node->timeKeeping;
+  backup->networkManager = *node->networkManager;
+  backup->slotMap = *node->slotMap;
+  backup->neighborhood = *node->neighborhood;
+  backup->timerWheel = *node->timerWheel;
+  backup->rangingManager = *node->rangingManager;
+  backup->lcg = *node->lcg;
+  backup->clock = *node->clock;
+  backup->driver = *node->driver;
+  backup->txRingHead = txRing->head;
+  backup->txRingCount = txRing->count;
+  backup->txRingNumDropped = txRing->numDropped;
+};
+
+static void restoreNode(ParallelStepper self, int16_t nodeIdx) {
+  Node node = self->sim->nodes[nodeIdx];
+  DriverTxRing txRing = &self->sim->txRings[nodeIdx];
+  ParallelNodeBackup backup = &self->backups[nodeIdx];
+
+  *node->stateMachine = backup->stateMachine;
+  *node->scheduler = backup->scheduler;
+  *node->timeKeeping = backup->timeKeeping;
+  *node->networkManager = backup->networkManager;
+  *node->slotMap = backup->slotMap;
+  *node->neighborhood = backup->neighborhood;
+  *node->timerWheel = backup->timerWheel;
+  *node->rangingManager = backup->rangingManager;
+  *node->lcg = backup->lcg;
+  *node->clock = backup->clock;
+  *node->driver = backup->driver;
+
+  // messages sent in the discarded TIME_TIC are dropped from the ring; the slots are overwritten when it runs again
+  txRing->head = backup->txRingHead;
+  txRing->count = backup->txRingCount;
+  txRing->numDropped = backup->txRingNumDropped;
+};
+
+static void barrierWait(ParallelStepper self, ParallelWorker worker) {
+  // sense-reversing barrier: the last worker to arrive resets the count and flips the sense the others are waiting for
+  worker->sense = !worker->sense;
+  if (__atomic_sub_fetch(&self->barrierCount, 1, __ATOMIC_ACQ_REL) == 0) {
+    __atomic_store_n(&self->barrierCount, self->numWorkers, __ATOMIC_RELAXED);
+    __atomic_store_n(&self->barrierSense, worker->sense, __ATOMIC_RELEASE);
+    return;
+  };
+
+  int32_t spins = 0;
+  while (__atomic_load_n(&self->barrierSense, __ATOMIC_ACQUIRE) != worker->sense) {
+    if (++spins == PARALLEL_SPIN_COUNT) {
+      spins = 0;
+      sched_yield();
+    };
+  };
+};
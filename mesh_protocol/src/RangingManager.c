@@ -47,10 +47,9 @@ RangingManager RangingManager_Create() {
 
 bool RangingManager_HasRangingTimedOut(Node node) {
   int64_t localTime = ProtocolClock_GetLocalTime(node->clock);
-  int64_t lastRangingMsgOutTime = node->rangingManager->lastRangingMsgOutTime;
 
   // ranging timed out if the other node did not answer to the last ranging message for a certain time
-  if (localTime > (lastRangingMsgOutTime + node->config->rangingTimeOut)) {
+  if (localTime >= RangingManager_GetTimeOutTime(node)) {
     #ifdef SIMULATION
     mexPrintf("Node %" PRIu8 " ranging timed out \n", node->id);
     #endif
@@ -58,13 +57,17 @@ bool RangingManager_HasRangingTimedOut(Node node) {
   };
 
   // it also timed out if the slot ended in which the ranging started 
-  uint8_t startSlot = TimeKeeping_CalculateOwnSlotAtTime(node, lastRangingMsgOutTime);
-  uint8_t currentSlot = TimeKeeping_CalculateCurrentSlotNum(node);
-  if (startSlot != currentSlot) {
-    return true;
-  };
+  return RangingManager_HasRangingSlotEnded(node);
+};
+
+int64_t RangingManager_GetTimeOutTime(Node node) {
+  return node->rangingManager->lastRangingMsgOutTime + node->config->rangingTimeOut + 1;
+};
 
-  return false;
+bool RangingManager_HasRangingSlotEnded(Node node) {
+  SlotNum startSlot = TimeKeeping_CalculateOwnSlotAtTime(node, node->rangingManager->lastRangingMsgOutTime);
+  SlotNum currentSlot = TimeKeeping_CalculateCurrentSlotNum(node);
+  return (startSlot != currentSlot);
 };
 
 void RangingManager_RecordRangingMsgIn(Node node, Message msg) {
@@ -0,0 +1,289 @@
+/* Copyright (c) 2022-23 California Institute of Technology (Caltech).
+ * U.S. Government sponsorship acknowledged.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Caltech nor its operating division,
+ *   the Jet Propulsion Laboratory, nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Open Source License Approved by Caltech/JPL
+ *
+ * APACHE LICENSE, VERSION 2.0
+ * - Text version: https://www.apache.org/licenses/LICENSE-2.0.txt
+ * - SPDX short identifier: Apache-2.0
+ * - OSI Approved License: https://opensource.org/licenses/Apache-2.0
+ */
+
+#include "../include/Replay.h"
+#include "../include/LCG.h"
+
+/** Maximum number of values in a line: the five values every line has plus the content of a ping */
+#define REPLAY_MAX_VALUES (5 + 3 + 4 * NUM_SLOTS)
+
+static int16_t parseValues(const char *str, double *values, int16_t size);
+static bool isReceivedMessage(ReplayEvent event);
+static int32_t diffType(Replay self, ReplayEventTypes recordedType, MessageTypes sentType, int64_t untilLocalTime, int64_t tolerance, FILE *out);
+
+Replay Replay_Create(int8_t nodeId, uint32_t seed) {
+  Replay self = calloc(1, sizeof(ReplayStruct));
+  self->nodeId = nodeId;
+
+  // the node is turned on at simulation time 0 and has no clock skew, so its local time is the simulation time
+  self->sim = Simulator_Create(1, seed);
+  Simulator_SetIdleSkipping(self->sim, true);
+  Simulator_AddNode(self->sim, nodeId, 0, 0, 0);
+  LCG_Reseed(Simulator_GetNode(self->sim, 0), seed);
+  Simulator_SetTxLog(self->sim, &self->txLog);
+
+  self->events = NULL;
+  self->numEvents = 0;
+  self->eventCapacity = 0;
+  self->nextEvent = 0;
+  self->numIncomplete = 0;
+
+  return self;
+};
+
+void Replay_Destroy(Replay self) {
+  Simulator_Destroy(self->sim);
+  free(self->txLog.elements);
+  free(self->events);
+  free(self);
+};
+
+bool Replay_ParseLine(const char *line, ReplayEvent event) {
+  char direction[3];
+  char kind[6];
+  int consumed = 0;
+  if (sscanf(line, " %2s %5s %n", direction, kind, &consumed) != 2 || consumed == 0) {
+    return false;
+  };
+
+  bool isTx = (strcmp(direction, "TX") == 0);
+  if (!isTx && strcmp(direction, "RX") != 0) {
+    return false;
+  };
+
+  memset(event, 0, sizeof(ReplayEventStruct));
+  if (isTx && strcmp(kind, "PING") == 0) {
+    event->type = REPLAY_TX_PING;
+    event->msg.type = PING;
+  } else if (isTx && strcmp(kind, "DIST") == 0) {
+    event->type = REPLAY_TX_DIST;
+    event->msg.type = RESULT;
+  } else if (!isTx && strcmp(kind, "PING") == 0) {
+    event->type = REPLAY_RX_PING;
+    event->msg.type = PING;
+  } else if (!isTx && strcmp(kind, "DIST") == 0) {
+    event->type = REPLAY_RX_DIST;
+    event->msg.type = RESULT;
+  } else if (!isTx && strcmp(kind, "POLL") == 0) {
+    event->type = REPLAY_RX_POLL;
+    event->msg.type = POLL;
+  } else if (!isTx && strcmp(kind, "RESP") == 0) {
+    event->type = REPLAY_RX_RESPONSE;
+    event->msg.type = RESPONSE;
+  } else if (!isTx && strcmp(kind, "FINAL") == 0) {
+    event->type = REPLAY_RX_FINAL;
+    event->msg.type = FINAL;
+  } else {
+    return false;
+  };
+
+  double values[REPLAY_MAX_VALUES];
+  int16_t numValues = parseValues(line + consumed, &values[0], REPLAY_MAX_VALUES);
+  if (numValues < 5) {
+    return false;
+  };
+
+  // <peer id> <distance or 0> <local time or timestamp> <slot> <ping number or 0>
+  event->peerId = (int8_t) values[0];
+  event->localTime = (int64_t) values[2];
+  event->slotNum = (SlotNum) values[3];
+  event->msg.senderId = event->peerId;
+  event->msg.timestamp = event->localTime;
+  event->msg.distance = values[1];
+  event->msg.pingNum = (int16_t) values[4];
+  event->complete = true;
+
+  if (event->type == REPLAY_RX_PING) {
+    // a ping can only be replayed with its content
+    event->complete = (numValues == REPLAY_MAX_VALUES);
+    if (event->complete) {
+      const double *content = &values[5];
+      event->msg.networkId = (uint8_t) content[0];
+      event->msg.networkAge = (int64_t) content[1];
+      event->msg.timeSinceFrameStart = (int64_t) content[2];
+      for (int i = 0; i < NUM_SLOTS; ++i) {
+        SlotStatus_Set(&event->msg.oneHopSlotStatus, i, (SlotOccupancy) content[3 + i]);
+        event->msg.oneHopSlotIds[i] = (int8_t) content[3 + NUM_SLOTS + i];
+        SlotStatus_Set(&event->msg.twoHopSlotStatus, i, (SlotOccupancy) content[3 + 2 * NUM_SLOTS + i]);
+        event->msg.twoHopSlotIds[i] = (int8_t) content[3 + 3 * NUM_SLOTS + i];
+      };
+    };
+  };
+
+  return true;
+};
+
+bool Replay_AddLine(Replay self, const char *line) {
+  ReplayEventStruct event;
+  if (!Replay_ParseLine(line, &event)) {
+    return false;
+  };
+
+  // ranging messages in the recording were addressed to the recorded node
+  if (isReceivedMessage(&event) && event.type != REPLAY_RX_PING) {
+    event.msg.recipientId = self->nodeId;
+  };
+  if (!event.complete) {
+    ++self->numIncomplete;
+  };
+
+  if (self->numEvents == self->eventCapacity) {
+    self->eventCapacity = (self->eventCapacity > 0) ? (2 * self->eventCapacity) : 256;
+    self->events = realloc(self->events, self->eventCapacity * sizeof(ReplayEventStruct));
+  };
+  self->events[self->numEvents] = event;
+  ++self->numEvents;
+  return true;
+};
+
+int32_t Replay_AddFile(Replay self, FILE *file) {
+  int32_t numAdded = 0;
+  char line[1024];
+  while (fgets(line, sizeof(line), file) != NULL) {
+    if (Replay_AddLine(self, line)) {
+      ++numAdded;
+    };
+  };
+  return numAdded;
+};
+
+void Replay_RunUntil(Replay self, int64_t localTime) {
+  while (self->nextEvent < self->numEvents) {
+    ReplayEvent event = &self->events[self->nextEvent];
+    if (!isReceivedMessage(event) || !event->complete) {
+      ++self->nextEvent;
+      continue;
+    };
+
+    // the firmware handles a message once it is complete, i.e. one air time after its preamble arrived
+    int64_t deliveryTime = event->localTime + Simulator_GetAirTime(event->msg.type);
+    if (deliveryTime >= localTime) {
+      break;
+    };
+
+    Simulator_RunUntil(self->sim, deliveryTime);
+    Simulator_DeliverMessage(self->sim, 0, &event->msg);
+    ++self->nextEvent;
+  };
+
+  Simulator_RunUntil(self->sim, localTime);
+};
+
+int32_t Replay_Diff(Replay self, int64_t untilLocalTime, int64_t tolerance, FILE *out) {
+  return diffType(self, REPLAY_TX_PING, PING, untilLocalTime, tolerance, out) 
+    + diffType(self, REPLAY_TX_DIST, RESULT, untilLocalTime, tolerance, out);
+};
+
+static int32_t diffType(Replay self, ReplayEventTypes recordedType, MessageTypes sentType, int64_t untilLocalTime, int64_t tolerance, FILE *out) {
+  const char *name = (recordedType == REPLAY_TX_PING) ? "TX PING" : "TX DIST";
+  int32_t numDiffs = 0;
+  int32_t recordedIdx = 0;
+  int32_t sentIdx = 0;
+  int32_t n = 0;
+
+  while (true) {
+    // find the next recorded and the next sent message of this type
+    while (recordedIdx < self->numEvents && (self->events[recordedIdx].type != recordedType 
+      || self->events[recordedIdx].localTime >= untilLocalTime)) {
+      ++recordedIdx;
+    };
+    while (sentIdx < self->txLog.num && (self->txLog.elements[sentIdx].type != sentType 
+      || self->txLog.elements[sentIdx].time >= untilLocalTime)) {
+      ++sentIdx;
+    };
+
+    bool hasRecorded = (recordedIdx < self->numEvents);
+    bool hasSent = (sentIdx < self->txLog.num);
+    if (!hasRecorded && !hasSent) {
+      break;
+    };
+
+    if (!hasSent) {
+      ++numDiffs;
+      if (out != NULL) {
+        fprintf(out, "%s #%" PRId32 ": recorded at %" PRId64 ", not sent in replay\n", name, n, self->events[recordedIdx].localTime);
+      };
+    } else if (!hasRecorded) {
+      ++numDiffs;
+      if (out != NULL) {
+        fprintf(out, "%s #%" PRId32 ": sent in replay at %" PRId64 ", not recorded\n", name, n, self->txLog.elements[sentIdx].time);
+      };
+    } else {
+      ReplayEvent recorded = &self->events[recordedIdx];
+      SimulatorTxRecord sent = &self->txLog.elements[sentIdx];
+      int64_t timeDiff = sent->time - recorded->localTime;
+      bool samePeer = (recordedType == REPLAY_TX_PING) || (sent->recipientId == recorded->peerId);
+      if (timeDiff > tolerance || timeDiff < -tolerance || !samePeer) {
+        ++numDiffs;
+        if (out != NULL) {
+          fprintf(out, "%s #%" PRId32 ": recorded at %" PRId64 " (peer %" PRId8 "), sent in replay at %" PRId64 " (peer %" PRId8 ")\n", 
+            name, n, recorded->localTime, recorded->peerId, sent->time, (recordedType == REPLAY_TX_PING) ? self->nodeId : sent->recipientId);
+        };
+      };
+    };
+
+    ++recordedIdx;
+    ++sentIdx;
+    ++n;
+  };
+
+  return numDiffs;
+};
+
+static int16_t parseValues(const char *str, double *values, int16_t size) {
+  int16_t numValues = 0;
+  char *end;
+  while (true) {
+    double value = strtod(str, &end);
+    if (end == str) {
+      break;
+    };
+    if (numValues == size) {
+      // more values than a line can have
+      return size + 1;
+    };
+    values[numValues] = value;
+    ++numValues;
+    str = end;
+  };
+  return numValues;
+};
+
+static bool isReceivedMessage(ReplayEvent event) {
+  return (event->type != REPLAY_TX_PING && event->type != REPLAY_TX_DIST);
+};
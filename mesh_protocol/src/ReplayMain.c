@@ -0,0 +1,99 @@
+/* Copyright (c) 2022-23 California Institute of Technology (Caltech).
+ * U.S. Government sponsorship acknowledged.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Caltech nor its operating division,
+ *   the Jet Propulsion Laboratory, nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Open Source License Approved by Caltech/JPL
+ *
+ * APACHE LICENSE, VERSION 2.0
+ * - Text version: https://www.apache.org/licenses/LICENSE-2.0.txt
+ * - SPDX short identifier: Apache-2.0
+ * - OSI Approved License: https://opensource.org/licenses/Apache-2.0
+ */
+
+
+/** @file ReplayMain.c
+*   @brief Command line front end of the replay of a recorded node (see Replay.h)
+*
+*   Usage: mesh_replay nodeId seed recordingFile [untilLocalTime] [tolerance]
+*
+*   Replays the recorded UART output of the node with the given ID and random seed up to untilLocalTime (default: the end of 
+*   the recording) and prints every ping and ranging result that the replayed node sent differently (more than tolerance 
+*   time tics apart, default 1) than the recorded node. Exits with 2 if there are differences.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../include/Replay.h"
+
+int main(int argc, char *argv[]) {
+  if (argc < 4) {
+    fprintf(stderr, "usage: %s nodeId seed recordingFile [untilLocalTime] [tolerance]\n", argv[0]);
+    return 1;
+  };
+  int8_t nodeId = (int8_t) atoi(argv[1]);
+  uint32_t seed = (uint32_t) strtoul(argv[2], NULL, 10);
+  int64_t tolerance = (argc > 5) ? atoll(argv[5]) : 1;
+
+  FILE *file = fopen(argv[3], "r");
+  if (file == NULL) {
+    fprintf(stderr, "cannot open %s\n", argv[3]);
+    return 1;
+  };
+
+  Replay replay = Replay_Create(nodeId, seed);
+  int32_t numEvents = Replay_AddFile(replay, file);
+  fclose(file);
+
+  int64_t untilLocalTime = 0;
+  for (int32_t i = 0; i < replay->numEvents; ++i) {
+    if (replay->events[i].localTime + 1 > untilLocalTime) {
+      untilLocalTime = replay->events[i].localTime + 1;
+    };
+  };
+  if (argc > 4) {
+    untilLocalTime = atoll(argv[4]);
+  };
+
+  printf("events %" PRId32 " (not replayable %" PRId32 ")\n", numEvents, replay->numIncomplete);
+  if (replay->numIncomplete > 0) {
+    printf("received pings without content were skipped; record with EVAL_REPLAY to replay them\n");
+  };
+
+  clock_t start = clock();
+  Replay_RunUntil(replay, untilLocalTime);
+  double elapsed = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+  int32_t numDiffs = Replay_Diff(replay, untilLocalTime, tolerance, stdout);
+  printf("replayed %" PRId64 " tics in %.3f s cpu, %" PRId32 " differences\n", untilLocalTime, elapsed, numDiffs);
+
+  Replay_Destroy(replay);
+  return (numDiffs > 0) ? 2 : 0;
+};
@@ -90,7 +90,7 @@ bool Scheduler_NothingScheduledYet(Node node) {
   return node->scheduler->timeNextSchedule == -1;
 };
 
-int8_t Scheduler_GetSlotOfNextSchedule(Node node) {
+SlotNum Scheduler_GetSlotOfNextSchedule(Node node) {
   uint64_t timeNextSchedule = Scheduler_GetTimeOfNextSchedule(node);
   return TimeKeeping_CalculateOwnSlotAtTime(node, timeNextSchedule);
 }
@@ -117,7 +117,7 @@ void Scheduler_ScheduleNextPing(Node node) {
       // when node is connected, the time of the next ping depends on whether it is a new reservation
       // or a regular ping in an already reserved slot
 
-      int8_t scheduleSlotNum = 0;
+      SlotNum scheduleSlotNum = 0;
       bool goalMet = SlotMap_SlotReservationGoalMet(node);
 
       uint64_t delay = 0;
@@ -131,13 +131,13 @@ void Scheduler_ScheduleNextPing(Node node) {
         delay = getRandomDelay(node);
       } else {
         // schedule ping to next own slot
-        uint8_t currentSlot = TimeKeeping_CalculateCurrentSlotNum(node);
+        SlotNum currentSlot = TimeKeeping_CalculateCurrentSlotNum(node);
         scheduleSlotNum = SlotMap_CalculateNextOwnOrPendingSlotNum(node, currentSlot);
         // add a small delay so if two nodes reserved the same slot without having common neighbors, they have a chance 
         // of recognizing this (without delay they would always send at the same time and could never "see" each other)
         delay = getRegularRandomDelay(node);
         #ifdef SIMULATION
-        mexPrintf("Node %" PRIu8 " schedules to own slot %" PRIu8 "\n", node->id, scheduleSlotNum);
+        mexPrintf("Node %" PRIu8 " schedules to own slot %" PRId16 "\n", node->id, scheduleSlotNum);
         #endif
       }
 
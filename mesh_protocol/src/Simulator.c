@@ -0,0 +1,1254 @@
+/* Copyright (c) 2022-23 California Institute of Technology (Caltech).
+ * U.S. Government sponsorship acknowledged.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Caltech nor its operating division,
+ *   the Jet Propulsion Laboratory, nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Open Source License Approved by Caltech/JPL
+ *
+ * APACHE LICENSE, VERSION 2.0
+ * - Text version: https://www.apache.org/licenses/LICENSE-2.0.txt
+ * - SPDX short identifier: Apache-2.0
+ * - OSI Approved License: https://opensource.org/licenses/Apache-2.0
+ */
+
+#include "../include/Simulator.h"
+
+static Node createNode(Simulator self, int16_t nodeIdx, int8_t id, uint32_t seed);
+static void destroyNode(Node node);
+static uint32_t nextInitialSeed(Simulator self);
+static void turnOnDueNodes(Simulator self);
+static void processDueEvents(Simulator self);
+static void runTimeTics(Simulator self);
+static void incrementLocalTimes(Simulator self);
+static int64_t ticsUntilLocalTime(Simulator self, int16_t nodeIdx, int64_t localTime);
+static void advanceLocalTime(Simulator self, int16_t nodeIdx, int64_t tics);
+static int64_t ticsUntilDriftedTime(Simulator self, int16_t nodeIdx, int64_t localTime);
+static void updateDrifts(Simulator self);
+static void startTransmission(Simulator self, int16_t senderIdx, Message msg);
+static void endTransmission(Simulator self, Transmission tx);
+static void deliver(Simulator self, int16_t receiverIdx, Transmission tx);
+static void pushEvent(Simulator self, int64_t time, Transmission tx);
+static void logTransmission(SimulatorTxLog txLog, int64_t time, int16_t senderIdx, Message msg);
+static SimEventStruct popEvent(Simulator self);
+static bool eventPrecedes(SimEventStruct *a, SimEventStruct *b);
+static void copyNodeState(Node dst, Node src);
+static Transmission copyTransmission(Simulator self, Transmission src);
+static void copyPerNodeValues(Simulator dst, Simulator src);
+static uint32_t nodeStateSize();
+static bool writeValues(FILE *file, const void *values, size_t size, size_t num);
+static bool readValues(FILE *file, void *values, size_t size, size_t num);
+static bool writeNodeState(FILE *file, Node node);
+static bool readNodeState(FILE *file, Node node);
+static bool writePerNodeValues(FILE *file, Simulator self);
+static bool readPerNodeValues(FILE *file, Simulator self);
+static bool writeChannel(FILE *file, Channel channel);
+static bool readChannel(FILE *file, Channel channel);
+static bool writeTransmission(FILE *file, Transmission tx);
+static Transmission readTransmission(FILE *file, Simulator self);
+
+Simulator Simulator_Create(int16_t capacity, uint32_t seed) {
+  Simulator self = calloc(1, sizeof(SimulatorStruct));
+  self->capacity = capacity;
+  self->numNodes = 0;
+  self->time = 0;
+  self->radioRange = INFINITY;
+
+  self->nodes = calloc(capacity, sizeof(Node));
+  self->txRings = calloc(capacity, sizeof(DriverTxRingStruct));
+
+  // room for one transmission of every node plus the message that is being delivered
+  self->messagePool = MessagePool_Create(capacity + 1);
+  self->txFinished = calloc(capacity, sizeof(bool));
+  self->isReceiving = calloc(capacity, sizeof(bool));
+  self->localTimes = calloc(capacity, sizeof(int64_t));
+  self->clockSkew = calloc(capacity, sizeof(int));
+  self->lastSkewTime = calloc(capacity, sizeof(int64_t));
+  self->drifts = calloc(capacity, sizeof(ClockDriftStruct));
+  self->driftIncrement = calloc(capacity, sizeof(int64_t));
+  self->driftFraction = calloc(capacity, sizeof(int64_t));
+  for (int16_t i = 0; i < capacity; ++i) {
+    ClockDrift_Init(&self->drifts[i], 0, 0, 0, 0, 0, 1, 0);
+  };
+  self->nextDriftUpdate = CLOCK_DRIFT_NO_UPDATE;
+  self->turnOnTimes = calloc(capacity, sizeof(int64_t));
+  self->isOn = calloc(capacity, sizeof(bool));
+  self->posX = calloc(capacity, sizeof(double));
+  self->posY = calloc(capacity, sizeof(double));
+  self->channel = Channel_Create(capacity);
+  self->nextTxId = 0;
+  self->rxTimestamp = calloc(capacity, sizeof(int64_t));
+
+  self->grid = SpatialGrid_Create(capacity, self->radioRange);
+  self->nodesInRange = calloc(capacity, sizeof(int16_t));
+
+  // the heap grows when needed; start with room for one transmission per node
+  self->eventCapacity = capacity;
+  self->events = calloc(self->eventCapacity, sizeof(SimEventStruct));
+  self->numEvents = 0;
+  self->nextEventSeq = 0;
+
+  // state of a private generator for the initial seeds of the nodes, so that simulations do not depend on 
+  // the global state of rand() (and can run in parallel)
+  self->seedState = seed;
+
+  self->idleSkipping = false;
+  self->trace = NULL;
+  self->txLog = NULL;
+  self->mobility = NULL;
+  self->positionsTime = -1;
+
+  return self;
+};
+
+void Simulator_Destroy(Simulator self) {
+  // free transmissions that are still on the channel
+  for (int32_t i = 0; i < self->numEvents; ++i) {
+    Transmission tx = self->events[i].tx;
+    for (int16_t j = 0; j <= tx->numReceivers; ++j) {
+      Message_Release(self->messagePool, tx->msg);
+    };
+    free(tx->receivers);
+    free(tx);
+  };
+
+  for (int16_t i = 0; i < self->numNodes; ++i) {
+    destroyNode(self->nodes[i]);
+  };
+
+  free(self->nodes);
+  free(self->txRings);
+  MessagePool_Destroy(self->messagePool);
+  free(self->txFinished);
+  free(self->isReceiving);
+  free(self->localTimes);
+  free(self->clockSkew);
+  free(self->lastSkewTime);
+  free(self->drifts);
+  free(self->driftIncrement);
+  free(self->driftFraction);
+  free(self->turnOnTimes);
+  free(self->isOn);
+  free(self->posX);
+  free(self->posY);
+  Channel_Destroy(self->channel);
+  free(self->rxTimestamp);
+  SpatialGrid_Destroy(self->grid);
+  free(self->nodesInRange);
+  free(self->events);
+  free(self);
+};
+
+int16_t Simulator_AddNode(Simulator self, int8_t id, double x, double y, int64_t turnOnTime) {
+  if (self->numNodes == self->capacity) {
+    return -1;
+  };
+
+  int16_t nodeIdx = self->numNodes;
+  self->localTimes[nodeIdx] = 0;
+  self->txFinished[nodeIdx] = true; // no transmission going on
+  self->isReceiving[nodeIdx] = false;
+  self->lastSkewTime[nodeIdx] = 0;
+  self->turnOnTimes[nodeIdx] = turnOnTime;
+  self->isOn[nodeIdx] = false;
+  self->posX[nodeIdx] = x;
+  self->posY[nodeIdx] = y;
+  SpatialGrid_Insert(self->grid, x, y);
+
+  self->nodes[nodeIdx] = createNode(self, nodeIdx, id, nextInitialSeed(self));
+  ++self->numNodes;
+
+  return nodeIdx;
+};
+
+void Simulator_MoveNode(Simulator self, int16_t nodeIdx, double x, double y) {
+  self->posX[nodeIdx] = x;
+  self->posY[nodeIdx] = y;
+  SpatialGrid_Move(self->grid, nodeIdx, x, y);
+};
+
+void Simulator_SetMobility(Simulator self, Mobility mobility) {
+  self->mobility = mobility;
+  self->positionsTime = -1;
+};
+
+void Simulator_UpdatePositions(Simulator self) {
+  if (self->mobility == NULL || self->mobility->numMoving == 0 || self->positionsTime == self->time) {
+    return;
+  };
+  self->positionsTime = self->time;
+
+  // the grid only relinks the nodes that changed their cell
+  for (int16_t i = 0; i < self->numNodes; ++i) {
+    if (!Mobility_IsMoving(self->mobility, i)) {
+      continue;
+    };
+    double x = self->posX[i];
+    double y = self->posY[i];
+    Mobility_GetPosition(self->mobility, i, self->time, &x, &y);
+    if (x != self->posX[i] || y != self->posY[i]) {
+      Simulator_MoveNode(self, i, x, y);
+    };
+  };
+};
+
+void Simulator_SetRadioRange(Simulator self, double range) {
+  self->radioRange = range;
+
+  // cells as big as the radio range: all nodes in range of a sender are in the 3 x 3 cells around it
+  SpatialGrid_SetCellSize(self->grid, range);
+};
+
+void Simulator_SetClockSkew(Simulator self, int16_t nodeIdx, int skew) {
+  self->clockSkew[nodeIdx] = skew;
+
+  // a skewed clock does not drift
+  ClockDrift_Init(&self->drifts[nodeIdx], 0, 0, 0, 0, 0, 1, self->time);
+  self->driftIncrement[nodeIdx] = 0;
+};
+
+void Simulator_SetClockDrift(Simulator self, int16_t nodeIdx, double offsetPpm, double randomWalkPpm, double variationPpm, 
+  int64_t variationPeriod, int64_t updateInterval) {
+
+  self->clockSkew[nodeIdx] = 0;
+
+  // the random walk of every node gets its own seed, derived from the initial seed of the node
+  uint32_t seed = self->nodes[nodeIdx]->lcg->next ^ (0x9E3779B9u * (uint32_t) (nodeIdx + 1));
+  ClockDrift drift = &self->drifts[nodeIdx];
+  ClockDrift_Init(drift, offsetPpm, randomWalkPpm, variationPpm, variationPeriod, updateInterval, seed, self->time);
+  self->driftIncrement[nodeIdx] = ClockDrift_GetIncrement(drift);
+  if (drift->nextUpdate < self->nextDriftUpdate) {
+    self->nextDriftUpdate = drift->nextUpdate;
+  };
+};
+
+int32_t Simulator_ReadClockDrifts(Simulator self, FILE *file) {
+  char line[256];
+  int32_t numRead = 0;
+
+  while (fgets(line, sizeof(line), file) != NULL) {
+    if (line[0] == '#' || strspn(line, " \t\r\n") == strlen(line)) {
+      continue;
+    };
+    for (char *c = line; *c != '\0'; ++c) {
+      if (*c == ',') {
+        *c = ' ';
+      };
+    };
+
+    int nodeIdx;
+    double offsetPpm = 0, randomWalkPpm = 0, variationPpm = 0;
+    long long variationPeriod = 0, updateInterval = 0;
+    int numValues = sscanf(line, "%d %lf %lf %lf %lld %lld", &nodeIdx, &offsetPpm, &randomWalkPpm, &variationPpm, 
+      &variationPeriod, &updateInterval);
+    if (numValues < 2 || nodeIdx < 0 || nodeIdx >= self->numNodes) {
+      return -1;
+    };
+
+    Simulator_SetClockDrift(self, nodeIdx, offsetPpm, randomWalkPpm, variationPpm, variationPeriod, updateInterval);
+    ++numRead;
+  };
+  return numRead;
+};
+
+double Simulator_GetClockOffset(Simulator self, int16_t nodeIdx) {
+  if (!self->isOn[nodeIdx]) {
+    return 0;
+  };
+  double fraction = (double) self->driftFraction[nodeIdx] / (double) (1LL << CLOCK_DRIFT_FRACTION_BITS);
+  return (double) (self->localTimes[nodeIdx] - (self->time - self->turnOnTimes[nodeIdx])) + fraction;
+};
+
+void Simulator_SetTrace(Simulator self, TraceWriter trace) {
+  self->trace = trace;
+  for (int16_t i = 0; i < self->numNodes; ++i) {
+    Node_SetTrace(self->nodes[i], trace);
+  };
+};
+
+void Simulator_SetTxLog(Simulator self, SimulatorTxLog txLog) {
+  self->txLog = txLog;
+};
+
+void Simulator_SetCapture(Simulator self, bool enabled, double thresholdDb, double pathLossExponent) {
+  Channel_SetCapture(self->channel, enabled, thresholdDb, pathLossExponent);
+};
+
+void Simulator_SetIdleSkipping(Simulator self, bool enabled) {
+  self->idleSkipping = enabled;
+};
+
+bool Simulator_NodesInRange(Simulator self, int16_t idxA, int16_t idxB) {
+  return (Simulator_GetDistance(self, idxA, idxB) <= self->radioRange);
+};
+
+double Simulator_GetDistance(Simulator self, int16_t idxA, int16_t idxB) {
+  double dx = self->posX[idxA] - self->posX[idxB];
+  double dy = self->posY[idxA] - self->posY[idxB];
+  return sqrt(dx * dx + dy * dy);
+};
+
+int16_t Simulator_FindNode(Simulator self, int8_t id) {
+  for (int16_t i = 0; i < self->numNodes; ++i) {
+    if (self->nodes[i]->id == id) {
+      return i;
+    };
+  };
+  return -1;
+};
+
+bool Simulator_GetTrueDistance(Simulator self, int16_t nodeIdx, int8_t neighborId, double *distance) {
+  int16_t neighborIdx = Simulator_FindNode(self, neighborId);
+  if (neighborIdx == -1) {
+    return false;
+  };
+  Simulator_UpdatePositions(self);
+  *distance = Simulator_GetDistance(self, nodeIdx, neighborIdx);
+  return true;
+};
+
+void Simulator_Step(Simulator self) {
+  Simulator_BeginTic(self);
+  runTimeTics(self);
+  Simulator_EndTic(self);
+};
+
+void Simulator_BeginTic(Simulator self) {
+  turnOnDueNodes(self);
+
+  // deliver transmissions first, so that nodes react to messages that arrived within the last tic
+  processDueEvents(self);
+};
+
+void Simulator_EndTic(Simulator self) {
+  incrementLocalTimes(self);
+  ++self->time;
+};
+
+void Simulator_RunUntil(Simulator self, int64_t endTime) {
+  while (self->time < endTime) {
+    Simulator_Advance(self, endTime);
+  };
+};
+
+void Simulator_Advance(Simulator self, int64_t endTime) {
+  Simulator_Step(self);
+  if (self->idleSkipping) {
+    Simulator_SkipIdleTics(self, endTime);
+  };
+};
+
+void Simulator_SkipIdleTics(Simulator self, int64_t endTime) {
+  // find the next simulation time at which anything can happen
+  int64_t nextTime = endTime;
+  if (self->numEvents > 0 && self->events[0].time < nextTime) {
+    nextTime = self->events[0].time;
+  };
+
+  // the tic in which the rate of a drifting clock changes is executed
+  if (self->nextDriftUpdate < nextTime) {
+    nextTime = self->nextDriftUpdate;
+  };
+
+  for (int16_t i = 0; i < self->numNodes; ++i) {
+    if (!self->isOn[i]) {
+      if (self->turnOnTimes[i] < nextTime) {
+        nextTime = self->turnOnTimes[i];
+      };
+      continue;
+    };
+
+    Node node = self->nodes[i];
+    int64_t deadline = Node_NextDeadline(node);
+    if (deadline == NODE_NO_DEADLINE) {
+      continue;
+    };
+
+    // deadlines are in protocol time, which may contain a correction of the local time
+    int64_t localDeadline = deadline - node->clock->correctionValue;
+    if (localDeadline <= self->localTimes[i]) {
+      // the next tic of this node must be executed
+      return;
+    };
+
+    int64_t tics = ticsUntilLocalTime(self, i, localDeadline);
+    if (tics < (nextTime - self->time)) {
+      nextTime = self->time + tics;
+    };
+  };
+
+  if (nextTime <= self->time) {
+    return;
+  };
+
+  int64_t tics = nextTime - self->time;
+  for (int16_t i = 0; i < self->numNodes; ++i) {
+    if (self->isOn[i]) {
+      advanceLocalTime(self, i, tics);
+    };
+  };
+  self->time = nextTime;
+};
+
+void Simulator_TransmitSentMessages(Simulator self, int16_t senderIdx) {
+  Node node = self->nodes[senderIdx];
+  if (!Driver_GetMessageSentFlag(node)) {
+    return;
+  };
+  Driver_SetMessageSentFlag(node, false);
+
+  // put every message the driver has written to the transmit ring on the channel
+  DriverTxRing txRing = &self->txRings[senderIdx];
+  Message msg;
+  while ((msg = Driver_TxRingPeek(txRing)) != NULL) {
+    startTransmission(self, senderIdx, msg);
+    Driver_TxRingPop(txRing);
+  };
+};
+
+int64_t Simulator_GetTime(Simulator self) {
+  return self->time;
+};
+
+void Simulator_DeliverMessage(Simulator self, int16_t nodeIdx, Message msg) {
+  if (!self->isOn[nodeIdx]) {
+    return;
+  };
+
+  // the state machine may change some fields of the message, so it gets a copy
+  Message copy = Message_Acquire(self->messagePool, msg->type);
+  Message_CopyContent(copy, msg);
+  StateMachine_Run(self->nodes[nodeIdx], INCOMING_MSG, copy);
+  Message_Release(self->messagePool, copy);
+
+  Simulator_TransmitSentMessages(self, nodeIdx);
+};
+
+Node Simulator_GetNode(Simulator self, int16_t nodeIdx) {
+  if (nodeIdx < 0 || nodeIdx >= self->numNodes) {
+    return NULL;
+  };
+  return self->nodes[nodeIdx];
+};
+
+void Simulator_Snapshot(Simulator self, Snapshot snapshot) {
+  Snapshot_Fill(snapshot, self->nodes, self->numNodes);
+};
+
+Simulator Simulator_Fork(Simulator self) {
+  Simulator fork = Simulator_Create(self->capacity, self->seedState);
+  Simulator_SetRadioRange(fork, self->radioRange);
+
+  for (int16_t i = 0; i < self->numNodes; ++i) {
+    Simulator_AddNode(fork, self->nodes[i]->id, self->posX[i], self->posY[i], self->turnOnTimes[i]);
+    copyNodeState(fork->nodes[i], self->nodes[i]);
+  };
+  copyPerNodeValues(fork, self);
+
+  Channel_Destroy(fork->channel);
+  fork->channel = Channel_Clone(self->channel);
+
+  // the heap is copied element by element, so it stays a valid heap
+  fork->eventCapacity = self->eventCapacity;
+  fork->events = realloc(fork->events, fork->eventCapacity * sizeof(SimEventStruct));
+  for (int32_t i = 0; i < self->numEvents; ++i) {
+    fork->events[i] = self->events[i];
+    fork->events[i].tx = copyTransmission(fork, self->events[i].tx);
+  };
+  fork->numEvents = self->numEvents;
+
+  fork->time = self->time;
+  fork->nextTxId = self->nextTxId;
+  fork->nextEventSeq = self->nextEventSeq;
+  fork->seedState = self->seedState;
+  fork->stats = self->stats;
+  fork->idleSkipping = self->idleSkipping;
+
+  return fork;
+};
+
+bool Simulator_SaveCheckpoint(Simulator self, FILE *file) {
+  SimulatorCheckpointHeaderStruct header;
+  memset(&header, 0, sizeof(SimulatorCheckpointHeaderStruct));
+  memcpy(header.magic, SIMULATOR_CHECKPOINT_MAGIC, sizeof(header.magic));
+  header.version = SIMULATOR_CHECKPOINT_VERSION;
+  header.nodeStateSize = nodeStateSize();
+  header.messageSize = sizeof(MessageStruct);
+
+  bool ok = writeValues(file, &header, sizeof(SimulatorCheckpointHeaderStruct), 1);
+  ok = ok && writeValues(file, &self->capacity, sizeof(int16_t), 1);
+  ok = ok && writeValues(file, &self->numNodes, sizeof(int16_t), 1);
+  ok = ok && writeValues(file, &self->radioRange, sizeof(double), 1);
+
+  // everything that is needed to add the nodes again comes first, then their state
+  ok = ok && writeValues(file, self->posX, sizeof(double), self->numNodes);
+  ok = ok && writeValues(file, self->posY, sizeof(double), self->numNodes);
+  ok = ok && writeValues(file, self->turnOnTimes, sizeof(int64_t), self->numNodes);
+  for (int16_t i = 0; i < self->numNodes; ++i) {
+    ok = ok && writeNodeState(file, self->nodes[i]);
+  };
+  ok = ok && writePerNodeValues(file, self);
+  ok = ok && writeChannel(file, self->channel);
+
+  // events in heap order, so they can be read back into a valid heap
+  ok = ok && writeValues(file, &self->numEvents, sizeof(int32_t), 1);
+  for (int32_t i = 0; i < self->numEvents; ++i) {
+    ok = ok && writeValues(file, &self->events[i].time, sizeof(int64_t), 1);
+    ok = ok && writeValues(file, &self->events[i].seq, sizeof(uint64_t), 1);
+    ok = ok && writeTransmission(file, self->events[i].tx);
+  };
+
+  ok = ok && writeValues(file, &self->time, sizeof(int64_t), 1);
+  ok = ok && writeValues(file, &self->nextTxId, sizeof(uint64_t), 1);
+  ok = ok && writeValues(file, &self->nextEventSeq, sizeof(uint64_t), 1);
+  ok = ok && writeValues(file, &self->seedState, sizeof(uint32_t), 1);
+  ok = ok && writeValues(file, &self->stats, sizeof(SimulatorStatsStruct), 1);
+  ok = ok && writeValues(file, &self->idleSkipping, sizeof(bool), 1);
+
+  return ok;
+};
+
+Simulator Simulator_LoadCheckpoint(FILE *file) {
+  SimulatorCheckpointHeaderStruct header;
+  if (!readValues(file, &header, sizeof(SimulatorCheckpointHeaderStruct), 1)
+      || memcmp(header.magic, SIMULATOR_CHECKPOINT_MAGIC, sizeof(header.magic)) != 0
+      || header.version != SIMULATOR_CHECKPOINT_VERSION
+      || header.nodeStateSize != nodeStateSize()
+      || header.messageSize != sizeof(MessageStruct)) {
+    return NULL;
+  };
+
+  int16_t capacity, numNodes;
+  double radioRange;
+  bool ok = readValues(file, &capacity, sizeof(int16_t), 1);
+  ok = ok && readValues(file, &numNodes, sizeof(int16_t), 1);
+  ok = ok && readValues(file, &radioRange, sizeof(double), 1);
+  if (!ok || capacity <= 0 || numNodes < 0 || numNodes > capacity) {
+    return NULL;
+  };
+
+  Simulator self = Simulator_Create(capacity, 0);
+  Simulator_SetRadioRange(self, radioRange);
+
+  double *posX = calloc(numNodes, sizeof(double));
+  double *posY = calloc(numNodes, sizeof(double));
+  int64_t *turnOnTimes = calloc(numNodes, sizeof(int64_t));
+  ok = readValues(file, posX, sizeof(double), numNodes);
+  ok = ok && readValues(file, posY, sizeof(double), numNodes);
+  ok = ok && readValues(file, turnOnTimes, sizeof(int64_t), numNodes);
+  for (int16_t i = 0; ok && i < numNodes; ++i) {
+    Simulator_AddNode(self, 0, posX[i], posY[i], turnOnTimes[i]);
+    ok = readNodeState(file, self->nodes[i]);
+  };
+  free(posX);
+  free(posY);
+  free(turnOnTimes);
+
+  ok = ok && readPerNodeValues(file, self);
+  ok = ok && readChannel(file, self->channel);
+
+  int32_t numEvents = 0;
+  ok = ok && readValues(file, &numEvents, sizeof(int32_t), 1);
+  ok = ok && (numEvents >= 0);
+  if (ok && numEvents > self->eventCapacity) {
+    self->eventCapacity = numEvents;
+    self->events = realloc(self->events, self->eventCapacity * sizeof(SimEventStruct));
+  };
+  for (int32_t i = 0; ok && i < numEvents; ++i) {
+    SimEventStruct event;
+    ok = readValues(file, &event.time, sizeof(int64_t), 1);
+    ok = ok && readValues(file, &event.seq, sizeof(uint64_t), 1);
+    event.tx = ok ? readTransmission(file, self) : NULL;
+    ok = ok && (event.tx != NULL);
+    if (ok) {
+      // numEvents only counts complete events, so that Simulator_Destroy can clean up if the file ends early
+      self->events[self->numEvents++] = event;
+    };
+  };
+
+  ok = ok && readValues(file, &self->time, sizeof(int64_t), 1);
+  ok = ok && readValues(file, &self->nextTxId, sizeof(uint64_t), 1);
+  ok = ok && readValues(file, &self->nextEventSeq, sizeof(uint64_t), 1);
+  ok = ok && readValues(file, &self->seedState, sizeof(uint32_t), 1);
+  ok = ok && readValues(file, &self->stats, sizeof(SimulatorStatsStruct), 1);
+  ok = ok && readValues(file, &self->idleSkipping, sizeof(bool), 1);
+
+  if (!ok) {
+    Simulator_Destroy(self);
+    return NULL;
+  };
+  return self;
+};
+
+int64_t Simulator_GetAirTime(MessageTypes type) {
+  switch (type) {
+    case PING:
+      return PING_SIZE;
+    case POLL:
+      return POLL_SIZE;
+    case RESPONSE:
+      return RESPONSE_SIZE;
+    case FINAL:
+      return FINAL_SIZE;
+    case RESULT:
+      return RESULT_SIZE;
+    default:
+      return 0;
+  };
+};
+
+static Node createNode(Simulator self, int16_t nodeIdx, int8_t id, uint32_t seed) {
+  // create all the structs that hold the data of the node (same as createNode() in the MatlabWrapper)
+  Node node = Node_Create();
+  StateMachine stateMachine = StateMachine_Create();
+  Scheduler scheduler = Scheduler_Create();
+  ProtocolClock clock = ProtocolClock_Create(&self->localTimes[nodeIdx]);
+  TimeKeeping timeKeeping = TimeKeeping_Create();
+  NetworkManager networkManager = NetworkManager_Create();
+  MessageHandler messageHandler = MessageHandler_Create();
+  SlotMap slotMap = SlotMap_Create();
+  Neighborhood neighborhood = Neighborhood_Create();
+  RangingManager rangingManager = RangingManager_Create();
+  LCG lcg = LCG_Create(seed);
+  Config config = Config_Create();
+  Driver driver = Driver_Create(&self->txFinished[nodeIdx], &self->isReceiving[nodeIdx]);
+  TimerWheel timerWheel = TimerWheel_Create();
+
+  // set the structs as pointers for the Node struct, so we only have to pass around the Node struct
+  Node_SetDriver(node, driver);
+  Driver_SetTxRing(node, &self->txRings[nodeIdx]);
+
+  Node_SetStateMachine(node, stateMachine);
+  Node_SetScheduler(node, scheduler);
+  Node_SetClock(node, clock);
+  Node_SetTimeKeeping(node, timeKeeping);
+  Node_SetNetworkManager(node, networkManager);
+  Node_SetMessageHandler(node, messageHandler);
+  Node_SetSlotMap(node, slotMap);
+  Node_SetNeighborhood(node, neighborhood);
+  Node_SetRangingManager(node, rangingManager);
+  Node_SetLCG(node, lcg);
+  Node_SetConfig(node, config);
+  Node_SetTrace(node, self->trace);
+  Node_SetTimerWheel(node, timerWheel);
+
+  node->id = id;
+  return node;
+};
+
+static void destroyNode(Node node) {
+  free(node->stateMachine);
+  free(node->scheduler);
+  free(node->clock);
+  free(node->timeKeeping);
+  free(node->networkManager);
+  free(node->messageHandler);
+  free(node->slotMap);
+  free(node->neighborhood);
+  free(node->rangingManager);
+  free(node->lcg);
+  free(node->config);
+  free(node->driver);
+  free(node->timerWheel);
+  free(node);
+};
+
+static uint32_t nextInitialSeed(Simulator self) {
+  // same range of seeds as the MatlabWrapper generates (100,000,000 to 999,999,999)
+  self->seedState = self->seedState * 1103515245 + 12345;
+  return (uint32_t) (100000000 + (self->seedState % 900000000));
+};
+
+static void turnOnDueNodes(Simulator self) {
+  for (int16_t i = 0; i < self->numNodes; ++i) {
+    if (!self->isOn[i] && self->turnOnTimes[i] <= self->time) {
+      self->isOn[i] = true;
+      /* TURN_ON will trigger the state transition from OFF to LISTENING_UNCONNECTED */
+      StateMachine_Run(self->nodes[i], TURN_ON, NULL);
+    };
+  };
+};
+
+static void processDueEvents(Simulator self) {
+  while (self->numEvents > 0 && self->events[0].time <= self->time) {
+    SimEventStruct event = popEvent(self);
+    endTransmission(self, event.tx);
+  };
+};
+
+static void runTimeTics(Simulator self) {
+  for (int16_t i = 0; i < self->numNodes; ++i) {
+    if (!self->isOn[i]) {
+      continue;
+    };
+    StateMachine_Run(self->nodes[i], TIME_TIC, NULL);
+    Simulator_TransmitSentMessages(self, i);
+  };
+};
+
+static void incrementLocalTimes(Simulator self) {
+  if (self->time >= self->nextDriftUpdate) {
+    updateDrifts(self);
+  };
+
+  for (int16_t i = 0; i < self->numNodes; ++i) {
+    if (!self->isOn[i]) {
+      continue;
+    };
+
+    // the fraction of a tic a drifting clock gained or lost is carried over; the shift rounds down, also for negative sums
+    int64_t fraction = self->driftFraction[i] + self->driftIncrement[i];
+    self->localTimes[i] += 1 + (fraction >> CLOCK_DRIFT_FRACTION_BITS);
+    self->driftFraction[i] = fraction & ((1LL << CLOCK_DRIFT_FRACTION_BITS) - 1);
+
+    // check if the local time must be skewed (clock skew); same rule as functionId 9 of the MatlabWrapper
+    if (self->clockSkew[i] != 0 && self->localTimes[i] == (self->lastSkewTime[i] + abs(self->clockSkew[i]))) {
+      self->lastSkewTime[i] = self->localTimes[i];
+
+      if (self->clockSkew[i] > 0) {
+        // add an additional tic
+        ++self->localTimes[i];
+      } else {
+        // skip one tic
+        --self->localTimes[i];
+      };
+    };
+  };
+};
+
+static int64_t ticsUntilLocalTime(Simulator self, int16_t nodeIdx, int64_t localTime) {
+  // number of tics until the local time of the node has reached localTime, following the skew rule of incrementLocalTimes()
+  int64_t time = self->localTimes[nodeIdx];
+  int64_t lastSkewTime = self->lastSkewTime[nodeIdx];
+  int skew = self->clockSkew[nodeIdx];
+  int64_t tics = 0;
+
+  if (skew == 0 && self->driftIncrement[nodeIdx] != 0) {
+    return ticsUntilDriftedTime(self, nodeIdx, localTime);
+  };
+
+  if (skew == -1) {
+    // every tic is skipped, the local time never advances
+    return (time >= localTime) ? 0 : NODE_NO_DEADLINE;
+  };
+
+  while (time < localTime) {
+    int64_t skewTime = lastSkewTime + abs(skew);
+    if (skew == 0 || skewTime <= time || skewTime > localTime) {
+      // no skew before the local time is reached
+      return tics + (localTime - time);
+    };
+
+    tics += skewTime - time;
+    lastSkewTime = skewTime;
+    time = (skew > 0) ? (skewTime + 1) : (skewTime - 1);
+  };
+  return tics;
+};
+
+static void advanceLocalTime(Simulator self, int16_t nodeIdx, int64_t tics) {
+  // same as calling incrementLocalTimes() tics times for this node, but only stops at the tics at which the clock is skewed
+  int skew = self->clockSkew[nodeIdx];
+
+  if (skew == 0) {
+    int64_t fraction = self->driftFraction[nodeIdx] + tics * self->driftIncrement[nodeIdx];
+    self->localTimes[nodeIdx] += tics + (fraction >> CLOCK_DRIFT_FRACTION_BITS);
+    self->driftFraction[nodeIdx] = fraction & ((1LL << CLOCK_DRIFT_FRACTION_BITS) - 1);
+    return;
+  };
+
+  while (tics > 0) {
+    int64_t skewTime = self->lastSkewTime[nodeIdx] + abs(skew);
+    if (skew == 0 || skewTime <= self->localTimes[nodeIdx] || (skewTime - self->localTimes[nodeIdx]) > tics) {
+      self->localTimes[nodeIdx] += tics;
+      return;
+    };
+
+    tics -= skewTime - self->localTimes[nodeIdx];
+    self->lastSkewTime[nodeIdx] = skewTime;
+    self->localTimes[nodeIdx] = (skew > 0) ? (skewTime + 1) : (skewTime - 1);
+  };
+};
+
+static int64_t ticsUntilDriftedTime(Simulator self, int16_t nodeIdx, int64_t localTime) {
+  // smallest n with localTime(n) = local + n + floor((fraction + n * increment) / 2^bits) >= localTime, which increases with n
+  int64_t increment = self->driftIncrement[nodeIdx];
+  int64_t fraction = self->driftFraction[nodeIdx];
+  int64_t remaining = localTime - self->localTimes[nodeIdx];
+  if (remaining <= 0) {
+    return 0;
+  };
+
+  // start close to the solution and correct the rounding of the estimate in both directions
+  double scale = (double) (1LL << CLOCK_DRIFT_FRACTION_BITS);
+  int64_t tics = (int64_t) (((double) remaining - fraction / scale) / (1.0 + increment / scale));
+  if (tics < 0) {
+    tics = 0;
+  };
+  while (tics + ((fraction + tics * increment) >> CLOCK_DRIFT_FRACTION_BITS) < remaining) {
+    ++tics;
+  };
+  while (tics > 0 && (tics - 1) + ((fraction + (tics - 1) * increment) >> CLOCK_DRIFT_FRACTION_BITS) >= remaining) {
+    --tics;
+  };
+  return tics;
+};
+
+static void updateDrifts(Simulator self) {
+  self->nextDriftUpdate = CLOCK_DRIFT_NO_UPDATE;
+  for (int16_t i = 0; i < self->numNodes; ++i) {
+    ClockDrift drift = &self->drifts[i];
+    if (ClockDrift_Update(drift, self->time)) {
+      self->driftIncrement[i] = ClockDrift_GetIncrement(drift);
+    };
+    if (drift->nextUpdate < self->nextDriftUpdate) {
+      self->nextDriftUpdate = drift->nextUpdate;
+    };
+  };
+};
+
+static void startTransmission(Simulator self, int16_t senderIdx, Message msg) {
+  Simulator_UpdatePositions(self);
+  ++self->stats.numTransmissions[msg->type];
+  if (self->txLog != NULL) {
+    logTransmission(self->txLog, self->time, senderIdx, msg);
+  };
+
+  // a node cannot receive while it is transmitting, so a reception that is currently going on is lost
+  Channel_AbortReceptions(self->channel, senderIdx);
+  self->txFinished[senderIdx] = false;
+
+  Transmission tx = calloc(1, sizeof(TransmissionStruct));
+  tx->id = self->nextTxId++;
+  tx->msg = Message_Acquire(self->messagePool, msg->type);
+  Message_CopyContent(tx->msg, msg);
+  tx->senderIdx = senderIdx;
+  tx->startTime = self->time;
+  tx->endTime = self->time + Simulator_GetAirTime(msg->type);
+  tx->receivers = calloc(self->numNodes, sizeof(int16_t));
+  tx->numReceivers = 0;
+
+  // every node that is in range, turned on and not transmitting itself starts receiving the transmission
+  int16_t numInRange = SpatialGrid_QueryRange(self->grid, senderIdx, self->radioRange, self->nodesInRange, self->numNodes);
+  for (int16_t k = 0; k < numInRange; ++k) {
+    int16_t i = self->nodesInRange[k];
+    if (!self->isOn[i] || !self->txFinished[i]) {
+      continue;
+    };
+
+    double power = Channel_ReceivedPower(self->channel, Simulator_GetDistance(self, senderIdx, i));
+    if (Channel_StartReception(self->channel, i, tx->id, tx->startTime, tx->endTime, power)) {
+      // first transmission that reaches the node; remember when its preamble arrived
+      self->rxTimestamp[i] = ProtocolClock_GetLocalTime(self->nodes[i]->clock);
+    };
+
+    self->isReceiving[i] = true;
+    Message_Retain(tx->msg);
+    tx->receivers[tx->numReceivers] = i;
+    ++tx->numReceivers;
+  };
+
+  pushEvent(self, tx->endTime, tx);
+};
+
+static void endTransmission(Simulator self, Transmission tx) {
+  self->txFinished[tx->senderIdx] = true;
+
+  for (int16_t i = 0; i < tx->numReceivers; ++i) {
+    deliver(self, tx->receivers[i], tx);
+    Message_Release(self->messagePool, tx->msg);
+  };
+
+  Message_Release(self->messagePool, tx->msg);
+  free(tx->receivers);
+  free(tx);
+};
+
+static void deliver(Simulator self, int16_t receiverIdx, Transmission tx) {
+  ChannelRxResult result = Channel_EndReception(self->channel, receiverIdx, tx->id, tx->endTime);
+  self->isReceiving[receiverIdx] = Channel_IsBusy(self->channel, receiverIdx);
+  self->stats.numCaptures = self->channel->numCaptures;
+  if (result == CHANNEL_RX_NONE) {
+    // other transmissions are still reaching this node or it already got the message it locked onto
+    return;
+  };
+
+  if (result == CHANNEL_RX_LOST || !self->isOn[receiverIdx]) {
+    ++self->stats.numLost;
+    return;
+  };
+
+  Node receiver = self->nodes[receiverIdx];
+  Message msg;
+  if (result == CHANNEL_RX_COLLISION) {
+    msg = Message_Acquire(self->messagePool, COLLISION);
+    ++self->stats.numCollisions;
+  } else {
+    // all receivers get the same message; only the fields that differ between receivers are set before every delivery
+    msg = tx->msg;
+    Message_Retain(msg);
+
+    // the distance of a ranging result is what the simulated ranging would have measured
+    if (msg->type == RESULT) {
+      Simulator_UpdatePositions(self);
+      msg->distance = Simulator_GetDistance(self, tx->senderIdx, receiverIdx);
+    };
+    ++self->stats.numDelivered;
+  };
+  msg->timestamp = self->rxTimestamp[receiverIdx];
+
+  StateMachine_Run(receiver, INCOMING_MSG, msg);
+  Message_Release(self->messagePool, msg);
+
+  // the receiver may answer right away (e.g. a response to a poll)
+  Simulator_TransmitSentMessages(self, receiverIdx);
+};
+
+static void logTransmission(SimulatorTxLog txLog, int64_t time, int16_t senderIdx, Message msg) {
+  if (txLog->num == txLog->capacity) {
+    txLog->capacity = (txLog->capacity > 0) ? (2 * txLog->capacity) : 64;
+    txLog->elements = realloc(txLog->elements, txLog->capacity * sizeof(SimulatorTxRecordStruct));
+  };
+
+  SimulatorTxRecord record = &txLog->elements[txLog->num];
+  record->time = time;
+  record->senderIdx = senderIdx;
+  record->type = msg->type;
+  record->recipientId = msg->recipientId;
+  record->networkId = msg->networkId;
+  record->distance = msg->distance;
+  ++txLog->num;
+};
+
+static void pushEvent(Simulator self, int64_t time, Transmission tx) {
+  if (self->numEvents == self->eventCapacity) {
+    self->eventCapacity = (self->eventCapacity > 0) ? (2 * self->eventCapacity) : 16;
+    self->events = realloc(self->events, self->eventCapacity * sizeof(SimEventStruct));
+  };
+
+  SimEventStruct event;
+  event.time = time;
+  event.seq = self->nextEventSeq++;
+  event.tx = tx;
+
+  // sift up
+  int32_t idx = self->numEvents++;
+  while (idx > 0) {
+    int32_t parent = (idx - 1) / 2;
+    if (!eventPrecedes(&event, &self->events[parent])) {
+      break;
+    };
+    self->events[idx] = self->events[parent];
+    idx = parent;
+  };
+  self->events[idx] = event;
+};
+
+static SimEventStruct popEvent(Simulator self) {
+  SimEventStruct top = self->events[0];
+  SimEventStruct last = self->events[--self->numEvents];
+
+  // sift down
+  int32_t idx = 0;
+  while (true) {
+    int32_t child = 2 * idx + 1;
+    if (child >= self->numEvents) {
+      break;
+    };
+    if (child + 1 < self->numEvents && eventPrecedes(&self->events[child + 1], &self->events[child])) {
+      ++child;
+    };
+    if (!eventPrecedes(&self->events[child], &last)) {
+      break;
+    };
+    self->events[idx] = self->events[child];
+    idx = child;
+  };
+  if (self->numEvents > 0) {
+    self->events[idx] = last;
+  };
+
+  return top;
+};
+
+static bool eventPrecedes(SimEventStruct *a, SimEventStruct *b) {
+  if (a->time != b->time) {
+    return (a->time < b->time);
+  };
+  return (a->seq < b->seq);
+};
+
+static void copyNodeState(Node dst, Node src) {
+  // the structs without pointers are copied as a whole; the clock and the driver keep pointing to the values of their own simulator
+  dst->id = src->id;
+  *dst->stateMachine = *src->stateMachine;
+  *dst->scheduler = *src->scheduler;
+  *dst->timeKeeping = *src->timeKeeping;
+  *dst->networkManager = *src->networkManager;
+  *dst->slotMap = *src->slotMap;
+  *dst->neighborhood = *src->neighborhood;
+  *dst->timerWheel = *src->timerWheel;
+  *dst->lcg = *src->lcg;
+  *dst->config = *src->config;
+
+  dst->clock->correctionValue = src->clock->correctionValue;
+  dst->clock->timeIsFixed = src->clock->timeIsFixed;
+  dst->clock->fixedTime = src->clock->fixedTime;
+
+  dst->driver->tx_antenna_delay = src->driver->tx_antenna_delay;
+  dst->driver->rx_antenna_delay = src->driver->rx_antenna_delay;
+  dst->driver->sentMessage = src->driver->sentMessage;
+  dst->driver->lastTxStartTime = src->driver->lastTxStartTime;
+
+  dst->rangingManager->lastRangingMsgOutTime = src->rangingManager->lastRangingMsgOutTime;
+  dst->rangingManager->lastRangingMsgInTime = src->rangingManager->lastRangingMsgInTime;
+};
+
+static Transmission copyTransmission(Simulator self, Transmission src) {
+  Transmission tx = calloc(1, sizeof(TransmissionStruct));
+  *tx = *src;
+
+  // the copy of the message is held by as many receivers as the original
+  tx->msg = Message_Acquire(self->messagePool, src->msg->type);
+  Message_CopyContent(tx->msg, src->msg);
+  tx->msg->refCount = src->msg->refCount;
+
+  tx->receivers = calloc(self->numNodes, sizeof(int16_t));
+  memcpy(tx->receivers, src->receivers, src->numReceivers * sizeof(int16_t));
+  return tx;
+};
+
+static void copyPerNodeValues(Simulator dst, Simulator src) {
+  int16_t n = src->numNodes;
+  memcpy(dst->txRings, src->txRings, n * sizeof(DriverTxRingStruct));
+  memcpy(dst->txFinished, src->txFinished, n * sizeof(bool));
+  memcpy(dst->isReceiving, src->isReceiving, n * sizeof(bool));
+  memcpy(dst->localTimes, src->localTimes, n * sizeof(int64_t));
+  memcpy(dst->clockSkew, src->clockSkew, n * sizeof(int));
+  memcpy(dst->lastSkewTime, src->lastSkewTime, n * sizeof(int64_t));
+  memcpy(dst->drifts, src->drifts, n * sizeof(ClockDriftStruct));
+  memcpy(dst->driftIncrement, src->driftIncrement, n * sizeof(int64_t));
+  memcpy(dst->driftFraction, src->driftFraction, n * sizeof(int64_t));
+  dst->nextDriftUpdate = src->nextDriftUpdate;
+  memcpy(dst->isOn, src->isOn, n * sizeof(bool));
+  memcpy(dst->rxTimestamp, src->rxTimestamp, n * sizeof(int64_t));
+};
+
+static uint32_t nodeStateSize() {
+  return sizeof(int8_t) + sizeof(StateMachineStruct) + sizeof(SchedulerStruct) + sizeof(TimeKeepingStruct) 
+    + sizeof(NetworkManagerStruct) + sizeof(SlotMapStruct) + sizeof(NeighborhoodStruct) + sizeof(TimerWheelStruct) 
+    + sizeof(ConfigStruct) + sizeof(ProtocolClockStruct) + sizeof(DriverStruct) + sizeof(RangingManagerStruct);
+};
+
+static bool writeValues(FILE *file, const void *values, size_t size, size_t num) {
+  return (num == 0 || fwrite(values, size, num, file) == num);
+};
+
+static bool readValues(FILE *file, void *values, size_t size, size_t num) {
+  return (num == 0 || fread(values, size, num, file) == num);
+};
+
+static bool writeNodeState(FILE *file, Node node) {
+  // same values as copyNodeState(), in the same order as readNodeState() reads them
+  bool ok = writeValues(file, &node->id, sizeof(int8_t), 1);
+  ok = ok && writeValues(file, node->stateMachine, sizeof(StateMachineStruct), 1);
+  ok = ok && writeValues(file, node->scheduler, sizeof(SchedulerStruct), 1);
+  ok = ok && writeValues(file, node->timeKeeping, sizeof(TimeKeepingStruct), 1);
+  ok = ok && writeValues(file, node->networkManager, sizeof(NetworkManagerStruct), 1);
+  ok = ok && writeValues(file, node->slotMap, sizeof(SlotMapStruct), 1);
+  ok = ok && writeValues(file, node->neighborhood, sizeof(NeighborhoodStruct), 1);
+  ok = ok && writeValues(file, node->timerWheel, sizeof(TimerWheelStruct), 1);
+  ok = ok && writeValues(file, node->lcg, sizeof(LCGStruct), 1);
+  ok = ok && writeValues(file, node->config, sizeof(ConfigStruct), 1);
+  ok = ok && writeValues(file, &node->clock->correctionValue, sizeof(int64_t), 1);
+  ok = ok && writeValues(file, &node->clock->timeIsFixed, sizeof(bool), 1);
+  ok = ok && writeValues(file, &node->clock->fixedTime, sizeof(node->clock->fixedTime), 1);
+  ok = ok && writeValues(file, &node->driver->tx_antenna_delay, sizeof(uint16_t), 1);
+  ok = ok && writeValues(file, &node->driver->rx_antenna_delay, sizeof(uint16_t), 1);
+  ok = ok && writeValues(file, &node->driver->sentMessage, sizeof(bool), 1);
+  ok = ok && writeValues(file, &node->driver->lastTxStartTime, sizeof(int64_t), 1);
+  ok = ok && writeValues(file, &node->rangingManager->lastRangingMsgOutTime, sizeof(int64_t), 1);
+  ok = ok && writeValues(file, &node->rangingManager->lastRangingMsgInTime, sizeof(int64_t), 1);
+  return ok;
+};
+
+static bool readNodeState(FILE *file, Node node) {
+  bool ok = readValues(file, &node->id, sizeof(int8_t), 1);
+  ok = ok && readValues(file, node->stateMachine, sizeof(StateMachineStruct), 1);
+  ok = ok && readValues(file, node->scheduler, sizeof(SchedulerStruct), 1);
+  ok = ok && readValues(file, node->timeKeeping, sizeof(TimeKeepingStruct), 1);
+  ok = ok && readValues(file, node->networkManager, sizeof(NetworkManagerStruct), 1);
+  ok = ok && readValues(file, node->slotMap, sizeof(SlotMapStruct), 1);
+  ok = ok && readValues(file, node->neighborhood, sizeof(NeighborhoodStruct), 1);
+  ok = ok && readValues(file, node->timerWheel, sizeof(TimerWheelStruct), 1);
+  ok = ok && readValues(file, node->lcg, sizeof(LCGStruct), 1);
+  ok = ok && readValues(file, node->config, sizeof(ConfigStruct), 1);
+  ok = ok && readValues(file, &node->clock->correctionValue, sizeof(int64_t), 1);
+  ok = ok && readValues(file, &node->clock->timeIsFixed, sizeof(bool), 1);
+  ok = ok && readValues(file, &node->clock->fixedTime, sizeof(node->clock->fixedTime), 1);
+  ok = ok && readValues(file, &node->driver->tx_antenna_delay, sizeof(uint16_t), 1);
+  ok = ok && readValues(file, &node->driver->rx_antenna_delay, sizeof(uint16_t), 1);
+  ok = ok && readValues(file, &node->driver->sentMessage, sizeof(bool), 1);
+  ok = ok && readValues(file, &node->driver->lastTxStartTime, sizeof(int64_t), 1);
+  ok = ok && readValues(file, &node->rangingManager->lastRangingMsgOutTime, sizeof(int64_t), 1);
+  ok = ok && readValues(file, &node->rangingManager->lastRangingMsgInTime, sizeof(int64_t), 1);
+  return ok;
+};
+
+static bool writePerNodeValues(FILE *file, Simulator self) {
+  // same values as copyPerNodeValues()
+  int16_t n = self->numNodes;
+  bool ok = writeValues(file, self->txRings, sizeof(DriverTxRingStruct), n);
+  ok = ok && writeValues(file, self->txFinished, sizeof(bool), n);
+  ok = ok && writeValues(file, self->isReceiving, sizeof(bool), n);
+  ok = ok && writeValues(file, self->localTimes, sizeof(int64_t), n);
+  ok = ok && writeValues(file, self->clockSkew, sizeof(int), n);
+  ok = ok && writeValues(file, self->lastSkewTime, sizeof(int64_t), n);
+  ok = ok && writeValues(file, self->drifts, sizeof(ClockDriftStruct), n);
+  ok = ok && writeValues(file, self->driftIncrement, sizeof(int64_t), n);
+  ok = ok && writeValues(file, self->driftFraction, sizeof(int64_t), n);
+  ok = ok && writeValues(file, &self->nextDriftUpdate, sizeof(int64_t), 1);
+  ok = ok && writeValues(file, self->isOn, sizeof(bool), n);
+  ok = ok && writeValues(file, self->rxTimestamp, sizeof(int64_t), n);
+  return ok;
+};
+
+static bool readPerNodeValues(FILE *file, Simulator self) {
+  int16_t n = self->numNodes;
+  bool ok = readValues(file, self->txRings, sizeof(DriverTxRingStruct), n);
+  ok = ok && readValues(file, self->txFinished, sizeof(bool), n);
+  ok = ok && readValues(file, self->isReceiving, sizeof(bool), n);
+  ok = ok && readValues(file, self->localTimes, sizeof(int64_t), n);
+  ok = ok && readValues(file, self->clockSkew, sizeof(int), n);
+  ok = ok && readValues(file, self->lastSkewTime, sizeof(int64_t), n);
+  ok = ok && readValues(file, self->drifts, sizeof(ClockDriftStruct), n);
+  ok = ok && readValues(file, self->driftIncrement, sizeof(int64_t), n);
+  ok = ok && readValues(file, self->driftFraction, sizeof(int64_t), n);
+  ok = ok && readValues(file, &self->nextDriftUpdate, sizeof(int64_t), 1);
+  ok = ok && readValues(file, self->isOn, sizeof(bool), n);
+  ok = ok && readValues(file, self->rxTimestamp, sizeof(int64_t), n);
+  return ok;
+};
+
+static bool writeChannel(FILE *file, Channel channel) {
+  bool ok = writeValues(file, &channel->captureEnabled, sizeof(bool), 1);
+  ok = ok && writeValues(file, &channel->captureThreshold, sizeof(double), 1);
+  ok = ok && writeValues(file, &channel->pathLossExponent, sizeof(double), 1);
+  ok = ok && writeValues(file, &channel->numOverlaps, sizeof(uint64_t), 1);
+  ok = ok && writeValues(file, &channel->numCaptures, sizeof(uint64_t), 1);
+
+  // every receiver as a whole (its pointer is replaced when reading) followed by its active receptions
+  for (int16_t i = 0; i < channel->numReceivers; ++i) {
+    ChannelReceiver receiver = &channel->receivers[i];
+    ok = ok && writeValues(file, receiver, sizeof(ChannelReceiverStruct), 1);
+    ok = ok && writeValues(file, receiver->active, sizeof(ChannelReceptionStruct), receiver->numActive);
+  };
+  return ok;
+};
+
+static bool readChannel(FILE *file, Channel channel) {
+  bool ok = readValues(file, &channel->captureEnabled, sizeof(bool), 1);
+  ok = ok && readValues(file, &channel->captureThreshold, sizeof(double), 1);
+  ok = ok && readValues(file, &channel->pathLossExponent, sizeof(double), 1);
+  ok = ok && readValues(file, &channel->numOverlaps, sizeof(uint64_t), 1);
+  ok = ok && readValues(file, &channel->numCaptures, sizeof(uint64_t), 1);
+
+  for (int16_t i = 0; ok && i < channel->numReceivers; ++i) {
+    ChannelReceiver receiver = &channel->receivers[i];
+    ChannelReceptionStruct *active = receiver->active;
+    ok = readValues(file, receiver, sizeof(ChannelReceiverStruct), 1);
+
+    // keep the (empty) array of the new channel unless the receptions do not fit
+    receiver->active = active;
+    receiver->activeCapacity = 0;
+    if (ok && receiver->numActive > 0) {
+      receiver->activeCapacity = receiver->numActive;
+      receiver->active = realloc(receiver->active, receiver->activeCapacity * sizeof(ChannelReceptionStruct));
+    };
+    if (!ok || receiver->numActive < 0) {
+      receiver->numActive = 0;
+      return false;
+    };
+    ok = readValues(file, receiver->active, sizeof(ChannelReceptionStruct), receiver->numActive);
+
+    // the channel relies on every reception interval being valid and on the receptions being sorted by end time
+    for (int32_t k = 0; ok && k < receiver->numActive; ++k) {
+      ChannelReceptionStruct *reception = &receiver->active[k];
+      ok = (reception->start <= reception->end) && (k == 0 || receiver->active[k - 1].end <= reception->end);
+    };
+  };
+  return ok;
+};
+
+static bool writeTransmission(FILE *file, Transmission tx) {
+  bool ok = writeValues(file, &tx->id, sizeof(uint64_t), 1);
+  ok = ok && writeValues(file, &tx->senderIdx, sizeof(int16_t), 1);
+  ok = ok && writeValues(file, &tx->startTime, sizeof(int64_t), 1);
+  ok = ok && writeValues(file, &tx->endTime, sizeof(int64_t), 1);
+  ok = ok && writeValues(file, &tx->numReceivers, sizeof(int16_t), 1);
+  ok = ok && writeValues(file, tx->receivers, sizeof(int16_t), tx->numReceivers);
+  ok = ok && writeValues(file, tx->msg, sizeof(MessageStruct), 1);
+  return ok;
+};
+
+static Transmission readTransmission(FILE *file, Simulator self) {
+  Transmission tx = calloc(1, sizeof(TransmissionStruct));
+  bool ok = readValues(file, &tx->id, sizeof(uint64_t), 1);
+  ok = ok && readValues(file, &tx->senderIdx, sizeof(int16_t), 1);
+  ok = ok && (tx->senderIdx >= 0 && tx->senderIdx < self->numNodes);
+  ok = ok && readValues(file, &tx->startTime, sizeof(int64_t), 1);
+  ok = ok && readValues(file, &tx->endTime, sizeof(int64_t), 1);
+  ok = ok && readValues(file, &tx->numReceivers, sizeof(int16_t), 1);
+  ok = ok && (tx->numReceivers >= 0 && tx->numReceivers <= self->numNodes);
+  if (ok) {
+    tx->receivers = calloc(self->numNodes, sizeof(int16_t));
+    ok = readValues(file, tx->receivers, sizeof(int16_t), tx->numReceivers);
+  };
+  // the indices are used for nodes, txFinished and isReceiving when the transmission ends
+  for (int16_t i = 0; ok && i < tx->numReceivers; ++i) {
+    ok = (tx->receivers[i] >= 0 && tx->receivers[i] < self->numNodes);
+  };
+
+  MessageStruct msg;
+  ok = ok && readValues(file, &msg, sizeof(MessageStruct), 1);
+  ok = ok && ((int) msg.type >= PING && (int) msg.type <= RESULT);
+  ok = ok && (msg.numCollisions >= 0 && msg.numCollisions <= MAX_NUM_COLLISIONS_RECORDED);
+  if (!ok) {
+    free(tx->receivers);
+    free(tx);
+    return NULL;
+  };
+
+  // the pointers of the message are only valid in the process that wrote it
+  msg.rx_buffer = NULL;
+  msg.multiHopStatus = NULL;
+  msg.multiHopIds = NULL;
+  tx->msg = Message_Acquire(self->messagePool, msg.type);
+  Message_CopyContent(tx->msg, &msg);
+  tx->msg->refCount = msg.refCount;
+  return tx;
+};
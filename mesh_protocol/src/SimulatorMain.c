@@ -0,0 +1,116 @@
+/* Copyright (c) 2022-23 California Institute of Technology (Caltech).
+ * U.S. Government sponsorship acknowledged.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Caltech nor its operating division,
+ *   the Jet Propulsion Laboratory, nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Open Source License Approved by Caltech/JPL
+ *
+ * APACHE LICENSE, VERSION 2.0
+ * - Text version: https://www.apache.org/licenses/LICENSE-2.0.txt
+ * - SPDX short identifier: Apache-2.0
+ * - OSI Approved License: https://opensource.org/licenses/Apache-2.0
+ */
+
+/** @file SimulatorMain.c
+*   @brief Command line front end of the native simulator
+*
+*   Usage: mesh_simulator [numNodes] [durationTics] [seed] [spacing] [radioRange] [idleSkipping] [traceFile]
+*
+*   Places numNodes nodes on a line with the given spacing, runs the simulation for durationTics time tics and prints 
+*   the final state of every node and the channel statistics. Idle tics are skipped unless idleSkipping is 0.
+*   If traceFile is given and tracing is compiled in (see Trace.h), the binary event trace is written to it.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../include/Simulator.h"
+
+int main(int argc, char *argv[]) {
+  int16_t numNodes = (argc > 1) ? atoi(argv[1]) : 4;
+  int64_t duration = (argc > 2) ? atoll(argv[2]) : 200000;
+  uint32_t seed = (argc > 3) ? (uint32_t) strtoul(argv[3], NULL, 10) : 1;
+  double spacing = (argc > 4) ? atof(argv[4]) : 1.0;
+  double radioRange = (argc > 5) ? atof(argv[5]) : 1.5;
+  bool idleSkipping = (argc > 6) ? (atoi(argv[6]) != 0) : true;
+  const char *tracePath = (argc > 7) ? argv[7] : NULL;
+
+  if (numNodes < 1 || numNodes > MAX_NUM_NODES) {
+    fprintf(stderr, "numNodes must be between 1 and %d\n", MAX_NUM_NODES);
+    return 1;
+  };
+
+  Simulator sim = Simulator_Create(numNodes, seed);
+  Simulator_SetRadioRange(sim, radioRange);
+  Simulator_SetIdleSkipping(sim, idleSkipping);
+
+  TraceWriter trace = NULL;
+  if (tracePath != NULL) {
+    trace = TraceWriter_Create(tracePath);
+    if (trace == NULL) {
+      fprintf(stderr, "cannot create trace file %s\n", tracePath);
+      Simulator_Destroy(sim);
+      return 1;
+    };
+    Simulator_SetTrace(sim, trace);
+  };
+  for (int16_t i = 0; i < numNodes; ++i) {
+    Simulator_AddNode(sim, (int8_t) (i + 1), i * spacing, 0, 0);
+  };
+
+  clock_t start = clock();
+  Simulator_RunUntil(sim, duration);
+  double elapsed = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+  printf("time %" PRId64 " tics, %.3f s cpu\n", Simulator_GetTime(sim), elapsed);
+  for (int16_t i = 0; i < numNodes; ++i) {
+    Node node = Simulator_GetNode(sim, i);
+    SlotNum ownSlots[MAX_NUM_OWN_SLOTS];
+    int8_t numOwn = SlotMap_GetOwnSlots(node, &ownSlots[0], MAX_NUM_OWN_SLOTS);
+
+    printf("node %" PRId8 ": state %d network %" PRIu8 " neighbors %" PRId8 " own slots", node->id, StateMachine_GetState(node), 
+      NetworkManager_GetNetworkId(node), node->neighborhood->numOneHopNeighbors);
+    for (int8_t j = 0; j < numOwn; ++j) {
+      printf(" %" PRId16, ownSlots[j]);
+    };
+    printf("\n");
+  };
+
+  printf("tx ping %" PRIu64 " poll %" PRIu64 " response %" PRIu64 " final %" PRIu64 " result %" PRIu64 "\n", 
+    sim->stats.numTransmissions[PING], sim->stats.numTransmissions[POLL], sim->stats.numTransmissions[RESPONSE], 
+    sim->stats.numTransmissions[FINAL], sim->stats.numTransmissions[RESULT]);
+  printf("delivered %" PRIu64 " collisions %" PRIu64 " lost %" PRIu64 "\n", sim->stats.numDelivered, sim->stats.numCollisions, sim->stats.numLost);
+
+  Simulator_Destroy(sim);
+  if (trace != NULL) {
+    printf("trace records %" PRIu64 "\n", trace->numRecords);
+    TraceWriter_Destroy(trace);
+  };
+  return 0;
+};
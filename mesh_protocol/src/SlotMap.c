@@ -38,16 +38,51 @@
 
 #include "../include/SlotMap.h"
 
-static bool isAcknowledged(Node node, int8_t queriedPendingSlot);
-static bool oneHopSlotIsExpired(Node node, int8_t currentSlot, int64_t timeout);
-static void updateMultiHopSlotMap(Node node, Message msg, int *multiHopSlotMapStatus, int8_t *multiHopSlotMapIds, int64_t *multiHopSlotMapLastUpdate);
-static bool slotReportedColliding(Message msg, int8_t slotNum);
-static bool slotReportedOccupiedByOtherNode(Node node, Message msg, int8_t slotNum);
-static void removeExpiredSlotsFromSlotMap(Node node, int *slotMapStatus, int8_t *slotMapIds, int64_t *slotMapLastUpdated);
-static int8_t findFreeSlotsInThreeHopNeighborhood(Node node, int8_t *freeSlots);
-static int8_t findFreeForThisNodeSlotsInThreeHopNeighborhood(Node node, int8_t *freeSlots);
-static int8_t findCollidingSlotsInThreeHopNeighborhood(Node node, int8_t *collidingSlots);
-static int8_t getNextSlotFromSelection(Node node, int8_t *selection, int8_t size);
+/** Word of a SlotMask that holds the bit of a slot index (slot number - 1), and the bit within that word */
+#define SLOT_WORD(slotIdx) ((slotIdx) / 64)
+#define SLOT_BIT(slotIdx) ((uint64_t) 1 << ((slotIdx) % 64))
+
+/** Builds with SLOT_MAP_CHECK defined compare the combined bit sets with the recomputed ones before every query */
+#ifdef SLOT_MAP_CHECK
+#define CHECK_COMBINED_MASKS(node) checkCombinedMasks(node)
+#else
+#define CHECK_COMBINED_MASKS(node)
+#endif
+
+static bool isAcknowledged(Node node, SlotNum queriedPendingSlot);
+static bool oneHopSlotIsExpired(Node node, SlotNum currentSlot, int64_t timeout);
+static void updateMultiHopSlotMap(Node node, Message msg, SlotStatusArray *multiHopSlotMapStatus, int8_t *multiHopSlotMapIds, int64_t *multiHopSlotMapLastUpdate, 
+  SlotMasksStruct *multiHopSlotMapMasks, int16_t firstTimer);
+static bool slotReportedColliding(Message msg, SlotNum slotNum);
+static bool slotReportedOccupiedByOtherNode(Node node, Message msg, SlotNum slotNum);
+static void removeExpiredSlotsFromSlotMap(Node node, SlotStatusArray *slotMapStatus, int8_t *slotMapIds, int64_t *slotMapLastUpdated, SlotMasksStruct *slotMapMasks, 
+  int16_t firstTimer);
+static void scheduleSlotTimer(Node node, SlotStatusArray *slotMapStatus, int64_t *slotMapLastUpdated, int16_t firstTimer, int slotIdx);
+static void scheduleSlotTimersOfSlot(Node node, SlotNum slotNum);
+static void schedulePendingSlotTimer(Node node, int16_t idx);
+static void scheduleOwnSlotTimer(Node node, int16_t idx);
+static void scheduleAllTimers(Node node);
+static void setSlot(Node node, SlotStatusArray *slotMapStatus, int8_t *slotMapIds, SlotMasksStruct *slotMapMasks, int slotIdx, int status, int8_t id);
+static void rebuildMasks(Node node, SlotStatusArray *slotMapStatus, int8_t *slotMapIds, SlotMasksStruct *slotMapMasks);
+static void unpackStatus(const SlotStatusArray *packed, int *buffer);
+static bool slotIsInFrame(SlotNum slotNum);
+static bool maskContains(const SlotMask *mask, SlotNum slotNum);
+static void addToMask(SlotMask *mask, SlotNum slotNum);
+static void removeFromMask(SlotMask *mask, SlotNum slotNum);
+static bool maskIsEmpty(const SlotMask *mask);
+static int16_t countSlots(const SlotMask *slots);
+static SlotNum getNthSlot(const SlotMask *slots, int16_t n);
+static SlotNum getNextSlotAfter(const SlotMask *slots, SlotNum slotNum);
+static uint64_t findFreeSlotsInThreeHopNeighborhood(SlotMap slotMap, int16_t word);
+static uint64_t findFreeForThisNodeSlotsInThreeHopNeighborhood(SlotMap slotMap, int16_t word);
+static uint64_t findSlotsOccupiedByOtherNodes(SlotMap slotMap, int16_t word);
+static uint64_t findCollidingSlotsInThreeHopNeighborhood(SlotMap slotMap, int16_t word);
+static void combineMasks(SlotMap slotMap, int16_t word, CombinedSlotMasksStruct *combined);
+static void updateCombinedMasksOfSlot(SlotMap slotMap, SlotNum slotNum);
+static void updateAllCombinedMasks(SlotMap slotMap);
+#ifdef SLOT_MAP_CHECK
+static void checkCombinedMasks(Node node);
+#endif
 
 SlotMap SlotMap_Create() {
   SlotMap self = calloc(1, sizeof(SlotMapStruct));
@@ -57,18 +92,23 @@ SlotMap SlotMap_Create() {
 
   // initialize all slot maps
   for(int i = 0; i < NUM_SLOTS; ++i) {
-    self->oneHopSlotsStatus[i] = FREE;
+    SlotStatus_Set(&self->oneHopSlotsStatus, i, FREE);
     self->oneHopSlotsIds[i] = 0;
     self->oneHopSlotsLastUpdated[i] = 0;
 
-    self->twoHopSlotsStatus[i] = FREE;
+    SlotStatus_Set(&self->twoHopSlotsStatus, i, FREE);
     self->twoHopSlotsIds[i] = 0;
     self->twoHopSlotsLastUpdated[i] = 0;
 
-    self->threeHopSlotsStatus[i] = FREE;
+    SlotStatus_Set(&self->threeHopSlotsStatus, i, FREE);
     self->threeHopSlotsIds[i] = 0;
     self->threeHopSlotsLastUpdated[i] = 0;
+
+    self->oneHopSlotsMasks.free.words[SLOT_WORD(i)] |= SLOT_BIT(i);
+    self->twoHopSlotsMasks.free.words[SLOT_WORD(i)] |= SLOT_BIT(i);
+    self->threeHopSlotsMasks.free.words[SLOT_WORD(i)] |= SLOT_BIT(i);
   };
+  updateAllCombinedMasks(self);
 
   // initialize all pending slots to -1, to signal there are none
   for(int i = 0; i < MAX_NUM_PENDING_SLOTS; ++i) {
@@ -85,16 +125,43 @@ SlotMap SlotMap_Create() {
   return self;
 };
 
-void SlotMap_UpdateOneHopSlotMap(Node node, Message msg, int8_t currentSlot) {
+void SlotMap_RebuildMasks(Node node) {
+  SlotMap slotMap = node->slotMap;
+  rebuildMasks(node, &slotMap->oneHopSlotsStatus, &slotMap->oneHopSlotsIds[0], &slotMap->oneHopSlotsMasks);
+  rebuildMasks(node, &slotMap->twoHopSlotsStatus, &slotMap->twoHopSlotsIds[0], &slotMap->twoHopSlotsMasks);
+  rebuildMasks(node, &slotMap->threeHopSlotsStatus, &slotMap->threeHopSlotsIds[0], &slotMap->threeHopSlotsMasks);
+
+  memset(&slotMap->ownSlotsMask, 0, sizeof(SlotMask));
+  for (int i = 0; i < slotMap->numOwnSlots; ++i) {
+    addToMask(&slotMap->ownSlotsMask, slotMap->ownSlots[i]);
+  };
+  memset(&slotMap->pendingSlotsMask, 0, sizeof(SlotMask));
+  for (int i = 0; i < slotMap->numPendingSlots; ++i) {
+    addToMask(&slotMap->pendingSlotsMask, slotMap->pendingSlots[i]);
+  };
+  updateAllCombinedMasks(slotMap);
+  scheduleAllTimers(node);
+};
+
+bool SlotMap_CombinedMasksAreConsistent(Node node) {
+  // recompute all words from the bit sets of the slot maps and compare them with the incrementally updated ones
+  CombinedSlotMasksStruct recomputed;
+  for (int16_t w = 0; w < SLOT_MASK_WORDS; ++w) {
+    combineMasks(node->slotMap, w, &recomputed);
+  };
+  return memcmp(&recomputed, &node->slotMap->combinedMasks, sizeof(CombinedSlotMasksStruct)) == 0;
+};
+
+void SlotMap_UpdateOneHopSlotMap(Node node, Message msg, SlotNum currentSlot) {
   /** One hop slot map contains all slot reservations this node receives directly;
   *   currentSlot is the slot that will be upated in the one hop slot map by this function,
   *   because it is the slot in which this message was received
   */
 
   // convert slot num to index by subtracting 1
-  int8_t currentSlotIndex = currentSlot - 1; 
+  int16_t currentSlotIndex = currentSlot - 1; 
   // current status of the slot in one hop slot map
-  int currentStatus = node->slotMap->oneHopSlotsStatus[currentSlotIndex]; 
+  int currentStatus = SlotStatus_Get(&node->slotMap->oneHopSlotsStatus, currentSlotIndex); 
 
   int64_t localTime = ProtocolClock_GetLocalTime(node->clock);
   switch(msg->type) {
@@ -108,8 +175,8 @@ void SlotMap_UpdateOneHopSlotMap(Node node, Message msg, int8_t currentSlot) {
         case FREE:
           // if the slot is currently FREE, it is immediately overwritten with
           // the new values
-          node->slotMap->oneHopSlotsStatus[currentSlotIndex] = OCCUPIED;
-          node->slotMap->oneHopSlotsIds[currentSlotIndex] = newId;
+          setSlot(node, &node->slotMap->oneHopSlotsStatus, &node->slotMap->oneHopSlotsIds[0], &node->slotMap->oneHopSlotsMasks, 
+            currentSlotIndex, OCCUPIED, newId);
           node->slotMap->oneHopSlotsLastUpdated[currentSlotIndex] = localTime;
           break;
 
@@ -123,8 +190,8 @@ void SlotMap_UpdateOneHopSlotMap(Node node, Message msg, int8_t currentSlot) {
             // when the slot is expired (the node that currently reserved the slot did not use 
             // it for a while), otherwise, the current node will keep the slot
             if(oneHopSlotIsExpired(node, currentSlot, node->config->occupiedTimeout)) {
-              node->slotMap->oneHopSlotsStatus[currentSlotIndex] = OCCUPIED;
-              node->slotMap->oneHopSlotsIds[currentSlotIndex] = newId;
+              setSlot(node, &node->slotMap->oneHopSlotsStatus, &node->slotMap->oneHopSlotsIds[0], &node->slotMap->oneHopSlotsMasks, 
+                currentSlotIndex, OCCUPIED, newId);
               node->slotMap->oneHopSlotsLastUpdated[currentSlotIndex] = localTime;
             };
           };
@@ -134,12 +201,15 @@ void SlotMap_UpdateOneHopSlotMap(Node node, Message msg, int8_t currentSlot) {
           // if the slot is currently colliding, we only overwrite it if the collision
           // is expired
           if(oneHopSlotIsExpired(node, currentSlot, node->config->collidingTimeout)) {
-            node->slotMap->oneHopSlotsStatus[currentSlotIndex] = OCCUPIED;
-            node->slotMap->oneHopSlotsIds[currentSlotIndex] = newId;
+            setSlot(node, &node->slotMap->oneHopSlotsStatus, &node->slotMap->oneHopSlotsIds[0], &node->slotMap->oneHopSlotsMasks, 
+              currentSlotIndex, OCCUPIED, newId);
             node->slotMap->oneHopSlotsLastUpdated[currentSlotIndex] = localTime;
           };
           break;
       };
+      updateCombinedMasksOfSlot(node->slotMap, currentSlot);
+      scheduleSlotTimer(node, &node->slotMap->oneHopSlotsStatus, &node->slotMap->oneHopSlotsLastUpdated[0], TIMER_WHEEL_ONE_HOP_SLOTS, 
+        currentSlotIndex);
 
       /** if the ping is a new reservation attempt, record that;
       /   it is considered a new reservation if the two hop slot map in the message does not state this slot as 
@@ -157,31 +227,42 @@ void SlotMap_UpdateTwoHopSlotMap(Node node, Message msg) {
   /** To update the two hop slot map of this node, the information from the one hop slot map 
   *   from the message is used (one hop of the neighbor node is two hop of this node)
   */
-  msg->multiHopStatus = &msg->oneHopSlotStatus[0];
+  msg->multiHopStatus = &msg->oneHopSlotStatus;
   msg->multiHopIds = &msg->oneHopSlotIds[0];
 
-  updateMultiHopSlotMap(node, msg, &node->slotMap->twoHopSlotsStatus[0], &node->slotMap->twoHopSlotsIds[0], &node->slotMap->twoHopSlotsLastUpdated[0]);
+  updateMultiHopSlotMap(node, msg, &node->slotMap->twoHopSlotsStatus, &node->slotMap->twoHopSlotsIds[0], &node->slotMap->twoHopSlotsLastUpdated[0], 
+    &node->slotMap->twoHopSlotsMasks, TIMER_WHEEL_TWO_HOP_SLOTS);
+
+  // own slots expire with their last update in the two hop slot map
+  for (int16_t i = 0; i < node->slotMap->numOwnSlots; ++i) {
+    scheduleOwnSlotTimer(node, i);
+  };
 };
 
 void SlotMap_UpdateThreeHopSlotMap(Node node, Message msg) {
   /** To update the three hop slot map of this node, the information from the two hop slot map 
   *   from the message is used (two hop of the neighbor node is three hop of this node)
   */
-  msg->multiHopStatus = &msg->twoHopSlotStatus[0];
+  msg->multiHopStatus = &msg->twoHopSlotStatus;
   msg->multiHopIds = &msg->twoHopSlotIds[0];
 
-  updateMultiHopSlotMap(node, msg, &node->slotMap->threeHopSlotsStatus[0], &node->slotMap->threeHopSlotsIds[0], &node->slotMap->threeHopSlotsLastUpdated[0]);
+  updateMultiHopSlotMap(node, msg, &node->slotMap->threeHopSlotsStatus, &node->slotMap->threeHopSlotsIds[0], &node->slotMap->threeHopSlotsLastUpdated[0], 
+    &node->slotMap->threeHopSlotsMasks, TIMER_WHEEL_THREE_HOP_SLOTS);
 };
 
-bool SlotMap_GetOneHopSlotMapStatus(Node node, int *buffer, int8_t size) {
+bool SlotMap_GetOneHopSlotMapStatus(Node node, int *buffer, int16_t size) {
   if(size < NUM_SLOTS) {
     return false;
   };
-  memcpy(buffer, &node->slotMap->oneHopSlotsStatus[0], sizeof(int) * size);
+  unpackStatus(&node->slotMap->oneHopSlotsStatus, buffer);
   return true;
 };
 
-bool SlotMap_GetOneHopSlotMapIds(Node node, int8_t *buffer, int8_t size) {
+void SlotMap_GetOneHopSlotMapPackedStatus(Node node, SlotStatusArray *buffer) {
+  *buffer = node->slotMap->oneHopSlotsStatus;
+};
+
+bool SlotMap_GetOneHopSlotMapIds(Node node, int8_t *buffer, int16_t size) {
   if(size < NUM_SLOTS) {
     return false;
   };
@@ -190,15 +271,19 @@ bool SlotMap_GetOneHopSlotMapIds(Node node, int8_t *buffer, int8_t size) {
 };
 
 
-bool SlotMap_GetTwoHopSlotMapStatus(Node node, int *buffer, int8_t size) {
+bool SlotMap_GetTwoHopSlotMapStatus(Node node, int *buffer, int16_t size) {
   if(size < NUM_SLOTS) {
     return false;
   };
-  memcpy(buffer, &node->slotMap->twoHopSlotsStatus[0], sizeof(int) * size);
+  unpackStatus(&node->slotMap->twoHopSlotsStatus, buffer);
   return true;
 };
 
-bool SlotMap_GetTwoHopSlotMapIds(Node node, int8_t *buffer, int8_t size) {
+void SlotMap_GetTwoHopSlotMapPackedStatus(Node node, SlotStatusArray *buffer) {
+  *buffer = node->slotMap->twoHopSlotsStatus;
+};
+
+bool SlotMap_GetTwoHopSlotMapIds(Node node, int8_t *buffer, int16_t size) {
   if(size < NUM_SLOTS) {
     return false;
   }; 
@@ -206,15 +291,15 @@ bool SlotMap_GetTwoHopSlotMapIds(Node node, int8_t *buffer, int8_t size) {
   return true;
 };
 
-bool SlotMap_GetThreeHopSlotMapStatus(Node node, int *buffer, int8_t size) {
+bool SlotMap_GetThreeHopSlotMapStatus(Node node, int *buffer, int16_t size) {
   if(size < NUM_SLOTS) {
     return false;
   };
-  memcpy(buffer, &node->slotMap->threeHopSlotsStatus[0], sizeof(int) * size);
+  unpackStatus(&node->slotMap->threeHopSlotsStatus, buffer);
   return true;
 };
 
-bool SlotMap_GetThreeHopSlotMapIds(Node node, int8_t *buffer, int8_t size) {
+bool SlotMap_GetThreeHopSlotMapIds(Node node, int8_t *buffer, int16_t size) {
   if(size < NUM_SLOTS) {
     return false;
   };
@@ -222,7 +307,7 @@ bool SlotMap_GetThreeHopSlotMapIds(Node node, int8_t *buffer, int8_t size) {
   return true;
 };
 
-int8_t SlotMap_CheckOwnSlotsForCollisions(Node node, Message msg, int8_t *buffer, int8_t size) {
+int8_t SlotMap_CheckOwnSlotsForCollisions(Node node, Message msg, SlotNum *buffer, int16_t size) {
   int8_t numOwnSlots = node->slotMap->numOwnSlots;
   if(size < numOwnSlots) {
     return -1;
@@ -241,7 +326,7 @@ int8_t SlotMap_CheckOwnSlotsForCollisions(Node node, Message msg, int8_t *buffer
   return collidingSlotCnt;
 };
 
-int8_t SlotMap_CheckPendingSlotsForCollisions(Node node, Message msg, int8_t *buffer, int8_t size) {
+int8_t SlotMap_CheckPendingSlotsForCollisions(Node node, Message msg, SlotNum *buffer, int16_t size) {
   int8_t numPendingSlots = node->slotMap->numPendingSlots;
   if(size < numPendingSlots)
     return -1;
@@ -267,55 +352,57 @@ bool SlotMap_SlotReservationGoalMet(Node node) {
   return false;
 };
 
-int8_t SlotMap_GetReservableSlot(Node node) {
+SlotNum SlotMap_GetReservableSlot(Node node) {
   /** A slot is considered reservable by this node if it is either free for a three hop neighborhood
   *   (meaning in all three slot maps of this node) or if it is colliding in any one of the three slot maps
   *   of this node and at the same time not reported/perceived as occupied by a node; colliding slots must 
   *   be considered reservable to avoid deadlocks (e.g. two nodes trying to reserve the last two free slots 
   *   alternatingly)
   */
-  int8_t freeSlots[NUM_SLOTS];
-  int8_t numFreeSlots = findFreeForThisNodeSlotsInThreeHopNeighborhood(node, &freeSlots[0]);
+  CHECK_COMBINED_MASKS(node);
+  SlotMap slotMap = node->slotMap;
+  int16_t numReservableSlots = countSlots(&slotMap->combinedMasks.reservable);
 
-  int8_t collidingSlots[NUM_SLOTS];
-  int8_t numCollidingSlots = findCollidingSlotsInThreeHopNeighborhood(node, &collidingSlots[0]);
-
-  int16_t reservableSlots[NUM_SLOTS]; // maximum number of slots that can be reservable are all slots
+  if (numReservableSlots == 0) {
+    return -1;
+  };
 
-  for (int i = 0; i < numFreeSlots; ++i) {
-    reservableSlots[i] = freeSlots[i];
+  // get one random slot of all reservable ones; they are numbered for the random choice in this order: the free slots, 
+  // then the colliding slots of the one, two and three hop slot map (each in ascending order)
+  int64_t randomIdx = RandomNumbers_GetRandomIntBetween(node, 0, (numReservableSlots - 1));
+  int16_t numFreeSlots = countSlots(&slotMap->combinedMasks.freeForThisNode);
+  if (randomIdx < numFreeSlots) {
+    return getNthSlot(&slotMap->combinedMasks.freeForThisNode, (int16_t) randomIdx);
   };
-  for (int i = 0; i < numCollidingSlots; ++i) {
-    reservableSlots[i + numFreeSlots] = collidingSlots[i];
+  randomIdx -= numFreeSlots;
+
+  // the colliding slots are only split by slot map if one of them was chosen
+  SlotMask selections[3];
+  for (int16_t w = 0; w < SLOT_MASK_WORDS; ++w) {
+    uint64_t occupiedByOtherNodes = slotMap->combinedMasks.occupiedByOtherNodes.words[w];
+    selections[0].words[w] = slotMap->oneHopSlotsMasks.colliding.words[w] & ~occupiedByOtherNodes;
+    selections[1].words[w] = slotMap->twoHopSlotsMasks.colliding.words[w] & ~occupiedByOtherNodes & ~selections[0].words[w];
+    selections[2].words[w] = slotMap->threeHopSlotsMasks.colliding.words[w] & ~occupiedByOtherNodes & ~selections[0].words[w] & ~selections[1].words[w];
   };
-
-  if ((numFreeSlots+numCollidingSlots) == 0) {
-    return -1;
+  for (int i = 0; i < 3; ++i) {
+    int16_t numSlots = countSlots(&selections[i]);
+    if (randomIdx < numSlots) {
+      return getNthSlot(&selections[i], (int16_t) randomIdx);
+    };
+    randomIdx -= numSlots;
   };
-
-  // get one random slot of all reservable ones
-  int16_t randomSlot = RandomNumbers_GetRandomElementFrom(node, &reservableSlots[0], (numFreeSlots+numCollidingSlots));
-
-  return (int8_t) randomSlot;
+  return -1;
 };
 
-int8_t SlotMap_CalculateNextOwnOrPendingSlotNum(Node node, int8_t currentSlot) {
-  // total number of own and pending slots
-  int16_t numOwnAndPending = node->slotMap->numOwnSlots + node->slotMap->numPendingSlots;
-
-  if (numOwnAndPending == 0) {
-    return -1;
+SlotNum SlotMap_CalculateNextOwnOrPendingSlotNum(Node node, SlotNum currentSlot) {
+  // combine own and pending slots into one bit set
+  SlotMask ownAndPending;
+  for (int16_t w = 0; w < SLOT_MASK_WORDS; ++w) {
+    ownAndPending.words[w] = node->slotMap->ownSlotsMask.words[w] | node->slotMap->pendingSlotsMask.words[w];
   };
 
-  // copy all own and pending slots into an array
-  int8_t selection[MAX_NUM_OWN_SLOTS + MAX_NUM_PENDING_SLOTS];
-  memcpy(&selection[0], &node->slotMap->ownSlots[0], sizeof(int8_t) * node->slotMap->numOwnSlots);
-  memcpy(&selection[node->slotMap->numOwnSlots], &node->slotMap->pendingSlots[0], sizeof(int8_t) * node->slotMap->numPendingSlots);
-
-  // get the slot that comes next from all own and pending slots
-  int8_t nextSlot = getNextSlotFromSelection(node, &selection[0], numOwnAndPending);
-
-  return nextSlot;
+  // get the slot that comes next from all own and pending slots (-1 if there are none)
+  return getNextSlotAfter(&ownAndPending, TimeKeeping_CalculateCurrentSlotNum(node));
 };
 
 void SlotMap_UpdatePendingSlotAcks(Node node, Message msg) {
@@ -325,7 +412,7 @@ void SlotMap_UpdatePendingSlotAcks(Node node, Message msg) {
       return;
     };
     // check if the current pending slot was acknowledged in this message
-    int8_t pendingSlotNum = node->slotMap->pendingSlots[i];
+    SlotNum pendingSlotNum = node->slotMap->pendingSlots[i];
     if(msg->oneHopSlotIds[pendingSlotNum - 1] == node->id) { // subtract -1 from the slot num to convert it to an index of the array
       // slot was acknowledged, so add the ID of the acknowledging node
       for(int j = 0; j < (MAX_NUM_NODES - 1); ++j) {
@@ -338,7 +425,7 @@ void SlotMap_UpdatePendingSlotAcks(Node node, Message msg) {
   };
 };
 
-bool SlotMap_AddPendingSlot(Node node, int8_t slotNum, int8_t *neighborsArray, int8_t neighborsArraySize) {
+bool SlotMap_AddPendingSlot(Node node, SlotNum slotNum, int8_t *neighborsArray, int8_t neighborsArraySize) {
   int8_t numPending = node->slotMap->numPendingSlots; // numPending is also the index of the first "free" element of the pendingSlots array
   if (numPending == MAX_NUM_PENDING_SLOTS) {
       return false; // cannot add another pending slot
@@ -353,16 +440,26 @@ bool SlotMap_AddPendingSlot(Node node, int8_t slotNum, int8_t *neighborsArray, i
   };
 
   node->slotMap->numPendingSlots = numPending + 1;
+  addToMask(&node->slotMap->pendingSlotsMask, slotNum);
+  updateCombinedMasksOfSlot(node->slotMap, slotNum);
+  schedulePendingSlotTimer(node, numPending);
+  TRACE_RECORD(node, TRACE_SLOT_PENDING, 0, 0, slotNum);
   return true;
 };
 
-bool SlotMap_ChangePendingToOwn(Node node, int8_t slotNum) {
+bool SlotMap_ChangePendingToOwn(Node node, SlotNum slotNum) {
   for(int i = 0; i < node->slotMap->numPendingSlots; ++i) {
     if (node->slotMap->pendingSlots[i] == slotNum) {
       // add to own slots
       int8_t numOwn = node->slotMap->numOwnSlots; // numOwn is also the index of the first "free" element of the ownSlots array
       node->slotMap->ownSlots[numOwn] = slotNum;
       ++node->slotMap->numOwnSlots;
+      addToMask(&node->slotMap->ownSlotsMask, slotNum);
+      updateCombinedMasksOfSlot(node->slotMap, slotNum);
+      scheduleOwnSlotTimer(node, numOwn);
+      // own slots expire later in the slot maps
+      scheduleSlotTimersOfSlot(node, slotNum);
+      TRACE_RECORD(node, TRACE_SLOT_RESERVED, 0, 0, slotNum);
 
       SlotMap_ReleasePendingSlot(node, slotNum);
       return true;
@@ -371,102 +468,72 @@ bool SlotMap_ChangePendingToOwn(Node node, int8_t slotNum) {
   return false;
 };
 
-bool SlotMap_OwnNetworkExists(Node node, int8_t *collidingSlots, int8_t collidingSlotsSize) {
+bool SlotMap_OwnNetworkExists(Node node, SlotNum *collidingSlots, int16_t collidingSlotsSize) {
   
   // check if another node in this network has reserved a slot;
   // if so, the creation was successful and this network exists
-  for (int i = 0; i < NUM_SLOTS; ++i) {
-    if (node->slotMap->oneHopSlotsStatus[i] == OCCUPIED) {
-      return true;
-    };
+  if (!maskIsEmpty(&node->slotMap->oneHopSlotsMasks.occupied)) {
+    return true;
   };
 
   // no other node has reserved a slot, so check if all own or pending slots are colliding
-  // find own slots reported as colliding
-  int8_t collidingOwnSlots[MAX_NUM_OWN_SLOTS];
-  int8_t numCollidingOwnSlots = 0;
+  SlotMask reportedColliding;
+  memset(&reportedColliding, 0, sizeof(SlotMask));
   for (int i = 0; i < collidingSlotsSize; ++i) {
-    int8_t idx = Util_Int8tArrayFindElement(&node->slotMap->ownSlots[0], collidingSlots[i], node->slotMap->numOwnSlots);
-    if (idx != -1) {
-      collidingOwnSlots[numCollidingOwnSlots] = node->slotMap->ownSlots[idx];
-      ++numCollidingOwnSlots;
-    };
+    addToMask(&reportedColliding, collidingSlots[i]);
   };
 
-  // find pending slots reported as colliding
-  int8_t collidingPendingSlots[MAX_NUM_PENDING_SLOTS];
-  int8_t numCollidingPendingSlots = 0;
-  for (int i = 0; i < collidingSlotsSize; ++i) {
-    int8_t idx = Util_Int8tArrayFindElement(&node->slotMap->pendingSlots[0], collidingSlots[i], node->slotMap->numPendingSlots);
-    if (idx != -1) {
-      collidingPendingSlots[numCollidingPendingSlots] = node->slotMap->pendingSlots[idx];
-      ++numCollidingPendingSlots;
+  for (int16_t w = 0; w < SLOT_MASK_WORDS; ++w) {
+    if (((node->slotMap->ownSlotsMask.words[w] | node->slotMap->pendingSlotsMask.words[w]) & ~reportedColliding.words[w]) != 0) {
+      // not all own and pending slots are colliding, so the network does exist
+      return true;
     };
   };
-
-  if ((node->slotMap->numOwnSlots == numCollidingOwnSlots) && (node->slotMap->numPendingSlots == numCollidingPendingSlots)) {
-    // all own and pending slots are colliding, so the network does not exist
-    return false;
-  };
-  // not all own and pending slots are colliding, so the network does exist
-  return true;
+  // all own and pending slots are colliding, so the network does not exist
+  return false;
 };
 
 bool SlotMap_ClearToSend(Node node) {
-  int8_t currentSlot = TimeKeeping_CalculateCurrentSlotNum(node);
-  // it is okay to send if the current slot is free, colliding or reserved by this node or if no frame has started (no network yet)
-  return (SlotMap_SlotIsFreeForThisNode(node, currentSlot) || SlotMap_SlotIsColliding(node, currentSlot) || 
-    SlotMap_IsOwnSlot(node, currentSlot) || SlotMap_IsPendingSlot(node, currentSlot) || currentSlot == 0);
-};
-
-bool SlotMap_SlotIsFree(Node node, int8_t slotNum) {
-  // find all "three hop free" slots
-  int8_t freeSlots[NUM_SLOTS];
-  int8_t numFreeSlots = findFreeSlotsInThreeHopNeighborhood(node, &freeSlots[0]);
-
-  // check if the queried slot is among the free slots
-  int16_t idx = Util_Int8tArrayFindElement(&freeSlots[0], slotNum, numFreeSlots);
-  if (idx != -1) {
-    // slot was found (index is not -1), so it is free
+  SlotNum currentSlot = TimeKeeping_CalculateCurrentSlotNum(node);
+  if (currentSlot == 0) {
+    // no frame has started (no network yet)
     return true;
   };
+  if (!slotIsInFrame(currentSlot)) {
+    return false;
+  };
 
-  // slot was not found, so it is not free
-  return false;
+  // it is okay to send if the current slot is free, colliding or reserved by this node
+  CHECK_COMBINED_MASKS(node);
+  return maskContains(&node->slotMap->combinedMasks.clearToSend, currentSlot);
 };
 
-bool SlotMap_SlotIsFreeForThisNode(Node node, int8_t slotNum) {
-  // find all "three hop free" slots and slots that are reported being occupied by this node
-  int8_t freeSlots[NUM_SLOTS];
-  int8_t numFreeSlots = findFreeForThisNodeSlotsInThreeHopNeighborhood(node, &freeSlots[0]);
-  
-  // check if the queried slot is among the free slots
-  int16_t idx = Util_Int8tArrayFindElement(&freeSlots[0], slotNum, numFreeSlots);
-  if (idx != -1) {
-    // slot was found (index is not -1)
-    return true;
+bool SlotMap_SlotIsFree(Node node, SlotNum slotNum) {
+  if (!slotIsInFrame(slotNum)) {
+    return false;
   };
-
-  // slot was not found, so it is not free
-  return false;
+  // slot is free if it is free in all three slot maps
+  return (findFreeSlotsInThreeHopNeighborhood(node->slotMap, SLOT_WORD(slotNum - 1)) & SLOT_BIT(slotNum - 1)) != 0;
 };
 
-bool SlotMap_SlotIsColliding(Node node, int8_t slotNum) {
-  // find all colliding slots
-  int8_t collidingSlots[NUM_SLOTS];
-  int8_t numCollidingSlots = findCollidingSlotsInThreeHopNeighborhood(node, &collidingSlots[0]);
+bool SlotMap_SlotIsFreeForThisNode(Node node, SlotNum slotNum) {
+  if (!slotIsInFrame(slotNum)) {
+    return false;
+  };
+  // slot is free for this node if it is free or reported being occupied by this node in all three slot maps
+  CHECK_COMBINED_MASKS(node);
+  return maskContains(&node->slotMap->combinedMasks.freeForThisNode, slotNum);
+};
 
-  // check if the queries slot is among the colliding slots
-  int16_t idx = Util_Int8tArrayFindElement(&collidingSlots[0], slotNum, numCollidingSlots);
-  if (idx != -1) {
-    // slot was found (index is not -1), so it is colliding
-    return true;
+bool SlotMap_SlotIsColliding(Node node, SlotNum slotNum) {
+  if (!slotIsInFrame(slotNum)) {
+    return false;
   };
-  // slot was not found, so it is not colliding
-  return false;
+  CHECK_COMBINED_MASKS(node);
+  return maskContains(&node->slotMap->combinedMasks.colliding, slotNum);
 };
 
-int8_t SlotMap_GetAcknowledgedPendingSlots(Node node, int8_t *buffer, int8_t size) {
+int8_t SlotMap_GetAcknowledgedPendingSlots(Node node, SlotNum *buffer, int16_t size) {
   if(size < node->slotMap->numPendingSlots) {
     // buffer too small
     return -1;
@@ -481,7 +548,7 @@ int8_t SlotMap_GetAcknowledgedPendingSlots(Node node, int8_t *buffer, int8_t siz
   return numAcknowledged;
 };
 
-int8_t SlotMap_GetPendingSlots(Node node, int8_t *buffer, int8_t size) {
+int8_t SlotMap_GetPendingSlots(Node node, SlotNum *buffer, int16_t size) {
   
   if(size < node->slotMap->numPendingSlots) {
     // buffer too small
@@ -494,7 +561,7 @@ int8_t SlotMap_GetPendingSlots(Node node, int8_t *buffer, int8_t size) {
   return node->slotMap->numPendingSlots;
 };
 
-int8_t SlotMap_GetOwnSlots(Node node, int8_t *buffer, int8_t size) {
+int8_t SlotMap_GetOwnSlots(Node node, SlotNum *buffer, int16_t size) {
   if(size < node->slotMap->numOwnSlots) {
     // buffer too small
     return -1;
@@ -510,30 +577,16 @@ int64_t SlotMap_GetLastReservationTime(Node node) {
   return node->slotMap->lastReservationTime;
 };
 
-bool SlotMap_IsOwnSlot(Node node, int8_t slotNum) {
-  // check if the queried slotNum is in the own slots array
-  int8_t idx = Util_Int8tArrayFindElement(&node->slotMap->ownSlots[0], slotNum, node->slotMap->numOwnSlots);
-  if (idx == -1) {
-    // slotNum was not found
-    return false;
-  };
-  // slotNum was found
-  return true;
+bool SlotMap_IsOwnSlot(Node node, SlotNum slotNum) {
+  return maskContains(&node->slotMap->ownSlotsMask, slotNum);
 };
 
-bool SlotMap_IsPendingSlot(Node node, int8_t slotNum) {
-  // check if the queried slotNum is in the pending slots array
-  int8_t idx = Util_Int8tArrayFindElement(&node->slotMap->pendingSlots[0], slotNum, node->slotMap->numPendingSlots);
-  if (idx == -1) {
-    // slotNum was not found
-    return false;
-  };
-  // slotNum was found
-  return true;
+bool SlotMap_IsPendingSlot(Node node, SlotNum slotNum) {
+  return maskContains(&node->slotMap->pendingSlotsMask, slotNum);
 };
 
-bool SlotMap_ReleaseOwnSlot(Node node, int8_t slotNum) {
-  int8_t idx = Util_Int8tArrayFindElement(&node->slotMap->ownSlots[0], slotNum, node->slotMap->numOwnSlots);
+bool SlotMap_ReleaseOwnSlot(Node node, SlotNum slotNum) {
+  int8_t idx = Util_Int16tArrayFindElement(&node->slotMap->ownSlots[0], slotNum, node->slotMap->numOwnSlots);
   if (idx == -1) {
     // slotNum is not own slot
     return false;
@@ -544,11 +597,21 @@ bool SlotMap_ReleaseOwnSlot(Node node, int8_t slotNum) {
   int8_t newNumOwn = --node->slotMap->numOwnSlots; 
   // let last element of ownSlots array overwrite the own slot that has to be removed (as order is not important)
   node->slotMap->ownSlots[idx] = node->slotMap->ownSlots[newNumOwn]; 
+  TimerWheel_Cancel(node->timerWheel, TIMER_WHEEL_OWN_SLOTS + newNumOwn);
+  if (idx < newNumOwn) {
+    scheduleOwnSlotTimer(node, idx);
+  };
+  // the slot could have been added twice
+  if (Util_Int16tArrayFindElement(&node->slotMap->ownSlots[0], slotNum, newNumOwn) == -1) {
+    removeFromMask(&node->slotMap->ownSlotsMask, slotNum);
+    updateCombinedMasksOfSlot(node->slotMap, slotNum);
+    scheduleSlotTimersOfSlot(node, slotNum);
+  };
   return true;
 };
 
-bool SlotMap_ReleasePendingSlot(Node node, int8_t slotNum) {
-  int8_t idx = Util_Int8tArrayFindElement(&node->slotMap->pendingSlots[0], slotNum, node->slotMap->numPendingSlots);
+bool SlotMap_ReleasePendingSlot(Node node, SlotNum slotNum) {
+  int8_t idx = Util_Int16tArrayFindElement(&node->slotMap->pendingSlots[0], slotNum, node->slotMap->numPendingSlots);
   if (idx == -1) {
     // slotNum is not pending slot
     return false;
@@ -561,6 +624,15 @@ bool SlotMap_ReleasePendingSlot(Node node, int8_t slotNum) {
   node->slotMap->pendingSlots[idx] = node->slotMap->pendingSlots[newNumPending]; 
   // set the slot that has overwritten the other to -1 again
   node->slotMap->pendingSlots[newNumPending] = -1; 
+  TimerWheel_Cancel(node->timerWheel, TIMER_WHEEL_PENDING_SLOTS + newNumPending);
+  if (idx < newNumPending) {
+    schedulePendingSlotTimer(node, idx);
+  };
+  // the slot could have been added twice
+  if (Util_Int16tArrayFindElement(&node->slotMap->pendingSlots[0], slotNum, newNumPending) == -1) {
+    removeFromMask(&node->slotMap->pendingSlotsMask, slotNum);
+    updateCombinedMasksOfSlot(node->slotMap, slotNum);
+  };
   // make sure to do the same for the nodes who acknowledged or need to acknowledge the other pending slot
   for (int i = 0; i < (MAX_NUM_NODES - 1); ++i) {
     node->slotMap->pendingSlotAcknowledgedBy[idx][i] = node->slotMap->pendingSlotAcknowledgedBy[newNumPending][i];
@@ -572,54 +644,85 @@ bool SlotMap_ReleasePendingSlot(Node node, int8_t slotNum) {
 };
 
 void SlotMap_RemoveExpiredSlotsFromOneHopSlotMap(Node node) {
-  removeExpiredSlotsFromSlotMap(node, &node->slotMap->oneHopSlotsStatus[0], &node->slotMap->oneHopSlotsIds[0], &node->slotMap->oneHopSlotsLastUpdated[0]);
+  removeExpiredSlotsFromSlotMap(node, &node->slotMap->oneHopSlotsStatus, &node->slotMap->oneHopSlotsIds[0], &node->slotMap->oneHopSlotsLastUpdated[0], 
+    &node->slotMap->oneHopSlotsMasks, TIMER_WHEEL_ONE_HOP_SLOTS);
 };
 
 void SlotMap_RemoveExpiredSlotsFromTwoHopSlotMap(Node node) {
-  removeExpiredSlotsFromSlotMap(node, &node->slotMap->twoHopSlotsStatus[0], &node->slotMap->twoHopSlotsIds[0], &node->slotMap->twoHopSlotsLastUpdated[0]);
+  removeExpiredSlotsFromSlotMap(node, &node->slotMap->twoHopSlotsStatus, &node->slotMap->twoHopSlotsIds[0], &node->slotMap->twoHopSlotsLastUpdated[0], 
+    &node->slotMap->twoHopSlotsMasks, TIMER_WHEEL_TWO_HOP_SLOTS);
 };
 
 void SlotMap_RemoveExpiredSlotsFromThreeHopSlotMap(Node node) {
-  removeExpiredSlotsFromSlotMap(node, &node->slotMap->threeHopSlotsStatus[0], &node->slotMap->threeHopSlotsIds[0], &node->slotMap->threeHopSlotsLastUpdated[0]);
+  removeExpiredSlotsFromSlotMap(node, &node->slotMap->threeHopSlotsStatus, &node->slotMap->threeHopSlotsIds[0], &node->slotMap->threeHopSlotsLastUpdated[0], 
+    &node->slotMap->threeHopSlotsMasks, TIMER_WHEEL_THREE_HOP_SLOTS);
 };
 
-static void removeExpiredSlotsFromSlotMap(Node node, int *slotMapStatus, int8_t *slotMapIds, int64_t *slotMapLastUpdated) {
+static void removeExpiredSlotsFromSlotMap(Node node, SlotStatusArray *slotMapStatus, int8_t *slotMapIds, int64_t *slotMapLastUpdated, SlotMasksStruct *slotMapMasks, 
+  int16_t firstTimer) {
   int64_t localTime = ProtocolClock_GetLocalTime(node->clock);
 
+  // only the slots whose timers have fired are visited; a timer may fire early, so the timeout is checked again and the 
+  // timer is scheduled again if the slot has not expired yet
+  int16_t firedTimers[NUM_SLOTS];
+  int16_t numFired = TimerWheel_PopExpired(node->timerWheel, localTime, firstTimer, NUM_SLOTS, &firedTimers[0]);
+
   int32_t timeout = 0;
-  // iterate over every slot in the slot map that was passed to this function and set the status to FREE
-  // if the slot expired/timed out
-  for(int i = 0; i < NUM_SLOTS; ++i) {
+  bool slotExpired = false;
+  // set the status to FREE if the slot expired/timed out; a FREE slot keeps the time of its last update, so only the slots 
+  // that are OCCUPIED or COLLIDING can expire, otherwise a FREE slot would expire again on every call
+  for (int16_t k = 0; k < numFired; ++k) {
+    int i = firedTimers[k] - firstTimer;
+    if (SlotStatus_Get(slotMapStatus, i) == FREE || slotMapLastUpdated[i] == 0) {
+      continue;
+    };
+
     int slotNum = i+1;
-    if (SlotMap_IsOwnSlot(node, slotNum)) { 
+    if (SlotMap_IsOwnSlot(node, slotNum)) {
       timeout = node->config->ownSlotExpirationTimeOut;
     } else {
       timeout = node->config->slotExpirationTimeOut;
     };
 
-    if (localTime > (slotMapLastUpdated[i] + timeout) && slotMapLastUpdated[i] != 0) {
+    if (localTime > (slotMapLastUpdated[i] + timeout)) {
       #ifdef SIMULATION
       if (slotMapIds[i] != 0)
         mexPrintf("Node %" PRIu8 ": slot %" PRIu8 " of node %" PRIu8 " timed out \n", node->id, (i+1), slotMapIds[i]);
       #endif
-      slotMapStatus[i] = FREE;
-      slotMapIds[i] = 0;
+      setSlot(node, slotMapStatus, slotMapIds, slotMapMasks, i, FREE, 0);
+      slotExpired = true;
+    } else {
+      TimerWheel_Schedule(node->timerWheel, firedTimers[k], slotMapLastUpdated[i] + timeout + 1);
     };
   };
-
+  if (slotExpired) {
+    updateAllCombinedMasks(node->slotMap);
+  };
 };
 
-int16_t SlotMap_RemoveExpiredPendingSlots(Node node, int8_t *buffer, int8_t size) {
+int16_t SlotMap_RemoveExpiredPendingSlots(Node node, SlotNum *buffer, int16_t size) {
 
-  int8_t expiredPendingSlots[MAX_NUM_PENDING_SLOTS];
+  SlotNum expiredPendingSlots[MAX_NUM_PENDING_SLOTS];
   int8_t numExpiredPending = 0;
   int64_t localTime = ProtocolClock_GetLocalTime(node->clock);
+
+  // only the pending slots whose timers have fired are checked, in the order of the pending slots array
+  int16_t firedTimers[MAX_NUM_PENDING_SLOTS];
+  int16_t numFired = TimerWheel_PopExpired(node->timerWheel, localTime, TIMER_WHEEL_PENDING_SLOTS, MAX_NUM_PENDING_SLOTS, &firedTimers[0]);
+  Util_SortInt16tArray(&firedTimers[0], numFired);
   
   // find expired pending slots
-  for(int i = 0; i < node->slotMap->numPendingSlots; ++i) {
+  for(int k = 0; k < numFired; ++k) {
+    int i = firedTimers[k] - TIMER_WHEEL_PENDING_SLOTS;
+    if (i >= node->slotMap->numPendingSlots) {
+      continue;
+    };
+    // the timer is scheduled again in any case; the expired slots are released below (or checked again with the next call 
+    // if the buffer is too small)
+    schedulePendingSlotTimer(node, i);
     if (localTime > node->slotMap->localTimePendingSlotAdded[i] + node->config->ownSlotExpirationTimeOut) {
       #ifdef SIMULATION
-      mexPrintf("%" PRId64 ": Node %" PRIu8 ": pending slot is expired: %" PRId64 "\n", localTime, node->id, node->slotMap->pendingSlots[i]);
+      mexPrintf("%" PRId64 ": Node %" PRIu8 ": pending slot is expired: %" PRId16 "\n", localTime, node->id, node->slotMap->pendingSlots[i]);
       #endif
 
       expiredPendingSlots[numExpiredPending] = node->slotMap->pendingSlots[i];
@@ -635,6 +738,7 @@ int16_t SlotMap_RemoveExpiredPendingSlots(Node node, int8_t *buffer, int8_t size
   // release expired pending slots
   for(int i = 0; i < numExpiredPending; ++i) {
     SlotMap_ReleasePendingSlot(node, expiredPendingSlots[i]);
+    TRACE_RECORD(node, TRACE_SLOT_EXPIRED, 0, 0, expiredPendingSlots[i]);
 
     // add removed slot to buffer
     buffer[i] = expiredPendingSlots[i];
@@ -642,19 +746,29 @@ int16_t SlotMap_RemoveExpiredPendingSlots(Node node, int8_t *buffer, int8_t size
   return numExpiredPending;
 };
 
-int16_t SlotMap_RemoveExpiredOwnSlots(Node node, int8_t *buffer, int8_t size) {
-  int8_t expiredOwnSlots[MAX_NUM_PENDING_SLOTS];
+int16_t SlotMap_RemoveExpiredOwnSlots(Node node, SlotNum *buffer, int16_t size) {
+  SlotNum expiredOwnSlots[MAX_NUM_OWN_SLOTS];
   int8_t numExpiredOwn = 0;
   int64_t localTime = ProtocolClock_GetLocalTime(node->clock);
+
+  // only the own slots whose timers have fired are checked, in the order of the own slots array
+  int16_t firedTimers[MAX_NUM_OWN_SLOTS];
+  int16_t numFired = TimerWheel_PopExpired(node->timerWheel, localTime, TIMER_WHEEL_OWN_SLOTS, MAX_NUM_OWN_SLOTS, &firedTimers[0]);
+  Util_SortInt16tArray(&firedTimers[0], numFired);
   
   // find expired own slots
-  for(int i = 0; i < node->slotMap->numOwnSlots; ++i) {
-    int8_t slotNum = node->slotMap->ownSlots[i];
+  for(int k = 0; k < numFired; ++k) {
+    int i = firedTimers[k] - TIMER_WHEEL_OWN_SLOTS;
+    if (i >= node->slotMap->numOwnSlots) {
+      continue;
+    };
+    scheduleOwnSlotTimer(node, i);
+    SlotNum slotNum = node->slotMap->ownSlots[i];
     int64_t slotLastAcknowledged = node->slotMap->twoHopSlotsLastUpdated[slotNum - 1];
 
     if (localTime > (slotLastAcknowledged + node->config->ownSlotExpirationTimeOut)) {
       #ifdef SIMULATION
-      mexPrintf("%" PRId64 ": Node %" PRIu8 ": own slot is expired: %" PRId8 " (last ack: %"PRId64 ")\n", localTime, node->id, node->slotMap->ownSlots[i], slotLastAcknowledged);
+      mexPrintf("%" PRId64 ": Node %" PRIu8 ": own slot is expired: %" PRId16 " (last ack: %"PRId64 ")\n", localTime, node->id, node->slotMap->ownSlots[i], slotLastAcknowledged);
       #endif 
       expiredOwnSlots[numExpiredOwn] = node->slotMap->ownSlots[i];
       ++numExpiredOwn;
@@ -669,6 +783,7 @@ int16_t SlotMap_RemoveExpiredOwnSlots(Node node, int8_t *buffer, int8_t size) {
   // release expired own slots
   for(int i = 0; i < numExpiredOwn; ++i) {
     SlotMap_ReleaseOwnSlot(node, expiredOwnSlots[i]);
+    TRACE_RECORD(node, TRACE_SLOT_EXPIRED, 0, 1, expiredOwnSlots[i]);
 
     // add removed slot to buffer
     buffer[i] = expiredOwnSlots[i];  
@@ -676,7 +791,7 @@ int16_t SlotMap_RemoveExpiredOwnSlots(Node node, int8_t *buffer, int8_t size) {
   return numExpiredOwn;
 };
 
-static bool isAcknowledged(Node node, int8_t queriedPendingSlot) {
+static bool isAcknowledged(Node node, SlotNum queriedPendingSlot) {
   // loop over all pending slots until the pending slot is found
   for(int i = 0; i < MAX_NUM_PENDING_SLOTS; ++i) {
     if (node->slotMap->pendingSlots[i] == -1) {
@@ -718,50 +833,51 @@ void SlotMap_ExtendTimeouts(Node node) {
   int64_t extensionTime = (node->config->frameLength * node->config->sleepFrames);
 
   for (int i = 0; i < NUM_SLOTS; ++i) {
-    if (node->slotMap->oneHopSlotsStatus[i] != FREE) {
+    if (SlotStatus_Get(&node->slotMap->oneHopSlotsStatus, i) != FREE) {
       node->slotMap->oneHopSlotsLastUpdated[i] += extensionTime;
     };
 
-    if (node->slotMap->twoHopSlotsStatus[i] != FREE) {
+    if (SlotStatus_Get(&node->slotMap->twoHopSlotsStatus, i) != FREE) {
       node->slotMap->twoHopSlotsLastUpdated[i] += extensionTime;
     };
 
-    if (node->slotMap->threeHopSlotsStatus[i] != FREE) {
+    if (SlotStatus_Get(&node->slotMap->threeHopSlotsStatus, i) != FREE) {
       node->slotMap->threeHopSlotsLastUpdated[i] += extensionTime;
     };
   };
+  scheduleAllTimers(node);
 };
 
-static bool oneHopSlotIsExpired(Node node, int8_t currentSlot, int64_t timeout) {
+static bool oneHopSlotIsExpired(Node node, SlotNum currentSlot, int64_t timeout) {
   int64_t localTime = ProtocolClock_GetLocalTime(node->clock);
   // slot is expired if local time is bigger or equal than when the slot was last updated plus the timeout
   return (localTime >= (node->slotMap->oneHopSlotsLastUpdated[currentSlot - 1] + timeout));
 };
 
-static bool multiHopSlotIsExpired(Node node, int8_t currentSlot, int64_t timeout, int64_t *multiHopLastUpdated) {
+static bool multiHopSlotIsExpired(Node node, SlotNum currentSlot, int64_t timeout, int64_t *multiHopLastUpdated) {
   int64_t localTime = ProtocolClock_GetLocalTime(node->clock);
   // slot is expired if local time is bigger or equal than when the slot was last updated plus the timeout
   return (localTime >= (multiHopLastUpdated[currentSlot - 1] + timeout));
 };
 
-static void updateMultiHopSlotMap(Node node, Message msg, int *multiHopSlotMapStatus, int8_t *multiHopSlotMapIds, int64_t *multiHopSlotMapLastUpdate) {
+static void updateMultiHopSlotMap(Node node, Message msg, SlotStatusArray *multiHopSlotMapStatus, int8_t *multiHopSlotMapIds, int64_t *multiHopSlotMapLastUpdate, 
+  SlotMasksStruct *multiHopSlotMapMasks, int16_t firstTimer) {
   // this function is used to update either two- or three-hop slot map (depending on which slot map is passed) to avoid code duplication
 
   // iterate over all slots
   for(int slotIdx = 0; slotIdx < NUM_SLOTS; ++slotIdx) {
     // get current status and ID of the slot
-    int currentStatus = multiHopSlotMapStatus[slotIdx];
+    int currentStatus = SlotStatus_Get(multiHopSlotMapStatus, slotIdx);
     int8_t currentId = multiHopSlotMapIds[slotIdx];
     // get status and ID of the slot from the message
-    int newStatus = msg->multiHopStatus[slotIdx];
+    int newStatus = SlotStatus_Get(msg->multiHopStatus, slotIdx);
     int8_t newId = msg->multiHopIds[slotIdx];
 
     // first check if one hop and two hop are reported occupied by different nodes; if so, set slot to colliding
     // in order to avoid a deadlock in certain situations
-    if (msg->oneHopSlotStatus[slotIdx] == OCCUPIED && msg->twoHopSlotStatus[slotIdx] == OCCUPIED) {
+    if (SlotStatus_Get(&msg->oneHopSlotStatus, slotIdx) == OCCUPIED && SlotStatus_Get(&msg->twoHopSlotStatus, slotIdx) == OCCUPIED) {
       if (msg->oneHopSlotIds[slotIdx] != msg->twoHopSlotIds[slotIdx]) {
-        multiHopSlotMapStatus[slotIdx] = COLLIDING;
-        multiHopSlotMapIds[slotIdx] = 0;
+        setSlot(node, multiHopSlotMapStatus, multiHopSlotMapIds, multiHopSlotMapMasks, slotIdx, COLLIDING, 0);
         multiHopSlotMapLastUpdate[slotIdx] = ProtocolClock_GetLocalTime(node->clock);
         continue;
       };
@@ -772,8 +888,7 @@ static void updateMultiHopSlotMap(Node node, Message msg, int *multiHopSlotMapSt
         switch(currentStatus) {
           case FREE:
             // current status is FREE, new status is OCCUPIED: update immediately
-            multiHopSlotMapStatus[slotIdx] = newStatus;
-            multiHopSlotMapIds[slotIdx] = newId;
+            setSlot(node, multiHopSlotMapStatus, multiHopSlotMapIds, multiHopSlotMapMasks, slotIdx, newStatus, newId);
             multiHopSlotMapLastUpdate[slotIdx] = ProtocolClock_GetLocalTime(node->clock);
             break;
           case OCCUPIED:
@@ -785,13 +900,11 @@ static void updateMultiHopSlotMap(Node node, Message msg, int *multiHopSlotMapSt
               // newly reported node is different from node that reserved the slot so far
               if(multiHopSlotIsExpired(node, slotIdx+1, node->config->occupiedTimeout, multiHopSlotMapLastUpdate)) {
                 // old reservation is expired, so overwrite with new one
-                multiHopSlotMapStatus[slotIdx] = newStatus;
-                multiHopSlotMapIds[slotIdx] = newId;
+                setSlot(node, multiHopSlotMapStatus, multiHopSlotMapIds, multiHopSlotMapMasks, slotIdx, newStatus, newId);
                 multiHopSlotMapLastUpdate[slotIdx] = ProtocolClock_GetLocalTime(node->clock);
               } else {
                 // old reservation is still valid; two different nodes are reported to occupy the same slot, so set it to COLLIDING
-                multiHopSlotMapStatus[slotIdx] = COLLIDING;
-                multiHopSlotMapIds[slotIdx] = 0;
+                setSlot(node, multiHopSlotMapStatus, multiHopSlotMapIds, multiHopSlotMapMasks, slotIdx, COLLIDING, 0);
                 multiHopSlotMapLastUpdate[slotIdx] = ProtocolClock_GetLocalTime(node->clock);
               };
             };
@@ -800,14 +913,13 @@ static void updateMultiHopSlotMap(Node node, Message msg, int *multiHopSlotMapSt
             // current status is COLLIDING, new status is OCCUPIED
             // if colliding report of slot is expired, overwrite it; otherwise, do nothing
             if(multiHopSlotIsExpired(node, slotIdx+1, node->config->collidingTimeoutMultiHop, multiHopSlotMapLastUpdate)) {
-              multiHopSlotMapStatus[slotIdx] = newStatus;
-              multiHopSlotMapIds[slotIdx] = newId;
+              setSlot(node, multiHopSlotMapStatus, multiHopSlotMapIds, multiHopSlotMapMasks, slotIdx, newStatus, newId);
               multiHopSlotMapLastUpdate[slotIdx] = ProtocolClock_GetLocalTime(node->clock);
             };
             break;
         };
         
-        int8_t slot = slotIdx + 1;
+        SlotNum slot = slotIdx + 1;
         bool slotIsOwnSlot = SlotMap_IsOwnSlot(node, slot);
         bool slotIsPendingSlot = SlotMap_IsPendingSlot(node, slot);
         
@@ -815,8 +927,7 @@ static void updateMultiHopSlotMap(Node node, Message msg, int *multiHopSlotMapSt
         // prevent deadlocks and instead make it reservable again
         if(slotIsOwnSlot || slotIsPendingSlot) {
           if(newId != node->id) {
-            multiHopSlotMapStatus[slotIdx] = COLLIDING;
-            multiHopSlotMapIds[slotIdx] = 0;
+            setSlot(node, multiHopSlotMapStatus, multiHopSlotMapIds, multiHopSlotMapMasks, slotIdx, COLLIDING, 0);
             multiHopSlotMapLastUpdate[slotIdx] = ProtocolClock_GetLocalTime(node->clock);
           };
         };
@@ -824,8 +935,7 @@ static void updateMultiHopSlotMap(Node node, Message msg, int *multiHopSlotMapSt
 
       case COLLIDING:
         // newly reported status is COLLIDING, so overwrite slot immediately
-        multiHopSlotMapStatus[slotIdx] = newStatus;
-        multiHopSlotMapIds[slotIdx] = 0;
+        setSlot(node, multiHopSlotMapStatus, multiHopSlotMapIds, multiHopSlotMapMasks, slotIdx, newStatus, 0);
         multiHopSlotMapLastUpdate[slotIdx] = ProtocolClock_GetLocalTime(node->clock);
         break;
       case FREE:
@@ -836,207 +946,264 @@ static void updateMultiHopSlotMap(Node node, Message msg, int *multiHopSlotMapSt
               mexPrintf("Node %" PRIu8 " multi hop slot is expired: %d \n", node->id, (slotIdx + 1));
             #endif
           #endif
-          multiHopSlotMapStatus[slotIdx] = newStatus;
-          multiHopSlotMapIds[slotIdx] = 0;
+          setSlot(node, multiHopSlotMapStatus, multiHopSlotMapIds, multiHopSlotMapMasks, slotIdx, newStatus, 0);
         };
         break;
     };
   };
+  updateAllCombinedMasks(node->slotMap);
+
+  // every slot that was set in this update expires with the time of this update
+  int64_t localTime = ProtocolClock_GetLocalTime(node->clock);
+  for(int slotIdx = 0; slotIdx < NUM_SLOTS; ++slotIdx) {
+    if (multiHopSlotMapLastUpdate[slotIdx] == localTime) {
+      scheduleSlotTimer(node, multiHopSlotMapStatus, multiHopSlotMapLastUpdate, firstTimer, slotIdx);
+    };
+  };
 };
 
-static bool slotReportedColliding(Message msg, int8_t slotNum) {
+static bool slotReportedColliding(Message msg, SlotNum slotNum) {
   // slot is reported colliding if it is colliding in one and/or two hop slot map of the message
-  if (msg->oneHopSlotStatus[slotNum - 1] == COLLIDING || msg->twoHopSlotStatus[slotNum - 1] == COLLIDING) {
+  if (SlotStatus_Get(&msg->oneHopSlotStatus, slotNum - 1) == COLLIDING || SlotStatus_Get(&msg->twoHopSlotStatus, slotNum - 1) == COLLIDING) {
     return true;
   };
 
   return false;
 };
 
-static bool slotReportedOccupiedByOtherNode(Node node, Message msg, int8_t slotNum) {
+static bool slotReportedOccupiedByOtherNode(Node node, Message msg, SlotNum slotNum) {
   // slot is reported occupied by another node if it is occupied in one and/or two hop slot map
   // and the corresponding ID is not this node's ID
-  if (((msg->oneHopSlotStatus[slotNum - 1] == OCCUPIED) && (msg->oneHopSlotIds[slotNum - 1] != node->id)) ||
-    ((msg->twoHopSlotStatus[slotNum - 1] == OCCUPIED) && (msg->twoHopSlotIds[slotNum - 1] != node->id))) {
+  if (((SlotStatus_Get(&msg->oneHopSlotStatus, slotNum - 1) == OCCUPIED) && (msg->oneHopSlotIds[slotNum - 1] != node->id)) ||
+    ((SlotStatus_Get(&msg->twoHopSlotStatus, slotNum - 1) == OCCUPIED) && (msg->twoHopSlotIds[slotNum - 1] != node->id))) {
     return true;
   };
   return false;
 };
 
-static int8_t findFreeSlotsInThreeHopNeighborhood(Node node, int8_t *freeSlots) {
-  
-  // first find free slots in the individual slot maps
-  int8_t oneHopFreeSlots[NUM_SLOTS];
-  int8_t numOneHopFree = 0;
-  int8_t twoHopFreeSlots[NUM_SLOTS];
-  int8_t numTwoHopFree = 0;
-  int8_t threeHopFreeSlots[NUM_SLOTS];
-  int8_t numThreeHopFree = 0;
-  for (int i = 0; i < NUM_SLOTS; ++i) {
-    int slotNum = i+1;
-    if (node->slotMap->oneHopSlotsStatus[i] == FREE) {
-      oneHopFreeSlots[numOneHopFree] = slotNum;
-      ++numOneHopFree;
-    };
+static void setSlot(Node node, SlotStatusArray *slotMapStatus, int8_t *slotMapIds, SlotMasksStruct *slotMapMasks, int slotIdx, int status, int8_t id) {
+  // change status and ID of a slot and update the bit sets accordingly
+  SlotStatus_Set(slotMapStatus, slotIdx, status);
+  slotMapIds[slotIdx] = id;
+
+  int16_t word = SLOT_WORD(slotIdx);
+  uint64_t bit = SLOT_BIT(slotIdx);
+  slotMapMasks->free.words[word] &= ~bit;
+  slotMapMasks->occupied.words[word] &= ~bit;
+  slotMapMasks->colliding.words[word] &= ~bit;
+  slotMapMasks->occupiedByThisNode.words[word] &= ~bit;
+  switch(status) {
+    case FREE:
+      slotMapMasks->free.words[word] |= bit;
+      break;
+    case OCCUPIED:
+      slotMapMasks->occupied.words[word] |= bit;
+      if (id == node->id) {
+        slotMapMasks->occupiedByThisNode.words[word] |= bit;
+      };
+      break;
+    case COLLIDING:
+      slotMapMasks->colliding.words[word] |= bit;
+      break;
+  };
+};
 
-    if (node->slotMap->twoHopSlotsStatus[i] == FREE) {
-      twoHopFreeSlots[numTwoHopFree] = slotNum;
-      ++numTwoHopFree;
-    };
+static void rebuildMasks(Node node, SlotStatusArray *slotMapStatus, int8_t *slotMapIds, SlotMasksStruct *slotMapMasks) {
+  memset(slotMapMasks, 0, sizeof(SlotMasksStruct));
+  for (int i = 0; i < NUM_SLOTS; ++i) {
+    setSlot(node, slotMapStatus, slotMapIds, slotMapMasks, i, SlotStatus_Get(slotMapStatus, i), slotMapIds[i]);
+  };
+};
 
-    if (node->slotMap->threeHopSlotsStatus[i] == FREE) {
-      threeHopFreeSlots[numThreeHopFree] = slotNum;
-      ++numThreeHopFree;
-    };
+static void scheduleSlotTimer(Node node, SlotStatusArray *slotMapStatus, int64_t *slotMapLastUpdated, int16_t firstTimer, int slotIdx) {
+  // same condition and timeout as in removeExpiredSlotsFromSlotMap(); a slot that cannot expire has no timer
+  if (SlotStatus_Get(slotMapStatus, slotIdx) == FREE || slotMapLastUpdated[slotIdx] == 0) {
+    TimerWheel_Cancel(node->timerWheel, firstTimer + slotIdx);
+    return;
   };
+  int32_t timeout = SlotMap_IsOwnSlot(node, slotIdx + 1) ? node->config->ownSlotExpirationTimeOut : node->config->slotExpirationTimeOut;
+  TimerWheel_Schedule(node->timerWheel, firstTimer + slotIdx, slotMapLastUpdated[slotIdx] + timeout + 1);
+};
 
-  // slot is truly free if it is free in all three slot maps, so we need the intersection (common elements of arrays)
-  // intersect one and two hop
-  int8_t intersectionOneHopTwoHop[NUM_SLOTS];
-  int16_t numCommonOneHopTwoHop = Util_IntersectSortedInt8tArrays(&oneHopFreeSlots[0], numOneHopFree, &twoHopFreeSlots[0], numTwoHopFree, &intersectionOneHopTwoHop[0]);
+static void scheduleSlotTimersOfSlot(Node node, SlotNum slotNum) {
+  SlotMap slotMap = node->slotMap;
+  scheduleSlotTimer(node, &slotMap->oneHopSlotsStatus, &slotMap->oneHopSlotsLastUpdated[0], TIMER_WHEEL_ONE_HOP_SLOTS, slotNum - 1);
+  scheduleSlotTimer(node, &slotMap->twoHopSlotsStatus, &slotMap->twoHopSlotsLastUpdated[0], TIMER_WHEEL_TWO_HOP_SLOTS, slotNum - 1);
+  scheduleSlotTimer(node, &slotMap->threeHopSlotsStatus, &slotMap->threeHopSlotsLastUpdated[0], TIMER_WHEEL_THREE_HOP_SLOTS, slotNum - 1);
+};
 
-  // intersect again with three hop
-  int16_t numFreeSlots = Util_IntersectSortedInt8tArrays(&intersectionOneHopTwoHop[0], numCommonOneHopTwoHop, &threeHopFreeSlots[0], numThreeHopFree, freeSlots);
-  return numFreeSlots;
+static void schedulePendingSlotTimer(Node node, int16_t idx) {
+  TimerWheel_Schedule(node->timerWheel, TIMER_WHEEL_PENDING_SLOTS + idx, 
+    node->slotMap->localTimePendingSlotAdded[idx] + node->config->ownSlotExpirationTimeOut + 1);
 };
 
-static int8_t findFreeForThisNodeSlotsInThreeHopNeighborhood(Node node, int8_t *freeSlots) {
-  // find slots that are either free or reported occupied by this node, so that this node can safely use them
-  int8_t oneHopFreeSlots[NUM_SLOTS];
-  int8_t numOneHopFree = 0;
-  int8_t twoHopFreeSlots[NUM_SLOTS];
-  int8_t numTwoHopFree = 0;
-  int8_t threeHopFreeSlots[NUM_SLOTS];
-  int8_t numThreeHopFree = 0;
-  for (int i = 0; i < NUM_SLOTS; ++i) {
-    int slotNum = i+1;
+static void scheduleOwnSlotTimer(Node node, int16_t idx) {
+  SlotNum slotNum = node->slotMap->ownSlots[idx];
+  TimerWheel_Schedule(node->timerWheel, TIMER_WHEEL_OWN_SLOTS + idx, 
+    node->slotMap->twoHopSlotsLastUpdated[slotNum - 1] + node->config->ownSlotExpirationTimeOut + 1);
+};
 
-    bool oneHopReportedOccupiedByThisNode = (node->slotMap->oneHopSlotsStatus[i] == OCCUPIED && node->slotMap->oneHopSlotsIds[i] == node->id);
-    if (node->slotMap->oneHopSlotsStatus[i] == FREE || oneHopReportedOccupiedByThisNode) {
-      oneHopFreeSlots[numOneHopFree] = slotNum;
-      ++numOneHopFree;
+static void scheduleAllTimers(Node node) {
+  for (int16_t slotNum = 1; slotNum <= NUM_SLOTS; ++slotNum) {
+    scheduleSlotTimersOfSlot(node, slotNum);
+  };
+  for (int16_t i = 0; i < MAX_NUM_PENDING_SLOTS; ++i) {
+    if (i < node->slotMap->numPendingSlots) {
+      schedulePendingSlotTimer(node, i);
+    } else {
+      TimerWheel_Cancel(node->timerWheel, TIMER_WHEEL_PENDING_SLOTS + i);
     };
-
-    bool twoHopReportedOccupiedByThisNode = (node->slotMap->twoHopSlotsStatus[i] == OCCUPIED && node->slotMap->twoHopSlotsIds[i] == node->id);
-    if (node->slotMap->twoHopSlotsStatus[i] == FREE || twoHopReportedOccupiedByThisNode) {
-      twoHopFreeSlots[numTwoHopFree] = slotNum;
-      ++numTwoHopFree;
+  };
+  for (int16_t i = 0; i < MAX_NUM_OWN_SLOTS; ++i) {
+    if (i < node->slotMap->numOwnSlots) {
+      scheduleOwnSlotTimer(node, i);
+    } else {
+      TimerWheel_Cancel(node->timerWheel, TIMER_WHEEL_OWN_SLOTS + i);
     };
+  };
+};
 
-    bool threeHopReportedOccupiedByThisNode = (node->slotMap->threeHopSlotsStatus[i] == OCCUPIED && node->slotMap->threeHopSlotsIds[i] == node->id);
-    if (node->slotMap->threeHopSlotsStatus[i] == FREE || threeHopReportedOccupiedByThisNode) {
-      threeHopFreeSlots[numThreeHopFree] = slotNum;
-      ++numThreeHopFree;
-    };
+static void unpackStatus(const SlotStatusArray *packed, int *buffer) {
+  for (int16_t i = 0; i < NUM_SLOTS; ++i) {
+    buffer[i] = SlotStatus_Get(packed, i);
   };
+};
 
-  // slot is truly free if it is free in all three slot maps, so we need the intersection (common elements of arrays)
-  // intersect one and two hop
-  int8_t intersectionOneHopTwoHop[NUM_SLOTS];
-  int16_t numCommonOneHopTwoHop = Util_IntersectSortedInt8tArrays(&oneHopFreeSlots[0], numOneHopFree, &twoHopFreeSlots[0], numTwoHopFree, &intersectionOneHopTwoHop[0]);
+static bool slotIsInFrame(SlotNum slotNum) {
+  // slot numbers outside of the frame are in none of the bit sets
+  return (slotNum >= 1 && slotNum <= NUM_SLOTS);
+};
 
-  // intersect again with three hop
-  int16_t numFreeSlots = Util_IntersectSortedInt8tArrays(&intersectionOneHopTwoHop[0], numCommonOneHopTwoHop, &threeHopFreeSlots[0], numThreeHopFree, freeSlots);
-  return numFreeSlots;
+static bool maskContains(const SlotMask *mask, SlotNum slotNum) {
+  if (!slotIsInFrame(slotNum)) {
+    return false;
+  };
+  return (mask->words[SLOT_WORD(slotNum - 1)] & SLOT_BIT(slotNum - 1)) != 0;
 };
 
-static int8_t findCollidingSlotsInThreeHopNeighborhood(Node node, int8_t *collidingSlots) {
-  // find slots that are colliding in at least one of the slot maps, but at the same time not occupied in any of the other two 
-  // by a node other than this, because then they are not reservable by this node
+static void addToMask(SlotMask *mask, SlotNum slotNum) {
+  if (slotIsInFrame(slotNum)) {
+    mask->words[SLOT_WORD(slotNum - 1)] |= SLOT_BIT(slotNum - 1);
+  };
+};
 
-  int8_t oneHopCollidingSlots[NUM_SLOTS];
-  int8_t numOneHopColliding = 0;
-  for (int i = 0; i < NUM_SLOTS; ++i) {
-    if (node->slotMap->oneHopSlotsStatus[i] == COLLIDING) {
-      // check if slot is not occupied by another node than this in the other two slot maps
-      bool twoHopNotOccupied = (node->slotMap->twoHopSlotsStatus[i] != OCCUPIED) || node->slotMap->twoHopSlotsIds[i] == node->id;
-      bool threeHopNotOccupied = (node->slotMap->threeHopSlotsStatus[i] != OCCUPIED) || node->slotMap->threeHopSlotsIds[i] == node->id;
-
-      if (twoHopNotOccupied && threeHopNotOccupied) {
-        oneHopCollidingSlots[numOneHopColliding] = i+1;
-        ++numOneHopColliding;
-      };
-    };
+static void removeFromMask(SlotMask *mask, SlotNum slotNum) {
+  if (slotIsInFrame(slotNum)) {
+    mask->words[SLOT_WORD(slotNum - 1)] &= ~SLOT_BIT(slotNum - 1);
   };
+};
 
-  int8_t twoHopCollidingSlots[NUM_SLOTS];
-  int8_t numTwoHopColliding = 0;
-  for (int i = 0; i < NUM_SLOTS; ++i) {
-    if (node->slotMap->twoHopSlotsStatus[i] == COLLIDING) {
-      // check if slot is not occupied by another node than this in the other two slot maps
-      bool oneHopNotOccupied = (node->slotMap->oneHopSlotsStatus[i] != OCCUPIED) || node->slotMap->oneHopSlotsIds[i] == node->id;
-      bool threeHopNotOccupied = (node->slotMap->threeHopSlotsStatus[i] != OCCUPIED) || node->slotMap->threeHopSlotsIds[i] == node->id;
-
-      if (oneHopNotOccupied && threeHopNotOccupied) {
-        twoHopCollidingSlots[numTwoHopColliding] = i+1;
-        ++numTwoHopColliding;
-      };
+static bool maskIsEmpty(const SlotMask *mask) {
+  for (int16_t w = 0; w < SLOT_MASK_WORDS; ++w) {
+    if (mask->words[w] != 0) {
+      return false;
     };
   };
+  return true;
+};
 
-  int8_t threeHopCollidingSlots[NUM_SLOTS];
-  int8_t numThreeHopColliding = 0;
-  for (int i = 0; i < NUM_SLOTS; ++i) {
-    if (node->slotMap->threeHopSlotsStatus[i] == COLLIDING) {
-      // check if slot is not occupied by another node than this in the other two slot maps
-      bool oneHopNotOccupied = (node->slotMap->oneHopSlotsStatus[i] != OCCUPIED) || node->slotMap->oneHopSlotsIds[i] == node->id;
-      bool twoHopNotOccupied = (node->slotMap->twoHopSlotsStatus[i] != OCCUPIED) || node->slotMap->twoHopSlotsIds[i] == node->id;
-
-      if (oneHopNotOccupied && twoHopNotOccupied) {
-        threeHopCollidingSlots[numThreeHopColliding] = i+1;
-        ++numThreeHopColliding;
+static int16_t countSlots(const SlotMask *slots) {
+  int16_t count = 0;
+  for (int16_t w = 0; w < SLOT_MASK_WORDS; ++w) {
+    count += __builtin_popcountll(slots->words[w]);
+  };
+  return count;
+};
+
+static SlotNum getNthSlot(const SlotMask *slots, int16_t n) {
+  // skip whole words until the word that contains the n-th slot (counting from 0) is reached
+  for (int16_t w = 0; w < SLOT_MASK_WORDS; ++w) {
+    uint64_t word = slots->words[w];
+    int16_t numSlotsInWord = __builtin_popcountll(word);
+    if (n < numSlotsInWord) {
+      // remove the n lowest slots of the word; the lowest remaining one is the n-th slot
+      for (int16_t i = 0; i < n; ++i) {
+        word &= word - 1;
       };
+      return (SlotNum) (w * 64 + __builtin_ctzll(word) + 1);
     };
+    n -= numSlotsInWord;
   };
+  return -1;
+};
 
-  // get union of the colliding slots of all slot maps
-  memcpy(collidingSlots, &oneHopCollidingSlots[0], sizeof(int8_t) * numOneHopColliding);
-  int8_t numCollidingSlots = numOneHopColliding;
-  
-  // add colliding slots from two hop slot map that are not in already
-  for (int i = 0; i < numTwoHopColliding; ++i) {
-    int8_t element = twoHopCollidingSlots[i];
-    int8_t idx = Util_Int8tArrayFindElement(collidingSlots, element, numCollidingSlots);
-    if (idx == -1) {
-      collidingSlots[numCollidingSlots] = element;
-      ++numCollidingSlots;
+static SlotNum getNextSlotAfter(const SlotMask *slots, SlotNum slotNum) {
+  // the first slot after slotNum in this frame; slot numbers start at 1, so slotNum is the index of the slot after it
+  int16_t startIdx = (slotNum < 0) ? 0 : slotNum;
+  for (int16_t w = SLOT_WORD(startIdx); w < SLOT_MASK_WORDS; ++w) {
+    uint64_t word = slots->words[w];
+    if (w == SLOT_WORD(startIdx)) {
+      word &= UINT64_MAX << (startIdx % 64);
+    };
+    if (word != 0) {
+      return (SlotNum) (w * 64 + __builtin_ctzll(word) + 1);
     };
   };
 
-  // add colliding slots from three hop slot map that are not in already
-  for (int i = 0; i < numThreeHopColliding; ++i) {
-    int8_t element = threeHopCollidingSlots[i];
-    int8_t idx = Util_Int8tArrayFindElement(collidingSlots, element, numCollidingSlots);
-    if (idx == -1) {
-      collidingSlots[numCollidingSlots] = element;
-      ++numCollidingSlots;
+  // no slot after slotNum in this frame, so the first slot of the next frame comes next (which can be slotNum itself)
+  for (int16_t w = 0; w < SLOT_MASK_WORDS; ++w) {
+    if (slots->words[w] != 0) {
+      return (SlotNum) (w * 64 + __builtin_ctzll(slots->words[w]) + 1);
     };
   };
+  return -1;
+};
 
-  return numCollidingSlots;
+static uint64_t findFreeSlotsInThreeHopNeighborhood(SlotMap slotMap, int16_t word) {
+  // slot is truly free if it is free in all three slot maps
+  return slotMap->oneHopSlotsMasks.free.words[word] & slotMap->twoHopSlotsMasks.free.words[word] & slotMap->threeHopSlotsMasks.free.words[word];
 };
 
-static int8_t getNextSlotFromSelection(Node node, int8_t *selection, int8_t size) {
-  // from a selection of slots, get the one that comes next
-  int8_t currentSlot = TimeKeeping_CalculateCurrentSlotNum(node);
+static uint64_t findFreeForThisNodeSlotsInThreeHopNeighborhood(SlotMap slotMap, int16_t word) {
+  // find slots that are either free or reported occupied by this node in all three slot maps, so that this node can safely use them
+  return (slotMap->oneHopSlotsMasks.free.words[word] | slotMap->oneHopSlotsMasks.occupiedByThisNode.words[word]) &
+    (slotMap->twoHopSlotsMasks.free.words[word] | slotMap->twoHopSlotsMasks.occupiedByThisNode.words[word]) &
+    (slotMap->threeHopSlotsMasks.free.words[word] | slotMap->threeHopSlotsMasks.occupiedByThisNode.words[word]);
+};
 
-  // array to hold all distances of the slots in the selection to the current slot 
-  int8_t distanceFromCurrentSlot[MAX_NUM_PENDING_SLOTS + MAX_NUM_OWN_SLOTS];
-  
-  // calculate the distance in slots from the current slot
-  for(int i = 0; i < size; ++i) {
-    distanceFromCurrentSlot[i] = selection[i] - currentSlot;
-    // slot is in the next frame, so add number of slots per frame to it
-    if (distanceFromCurrentSlot[i] <= 0) {
-      distanceFromCurrentSlot[i] += NUM_SLOTS;
-    };
-  };
+static uint64_t findSlotsOccupiedByOtherNodes(SlotMap slotMap, int16_t word) {
+  // slots that are occupied by another node than this in any of the slot maps
+  return (slotMap->oneHopSlotsMasks.occupied.words[word] & ~slotMap->oneHopSlotsMasks.occupiedByThisNode.words[word]) |
+    (slotMap->twoHopSlotsMasks.occupied.words[word] & ~slotMap->twoHopSlotsMasks.occupiedByThisNode.words[word]) |
+    (slotMap->threeHopSlotsMasks.occupied.words[word] & ~slotMap->threeHopSlotsMasks.occupiedByThisNode.words[word]);
+};
 
-  int8_t minIdx = (int8_t) Util_Int8tFindIdxOfMinimumInArray(&distanceFromCurrentSlot[0], size);
+static uint64_t findCollidingSlotsInThreeHopNeighborhood(SlotMap slotMap, int16_t word) {
+  // find slots that are colliding in at least one of the slot maps, but at the same time not occupied in any of the other two 
+  // by a node other than this, because then they are not reservable by this node
+  uint64_t colliding = slotMap->oneHopSlotsMasks.colliding.words[word] | slotMap->twoHopSlotsMasks.colliding.words[word] | 
+    slotMap->threeHopSlotsMasks.colliding.words[word];
+  return colliding & ~findSlotsOccupiedByOtherNodes(slotMap, word);
+};
 
-  if (minIdx == -1) {
-    return -1;
+static void combineMasks(SlotMap slotMap, int16_t word, CombinedSlotMasksStruct *combined) {
+  // combine one word of the bit sets of the three slot maps and the own and pending slots
+  combined->occupiedByOtherNodes.words[word] = findSlotsOccupiedByOtherNodes(slotMap, word);
+  combined->freeForThisNode.words[word] = findFreeForThisNodeSlotsInThreeHopNeighborhood(slotMap, word);
+  combined->colliding.words[word] = findCollidingSlotsInThreeHopNeighborhood(slotMap, word);
+  combined->reservable.words[word] = combined->freeForThisNode.words[word] | combined->colliding.words[word];
+  combined->clearToSend.words[word] = combined->reservable.words[word] | slotMap->ownSlotsMask.words[word] | 
+    slotMap->pendingSlotsMask.words[word];
+};
+
+static void updateCombinedMasksOfSlot(SlotMap slotMap, SlotNum slotNum) {
+  // only the word that contains the slot can have changed
+  if (slotIsInFrame(slotNum)) {
+    combineMasks(slotMap, SLOT_WORD(slotNum - 1), &slotMap->combinedMasks);
   };
+};
 
-  return selection[minIdx];
+static void updateAllCombinedMasks(SlotMap slotMap) {
+  for (int16_t w = 0; w < SLOT_MASK_WORDS; ++w) {
+    combineMasks(slotMap, w, &slotMap->combinedMasks);
+  };
+};
+
+#ifdef SLOT_MAP_CHECK
+static void checkCombinedMasks(Node node) {
+  if (!SlotMap_CombinedMasksAreConsistent(node)) {
+    fprintf(stderr, "Node %" PRIu8 ": combined slot masks do not match the slot maps\n", node->id);
+    abort();
+  };
 };
+#endif
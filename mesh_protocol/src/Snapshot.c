@@ -0,0 +1,116 @@
+/* Copyright (c) 2022-23 California Institute of Technology (Caltech).
+ * U.S. Government sponsorship acknowledged.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Caltech nor its operating division,
+ *   the Jet Propulsion Laboratory, nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Open Source License Approved by Caltech/JPL
+ *
+ * APACHE LICENSE, VERSION 2.0
+ * - Text version: https://www.apache.org/licenses/LICENSE-2.0.txt
+ * - SPDX short identifier: Apache-2.0
+ * - OSI Approved License: https://opensource.org/licenses/Apache-2.0
+ */
+
+#include "../include/Snapshot.h"
+
+static void copySlotMapRow(int32_t *statusDst, int8_t *idsDst, const SlotStatusArray *status, int8_t *ids, int16_t row, int16_t numRows);
+
+Snapshot Snapshot_Create(int16_t numNodes) {
+  Snapshot self = calloc(1, sizeof(SnapshotStruct));
+  self->numNodes = numNodes;
+
+  self->state = calloc(numNodes, sizeof(int8_t));
+  self->localTime = calloc(numNodes, sizeof(int64_t));
+  self->networkId = calloc(numNodes, sizeof(uint8_t));
+  self->networkAge = calloc(numNodes, sizeof(int64_t));
+  self->currentSlot = calloc(numNodes, sizeof(SlotNum));
+
+  self->ownSlots = calloc(numNodes * MAX_NUM_OWN_SLOTS, sizeof(SlotNum));
+  self->pendingSlots = calloc(numNodes * MAX_NUM_PENDING_SLOTS, sizeof(SlotNum));
+
+  self->oneHopSlotsStatus = calloc(numNodes * NUM_SLOTS, sizeof(int32_t));
+  self->oneHopSlotsIds = calloc(numNodes * NUM_SLOTS, sizeof(int8_t));
+  self->twoHopSlotsStatus = calloc(numNodes * NUM_SLOTS, sizeof(int32_t));
+  self->twoHopSlotsIds = calloc(numNodes * NUM_SLOTS, sizeof(int8_t));
+  self->threeHopSlotsStatus = calloc(numNodes * NUM_SLOTS, sizeof(int32_t));
+  self->threeHopSlotsIds = calloc(numNodes * NUM_SLOTS, sizeof(int8_t));
+
+  return self;
+};
+
+void Snapshot_Destroy(Snapshot self) {
+  free(self->state);
+  free(self->localTime);
+  free(self->networkId);
+  free(self->networkAge);
+  free(self->currentSlot);
+  free(self->ownSlots);
+  free(self->pendingSlots);
+  free(self->oneHopSlotsStatus);
+  free(self->oneHopSlotsIds);
+  free(self->twoHopSlotsStatus);
+  free(self->twoHopSlotsIds);
+  free(self->threeHopSlotsStatus);
+  free(self->threeHopSlotsIds);
+  free(self);
+};
+
+void Snapshot_Fill(Snapshot self, Node *nodes, int16_t numNodes) {
+  int16_t numRows = self->numNodes;
+
+  for (int16_t i = 0; i < numNodes; ++i) {
+    Node node = nodes[i];
+    SlotMap slotMap = node->slotMap;
+
+    self->state[i] = StateMachine_GetState(node);
+    self->localTime[i] = ProtocolClock_GetLocalTime(node->clock);
+    self->networkId[i] = NetworkManager_GetNetworkId(node);
+    self->networkAge[i] = NetworkManager_CalculateNetworkAge(node);
+    self->currentSlot[i] = TimeKeeping_CalculateCurrentSlotNum(node);
+
+    // unused entries are set to 0, same as getOwnSlots of the MatlabWrapper
+    for (int8_t slot = 0; slot < MAX_NUM_OWN_SLOTS; ++slot) {
+      self->ownSlots[i + slot * numRows] = (slot < slotMap->numOwnSlots) ? slotMap->ownSlots[slot] : 0;
+    };
+    for (int8_t slot = 0; slot < MAX_NUM_PENDING_SLOTS; ++slot) {
+      self->pendingSlots[i + slot * numRows] = (slot < slotMap->numPendingSlots) ? slotMap->pendingSlots[slot] : 0;
+    };
+
+    copySlotMapRow(self->oneHopSlotsStatus, self->oneHopSlotsIds, &slotMap->oneHopSlotsStatus, slotMap->oneHopSlotsIds, i, numRows);
+    copySlotMapRow(self->twoHopSlotsStatus, self->twoHopSlotsIds, &slotMap->twoHopSlotsStatus, slotMap->twoHopSlotsIds, i, numRows);
+    copySlotMapRow(self->threeHopSlotsStatus, self->threeHopSlotsIds, &slotMap->threeHopSlotsStatus, slotMap->threeHopSlotsIds, i, numRows);
+  };
+};
+
+static void copySlotMapRow(int32_t *statusDst, int8_t *idsDst, const SlotStatusArray *status, int8_t *ids, int16_t row, int16_t numRows) {
+  // the snapshot holds the status unpacked, one value per slot
+  for (int16_t slot = 0; slot < NUM_SLOTS; ++slot) {
+    statusDst[row + slot * numRows] = SlotStatus_Get(status, slot);
+    idsDst[row + slot * numRows] = ids[slot];
+  };
+};
@@ -0,0 +1,230 @@
+/* Copyright (c) 2022-23 California Institute of Technology (Caltech).
+ * U.S. Government sponsorship acknowledged.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Caltech nor its operating division,
+ *   the Jet Propulsion Laboratory, nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Open Source License Approved by Caltech/JPL
+ *
+ * APACHE LICENSE, VERSION 2.0
+ * - Text version: https://www.apache.org/licenses/LICENSE-2.0.txt
+ * - SPDX short identifier: Apache-2.0
+ * - OSI Approved License: https://opensource.org/licenses/Apache-2.0
+ */
+
+#include "../include/SpatialGrid.h"
+
+static double validCellSize(double cellSize);
+static int32_t cellCoordinate(SpatialGrid self, double pos);
+static int32_t bucketOf(SpatialGrid self, int32_t cellX, int32_t cellY);
+static void link(SpatialGrid self, int16_t nodeIdx);
+static void unlink(SpatialGrid self, int16_t nodeIdx);
+static void sortAscending(int16_t *buffer, int16_t size);
+static double distance(SpatialGrid self, int16_t nodeIdx, double x, double y);
+
+SpatialGrid SpatialGrid_Create(int16_t capacity, double cellSize) {
+  SpatialGrid self = calloc(1, sizeof(SpatialGridStruct));
+  self->capacity = capacity;
+  self->numNodes = 0;
+  self->cellSize = validCellSize(cellSize);
+
+  self->posX = calloc(capacity, sizeof(double));
+  self->posY = calloc(capacity, sizeof(double));
+  self->cellX = calloc(capacity, sizeof(int32_t));
+  self->cellY = calloc(capacity, sizeof(int32_t));
+  self->next = calloc(capacity, sizeof(int16_t));
+  self->prev = calloc(capacity, sizeof(int16_t));
+
+  // about two buckets per node keeps the lists short
+  self->numBuckets = 1;
+  while (self->numBuckets < 2 * capacity) {
+    self->numBuckets *= 2;
+  };
+  self->buckets = malloc(self->numBuckets * sizeof(int16_t));
+  for (int32_t i = 0; i < self->numBuckets; ++i) {
+    self->buckets[i] = -1;
+  };
+
+  return self;
+};
+
+void SpatialGrid_Destroy(SpatialGrid self) {
+  free(self->posX);
+  free(self->posY);
+  free(self->cellX);
+  free(self->cellY);
+  free(self->next);
+  free(self->prev);
+  free(self->buckets);
+  free(self);
+};
+
+void SpatialGrid_SetCellSize(SpatialGrid self, double cellSize) {
+  self->cellSize = validCellSize(cellSize);
+
+  for (int32_t i = 0; i < self->numBuckets; ++i) {
+    self->buckets[i] = -1;
+  };
+  for (int16_t i = 0; i < self->numNodes; ++i) {
+    self->cellX[i] = cellCoordinate(self, self->posX[i]);
+    self->cellY[i] = cellCoordinate(self, self->posY[i]);
+    link(self, i);
+  };
+};
+
+int16_t SpatialGrid_Insert(SpatialGrid self, double x, double y) {
+  if (self->numNodes == self->capacity) {
+    return -1;
+  };
+
+  int16_t nodeIdx = self->numNodes;
+  ++self->numNodes;
+
+  self->posX[nodeIdx] = x;
+  self->posY[nodeIdx] = y;
+  self->cellX[nodeIdx] = cellCoordinate(self, x);
+  self->cellY[nodeIdx] = cellCoordinate(self, y);
+  link(self, nodeIdx);
+
+  return nodeIdx;
+};
+
+void SpatialGrid_Move(SpatialGrid self, int16_t nodeIdx, double x, double y) {
+  self->posX[nodeIdx] = x;
+  self->posY[nodeIdx] = y;
+
+  int32_t cellX = cellCoordinate(self, x);
+  int32_t cellY = cellCoordinate(self, y);
+  if (cellX == self->cellX[nodeIdx] && cellY == self->cellY[nodeIdx]) {
+    // still in the same cell; nothing to relink
+    return;
+  };
+
+  unlink(self, nodeIdx);
+  self->cellX[nodeIdx] = cellX;
+  self->cellY[nodeIdx] = cellY;
+  link(self, nodeIdx);
+};
+
+int16_t SpatialGrid_QueryRange(SpatialGrid self, int16_t nodeIdx, double range, int16_t *buffer, int16_t size) {
+  double x = self->posX[nodeIdx];
+  double y = self->posY[nodeIdx];
+  int16_t numFound = 0;
+
+  // if the square around the node covers more cells than there are nodes, checking every node is cheaper
+  double cellsPerSide = floor(2 * range / self->cellSize) + 2;
+  if (!isfinite(range) || !isfinite(cellsPerSide) || (cellsPerSide * cellsPerSide) > self->numNodes) {
+    for (int16_t i = 0; i < self->numNodes && numFound < size; ++i) {
+      if (i != nodeIdx && distance(self, i, x, y) <= range) {
+        buffer[numFound] = i;
+        ++numFound;
+      };
+    };
+    return numFound;
+  };
+
+  int32_t minCellX = cellCoordinate(self, x - range);
+  int32_t maxCellX = cellCoordinate(self, x + range);
+  int32_t minCellY = cellCoordinate(self, y - range);
+  int32_t maxCellY = cellCoordinate(self, y + range);
+
+  for (int32_t cellX = minCellX; cellX <= maxCellX; ++cellX) {
+    for (int32_t cellY = minCellY; cellY <= maxCellY; ++cellY) {
+      int16_t i = self->buckets[bucketOf(self, cellX, cellY)];
+      while (i != -1 && numFound < size) {
+        // buckets are shared by different cells, so the cell has to be checked as well
+        if (i != nodeIdx && self->cellX[i] == cellX && self->cellY[i] == cellY 
+            && distance(self, i, x, y) <= range) {
+          buffer[numFound] = i;
+          ++numFound;
+        };
+        i = self->next[i];
+      };
+    };
+  };
+
+  sortAscending(buffer, numFound);
+  return numFound;
+};
+
+static double validCellSize(double cellSize) {
+  // an infinite radio range puts all nodes into one cell
+  if (isinf(cellSize) && cellSize > 0) {
+    return cellSize;
+  };
+  return (cellSize > 0) ? cellSize : 1.0;
+};
+
+static int32_t cellCoordinate(SpatialGrid self, double pos) {
+  return (int32_t) floor(pos / self->cellSize);
+};
+
+static int32_t bucketOf(SpatialGrid self, int32_t cellX, int32_t cellY) {
+  uint32_t hash = ((uint32_t) cellX * 73856093u) ^ ((uint32_t) cellY * 19349663u);
+  return (int32_t) (hash & (uint32_t) (self->numBuckets - 1));
+};
+
+static void link(SpatialGrid self, int16_t nodeIdx) {
+  int32_t bucket = bucketOf(self, self->cellX[nodeIdx], self->cellY[nodeIdx]);
+  self->prev[nodeIdx] = -1;
+  self->next[nodeIdx] = self->buckets[bucket];
+  if (self->buckets[bucket] != -1) {
+    self->prev[self->buckets[bucket]] = nodeIdx;
+  };
+  self->buckets[bucket] = nodeIdx;
+};
+
+static void unlink(SpatialGrid self, int16_t nodeIdx) {
+  if (self->prev[nodeIdx] != -1) {
+    self->next[self->prev[nodeIdx]] = self->next[nodeIdx];
+  } else {
+    self->buckets[bucketOf(self, self->cellX[nodeIdx], self->cellY[nodeIdx])] = self->next[nodeIdx];
+  };
+  if (self->next[nodeIdx] != -1) {
+    self->prev[self->next[nodeIdx]] = self->prev[nodeIdx];
+  };
+};
+
+static void sortAscending(int16_t *buffer, int16_t size) {
+  // insertion sort; only a few nodes are in range of each other
+  for (int16_t i = 1; i < size; ++i) {
+    int16_t value = buffer[i];
+    int16_t j = i - 1;
+    while (j >= 0 && buffer[j] > value) {
+      buffer[j + 1] = buffer[j];
+      --j;
+    };
+    buffer[j + 1] = value;
+  };
+};
+
+static double distance(SpatialGrid self, int16_t nodeIdx, double x, double y) {
+  // same calculation as Simulator_GetDistance, so both agree on which nodes are in range
+  double dx = self->posX[nodeIdx] - x;
+  double dy = self->posY[nodeIdx] - y;
+  return sqrt(dx * dx + dy * dy);
+};
@@ -85,19 +85,19 @@ void StateActions_ListeningConnectedTimeTicAction(Node node) {
   SlotMap_RemoveExpiredSlotsFromThreeHopSlotMap(node);
 
   // release expired pending and own slots
-  int8_t removedPending[NUM_SLOTS];
-  int8_t removedOwn[NUM_SLOTS];
+  SlotNum removedPending[NUM_SLOTS];
+  SlotNum removedOwn[NUM_SLOTS];
   int16_t numRemovedPending = SlotMap_RemoveExpiredPendingSlots(node, &removedPending[0], NUM_SLOTS);
   int16_t numRemovedOwn = SlotMap_RemoveExpiredOwnSlots(node, &removedOwn[0], NUM_SLOTS);
 
   // check if the next schedule is for one of the expired slots and if so, cancel it
-  int8_t nextScheduledSlot = Scheduler_GetSlotOfNextSchedule(node);
-  int16_t indexPending = Util_Int8tArrayFindElement(&removedPending[0], nextScheduledSlot, numRemovedPending);
+  SlotNum nextScheduledSlot = Scheduler_GetSlotOfNextSchedule(node);
+  int16_t indexPending = Util_Int16tArrayFindElement(&removedPending[0], nextScheduledSlot, numRemovedPending);
   if (indexPending != -1) {
     Scheduler_CancelScheduledPing(node);
   };
 
-  int16_t indexOwn = Util_Int8tArrayFindElement(&removedOwn[0], nextScheduledSlot, numRemovedOwn);
+  int16_t indexOwn = Util_Int16tArrayFindElement(&removedOwn[0], nextScheduledSlot, numRemovedOwn);
   if (indexOwn != -1) {
     Scheduler_CancelScheduledPing(node);
   };
@@ -129,9 +129,9 @@ void StateActions_ListeningConnectedIncomingMsgAction(Node node, Message msg) {
         printf("Network: %" PRIu8 "\n", msg->networkId);
 
         for(int i = 0; i < NUM_SLOTS; ++i) {
-          printf("1H (S%d): %d \n", (i+1), msg->oneHopSlotStatus[i]);
+          printf("1H (S%d): %d \n", (i+1), SlotStatus_Get(&msg->oneHopSlotStatus, i));
           printf("1H ID (S%d): %" PRId8 "\n", (i+1), msg->oneHopSlotIds[i]);
-          printf("2H (S%d): %d \n", (i+1), msg->twoHopSlotStatus[i]);
+          printf("2H (S%d): %d \n", (i+1), SlotStatus_Get(&msg->twoHopSlotStatus, i));
           printf("2H ID (S%d): %" PRId8 "\n", (i+1), msg->twoHopSlotIds[i]);
         };
 #endif
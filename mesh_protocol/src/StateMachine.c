@@ -50,6 +50,12 @@ States StateMachine_GetState(Node node) {
 };
 
 void StateMachine_Run(Node node, Events event, Message msg) {
+#ifdef TRACE
+  States stateBefore = node->stateMachine->state;
+  if (event == INCOMING_MSG) {
+    TRACE_RECORD(node, TRACE_RX, msg->type, msg->senderId, msg->networkId);
+  };
+#endif
   
   // execute actions depending on the current state of the state machine and the
   // event that happened (TURN_ON, TIME_TIC or INCOMING_MSG)
@@ -327,6 +333,12 @@ void StateMachine_Run(Node node, Events event, Message msg) {
       break;
   }
 
+#ifdef TRACE
+  // only the resulting state is recorded if the state changed more than once during this event
+  if (node->stateMachine->state != stateBefore) {
+    TRACE_RECORD(node, TRACE_STATE_CHANGE, stateBefore, node->stateMachine->state, 0);
+  };
+#endif
 };
 
 
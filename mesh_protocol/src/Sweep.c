@@ -0,0 +1,507 @@
+/* Copyright (c) 2022-23 California Institute of Technology (Caltech).
+ * U.S. Government sponsorship acknowledged.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Caltech nor its operating division,
+ *   the Jet Propulsion Laboratory, nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Open Source License Approved by Caltech/JPL
+ *
+ * APACHE LICENSE, VERSION 2.0
+ * - Text version: https://www.apache.org/licenses/LICENSE-2.0.txt
+ * - SPDX short identifier: Apache-2.0
+ * - OSI Approved License: https://opensource.org/licenses/Apache-2.0
+ */
+
+#include "../include/Sweep.h"
+
+#include <pthread.h>
+#include <unistd.h>
+
+typedef struct SweepPoolStruct * SweepPool;
+
+/** Fraction of the radio range between nodes that should just be in range of each other */
+#define NEAR_FRACTION 0.9
+
+/**
+* ownSlots: own slots of the node after the last executed tic
+* numOwnSlots: number of elements in ownSlots
+* lastNetworkId: ID of the last network the node was connected to; 0 if it has not been connected yet
+*/
+typedef struct SweepNodeRecordStruct {
+  SlotNum ownSlots[MAX_NUM_OWN_SLOTS];
+  int8_t numOwnSlots;
+  uint8_t lastNetworkId;
+} SweepNodeRecordStruct;
+
+static const char *topologyNames[NUM_TOPOLOGIES] = {"line", "grid", "random", "clique", "ring", "star", "merge", "hidden"};
+
+/**
+* thread: the thread of the worker
+* pool: the pool the worker belongs to
+* lock: protects begin and end, as other workers may steal from this worker
+* begin, end: range of scenario indices [begin, end) this worker still has to run
+*/
+typedef struct SweepWorkerStruct {
+  pthread_t thread;
+  SweepPool pool;
+  pthread_mutex_t lock;
+  int32_t begin;
+  int32_t end;
+} SweepWorkerStruct;
+
+typedef struct SweepWorkerStruct * SweepWorker;
+
+typedef struct SweepPoolStruct {
+  SweepScenarioStruct *scenarios;
+  SweepResultStruct *results;
+  SweepWorkerStruct *workers;
+  int16_t numWorkers;
+} SweepPoolStruct;
+
+static void *workerMain(void *arg);
+static bool takeScenario(SweepWorker worker, int32_t *scenarioIdx);
+static bool stealScenarios(SweepWorker thief);
+static void placeNodes(Simulator sim, SweepScenario scenario);
+static void placeOnCircle(int16_t index, int16_t count, double radius, double centerX, double *x, double *y);
+static void mergeClusters(Simulator sim, SweepScenario scenario);
+static void recordChanges(Simulator sim, SweepNodeRecordStruct *records, SweepResult result);
+static bool networkFormed(Simulator sim);
+static bool firstSlotsReserved(Simulator sim);
+static bool slotGoalMet(Simulator sim);
+static uint32_t nextRandom(uint32_t *state);
+
+SweepScenarioStruct *Sweep_CreateScenarioMatrix(uint32_t *seeds, int32_t numSeeds, int16_t *nodeCounts, int32_t numNodeCounts, 
+  SweepTopology *topologies, int32_t numTopologies, ConfigStruct *configs, int32_t numConfigs, double spacing, double radioRange, 
+  int64_t duration, int32_t *numScenarios) {
+
+  *numScenarios = numSeeds * numNodeCounts * numTopologies * numConfigs;
+  SweepScenarioStruct *scenarios = calloc(*numScenarios, sizeof(SweepScenarioStruct));
+
+  int32_t id = 0;
+  for (int32_t c = 0; c < numConfigs; ++c) {
+    for (int32_t t = 0; t < numTopologies; ++t) {
+      for (int32_t n = 0; n < numNodeCounts; ++n) {
+        for (int32_t s = 0; s < numSeeds; ++s) {
+          SweepScenario scenario = &scenarios[id];
+          scenario->id = id;
+          scenario->seed = seeds[s];
+          scenario->numNodes = nodeCounts[n];
+          scenario->topology = topologies[t];
+          scenario->spacing = spacing;
+          scenario->radioRange = radioRange;
+          scenario->duration = duration;
+          scenario->configIdx = c;
+          scenario->config = configs[c];
+          ++id;
+        };
+      };
+    };
+  };
+
+  return scenarios;
+};
+
+const char *Sweep_GetTopologyName(SweepTopology topology) {
+  if (topology < 0 || topology >= NUM_TOPOLOGIES) {
+    return NULL;
+  };
+  return topologyNames[topology];
+};
+
+bool Sweep_ParseTopology(const char *name, SweepTopology *topology) {
+  for (int i = 0; i < NUM_TOPOLOGIES; ++i) {
+    if (strcmp(name, topologyNames[i]) == 0) {
+      *topology = (SweepTopology) i;
+      return true;
+    };
+  };
+  return false;
+};
+
+bool Sweep_SetConfigValue(Config config, const char *key, int64_t value) {
+  if (strcmp(key, "frameLength") == 0) {
+    config->frameLength = value;
+  } else if (strcmp(key, "slotLength") == 0) {
+    config->slotLength = value;
+  } else if (strcmp(key, "slotGoal") == 0) {
+    config->slotGoal = value;
+  } else if (strcmp(key, "initialPingUpperLimit") == 0) {
+    config->initialPingUpperLimit = value;
+  } else if (strcmp(key, "initialWaitTime") == 0) {
+    config->initialWaitTime = value;
+  } else if (strcmp(key, "guardPeriodLength") == 0) {
+    config->guardPeriodLength = value;
+  } else if (strcmp(key, "networkAgeToleranceSameNetwork") == 0) {
+    config->networkAgeToleranceSameNetwork = value;
+  } else if (strcmp(key, "rangingTimeOut") == 0) {
+    config->rangingTimeOut = value;
+  } else if (strcmp(key, "rangingWaitTime") == 0) {
+    config->rangingWaitTime = value;
+  } else if (strcmp(key, "slotExpirationTimeOut") == 0) {
+    config->slotExpirationTimeOut = value;
+  } else if (strcmp(key, "ownSlotExpirationTimeOut") == 0) {
+    config->ownSlotExpirationTimeOut = value;
+  } else if (strcmp(key, "absentNeighborTimeOut") == 0) {
+    config->absentNeighborTimeOut = value;
+  } else if (strcmp(key, "rangingRefreshTime") == 0) {
+    config->rangingRefreshTime = value;
+  } else if (strcmp(key, "occupiedTimeout") == 0) {
+    config->occupiedTimeout = value;
+  } else if (strcmp(key, "occupiedToFreeTimeoutMultiHop") == 0) {
+    config->occupiedToFreeTimeoutMultiHop = value;
+  } else if (strcmp(key, "collidingTimeoutMultiHop") == 0) {
+    config->collidingTimeoutMultiHop = value;
+  } else if (strcmp(key, "collidingTimeout") == 0) {
+    config->collidingTimeout = value;
+  } else if (strcmp(key, "sleepFrames") == 0) {
+    config->sleepFrames = value;
+  } else if (strcmp(key, "wakeFrames") == 0) {
+    config->wakeFrames = value;
+  } else {
+    return false;
+  };
+  return true;
+};
+
+Simulator Sweep_CreateSimulator(SweepScenario scenario) {
+  Simulator sim = Simulator_Create(scenario->numNodes, scenario->seed);
+  Simulator_SetRadioRange(sim, scenario->radioRange);
+  Simulator_SetIdleSkipping(sim, true);
+  placeNodes(sim, scenario);
+  return sim;
+};
+
+int64_t Sweep_UpdateTopology(Simulator sim, SweepScenario scenario) {
+  if (scenario->topology != TOPOLOGY_MERGE) {
+    return scenario->duration;
+  };
+
+  // the clusters merge after half of the duration
+  int64_t mergeTime = scenario->duration / 2;
+  if (Simulator_GetTime(sim) < mergeTime) {
+    return mergeTime;
+  };
+  if (Simulator_GetTime(sim) == mergeTime) {
+    mergeClusters(sim, scenario);
+  };
+  return scenario->duration;
+};
+
+void Sweep_RunScenario(SweepScenario scenario, SweepResult result) {
+  Simulator sim = Sweep_CreateSimulator(scenario);
+
+  memset(result, 0, sizeof(SweepResultStruct));
+  result->scenarioId = scenario->id;
+  result->networkFormationTime = -1;
+  result->firstSlotTime = -1;
+  result->slotGoalTime = -1;
+
+  SweepNodeRecordStruct *records = calloc(scenario->numNodes, sizeof(SweepNodeRecordStruct));
+
+  while (Simulator_GetTime(sim) < scenario->duration) {
+    int64_t nextChange = Sweep_UpdateTopology(sim, scenario);
+
+    // the nodes can only change in the tic that is executed first, so this is the time of any change
+    int64_t tic = Simulator_GetTime(sim);
+    Simulator_Advance(sim, nextChange);
+    recordChanges(sim, records, result);
+
+    if (result->networkFormationTime == -1 && networkFormed(sim)) {
+      result->networkFormationTime = tic;
+    };
+    if (result->firstSlotTime == -1 && firstSlotsReserved(sim)) {
+      result->firstSlotTime = tic;
+    };
+    if (result->slotGoalTime == -1 && slotGoalMet(sim)) {
+      result->slotGoalTime = tic;
+    };
+  };
+  free(records);
+
+  result->numCollisions = sim->stats.numCollisions;
+  result->numRangings = sim->stats.numTransmissions[RESULT];
+  result->numPings = sim->stats.numTransmissions[PING];
+
+  Simulator_Destroy(sim);
+};
+
+void Sweep_Run(SweepScenarioStruct *scenarios, int32_t numScenarios, SweepResultStruct *results, int16_t numThreads) {
+  if (numThreads < 1) {
+    numThreads = sysconf(_SC_NPROCESSORS_ONLN);
+  };
+  if (numThreads > numScenarios) {
+    numThreads = numScenarios;
+  };
+  if (numThreads < 1) {
+    return;
+  };
+
+  SweepPoolStruct pool;
+  pool.scenarios = scenarios;
+  pool.results = results;
+  pool.numWorkers = numThreads;
+  pool.workers = calloc(numThreads, sizeof(SweepWorkerStruct));
+
+  // split the scenarios evenly; the workers balance the load by stealing later
+  for (int16_t i = 0; i < numThreads; ++i) {
+    SweepWorker worker = &pool.workers[i];
+    worker->pool = &pool;
+    worker->begin = (int32_t) (((int64_t) numScenarios * i) / numThreads);
+    worker->end = (int32_t) (((int64_t) numScenarios * (i + 1)) / numThreads);
+    pthread_mutex_init(&worker->lock, NULL);
+  };
+
+  for (int16_t i = 0; i < numThreads; ++i) {
+    pthread_create(&pool.workers[i].thread, NULL, workerMain, &pool.workers[i]);
+  };
+  for (int16_t i = 0; i < numThreads; ++i) {
+    pthread_join(pool.workers[i].thread, NULL);
+    pthread_mutex_destroy(&pool.workers[i].lock);
+  };
+
+  free(pool.workers);
+};
+
+void Sweep_WriteHeader(FILE *file) {
+  fprintf(file, "scenario,seed,topology,numNodes,config,networkFormationTime,firstSlotTime,slotGoalTime,collisions,rangings,pings,"
+    "slotReleases,networkSwitches\n");
+};
+
+void Sweep_WriteRow(FILE *file, SweepScenario scenario, SweepResult result) {
+  fprintf(file, "%" PRId32 ",%" PRIu32 ",%d,%" PRId16 ",%" PRId16 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 
+    ",%" PRIu64 ",%" PRIu64 "\n", scenario->id, scenario->seed, (int) scenario->topology, scenario->numNodes, scenario->configIdx, 
+    result->networkFormationTime, result->firstSlotTime, result->slotGoalTime, result->numCollisions, result->numRangings, 
+    result->numPings, result->numSlotReleases, result->numNetworkSwitches);
+};
+
+static void *workerMain(void *arg) {
+  SweepWorker worker = (SweepWorker) arg;
+  SweepPool pool = worker->pool;
+
+  int32_t scenarioIdx;
+  while (true) {
+    if (!takeScenario(worker, &scenarioIdx)) {
+      if (!stealScenarios(worker)) {
+        // no worker has scenarios left
+        break;
+      };
+      continue;
+    };
+    Sweep_RunScenario(&pool->scenarios[scenarioIdx], &pool->results[scenarioIdx]);
+  };
+  return NULL;
+};
+
+static bool takeScenario(SweepWorker worker, int32_t *scenarioIdx) {
+  // the owner takes scenarios from the front of its range, thieves from the back
+  bool found = false;
+  pthread_mutex_lock(&worker->lock);
+  if (worker->begin < worker->end) {
+    *scenarioIdx = worker->begin;
+    ++worker->begin;
+    found = true;
+  };
+  pthread_mutex_unlock(&worker->lock);
+  return found;
+};
+
+static bool stealScenarios(SweepWorker thief) {
+  SweepPool pool = thief->pool;
+  int16_t thiefIdx = thief - pool->workers;
+
+  // try the other workers round robin, starting with the next one
+  for (int16_t i = 1; i < pool->numWorkers; ++i) {
+    SweepWorker victim = &pool->workers[(thiefIdx + i) % pool->numWorkers];
+
+    pthread_mutex_lock(&victim->lock);
+    int32_t remaining = victim->end - victim->begin;
+    if (remaining < 1) {
+      pthread_mutex_unlock(&victim->lock);
+      continue;
+    };
+    // steal the back half (rounded up, so a single remaining scenario can be stolen, too)
+    int32_t stolenBegin = victim->end - (remaining + 1) / 2;
+    int32_t stolenEnd = victim->end;
+    victim->end = stolenBegin;
+    pthread_mutex_unlock(&victim->lock);
+
+    pthread_mutex_lock(&thief->lock);
+    thief->begin = stolenBegin;
+    thief->end = stolenEnd;
+    pthread_mutex_unlock(&thief->lock);
+    return true;
+  };
+  return false;
+};
+
+static void placeNodes(Simulator sim, SweepScenario scenario) {
+  int16_t numColumns = (int16_t) ceil(sqrt(scenario->numNodes));
+  double areaSide = numColumns * scenario->spacing;
+  double nearDistance = NEAR_FRACTION * scenario->radioRange;
+  int16_t numFirstCluster = (scenario->numNodes + 1) / 2;
+  uint32_t randomState = scenario->seed ^ 0x5eed5eed;
+  if (randomState == 0) {
+    // xorshift would only produce zeros
+    randomState = 1;
+  };
+
+  for (int16_t i = 0; i < scenario->numNodes; ++i) {
+    double x = 0;
+    double y = 0;
+    double radius;
+    switch (scenario->topology) {
+      case TOPOLOGY_LINE:
+        x = i * scenario->spacing;
+        break;
+      case TOPOLOGY_GRID:
+        x = (i % numColumns) * scenario->spacing;
+        y = (i / numColumns) * scenario->spacing;
+        break;
+      case TOPOLOGY_RANDOM:
+        x = areaSide * nextRandom(&randomState) / (double) UINT32_MAX;
+        y = areaSide * nextRandom(&randomState) / (double) UINT32_MAX;
+        break;
+      case TOPOLOGY_CLIQUE:
+        placeOnCircle(i, scenario->numNodes, scenario->radioRange / 4, 0, &x, &y);
+        break;
+      case TOPOLOGY_RING:
+        // circumradius of a polygon with sides of length nearDistance; two nodes are simply nearDistance apart
+        radius = (scenario->numNodes < 3) ? nearDistance / 2 : nearDistance / (2 * sin(M_PI / scenario->numNodes));
+        placeOnCircle(i, scenario->numNodes, radius, 0, &x, &y);
+        break;
+      case TOPOLOGY_STAR:
+        if (i > 0) {
+          placeOnCircle(i - 1, scenario->numNodes - 1, nearDistance, 0, &x, &y);
+        };
+        break;
+      case TOPOLOGY_MERGE:
+        // the second cluster starts far away (see mergeClusters)
+        if (i < numFirstCluster) {
+          placeOnCircle(i, numFirstCluster, scenario->radioRange / 4, 0, &x, &y);
+        } else {
+          placeOnCircle(i - numFirstCluster, scenario->numNodes - numFirstCluster, scenario->radioRange / 4, 
+            100 * scenario->radioRange, &x, &y);
+        };
+        break;
+      case TOPOLOGY_HIDDEN:
+        // the first row holds as many nodes as the first cluster of TOPOLOGY_MERGE
+        x = (i % numFirstCluster) * nearDistance;
+        y = (i / numFirstCluster) * nearDistance;
+        break;
+      default:
+        break;
+    };
+
+    int16_t nodeIdx = Simulator_AddNode(sim, (int8_t) (i + 1), x, y, 0);
+    // every node gets its own copy of the config of the scenario
+    *Simulator_GetNode(sim, nodeIdx)->config = scenario->config;
+  };
+};
+
+static void placeOnCircle(int16_t index, int16_t count, double radius, double centerX, double *x, double *y) {
+  double angle = 2 * M_PI * index / count;
+  *x = centerX + radius * cos(angle);
+  *y = radius * sin(angle);
+};
+
+static void mergeClusters(Simulator sim, SweepScenario scenario) {
+  // move the second cluster so that its center is 0.75 radio ranges from the center of the first one; some nodes of the 
+  // two clusters are in range of each other, others are not
+  int16_t numFirstCluster = (scenario->numNodes + 1) / 2;
+  for (int16_t i = numFirstCluster; i < scenario->numNodes; ++i) {
+    double x, y;
+    placeOnCircle(i - numFirstCluster, scenario->numNodes - numFirstCluster, scenario->radioRange / 4, 0.75 * scenario->radioRange, 
+      &x, &y);
+    Simulator_MoveNode(sim, i, x, y);
+  };
+};
+
+static void recordChanges(Simulator sim, SweepNodeRecordStruct *records, SweepResult result) {
+  for (int16_t i = 0; i < sim->numNodes; ++i) {
+    Node node = Simulator_GetNode(sim, i);
+    SweepNodeRecordStruct *record = &records[i];
+
+    // own slots of the last tic that are not own slots anymore were released or have expired
+    for (int8_t j = 0; j < record->numOwnSlots; ++j) {
+      bool kept = false;
+      for (int8_t k = 0; k < node->slotMap->numOwnSlots; ++k) {
+        kept = kept || (node->slotMap->ownSlots[k] == record->ownSlots[j]);
+      };
+      if (!kept) {
+        ++result->numSlotReleases;
+      };
+    };
+    memcpy(record->ownSlots, node->slotMap->ownSlots, sizeof(record->ownSlots));
+    record->numOwnSlots = node->slotMap->numOwnSlots;
+
+    if (node->networkManager->networkStatus == CONNECTED) {
+      uint8_t networkId = node->networkManager->networkId;
+      if (record->lastNetworkId != 0 && networkId != record->lastNetworkId) {
+        ++result->numNetworkSwitches;
+      };
+      record->lastNetworkId = networkId;
+    };
+  };
+};
+
+static bool networkFormed(Simulator sim) {
+  Node first = Simulator_GetNode(sim, 0);
+  for (int16_t i = 0; i < sim->numNodes; ++i) {
+    Node node = Simulator_GetNode(sim, i);
+    if (node->networkManager->networkStatus != CONNECTED || node->networkManager->networkId != first->networkManager->networkId) {
+      return false;
+    };
+  };
+  return true;
+};
+
+static bool firstSlotsReserved(Simulator sim) {
+  for (int16_t i = 0; i < sim->numNodes; ++i) {
+    if (Simulator_GetNode(sim, i)->slotMap->numOwnSlots < 1) {
+      return false;
+    };
+  };
+  return true;
+};
+
+static bool slotGoalMet(Simulator sim) {
+  for (int16_t i = 0; i < sim->numNodes; ++i) {
+    Node node = Simulator_GetNode(sim, i);
+    if (node->slotMap->numOwnSlots < node->config->slotGoal) {
+      return false;
+    };
+  };
+  return true;
+};
+
+static uint32_t nextRandom(uint32_t *state) {
+  // xorshift32; only used for the positions of the nodes
+  *state ^= *state << 13;
+  *state ^= *state >> 17;
+  *state ^= *state << 5;
+  return *state;
+};
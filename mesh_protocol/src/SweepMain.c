@@ -0,0 +1,205 @@
+/* Copyright (c) 2022-23 California Institute of Technology (Caltech).
+ * U.S. Government sponsorship acknowledged.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Caltech nor its operating division,
+ *   the Jet Propulsion Laboratory, nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Open Source License Approved by Caltech/JPL
+ *
+ * APACHE LICENSE, VERSION 2.0
+ * - Text version: https://www.apache.org/licenses/LICENSE-2.0.txt
+ * - SPDX short identifier: Apache-2.0
+ * - OSI Approved License: https://opensource.org/licenses/Apache-2.0
+ */
+
+/** @file SweepMain.c
+*   @brief Command line front end of the Monte Carlo sweep runner
+*
+*   Usage: mesh_sweep [-s numSeeds] [-f firstSeed] [-n nodeCounts] [-t topologies] [-d durationTics] [-p spacing] 
+*                     [-r radioRange] [-j numThreads] [-c key=value,...]...
+*
+*   nodeCounts and topologies are comma separated lists (e.g. -n 2,4,6 -t line,grid,random; the topologies are line, grid, 
+*   random, clique, ring, star, merge and hidden). Every -c option adds a config variant that changes the given fields of the 
+*   default config; without -c, only the default config is used.
+*   Runs every combination of seed, node count, topology and config and writes one CSV row per scenario to stdout.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <getopt.h>
+
+#include "../include/Sweep.h"
+
+#define MAX_LIST_LENGTH 32
+
+static int32_t parseNodeCounts(char *list, int16_t *nodeCounts);
+static int32_t parseTopologies(char *list, SweepTopology *topologies);
+static bool parseConfig(char *assignments, Config config);
+
+int main(int argc, char *argv[]) {
+  int32_t numSeeds = 10;
+  uint32_t firstSeed = 1;
+  int16_t nodeCounts[MAX_LIST_LENGTH] = {4};
+  int32_t numNodeCounts = 1;
+  SweepTopology topologies[MAX_LIST_LENGTH] = {TOPOLOGY_LINE};
+  int32_t numTopologies = 1;
+  ConfigStruct configs[MAX_LIST_LENGTH];
+  int32_t numConfigs = 0;
+  int64_t duration = 200000;
+  double spacing = 1.0;
+  double radioRange = 1.5;
+  int16_t numThreads = 0;
+
+  int option;
+  while ((option = getopt(argc, argv, "s:f:n:t:d:p:r:j:c:")) != -1) {
+    switch (option) {
+      case 's':
+        numSeeds = atoi(optarg);
+        break;
+      case 'f':
+        firstSeed = (uint32_t) strtoul(optarg, NULL, 10);
+        break;
+      case 'n':
+        numNodeCounts = parseNodeCounts(optarg, &nodeCounts[0]);
+        break;
+      case 't':
+        numTopologies = parseTopologies(optarg, &topologies[0]);
+        break;
+      case 'd':
+        duration = atoll(optarg);
+        break;
+      case 'p':
+        spacing = atof(optarg);
+        break;
+      case 'r':
+        radioRange = atof(optarg);
+        break;
+      case 'j':
+        numThreads = atoi(optarg);
+        break;
+      case 'c': ;
+        if (numConfigs == MAX_LIST_LENGTH) {
+          fprintf(stderr, "at most %d config variants\n", MAX_LIST_LENGTH);
+          return 1;
+        };
+        Config defaultConfig = Config_Create();
+        configs[numConfigs] = *defaultConfig;
+        free(defaultConfig);
+        if (!parseConfig(optarg, &configs[numConfigs])) {
+          return 1;
+        };
+        ++numConfigs;
+        break;
+      default:
+        fprintf(stderr, "usage: %s [-s numSeeds] [-f firstSeed] [-n nodeCounts] [-t topologies] [-d durationTics] [-p spacing] "
+          "[-r radioRange] [-j numThreads] [-c key=value,...]...\n", argv[0]);
+        return 1;
+    };
+  };
+
+  if (numConfigs == 0) {
+    Config defaultConfig = Config_Create();
+    configs[0] = *defaultConfig;
+    free(defaultConfig);
+    numConfigs = 1;
+  };
+  if (numSeeds < 1 || numNodeCounts < 1 || numTopologies < 1) {
+    fprintf(stderr, "invalid seeds, node counts or topologies\n");
+    return 1;
+  };
+
+  uint32_t *seeds = calloc(numSeeds, sizeof(uint32_t));
+  for (int32_t i = 0; i < numSeeds; ++i) {
+    seeds[i] = firstSeed + i;
+  };
+
+  int32_t numScenarios = 0;
+  SweepScenarioStruct *scenarios = Sweep_CreateScenarioMatrix(&seeds[0], numSeeds, &nodeCounts[0], numNodeCounts, &topologies[0], 
+    numTopologies, &configs[0], numConfigs, spacing, radioRange, duration, &numScenarios);
+  SweepResultStruct *results = calloc(numScenarios, sizeof(SweepResultStruct));
+
+  struct timespec start, end;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  Sweep_Run(scenarios, numScenarios, results, numThreads);
+  clock_gettime(CLOCK_MONOTONIC, &end);
+
+  Sweep_WriteHeader(stdout);
+  for (int32_t i = 0; i < numScenarios; ++i) {
+    Sweep_WriteRow(stdout, &scenarios[i], &results[i]);
+  };
+
+  double elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+  fprintf(stderr, "%" PRId32 " scenarios in %.3f s\n", numScenarios, elapsed);
+
+  free(seeds);
+  free(scenarios);
+  free(results);
+  return 0;
+};
+
+static int32_t parseNodeCounts(char *list, int16_t *nodeCounts) {
+  int32_t num = 0;
+  for (char *token = strtok(list, ","); token != NULL && num < MAX_LIST_LENGTH; token = strtok(NULL, ",")) {
+    int16_t numNodes = atoi(token);
+    if (numNodes < 1 || numNodes > MAX_NUM_NODES) {
+      fprintf(stderr, "number of nodes must be between 1 and %d\n", MAX_NUM_NODES);
+      return 0;
+    };
+    nodeCounts[num++] = numNodes;
+  };
+  return num;
+};
+
+static int32_t parseTopologies(char *list, SweepTopology *topologies) {
+  int32_t num = 0;
+  for (char *token = strtok(list, ","); token != NULL && num < MAX_LIST_LENGTH; token = strtok(NULL, ",")) {
+    if (!Sweep_ParseTopology(token, &topologies[num])) {
+      fprintf(stderr, "unknown topology %s\n", token);
+      return 0;
+    };
+    ++num;
+  };
+  return num;
+};
+
+static bool parseConfig(char *assignments, Config config) {
+  for (char *token = strtok(assignments, ","); token != NULL; token = strtok(NULL, ",")) {
+    char *separator = strchr(token, '=');
+    if (separator == NULL) {
+      fprintf(stderr, "config values must be given as key=value: %s\n", token);
+      return false;
+    };
+    *separator = '\0';
+    if (!Sweep_SetConfigValue(config, token, atoll(separator + 1))) {
+      fprintf(stderr, "unknown config field %s\n", token);
+      return false;
+    };
+  };
+  return true;
+};
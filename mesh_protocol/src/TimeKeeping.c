@@ -79,7 +79,7 @@ void TimeKeeping_ResetTime(Node node) {
   node->timeKeeping->lastResetAt = localTime;
 };
 
-uint8_t TimeKeeping_CalculateOwnSlotAtTime(Node node, int64_t time) {
+SlotNum TimeKeeping_CalculateOwnSlotAtTime(Node node, int64_t time) {
   // calculate for a given time in which slot the node was or will be then
   int32_t frameLength = node->config->frameLength;
   int32_t slotLength = node->config->slotLength;
@@ -91,10 +91,10 @@ uint8_t TimeKeeping_CalculateOwnSlotAtTime(Node node, int64_t time) {
   int64_t timeInFrame = timeSinceFirstFrameStart % frameLength; 
 
   double slotAtQueriedTime = floor((timeInFrame + slotLength)/slotLength);
-  return (uint16_t) slotAtQueriedTime;
+  return (SlotNum) slotAtQueriedTime;
 };
 
-uint8_t TimeKeeping_CalculateCurrentSlotNum(Node node) {
+SlotNum TimeKeeping_CalculateCurrentSlotNum(Node node) {
   if (!node->timeKeeping->frameStartSet) {
     // if frameStartTime not set, it is slot 1
     return 1;
@@ -115,7 +115,7 @@ uint64_t TimeKeeping_CalculateCurrentFrameNum(Node node) {
   return currentFrameNum;
 };
 
-int64_t TimeKeeping_CalculateNextStartOfSlot(Node node, uint8_t slotNum) {
+int64_t TimeKeeping_CalculateNextStartOfSlot(Node node, SlotNum slotNum) {
   int64_t nextStartTime = -1;
   if (node->timeKeeping->frameStartSet) {
     int64_t localTime = ProtocolClock_GetLocalTime(node->clock);
@@ -146,7 +146,7 @@ int64_t TimeKeeping_CalculateTimeSinceFrameStart(Node node) {
   if(!node->timeKeeping->frameStartSet) {
     return 0;
   };
-  uint8_t currentSlotNum = TimeKeeping_CalculateCurrentSlotNum(node);
+  SlotNum currentSlotNum = TimeKeeping_CalculateCurrentSlotNum(node);
   int64_t timeInSlot = calculateTimeInSlot(node);
 
   // time since the start of the current frame is the number of slot multiplied by the slot length 
@@ -184,13 +184,20 @@ int64_t TimeKeeping_GetLastTimeIdled(Node node) {
 };
 
 bool TimeKeeping_IsAutoCycleWakeupTime(Node node) {
+  return (TimeKeeping_CalculateTimeUntilWakeup(node) == 0);
+};
+
+int64_t TimeKeeping_CalculateTimeUntilWakeup(Node node) {
   // sleeptime is defined as a multiple of frames; sleepFrames is the number of frames to sleep
   int64_t sleeptime = (node->config->frameLength * node->config->sleepFrames);
+  if (sleeptime <= 0) {
+    return 0;
+  };
   int64_t networkAge = NetworkManager_CalculateNetworkAge(node);
 
   // nodes should wake up when the current network age is an even multiple of the sleeptime; 
   // as the network age is the same among the nodes, this makes then wake up at the same time
-  return (networkAge % sleeptime == 0);
+  return (sleeptime - (networkAge % sleeptime)) % sleeptime;
 };
 
 static int64_t calculateTimeSinceLastPreamble(Node node, Message msg) {
@@ -0,0 +1,250 @@
+/* Copyright (c) 2022-23 California Institute of Technology (Caltech).
+ * U.S. Government sponsorship acknowledged.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Caltech nor its operating division,
+ *   the Jet Propulsion Laboratory, nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Open Source License Approved by Caltech/JPL
+ *
+ * APACHE LICENSE, VERSION 2.0
+ * - Text version: https://www.apache.org/licenses/LICENSE-2.0.txt
+ * - SPDX short identifier: Apache-2.0
+ * - OSI Approved License: https://opensource.org/licenses/Apache-2.0
+ */
+
+#include "../include/TimerWheel.h"
+
+/** Index of the list of the timers that have fired, and index of the head of a list in next and prev */
+#define FIRED_LIST (TIMER_WHEEL_LEVELS * TIMER_WHEEL_BUCKETS)
+#define HEAD(list) ((int16_t) (TIMER_WHEEL_NUM_TIMERS + (list)))
+#define NOT_SCHEDULED -1
+#define NO_LIST UINT8_MAX
+
+static void advance(TimerWheel self, int64_t now);
+static int16_t findList(TimerWheel self, int64_t expirationTime);
+static void unlinkTimer(TimerWheel self, int16_t timer);
+static void appendTimer(TimerWheel self, int16_t list, int16_t timer);
+static void fireBucket(TimerWheel self, int16_t list);
+static int64_t bucketIndex(int64_t time, int level);
+static uint32_t rotateLeft(uint32_t bits, int64_t count);
+
+TimerWheel TimerWheel_Create() {
+  TimerWheel self = calloc(1, sizeof(TimerWheelStruct));
+
+  for (int16_t i = 0; i < TIMER_WHEEL_NUM_TIMERS; ++i) {
+    self->next[i] = NOT_SCHEDULED;
+    self->prev[i] = NOT_SCHEDULED;
+    self->list[i] = NO_LIST;
+  };
+  // all lists are empty, i.e. their heads point to themselves
+  for (int16_t list = 0; list < TIMER_WHEEL_NUM_LISTS; ++list) {
+    self->next[HEAD(list)] = HEAD(list);
+    self->prev[HEAD(list)] = HEAD(list);
+  };
+  self->cursor = 0;
+
+  return self;
+};
+
+void TimerWheel_Schedule(TimerWheel self, int16_t timer, int64_t expirationTime) {
+  // a slot that is updated again usually stays in the same bucket
+  int16_t list = findList(self, expirationTime);
+  if (self->list[timer] == list) {
+    return;
+  };
+  unlinkTimer(self, timer);
+  appendTimer(self, list, timer);
+};
+
+void TimerWheel_Cancel(TimerWheel self, int16_t timer) {
+  unlinkTimer(self, timer);
+};
+
+bool TimerWheel_IsScheduled(TimerWheel self, int16_t timer) {
+  return self->list[timer] != NO_LIST;
+};
+
+int16_t TimerWheel_PopExpired(TimerWheel self, int64_t now, int16_t firstTimer, int16_t numTimers, int16_t *buffer) {
+  advance(self, now);
+
+  int16_t numFired = 0;
+  int16_t timer = self->next[HEAD(FIRED_LIST)];
+  while (timer != HEAD(FIRED_LIST)) {
+    int16_t following = self->next[timer];
+    if (timer >= firstTimer && timer < firstTimer + numTimers) {
+      unlinkTimer(self, timer);
+      buffer[numFired] = timer;
+      ++numFired;
+    };
+    timer = following;
+  };
+  return numFired;
+};
+
+int64_t TimerWheel_NextFireTime(TimerWheel self) {
+  if (self->next[HEAD(FIRED_LIST)] != HEAD(FIRED_LIST)) {
+    return TIMER_WHEEL_FIRED;
+  };
+
+  int64_t fireTime = TIMER_WHEEL_NO_TIMER;
+  for (int level = 0; level < TIMER_WHEEL_LEVELS; ++level) {
+    if (self->nonEmpty[level] == 0) {
+      continue;
+    };
+    // the buckets of a level follow the bucket of the cursor, so the first non-empty one is found by rotating the bits 
+    // of the bucket after the cursor to bit 0
+    int64_t cursorIdx = bucketIndex(self->cursor, level);
+    uint32_t ahead = rotateLeft(self->nonEmpty[level], TIMER_WHEEL_BUCKETS - ((cursorIdx + 1) & (TIMER_WHEEL_BUCKETS - 1)));
+    int64_t idx = cursorIdx + 1 + __builtin_ctz(ahead);
+    int64_t startTime = idx * ((int64_t) 1 << (level * TIMER_WHEEL_BUCKET_BITS));
+    if (startTime < fireTime) {
+      fireTime = startTime;
+    };
+  };
+  return fireTime;
+};
+
+static void advance(TimerWheel self, int64_t now) {
+  if (now == self->cursor) {
+    return;
+  };
+
+  for (int level = 0; level < TIMER_WHEEL_LEVELS; ++level) {
+    int64_t oldIdx = bucketIndex(self->cursor, level);
+    int64_t newIdx = bucketIndex(now, level);
+    if (oldIdx == newIdx) {
+      // the higher levels have not moved either
+      break;
+    };
+
+    // forwards, the buckets up to the new time fire; backwards, the buckets that the new cursor would take for buckets of
+    // the next round (the last ones before the old cursor comes around again) fire early
+    int64_t count = (now > self->cursor) ? (newIdx - oldIdx) : (oldIdx - newIdx);
+    int64_t first = (now > self->cursor) ? (oldIdx + 1) : (oldIdx + TIMER_WHEEL_BUCKETS - count);
+    uint32_t buckets = UINT32_MAX;
+    if (count < TIMER_WHEEL_BUCKETS) {
+      buckets = rotateLeft(((uint32_t) 1 << count) - 1, first);
+    };
+
+    buckets &= self->nonEmpty[level];
+    while (buckets != 0) {
+      int bucket = __builtin_ctz(buckets);
+      buckets &= buckets - 1;
+      fireBucket(self, level * TIMER_WHEEL_BUCKETS + bucket);
+    };
+  };
+  self->cursor = now;
+};
+
+static int16_t findList(TimerWheel self, int64_t expirationTime) {
+  if (expirationTime <= self->cursor) {
+    return FIRED_LIST;
+  };
+
+  // lowest level whose buckets reach the expiration time; the bucket of the cursor has already fired on every level, 
+  // so the timer always ends up in a bucket after it
+  for (int level = 0; level < TIMER_WHEEL_LEVELS; ++level) {
+    int64_t idx = bucketIndex(expirationTime, level);
+    if (idx - bucketIndex(self->cursor, level) < TIMER_WHEEL_BUCKETS) {
+      return level * TIMER_WHEEL_BUCKETS + (idx & (TIMER_WHEEL_BUCKETS - 1));
+    };
+  };
+
+  // beyond the range of the wheel: the last bucket of the top level fires early and the timer is scheduled again
+  int level = TIMER_WHEEL_LEVELS - 1;
+  int64_t idx = bucketIndex(self->cursor, level) + TIMER_WHEEL_BUCKETS - 1;
+  return level * TIMER_WHEEL_BUCKETS + (idx & (TIMER_WHEEL_BUCKETS - 1));
+};
+
+static void unlinkTimer(TimerWheel self, int16_t timer) {
+  int16_t list = self->list[timer];
+  if (list == NO_LIST) {
+    return;
+  };
+
+  int16_t next = self->next[timer];
+  int16_t prev = self->prev[timer];
+  self->next[prev] = next;
+  self->prev[next] = prev;
+  self->next[timer] = NOT_SCHEDULED;
+  self->prev[timer] = NOT_SCHEDULED;
+  self->list[timer] = NO_LIST;
+
+  if (list != FIRED_LIST && self->next[HEAD(list)] == HEAD(list)) {
+    self->nonEmpty[list / TIMER_WHEEL_BUCKETS] &= ~((uint32_t) 1 << (list % TIMER_WHEEL_BUCKETS));
+  };
+};
+
+static void appendTimer(TimerWheel self, int16_t list, int16_t timer) {
+  int16_t head = HEAD(list);
+  int16_t tail = self->prev[head];
+  self->next[tail] = timer;
+  self->prev[timer] = tail;
+  self->next[timer] = head;
+  self->prev[head] = timer;
+  self->list[timer] = (uint8_t) list;
+
+  if (list != FIRED_LIST) {
+    self->nonEmpty[list / TIMER_WHEEL_BUCKETS] |= (uint32_t) 1 << (list % TIMER_WHEEL_BUCKETS);
+  };
+};
+
+static void fireBucket(TimerWheel self, int16_t list) {
+  // move the whole list to the end of the list of fired timers
+  int16_t head = HEAD(list);
+  int16_t first = self->next[head];
+  int16_t last = self->prev[head];
+  if (first == head) {
+    return;
+  };
+  for (int16_t timer = first; timer != head; timer = self->next[timer]) {
+    self->list[timer] = FIRED_LIST;
+  };
+
+  int16_t firedHead = HEAD(FIRED_LIST);
+  int16_t firedTail = self->prev[firedHead];
+  self->next[firedTail] = first;
+  self->prev[first] = firedTail;
+  self->next[last] = firedHead;
+  self->prev[firedHead] = last;
+
+  self->next[head] = head;
+  self->prev[head] = head;
+  self->nonEmpty[list / TIMER_WHEEL_BUCKETS] &= ~((uint32_t) 1 << (list % TIMER_WHEEL_BUCKETS));
+};
+
+static int64_t bucketIndex(int64_t time, int level) {
+  return time >> (level * TIMER_WHEEL_BUCKET_BITS);
+};
+
+static uint32_t rotateLeft(uint32_t bits, int64_t count) {
+  int shift = (int) (count & (TIMER_WHEEL_BUCKETS - 1));
+  if (shift == 0) {
+    return bits;
+  };
+  return (bits << shift) | (bits >> (TIMER_WHEEL_BUCKETS - shift));
+};
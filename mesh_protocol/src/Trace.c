@@ -0,0 +1,110 @@
+/* Copyright (c) 2022-23 California Institute of Technology (Caltech).
+ * U.S. Government sponsorship acknowledged.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Caltech nor its operating division,
+ *   the Jet Propulsion Laboratory, nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Open Source License Approved by Caltech/JPL
+ *
+ * APACHE LICENSE, VERSION 2.0
+ * - Text version: https://www.apache.org/licenses/LICENSE-2.0.txt
+ * - SPDX short identifier: Apache-2.0
+ * - OSI Approved License: https://opensource.org/licenses/Apache-2.0
+ */
+
+#include "../include/Trace.h"
+#include "../include/ProtocolClock.h"
+
+TraceWriter TraceWriter_Create(const char *path) {
+  FILE *file = fopen(path, "wb");
+  if (file == NULL) {
+    return NULL;
+  };
+
+  TraceWriter self = calloc(1, sizeof(TraceWriterStruct));
+  self->file = file;
+  self->numBuffered = 0;
+  self->numRecords = 0;
+
+  TraceHeaderStruct header;
+  memcpy(header.magic, TRACE_MAGIC, sizeof(header.magic));
+  header.version = TRACE_VERSION;
+  header.recordSize = sizeof(TraceRecordStruct);
+  fwrite(&header, sizeof(TraceHeaderStruct), 1, self->file);
+
+  return self;
+};
+
+void TraceWriter_Destroy(TraceWriter self) {
+  TraceWriter_Flush(self);
+  fclose(self->file);
+  free(self);
+};
+
+void TraceWriter_Write(TraceWriter self, const TraceRecordStruct *record) {
+  if (self->numBuffered == TRACE_BUFFER_SIZE) {
+    TraceWriter_Flush(self);
+  };
+  self->buffer[self->numBuffered] = *record;
+  ++self->numBuffered;
+  ++self->numRecords;
+};
+
+void TraceWriter_Flush(TraceWriter self) {
+  fwrite(self->buffer, sizeof(TraceRecordStruct), self->numBuffered, self->file);
+  self->numBuffered = 0;
+};
+
+void Trace_Record(Node node, TraceRecordTypes type, int8_t arg0, int8_t arg1, int32_t value) {
+  TraceRecordStruct record;
+  record.localTime = ProtocolClock_GetLocalTime(node->clock);
+  record.value = value;
+  record.type = (uint8_t) type;
+  record.nodeId = node->id;
+  record.arg0 = arg0;
+  record.arg1 = arg1;
+  TraceWriter_Write(node->trace, &record);
+};
+
+bool Trace_ReadHeader(FILE *file) {
+  TraceHeaderStruct header;
+  if (fread(&header, sizeof(TraceHeaderStruct), 1, file) != 1) {
+    return false;
+  };
+  return (memcmp(header.magic, TRACE_MAGIC, sizeof(header.magic)) == 0 && header.version == TRACE_VERSION 
+    && header.recordSize == sizeof(TraceRecordStruct));
+};
+
+const char *Trace_GetTypeName(uint8_t type) {
+  static const char *names[TRACE_NUM_RECORD_TYPES] = {
+    "STATE", "TX", "RX", "SLOT_PENDING", "SLOT_RESERVED", "SLOT_RELEASED", "SLOT_EXPIRED", "JOIN", "RANGING"
+  };
+  if (type >= TRACE_NUM_RECORD_TYPES) {
+    return "UNKNOWN";
+  };
+  return names[type];
+};
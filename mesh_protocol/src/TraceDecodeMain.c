@@ -0,0 +1,144 @@
+/* Copyright (c) 2022-23 California Institute of Technology (Caltech).
+ * U.S. Government sponsorship acknowledged.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Caltech nor its operating division,
+ *   the Jet Propulsion Laboratory, nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Open Source License Approved by Caltech/JPL
+ *
+ * APACHE LICENSE, VERSION 2.0
+ * - Text version: https://www.apache.org/licenses/LICENSE-2.0.txt
+ * - SPDX short identifier: Apache-2.0
+ * - OSI Approved License: https://opensource.org/licenses/Apache-2.0
+ */
+
+
+/** @file TraceDecodeMain.c
+*   @brief Converts a binary event trace (see Trace.h) to text
+*
+*   Usage: mesh_trace_decode traceFile [-s]
+*
+*   Prints one line per record: local time of the node, node ID, record type and its arguments.
+*   With -s, only the number of records of every type is printed.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "../include/Trace.h"
+
+static const char *stateName(int8_t state) {
+  static const char *names[] = {
+    "OFF", "LISTENING_UNCONNECTED", "LISTENING_CONNECTED", "SENDING_UNCONNECTED", "SENDING_CONNECTED", "RANGING_POLL", 
+    "RANGING_LISTEN", "RANGING_WAIT", "RANGING_RESPONSE", "RANGING_FINAL", "RANGING_RESULT", "IDLE"
+  };
+  if (state < 0 || state >= (int8_t) (sizeof(names) / sizeof(names[0]))) {
+    return "?";
+  };
+  return names[state];
+};
+
+static const char *messageName(int8_t type) {
+  static const char *names[] = {"PING", "COLLISION", "POLL", "RESPONSE", "FINAL", "RESULT"};
+  if (type < 0 || type >= (int8_t) (sizeof(names) / sizeof(names[0]))) {
+    return "?";
+  };
+  return names[type];
+};
+
+static void printRecord(const TraceRecordStruct *record) {
+  printf("%" PRId64 " node %" PRId8 " %s", record->localTime, record->nodeId, Trace_GetTypeName(record->type));
+
+  switch (record->type) {
+    case TRACE_STATE_CHANGE:
+      printf(" %s -> %s", stateName(record->arg0), stateName(record->arg1));
+      break;
+    case TRACE_TX:
+      printf(" %s to %" PRId8 " network %" PRId32, messageName(record->arg0), record->arg1, record->value);
+      break;
+    case TRACE_RX:
+      printf(" %s from %" PRId8 " network %" PRId32, messageName(record->arg0), record->arg1, record->value);
+      break;
+    case TRACE_SLOT_PENDING:
+    case TRACE_SLOT_RESERVED:
+      printf(" slot %" PRId32, record->value);
+      break;
+    case TRACE_SLOT_RELEASED:
+    case TRACE_SLOT_EXPIRED:
+      printf(" %s slot %" PRId32, (record->arg1 != 0) ? "own" : "pending", record->value);
+      break;
+    case TRACE_JOIN:
+      printf(" network %" PRId32 " of node %" PRId8, record->value, record->arg1);
+      break;
+    case TRACE_RANGING_RESULT:
+      printf(" node %" PRId8 " distance %.3f", record->arg1, record->value / 1000.0);
+      break;
+  };
+  printf("\n");
+};
+
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    fprintf(stderr, "usage: %s traceFile [-s]\n", argv[0]);
+    return 1;
+  };
+  bool summaryOnly = (argc > 2 && strcmp(argv[2], "-s") == 0);
+
+  FILE *file = fopen(argv[1], "rb");
+  if (file == NULL) {
+    fprintf(stderr, "cannot open %s\n", argv[1]);
+    return 1;
+  };
+  if (!Trace_ReadHeader(file)) {
+    fprintf(stderr, "%s is not a trace file of this version\n", argv[1]);
+    fclose(file);
+    return 1;
+  };
+
+  uint64_t counts[TRACE_NUM_RECORD_TYPES + 1] = {0};
+  TraceRecordStruct records[TRACE_BUFFER_SIZE];
+  size_t numRead;
+  while ((numRead = fread(records, sizeof(TraceRecordStruct), TRACE_BUFFER_SIZE, file)) > 0) {
+    for (size_t i = 0; i < numRead; ++i) {
+      uint8_t type = (records[i].type < TRACE_NUM_RECORD_TYPES) ? records[i].type : TRACE_NUM_RECORD_TYPES;
+      ++counts[type];
+      if (!summaryOnly) {
+        printRecord(&records[i]);
+      };
+    };
+  };
+  fclose(file);
+
+  if (summaryOnly) {
+    for (uint8_t type = 0; type <= TRACE_NUM_RECORD_TYPES; ++type) {
+      printf("%s %" PRIu64 "\n", Trace_GetTypeName(type), counts[type]);
+    };
+  };
+  return 0;
+};
@@ -36,9 +36,12 @@
  * - OSI Approved License: https://opensource.org/licenses/Apache-2.0
  */
 
+#include <stdlib.h>
+
 #include "../include/Util.h"
 
 static int compare( const void* a, const void* b);
+static int compareInt16(const void *a, const void *b);
 
 int16_t Util_Int8tArrayFindElement(int8_t *array, int8_t element, int16_t arraySize) {
   // compare each array element with the element that should be found
@@ -50,6 +53,16 @@ int16_t Util_Int8tArrayFindElement(int8_t *array, int8_t element, int16_t arrayS
   return -1;
 };
 
+int16_t Util_Int16tArrayFindElement(int16_t *array, int16_t element, int16_t arraySize) {
+  // compare each array element with the element that should be found
+  for (int i = 0; i < arraySize; ++i) {
+    if (array[i] == element) {
+      return i;
+    };
+  };
+  return -1;
+};
+
 int16_t Util_IntersectSortedInt8tArrays(int8_t *array1, int8_t size1, int8_t *array2, int8_t size2, int8_t *intersection) {
   int16_t i = 0;
   int16_t j = 0;
@@ -77,6 +90,10 @@ void Util_SortInt8tArray(int8_t *array, int8_t arraySize, int8_t *sorted) {
   qsort(sorted, arraySize, sizeof(int8_t), compare);
 };
 
+void Util_SortInt16tArray(int16_t *array, int16_t arraySize) {
+  qsort(array, arraySize, sizeof(int16_t), compareInt16);
+};
+
 int16_t Util_Int8tFindIdxOfMinimumInArray(int8_t *array, int16_t arraySize) {
   int16_t minIdx = 0;
   int8_t minValue = array[0];
@@ -129,3 +146,16 @@ static int compare( const void* a, const void* b) {
     return 1;
    };
 };
+
+static int compareInt16(const void *a, const void *b) {
+  int16_t int_a = *((const int16_t *) a);
+  int16_t int_b = *((const int16_t *) b);
+
+  if (int_a == int_b) {
+    return 0;
+  } else if (int_a < int_b) {
+    return -1;
+  } else {
+    return 1;
+  };
+};
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+extern "C" {
+#include "../include/Channel.h"
+}
+
+TEST(ChannelTest, singleReceptionIsDelivered) {
+  Channel channel = Channel_Create(1);
+
+  EXPECT_TRUE(Channel_StartReception(channel, 0, 1, 0, 20, 0.0));
+  EXPECT_TRUE(Channel_IsBusy(channel, 0));
+  EXPECT_EQ(CHANNEL_RX_MESSAGE, Channel_EndReception(channel, 0, 1, 20));
+  EXPECT_FALSE(Channel_IsBusy(channel, 0));
+
+  Channel_Destroy(channel);
+}
+
+TEST(ChannelTest, overlappingReceptionsCollideWithoutCapture) {
+  Channel channel = Channel_Create(1);
+
+  EXPECT_TRUE(Channel_StartReception(channel, 0, 1, 0, 20, 0.0));
+  EXPECT_FALSE(Channel_StartReception(channel, 0, 2, 10, 19, -100.0));
+  EXPECT_EQ(1, channel->numOverlaps);
+
+  // the node gets one collision when the last transmission ends
+  EXPECT_EQ(CHANNEL_RX_NONE, Channel_EndReception(channel, 0, 2, 19));
+  EXPECT_EQ(CHANNEL_RX_COLLISION, Channel_EndReception(channel, 0, 1, 20));
+
+  Channel_Destroy(channel);
+}
+
+TEST(ChannelTest, strongReceptionIsCapturedOnlyAboveThreshold) {
+  Channel channel = Channel_Create(2);
+  Channel_SetCapture(channel, true, 10.0, 2.0);
+
+  // receiver 0: locked transmission ends first and is delivered while the weak one still goes on
+  double strong = Channel_ReceivedPower(channel, 1.0);
+  double weak = Channel_ReceivedPower(channel, 10.0);
+  EXPECT_DOUBLE_EQ(20.0, strong - weak);
+  Channel_StartReception(channel, 0, 1, 0, 9, strong);
+  Channel_StartReception(channel, 0, 2, 5, 25, weak);
+  EXPECT_EQ(CHANNEL_RX_MESSAGE, Channel_EndReception(channel, 0, 1, 9));
+  EXPECT_TRUE(Channel_IsBusy(channel, 0));
+  EXPECT_EQ(CHANNEL_RX_NONE, Channel_EndReception(channel, 0, 2, 25));
+  EXPECT_EQ(1, channel->numCaptures);
+
+  // receiver 1: interference is too strong
+  Channel_StartReception(channel, 1, 3, 0, 9, Channel_ReceivedPower(channel, 1.0));
+  Channel_StartReception(channel, 1, 4, 5, 25, Channel_ReceivedPower(channel, 2.0));
+  EXPECT_EQ(CHANNEL_RX_NONE, Channel_EndReception(channel, 1, 3, 9));
+  EXPECT_EQ(CHANNEL_RX_COLLISION, Channel_EndReception(channel, 1, 4, 25));
+  EXPECT_EQ(1, channel->numCaptures);
+
+  Channel_Destroy(channel);
+}
+
+TEST(ChannelTest, receptionIsLostWhenReceiverTransmits) {
+  Channel channel = Channel_Create(1);
+
+  Channel_StartReception(channel, 0, 1, 0, 20, 0.0);
+  Channel_AbortReceptions(channel, 0);
+  EXPECT_EQ(CHANNEL_RX_LOST, Channel_EndReception(channel, 0, 1, 20));
+
+  // the next busy period starts clean
+  Channel_StartReception(channel, 0, 2, 30, 50, 0.0);
+  EXPECT_EQ(CHANNEL_RX_MESSAGE, Channel_EndReception(channel, 0, 2, 50));
+
+  Channel_Destroy(channel);
+}
+
+TEST(ChannelTest, countOverlapsCountsReceptionsGoingOnAtTime) {
+  Channel channel = Channel_Create(1);
+
+  for (uint64_t id = 0; id < 10; ++id) {
+    Channel_StartReception(channel, 0, id, id, 100 - 5 * id, 0.0);
+  };
+  // receptions end at 100, 95, ..., 55
+  EXPECT_EQ(10, Channel_CountOverlaps(channel, 0, 54));
+  EXPECT_EQ(5, Channel_CountOverlaps(channel, 0, 75));
+  EXPECT_EQ(0, Channel_CountOverlaps(channel, 0, 100));
+
+  // ending one in the middle keeps the others sorted
+  EXPECT_EQ(CHANNEL_RX_NONE, Channel_EndReception(channel, 0, 4, 80));
+  EXPECT_EQ(4, Channel_CountOverlaps(channel, 0, 75));
+
+  Channel_Destroy(channel);
+}
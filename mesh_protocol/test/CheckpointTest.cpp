@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+
+extern "C" {
+#include "../include/Simulator.h"
+#include "../include/Node.h"
+#include "../include/StateMachine.h"
+#include "../include/NetworkManager.h"
+#include "../include/SlotMap.h"
+#include "../include/Config.h"
+}
+
+class CheckpointTestGeneral : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    sim = Simulator_Create(MAX_NUM_NODES, 42);
+    Simulator_SetRadioRange(sim, 1.5);
+
+    int skews[4] = {50, -50, 70, 0};
+    for (int i = 0; i < 4; ++i) {
+      Simulator_AddNode(sim, i + 1, i, 0, 10 * i);
+      Simulator_SetClockSkew(sim, i, skews[i]);
+    };
+  }
+
+  void TearDown() override {
+    Simulator_Destroy(sim);
+  }
+
+  /** run until a transmission is on the channel, so that it has to be copied as well */
+  void warmUp(int64_t endTime) {
+    Simulator_RunUntil(sim, endTime);
+    while (sim->numEvents == 0) {
+      Simulator_Step(sim);
+    };
+  }
+
+  /** save the simulation and load it again; return NULL if the checkpoint is rejected */
+  Simulator saveAndLoad(Simulator simulator) {
+    FILE *file = tmpfile();
+    EXPECT_NE(nullptr, file);
+    EXPECT_TRUE(Simulator_SaveCheckpoint(simulator, file));
+    rewind(file);
+    Simulator loaded = Simulator_LoadCheckpoint(file);
+    fclose(file);
+    return loaded;
+  }
+
+  void expectSameState(Simulator a, Simulator b) {
+    EXPECT_EQ(Simulator_GetTime(a), Simulator_GetTime(b));
+    EXPECT_EQ(0, memcmp(&a->stats, &b->stats, sizeof(SimulatorStatsStruct)));
+    ASSERT_EQ(a->numNodes, b->numNodes);
+    for (int16_t i = 0; i < a->numNodes; ++i) {
+      Node nodeA = Simulator_GetNode(a, i);
+      Node nodeB = Simulator_GetNode(b, i);
+      EXPECT_EQ(nodeA->id, nodeB->id);
+      EXPECT_EQ(a->localTimes[i], b->localTimes[i]);
+      EXPECT_EQ(StateMachine_GetState(nodeA), StateMachine_GetState(nodeB));
+      EXPECT_EQ(NetworkManager_GetNetworkId(nodeA), NetworkManager_GetNetworkId(nodeB));
+      EXPECT_EQ(0, memcmp(nodeA->slotMap, nodeB->slotMap, sizeof(SlotMapStruct)));
+      EXPECT_EQ(nodeA->lcg->next, nodeB->lcg->next);
+    };
+  }
+
+  Simulator sim;
+};
+
+TEST_F(CheckpointTestGeneral, forkContinuesLikeOriginal) {
+  warmUp(10000);
+  Simulator fork = Simulator_Fork(sim);
+  expectSameState(sim, fork);
+  EXPECT_EQ(sim->numEvents, fork->numEvents);
+
+  Simulator_RunUntil(sim, 30000);
+  Simulator_RunUntil(fork, 30000);
+  expectSameState(sim, fork);
+
+  Simulator_Destroy(fork);
+}
+
+TEST_F(CheckpointTestGeneral, forkSharesNoStateWithOriginal) {
+  warmUp(10000);
+  Simulator fork = Simulator_Fork(sim);
+  Simulator reference = Simulator_Fork(sim);
+
+  // a different variant of the protocol in the fork does not change the original
+  for (int16_t i = 0; i < fork->numNodes; ++i) {
+    Simulator_GetNode(fork, i)->config->slotGoal = 2;
+  };
+  Simulator_MoveNode(fork, 0, 10, 10);
+  Simulator_RunUntil(fork, 30000);
+  Simulator_Destroy(fork);
+
+  Simulator_RunUntil(sim, 30000);
+  Simulator_RunUntil(reference, 30000);
+  expectSameState(sim, reference);
+
+  Simulator_Destroy(reference);
+}
+
+TEST_F(CheckpointTestGeneral, loadedCheckpointContinuesLikeOriginal) {
+  warmUp(10000);
+  Simulator_SetIdleSkipping(sim, true);
+
+  FILE *file = tmpfile();
+  ASSERT_NE(nullptr, file);
+  ASSERT_TRUE(Simulator_SaveCheckpoint(sim, file));
+  rewind(file);
+  Simulator loaded = Simulator_LoadCheckpoint(file);
+  fclose(file);
+  ASSERT_NE(nullptr, loaded);
+  expectSameState(sim, loaded);
+  EXPECT_TRUE(loaded->idleSkipping);
+
+  Simulator_RunUntil(sim, 30000);
+  Simulator_RunUntil(loaded, 30000);
+  expectSameState(sim, loaded);
+
+  Simulator_Destroy(loaded);
+}
+
+TEST_F(CheckpointTestGeneral, invalidCheckpointIsRejected) {
+  warmUp(10000);
+
+  FILE *file = tmpfile();
+  ASSERT_NE(nullptr, file);
+  fwrite("MTRC", 1, 4, file);
+  rewind(file);
+  EXPECT_EQ(nullptr, Simulator_LoadCheckpoint(file));
+  fclose(file);
+
+  // a checkpoint that ends early is rejected as well
+  file = tmpfile();
+  ASSERT_NE(nullptr, file);
+  ASSERT_TRUE(Simulator_SaveCheckpoint(sim, file));
+  long size = ftell(file);
+  rewind(file);
+  char *buffer = (char *) malloc(size);
+  ASSERT_EQ((size_t) size, fread(buffer, 1, size, file));
+  fclose(file);
+
+  file = tmpfile();
+  fwrite(buffer, 1, size - 8, file);
+  rewind(file);
+  EXPECT_EQ(nullptr, Simulator_LoadCheckpoint(file));
+  fclose(file);
+  free(buffer);
+}
+
+TEST_F(CheckpointTestGeneral, checkpointWithIndexOutOfRangeIsRejected) {
+  warmUp(10000);
+  Transmission tx = sim->events[0].tx;
+  ASSERT_GT(tx->numReceivers, 0);
+
+  // every corrupted value would index the nodes or the message pool out of bounds once the transmission ends
+  int16_t senderIdx = tx->senderIdx;
+  tx->senderIdx = sim->numNodes;
+  EXPECT_EQ(nullptr, saveAndLoad(sim));
+  tx->senderIdx = senderIdx;
+
+  int16_t receiverIdx = tx->receivers[0];
+  tx->receivers[0] = -1;
+  EXPECT_EQ(nullptr, saveAndLoad(sim));
+  tx->receivers[0] = receiverIdx;
+
+  MessageTypes type = tx->msg->type;
+  tx->msg->type = (MessageTypes) 42;
+  EXPECT_EQ(nullptr, saveAndLoad(sim));
+  tx->msg->type = type;
+
+  int8_t numCollisions = tx->msg->numCollisions;
+  tx->msg->numCollisions = MAX_NUM_COLLISIONS_RECORDED + 1;
+  EXPECT_EQ(nullptr, saveAndLoad(sim));
+  tx->msg->numCollisions = numCollisions;
+
+  // a reception that ends before it starts
+  ChannelReceiver receiver = &sim->channel->receivers[receiverIdx];
+  ASSERT_GT(receiver->numActive, 0);
+  int64_t start = receiver->active[0].start;
+  receiver->active[0].start = receiver->active[0].end + 1;
+  EXPECT_EQ(nullptr, saveAndLoad(sim));
+  receiver->active[0].start = start;
+
+  Simulator loaded = saveAndLoad(sim);
+  ASSERT_NE(nullptr, loaded);
+  expectSameState(sim, loaded);
+  Simulator_Destroy(loaded);
+}
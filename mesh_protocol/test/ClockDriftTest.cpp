@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+
+extern "C" {
+#include "../include/ClockDrift.h"
+#include "../include/Simulator.h"
+#include "../include/Node.h"
+#include "../include/StateMachine.h"
+#include "../include/SlotMap.h"
+#include "../include/Config.h"
+}
+
+TEST(ClockDriftTest, constantOffsetIsConvertedToFixedPoint) {
+  ClockDriftStruct drift;
+  ClockDrift_Init(&drift, 100, 0, 0, 0, 0, 1, 0);
+  EXPECT_EQ(CLOCK_DRIFT_NO_UPDATE, drift.nextUpdate);
+  EXPECT_DOUBLE_EQ(100, drift.ratePpm);
+  EXPECT_EQ(llround(100e-6 * 4294967296.0), ClockDrift_GetIncrement(&drift));
+  EXPECT_FALSE(ClockDrift_Update(&drift, 1000000));
+
+  ClockDrift_Init(&drift, -20, 0, 0, 0, 0, 1, 0);
+  EXPECT_LT(ClockDrift_GetIncrement(&drift), 0);
+}
+
+TEST(ClockDriftTest, randomWalkIsDeterministic) {
+  ClockDriftStruct a, b, c;
+  ClockDrift_Init(&a, 0, 1, 0, 0, 100, 7, 0);
+  ClockDrift_Init(&b, 0, 1, 0, 0, 100, 7, 0);
+  ClockDrift_Init(&c, 0, 1, 0, 0, 100, 8, 0);
+
+  bool differs = false;
+  for (int64_t time = 0; time <= 10000; ++time) {
+    EXPECT_EQ(ClockDrift_Update(&a, time), ClockDrift_Update(&b, time));
+    ClockDrift_Update(&c, time);
+    EXPECT_EQ(a.ratePpm, b.ratePpm);
+    differs = differs || (a.ratePpm != c.ratePpm);
+  };
+  EXPECT_TRUE(differs);
+  EXPECT_EQ(10100, a.nextUpdate);
+}
+
+TEST(ClockDriftTest, variationFollowsPeriod) {
+  ClockDriftStruct drift;
+  ClockDrift_Init(&drift, 0, 0, 10, 1000, 10, 1, 0);
+  EXPECT_NEAR(0, drift.ratePpm, 1e-9);
+  ClockDrift_Update(&drift, 250);
+  EXPECT_NEAR(10, drift.ratePpm, 1e-9);
+  ClockDrift_Update(&drift, 750);
+  EXPECT_NEAR(-10, drift.ratePpm, 1e-9);
+}
+
+class ClockDriftTestSimulator : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    sim = Simulator_Create(MAX_NUM_NODES, 42);
+    Simulator_SetRadioRange(sim, 1.5);
+    for (int i = 0; i < 4; ++i) {
+      Simulator_AddNode(sim, i + 1, i, 0, 10 * i);
+    };
+  }
+
+  void TearDown() override {
+    Simulator_Destroy(sim);
+  }
+
+  void expectSameState(Simulator a, Simulator b) {
+    EXPECT_EQ(Simulator_GetTime(a), Simulator_GetTime(b));
+    EXPECT_EQ(0, memcmp(&a->stats, &b->stats, sizeof(SimulatorStatsStruct)));
+    for (int16_t i = 0; i < a->numNodes; ++i) {
+      EXPECT_EQ(a->localTimes[i], b->localTimes[i]);
+      EXPECT_EQ(a->driftFraction[i], b->driftFraction[i]);
+      EXPECT_EQ(a->driftIncrement[i], b->driftIncrement[i]);
+      EXPECT_EQ(StateMachine_GetState(Simulator_GetNode(a, i)), StateMachine_GetState(Simulator_GetNode(b, i)));
+      EXPECT_EQ(0, memcmp(Simulator_GetNode(a, i)->slotMap, Simulator_GetNode(b, i)->slotMap, sizeof(SlotMapStruct)));
+    };
+  }
+
+  Simulator sim;
+};
+
+TEST_F(ClockDriftTestSimulator, constantOffsetGainsExpectedTime) {
+  Simulator_SetClockDrift(sim, 0, 100, 0, 0, 0, 0);
+  Simulator_SetClockDrift(sim, 1, -100, 0, 0, 0, 0);
+  Simulator_RunUntil(sim, 100000);
+
+  // 100 ppm of 100000 tics are 10 tics
+  EXPECT_NEAR(10, Simulator_GetClockOffset(sim, 0), 1e-3);
+  EXPECT_NEAR(-10 * (100000 - 10) / 100000.0, Simulator_GetClockOffset(sim, 1), 1e-3);
+  EXPECT_EQ(0, Simulator_GetClockOffset(sim, 2));
+}
+
+TEST_F(ClockDriftTestSimulator, idleSkippingGivesSameResult) {
+  Simulator_SetClockDrift(sim, 0, 150, 0, 0, 0, 0);
+  Simulator_SetClockDrift(sim, 1, -80, 2, 20, 50000, 1000);
+  Simulator_SetClockDrift(sim, 2, 30, 1, 0, 0, 777);
+  Simulator_SetClockSkew(sim, 3, 70);
+
+  Simulator skipping = Simulator_Fork(sim);
+  Simulator_SetIdleSkipping(skipping, true);
+
+  Simulator_RunUntil(sim, 200000);
+  Simulator_RunUntil(skipping, 200000);
+  expectSameState(sim, skipping);
+
+  Simulator_Destroy(skipping);
+}
+
+TEST_F(ClockDriftTestSimulator, clockSkewReplacesDrift) {
+  Simulator_SetClockDrift(sim, 0, 100, 0, 0, 0, 0);
+  Simulator_SetClockSkew(sim, 0, 0);
+  EXPECT_EQ(0, sim->driftIncrement[0]);
+  Simulator_RunUntil(sim, 100000);
+  EXPECT_EQ(0, Simulator_GetClockOffset(sim, 0));
+}
+
+TEST_F(ClockDriftTestSimulator, checkpointPreservesDrift) {
+  Simulator_SetClockDrift(sim, 0, 0, 3, 5, 20000, 500);
+  Simulator_SetClockDrift(sim, 1, -40, 0, 0, 0, 0);
+  Simulator_RunUntil(sim, 10000);
+
+  FILE *file = tmpfile();
+  ASSERT_NE(nullptr, file);
+  ASSERT_TRUE(Simulator_SaveCheckpoint(sim, file));
+  rewind(file);
+  Simulator loaded = Simulator_LoadCheckpoint(file);
+  fclose(file);
+  ASSERT_NE(nullptr, loaded);
+  EXPECT_EQ(sim->nextDriftUpdate, loaded->nextDriftUpdate);
+
+  Simulator_RunUntil(sim, 60000);
+  Simulator_RunUntil(loaded, 60000);
+  expectSameState(sim, loaded);
+
+  Simulator_Destroy(loaded);
+}
+
+TEST_F(ClockDriftTestSimulator, driftsAreReadFromFile) {
+  FILE *file = tmpfile();
+  ASSERT_NE(nullptr, file);
+  fputs("# nodeIdx offsetPpm randomWalkPpm variationPpm variationPeriod updateInterval\n", file);
+  fputs("0 25\n", file);
+  fputs("2, -10, 1, 2, 10000, 100\n", file);
+  rewind(file);
+  EXPECT_EQ(2, Simulator_ReadClockDrifts(sim, file));
+  fclose(file);
+  EXPECT_DOUBLE_EQ(25, sim->drifts[0].ratePpm);
+  EXPECT_EQ(100, sim->drifts[2].updateInterval);
+  EXPECT_EQ(100, sim->nextDriftUpdate);
+
+  file = tmpfile();
+  fputs("9 25\n", file);
+  rewind(file);
+  EXPECT_EQ(-1, Simulator_ReadClockDrifts(sim, file));
+  fclose(file);
+}
@@ -70,6 +70,7 @@ class MessageHandlerTestGeneral : public ::testing::Test {
     timeKeeping = TimeKeeping_Create();
     slotMap = SlotMap_Create();
     neighborhood = Neighborhood_Create();
+    timerWheel = TimerWheel_Create();
 
     int64_t *time = (int64_t *)malloc(1);
     *time = 5;
@@ -84,6 +85,7 @@ class MessageHandlerTestGeneral : public ::testing::Test {
     Node_SetSlotMap(node, slotMap);
     Node_SetNeighborhood(node, neighborhood);
     Node_SetConfig(node, config);
+    Node_SetTimerWheel(node, timerWheel);
   }
 
    //void TearDown() override {}
@@ -96,6 +98,7 @@ class MessageHandlerTestGeneral : public ::testing::Test {
   ProtocolClock clock;
   SlotMap slotMap;
   Neighborhood neighborhood;
+  TimerWheel timerWheel;
   Config config;
 };
 
@@ -105,19 +108,19 @@ TEST_F(MessageHandlerTestGeneral, handlePingUnconnected) {
   msg->senderId = 2;
   msg->timestamp = ProtocolClock_GetLocalTime(node->clock);
 
-  msg->oneHopSlotStatus[0] = FREE;
-  msg->oneHopSlotStatus[1] = OCCUPIED;
-  msg->oneHopSlotStatus[2] = FREE;
-  msg->oneHopSlotStatus[3] = FREE;
+  SlotStatus_Set(&msg->oneHopSlotStatus, 0, FREE);
+  SlotStatus_Set(&msg->oneHopSlotStatus, 1, OCCUPIED);
+  SlotStatus_Set(&msg->oneHopSlotStatus, 2, FREE);
+  SlotStatus_Set(&msg->oneHopSlotStatus, 3, FREE);
   msg->oneHopSlotIds[0] = 0;
   msg->oneHopSlotIds[1] = 3;
   msg->oneHopSlotIds[2] = 0;
   msg->oneHopSlotIds[3] = 0;
 
-  msg->twoHopSlotStatus[0] = FREE;
-  msg->twoHopSlotStatus[1] = FREE;
-  msg->twoHopSlotStatus[2] = FREE;
-  msg->twoHopSlotStatus[3] = COLLIDING;
+  SlotStatus_Set(&msg->twoHopSlotStatus, 0, FREE);
+  SlotStatus_Set(&msg->twoHopSlotStatus, 1, FREE);
+  SlotStatus_Set(&msg->twoHopSlotStatus, 2, FREE);
+  SlotStatus_Set(&msg->twoHopSlotStatus, 3, COLLIDING);
   msg->twoHopSlotIds[0] = 0;
   msg->twoHopSlotIds[1] = 0;
   msg->twoHopSlotIds[2] = 0;
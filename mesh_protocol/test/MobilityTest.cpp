@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+
+extern "C" {
+#include "../include/Mobility.h"
+#include "../include/Simulator.h"
+#include "../include/Node.h"
+#include "../include/StateMachine.h"
+#include "../include/Neighborhood.h"
+}
+
+TEST(MobilityTest, nodesAreStaticByDefault) {
+  Mobility mobility = Mobility_Create(2, 1);
+  EXPECT_FALSE(Mobility_IsMoving(mobility, 0));
+  EXPECT_EQ(0, mobility->numMoving);
+
+  double x = 3, y = 4;
+  Mobility_GetPosition(mobility, 0, 1000, &x, &y);
+  EXPECT_EQ(3, x);
+  EXPECT_EQ(4, y);
+
+  Mobility_Destroy(mobility);
+}
+
+TEST(MobilityTest, pathIsInterpolatedBetweenWaypoints) {
+  Mobility mobility = Mobility_Create(1, 1);
+  // not ordered by time on purpose
+  MobilityWaypointStruct waypoints[3] = {{200, 10, 10}, {100, 10, 0}, {0, 0, 0}};
+  Mobility_SetPath(mobility, 0, &waypoints[0], 3);
+  EXPECT_TRUE(Mobility_IsMoving(mobility, 0));
+
+  double x, y;
+  Mobility_GetPosition(mobility, 0, 0, &x, &y);
+  EXPECT_DOUBLE_EQ(0, x);
+  Mobility_GetPosition(mobility, 0, 50, &x, &y);
+  EXPECT_DOUBLE_EQ(5, x);
+  EXPECT_DOUBLE_EQ(0, y);
+  Mobility_GetPosition(mobility, 0, 175, &x, &y);
+  EXPECT_DOUBLE_EQ(10, x);
+  EXPECT_DOUBLE_EQ(7.5, y);
+
+  // the node stays at the last waypoint
+  Mobility_GetPosition(mobility, 0, 1000, &x, &y);
+  EXPECT_DOUBLE_EQ(10, x);
+  EXPECT_DOUBLE_EQ(10, y);
+
+  Mobility_Destroy(mobility);
+}
+
+TEST(MobilityTest, randomWaypointStaysInAreaAndBelowMaxSpeed) {
+  Mobility mobility = Mobility_Create(1, 42);
+  Mobility_SetRandomWaypoint(mobility, 0, 5, 5, 0, 0, 10, 20, 0.01, 0.05, 100);
+
+  double lastX = 5, lastY = 5;
+  bool moved = false;
+  for (int64_t time = 1; time < 100000; time += 7) {
+    double x, y;
+    Mobility_GetPosition(mobility, 0, time, &x, &y);
+    EXPECT_GE(x, 0);
+    EXPECT_LE(x, 10);
+    EXPECT_GE(y, 0);
+    EXPECT_LE(y, 20);
+    EXPECT_LE(hypot(x - lastX, y - lastY), 7 * 0.05 + 1e-9);
+    moved = moved || (x != lastX || y != lastY);
+    lastX = x;
+    lastY = y;
+  };
+  EXPECT_TRUE(moved);
+
+  Mobility_Destroy(mobility);
+}
+
+TEST(MobilityTest, pathsAreReadFromFile) {
+  Mobility mobility = Mobility_Create(3, 1);
+
+  FILE *file = tmpfile();
+  ASSERT_NE(nullptr, file);
+  fputs("# nodeIdx time x y\n2, 100, 4.0, 2.0\n2 0 0 0\n\n0 50 1 1\n", file);
+  rewind(file);
+  EXPECT_EQ(3, Mobility_ReadPaths(mobility, file));
+  fclose(file);
+
+  EXPECT_TRUE(Mobility_IsMoving(mobility, 0));
+  EXPECT_FALSE(Mobility_IsMoving(mobility, 1));
+  EXPECT_TRUE(Mobility_IsMoving(mobility, 2));
+
+  double x, y;
+  Mobility_GetPosition(mobility, 2, 25, &x, &y);
+  EXPECT_DOUBLE_EQ(1, x);
+  EXPECT_DOUBLE_EQ(0.5, y);
+
+  file = tmpfile();
+  fputs("7 0 0 0\n", file);
+  rewind(file);
+  EXPECT_EQ(-1, Mobility_ReadPaths(mobility, file));
+  fclose(file);
+
+  Mobility_Destroy(mobility);
+}
+
+TEST(MobilityTest, movingNodeLeavesRadioRange) {
+  Simulator sim = Simulator_Create(2, 42);
+  Simulator_SetRadioRange(sim, 1.5);
+  Simulator_AddNode(sim, 1, 0, 0, 0);
+  Simulator_AddNode(sim, 2, 1, 0, 0);
+
+  // node 2 moves away after the network has formed
+  Mobility mobility = Mobility_Create(2, 1);
+  MobilityWaypointStruct waypoints[2] = {{20000, 1, 0}, {20100, 100, 0}};
+  Mobility_SetPath(mobility, 1, &waypoints[0], 2);
+  Simulator_SetMobility(sim, mobility);
+
+  Simulator_RunUntil(sim, 20000);
+  EXPECT_EQ(1, Simulator_GetNode(sim, 0)->neighborhood->numOneHopNeighbors);
+  uint64_t numDelivered = sim->stats.numDelivered;
+  EXPECT_GT(numDelivered, 0);
+
+  Simulator_RunUntil(sim, 30000);
+  EXPECT_EQ(numDelivered, sim->stats.numDelivered);
+  EXPECT_EQ(100, sim->posX[1]);
+  EXPECT_EQ(0, Simulator_GetNode(sim, 0)->neighborhood->numOneHopNeighbors);
+
+  double distance;
+  EXPECT_TRUE(Simulator_GetTrueDistance(sim, 0, 2, &distance));
+  EXPECT_DOUBLE_EQ(100, distance);
+  EXPECT_FALSE(Simulator_GetTrueDistance(sim, 0, 5, &distance));
+
+  Simulator_Destroy(sim);
+  Mobility_Destroy(mobility);
+}
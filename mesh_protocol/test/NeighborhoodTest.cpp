@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+
+extern "C" {
+#include "../include/Node.h"
+#include "../include/Neighborhood.h"
+#include "../include/ProtocolClock.h"
+#include "../include/Config.h"
+#include "../include/TimerWheel.h"
+}
+
+class NeighborhoodTestGeneral : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    node = Node_Create();
+    neighborhood = Neighborhood_Create();
+    config = Config_Create();
+    timerWheel = TimerWheel_Create();
+
+    time = 1;
+    clock = ProtocolClock_Create(&time);
+
+    Node_SetNeighborhood(node, neighborhood);
+    Node_SetClock(node, clock);
+    Node_SetConfig(node, config);
+    Node_SetTimerWheel(node, timerWheel);
+  }
+
+  int64_t time;
+  Node node;
+  Neighborhood neighborhood;
+  ProtocolClock clock;
+  Config config;
+  TimerWheel timerWheel;
+};
+
+TEST_F(NeighborhoodTestGeneral, rangingResultUpdatesNeighbor) {
+  Neighborhood_AddOrUpdateOneHopNeighbor(node, 2);
+  Neighborhood_AddOrUpdateOneHopNeighbor(node, 3);
+  Neighborhood_UpdateRanging(node, 3, 4, 1.5);
+
+  EXPECT_EQ(0, neighborhood->oneHopNeighborsLastRanging[0]);
+  EXPECT_EQ(4, neighborhood->oneHopNeighborsLastRanging[1]);
+  EXPECT_DOUBLE_EQ(1.5, neighborhood->oneHopNeighborsLastDistance[1]);
+}
+
+TEST_F(NeighborhoodTestGeneral, rangingResultOfUnknownNeighborIsIgnored) {
+  Neighborhood_AddOrUpdateOneHopNeighbor(node, 2);
+  Neighborhood_AddOrUpdateOneHopNeighbor(node, 3);
+  Neighborhood_UpdateRanging(node, 3, 4, 1.5);
+  NeighborhoodStruct before = *neighborhood;
+
+  // a result can arrive from a node that has already been removed from the neighborhood
+  Neighborhood_UpdateRanging(node, 7, 5, 2.5);
+
+  EXPECT_EQ(0, memcmp(&before, neighborhood, sizeof(NeighborhoodStruct)));
+  EXPECT_EQ(2, neighborhood->numOneHopNeighbors);
+}
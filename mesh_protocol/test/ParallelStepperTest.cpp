@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+extern "C" {
+#include "../include/ParallelStepper.h"
+#include "../include/Simulator.h"
+#include "../include/Node.h"
+#include "../include/StateMachine.h"
+#include "../include/NetworkManager.h"
+#include "../include/SlotMap.h"
+}
+
+class ParallelStepperTestGeneral : public ::testing::Test {
+ protected:
+  /** several clusters of MAX_NUM_NODES nodes; a cluster is a line of nodes, far away from the other clusters */
+  Simulator createClusters(int16_t numClusters) {
+    Simulator sim = Simulator_Create(numClusters * MAX_NUM_NODES, 42);
+    Simulator_SetRadioRange(sim, 1.5);
+    for (int16_t c = 0; c < numClusters; ++c) {
+      for (int16_t i = 0; i < MAX_NUM_NODES; ++i) {
+        int16_t nodeIdx = Simulator_AddNode(sim, i + 1, i, 100 * c, 10 * i + c);
+        Simulator_SetClockSkew(sim, nodeIdx, (i % 3 == 0) ? 0 : (50 + 10 * i) * ((c % 2 == 0) ? 1 : -1));
+      };
+    };
+    return sim;
+  }
+
+  void expectSameState(Simulator a, Simulator b) {
+    EXPECT_EQ(Simulator_GetTime(a), Simulator_GetTime(b));
+    EXPECT_EQ(0, memcmp(&a->stats, &b->stats, sizeof(SimulatorStatsStruct)));
+    ASSERT_EQ(a->numNodes, b->numNodes);
+    for (int16_t i = 0; i < a->numNodes; ++i) {
+      Node nodeA = Simulator_GetNode(a, i);
+      Node nodeB = Simulator_GetNode(b, i);
+      EXPECT_EQ(a->localTimes[i], b->localTimes[i]);
+      EXPECT_EQ(StateMachine_GetState(nodeA), StateMachine_GetState(nodeB));
+      EXPECT_EQ(NetworkManager_GetNetworkId(nodeA), NetworkManager_GetNetworkId(nodeB));
+      EXPECT_EQ(0, memcmp(nodeA->slotMap, nodeB->slotMap, sizeof(SlotMapStruct)));
+      EXPECT_EQ(0, memcmp(nodeA->neighborhood, nodeB->neighborhood, sizeof(NeighborhoodStruct)));
+      EXPECT_EQ(nodeA->lcg->next, nodeB->lcg->next);
+    };
+  }
+};
+
+TEST_F(ParallelStepperTestGeneral, resultIsSameAsSequential) {
+  Simulator sequential = createClusters(8);
+  Simulator parallel = createClusters(8);
+  ParallelStepper stepper = ParallelStepper_Create(parallel, 4);
+
+  Simulator_RunUntil(sequential, 30000);
+  ParallelStepper_RunUntil(stepper, 30000);
+  expectSameState(sequential, parallel);
+  EXPECT_EQ(30000, stepper->numTics);
+
+  ParallelStepper_Destroy(stepper);
+  Simulator_Destroy(sequential);
+  Simulator_Destroy(parallel);
+}
+
+TEST_F(ParallelStepperTestGeneral, resultIsSameAsSequentialWithIdleSkipping) {
+  Simulator sequential = createClusters(5);
+  Simulator parallel = createClusters(5);
+  Simulator_SetIdleSkipping(sequential, true);
+  Simulator_SetIdleSkipping(parallel, true);
+  ParallelStepper stepper = ParallelStepper_Create(parallel, 3);
+
+  Simulator_RunUntil(sequential, 30000);
+  ParallelStepper_RunUntil(stepper, 30000);
+  expectSameState(sequential, parallel);
+
+  ParallelStepper_Destroy(stepper);
+  Simulator_Destroy(sequential);
+  Simulator_Destroy(parallel);
+}
+
+TEST_F(ParallelStepperTestGeneral, nodesReachedInTheSameTicAreRunAgain) {
+  // all nodes in range of each other, so that every transmission reaches the nodes with higher indices
+  Simulator sequential = Simulator_Create(MAX_NUM_NODES, 7);
+  Simulator parallel = Simulator_Create(MAX_NUM_NODES, 7);
+  for (int16_t i = 0; i < MAX_NUM_NODES; ++i) {
+    Simulator_AddNode(sequential, i + 1, 0.1 * i, 0, 0);
+    Simulator_AddNode(parallel, i + 1, 0.1 * i, 0, 0);
+  };
+  ParallelStepper stepper = ParallelStepper_Create(parallel, MAX_NUM_NODES);
+
+  Simulator_RunUntil(sequential, 30000);
+  ParallelStepper_RunUntil(stepper, 30000);
+  expectSameState(sequential, parallel);
+  EXPECT_GT(stepper->numReruns, 0);
+
+  ParallelStepper_Destroy(stepper);
+  Simulator_Destroy(sequential);
+  Simulator_Destroy(parallel);
+}
+
+TEST_F(ParallelStepperTestGeneral, nodesAddedAfterCreationAreStepped) {
+  Simulator sequential = createClusters(2);
+  Simulator parallel = Simulator_Create(2 * MAX_NUM_NODES, 42);
+  Simulator_SetRadioRange(parallel, 1.5);
+  ParallelStepper stepper = ParallelStepper_Create(parallel, 2);
+  for (int16_t c = 0; c < 2; ++c) {
+    for (int16_t i = 0; i < MAX_NUM_NODES; ++i) {
+      int16_t nodeIdx = Simulator_AddNode(parallel, i + 1, i, 100 * c, 10 * i + c);
+      Simulator_SetClockSkew(parallel, nodeIdx, (i % 3 == 0) ? 0 : (50 + 10 * i) * ((c % 2 == 0) ? 1 : -1));
+    };
+  };
+
+  Simulator_RunUntil(sequential, 20000);
+  ParallelStepper_RunUntil(stepper, 20000);
+  expectSameState(sequential, parallel);
+
+  ParallelStepper_Destroy(stepper);
+  Simulator_Destroy(sequential);
+  Simulator_Destroy(parallel);
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+extern "C" {
+#include "../include/Replay.h"
+#include "../include/NetworkManager.h"
+}
+
+TEST(ReplayTest, evalLinesAreParsedAndOtherOutputIsIgnored) {
+  ReplayEventStruct event;
+
+  ASSERT_TRUE(Replay_ParseLine("TX PING 3 0 12345 2 7 \n", &event));
+  EXPECT_EQ(REPLAY_TX_PING, event.type);
+  EXPECT_EQ(3, event.peerId);
+  EXPECT_EQ(12345, event.localTime);
+  EXPECT_EQ(2, event.slotNum);
+
+  ASSERT_TRUE(Replay_ParseLine("RX DIST 4 1.250000 2000 1 0 \n", &event));
+  EXPECT_EQ(REPLAY_RX_DIST, event.type);
+  EXPECT_EQ(RESULT, event.msg.type);
+  EXPECT_DOUBLE_EQ(1.25, event.msg.distance);
+  EXPECT_TRUE(event.complete);
+
+  // a received ping without its content cannot be replayed
+  ASSERT_TRUE(Replay_ParseLine("RX PING 4 0 2000 1 3 \n", &event));
+  EXPECT_FALSE(event.complete);
+
+  EXPECT_FALSE(Replay_ParseLine("Node 1 scheduled ping to 123\n", &event));
+  EXPECT_FALSE(Replay_ParseLine("TX PING\n", &event));
+  EXPECT_FALSE(Replay_ParseLine("\n", &event));
+}
+
+TEST(ReplayTest, replayOfOwnOutputHasNoDifferences) {
+  // record what a node does on its own
+  Replay recording = Replay_Create(1, 123456);
+  Replay_RunUntil(recording, 50000);
+  ASSERT_GT(recording->txLog.num, 2);
+
+  Replay replay = Replay_Create(1, 123456);
+  for (int32_t i = 0; i < recording->txLog.num; ++i) {
+    std::string line = "TX PING 1 0 " + std::to_string(recording->txLog.elements[i].time) + " 1 0 \n";
+    ASSERT_TRUE(Replay_AddLine(replay, line.c_str()));
+  };
+  Replay_RunUntil(replay, 50000);
+  EXPECT_EQ(0, Replay_Diff(replay, 50000, 0, NULL));
+
+  // a node with a different seed sends at different times
+  Replay other = Replay_Create(1, 654321);
+  for (int32_t i = 0; i < recording->txLog.num; ++i) {
+    std::string line = "TX PING 1 0 " + std::to_string(recording->txLog.elements[i].time) + " 1 0 \n";
+    Replay_AddLine(other, line.c_str());
+  };
+  Replay_RunUntil(other, 50000);
+  EXPECT_GT(Replay_Diff(other, 50000, 0, NULL), 0);
+  Replay_Destroy(other);
+
+  // a ping that was sent later than in the recording is reported
+  replay->events[1].localTime += 5;
+  EXPECT_EQ(1, Replay_Diff(replay, 50000, 1, NULL));
+  EXPECT_EQ(0, Replay_Diff(replay, 50000, 5, NULL));
+
+  Replay_Destroy(replay);
+  Replay_Destroy(recording);
+}
+
+TEST(ReplayTest, recordedPingIsDeliveredAndJoined) {
+  Replay replay = Replay_Create(1, 123456);
+
+  // ping of node 5 (network 5) with its content: network age, time since frame start, one-hop and two-hop status and IDs
+  std::string line = "RX PING 5 0 100 1 0 5 1000 20";
+  for (int i = 0; i < 4 * NUM_SLOTS; ++i) {
+    line += " 0";
+  };
+  ASSERT_TRUE(Replay_AddLine(replay, line.c_str()));
+  EXPECT_EQ(0, replay->numIncomplete);
+
+  Replay_RunUntil(replay, 100 + PING_SIZE);
+  EXPECT_EQ(0, NetworkManager_GetNetworkId(Simulator_GetNode(replay->sim, 0)));
+
+  Replay_RunUntil(replay, 100 + PING_SIZE + 1);
+  EXPECT_EQ(5, NetworkManager_GetNetworkId(Simulator_GetNode(replay->sim, 0)));
+
+  Replay_Destroy(replay);
+}
@@ -14,36 +14,38 @@ extern "C" {
 DEFINE_FFF_GLOBALS;
 FAKE_VALUE_FUNC(int64_t, RandomNumbers_GetRandomIntBetween, Node, int64_t, int64_t);
 FAKE_VALUE_FUNC(bool, SlotMap_SlotReservationGoalMet, Node);
-FAKE_VALUE_FUNC(int8_t, SlotMap_GetReservableSlot, Node);
-FAKE_VALUE_FUNC(int8_t, SlotMap_CalculateNextOwnOrPendingSlotNum, Node, int8_t);
-FAKE_VALUE_FUNC(int8_t, SlotMap_GetAcknowledgedPendingSlots, Node, int8_t*, int8_t);
-FAKE_VALUE_FUNC(bool, SlotMap_ChangePendingToOwn, Node, int8_t);
-FAKE_VALUE_FUNC(int8_t, SlotMap_CheckOwnSlotsForCollisions, Node, Message, int8_t*, int8_t);
-FAKE_VALUE_FUNC(int8_t, SlotMap_CheckPendingSlotsForCollisions, Node, Message, int8_t*, int8_t);
-FAKE_VALUE_FUNC(bool, SlotMap_OwnNetworkExists, Node, int8_t*, int8_t);
-FAKE_VALUE_FUNC(bool, SlotMap_IsOwnSlot, Node, int8_t);
-FAKE_VALUE_FUNC(bool, SlotMap_IsPendingSlot, Node, int8_t);
-FAKE_VALUE_FUNC(bool, SlotMap_ReleasePendingSlot, Node, int8_t);
-FAKE_VALUE_FUNC(bool, SlotMap_ReleaseOwnSlot, Node, int8_t);
-FAKE_VALUE_FUNC(bool, SlotMap_GetOneHopSlotMapStatus, Node, int*, int8_t);
-FAKE_VALUE_FUNC(bool, SlotMap_GetOneHopSlotMapIds, Node, int8_t*, int8_t);
-FAKE_VALUE_FUNC(bool, SlotMap_GetOneHopSlotMapLastUpdated, Node, int64_t*, int8_t);
-FAKE_VALUE_FUNC(bool, SlotMap_GetTwoHopSlotMapStatus, Node, int*, int8_t);
-FAKE_VALUE_FUNC(bool, SlotMap_GetTwoHopSlotMapIds, Node, int8_t*, int8_t);
-FAKE_VALUE_FUNC(bool, SlotMap_GetTwoHopSlotMapLastUpdated, Node, int64_t*, int8_t);
-FAKE_VALUE_FUNC(bool, SlotMap_GetThreeHopSlotMapStatus, Node, int*, int8_t);
-FAKE_VALUE_FUNC(bool, SlotMap_GetThreeHopSlotMapIds, Node, int8_t*, int8_t);
-FAKE_VALUE_FUNC(bool, SlotMap_GetThreeHopSlotMapLastUpdated, Node, int64_t*, int8_t);
+FAKE_VALUE_FUNC(SlotNum, SlotMap_GetReservableSlot, Node);
+FAKE_VALUE_FUNC(SlotNum, SlotMap_CalculateNextOwnOrPendingSlotNum, Node, SlotNum);
+FAKE_VALUE_FUNC(int8_t, SlotMap_GetAcknowledgedPendingSlots, Node, SlotNum*, int16_t);
+FAKE_VALUE_FUNC(bool, SlotMap_ChangePendingToOwn, Node, SlotNum);
+FAKE_VALUE_FUNC(int8_t, SlotMap_CheckOwnSlotsForCollisions, Node, Message, SlotNum*, int16_t);
+FAKE_VALUE_FUNC(int8_t, SlotMap_CheckPendingSlotsForCollisions, Node, Message, SlotNum*, int16_t);
+FAKE_VALUE_FUNC(bool, SlotMap_OwnNetworkExists, Node, SlotNum*, int16_t);
+FAKE_VALUE_FUNC(bool, SlotMap_IsOwnSlot, Node, SlotNum);
+FAKE_VALUE_FUNC(bool, SlotMap_IsPendingSlot, Node, SlotNum);
+FAKE_VALUE_FUNC(bool, SlotMap_ReleasePendingSlot, Node, SlotNum);
+FAKE_VALUE_FUNC(bool, SlotMap_ReleaseOwnSlot, Node, SlotNum);
+FAKE_VALUE_FUNC(bool, SlotMap_GetOneHopSlotMapStatus, Node, int*, int16_t);
+FAKE_VOID_FUNC(SlotMap_GetOneHopSlotMapPackedStatus, Node, SlotStatusArray*);
+FAKE_VALUE_FUNC(bool, SlotMap_GetOneHopSlotMapIds, Node, int8_t*, int16_t);
+FAKE_VALUE_FUNC(bool, SlotMap_GetOneHopSlotMapLastUpdated, Node, int64_t*, int16_t);
+FAKE_VALUE_FUNC(bool, SlotMap_GetTwoHopSlotMapStatus, Node, int*, int16_t);
+FAKE_VOID_FUNC(SlotMap_GetTwoHopSlotMapPackedStatus, Node, SlotStatusArray*);
+FAKE_VALUE_FUNC(bool, SlotMap_GetTwoHopSlotMapIds, Node, int8_t*, int16_t);
+FAKE_VALUE_FUNC(bool, SlotMap_GetTwoHopSlotMapLastUpdated, Node, int64_t*, int16_t);
+FAKE_VALUE_FUNC(bool, SlotMap_GetThreeHopSlotMapStatus, Node, int*, int16_t);
+FAKE_VALUE_FUNC(bool, SlotMap_GetThreeHopSlotMapIds, Node, int8_t*, int16_t);
+FAKE_VALUE_FUNC(bool, SlotMap_GetThreeHopSlotMapLastUpdated, Node, int64_t*, int16_t);
 FAKE_VALUE_FUNC(int8_t, SlotMap_GetCollisionTimes, Node, int64_t*, int8_t);
-FAKE_VALUE_FUNC(bool, SlotMap_AddPendingSlot, Node, int8_t, int8_t*, int8_t);
-FAKE_VALUE_FUNC(int16_t, SlotMap_RemoveExpiredPendingSlots, Node, int8_t*, int8_t);
-FAKE_VALUE_FUNC(int16_t, SlotMap_RemoveExpiredOwnSlots, Node, int8_t*, int8_t);
+FAKE_VALUE_FUNC(bool, SlotMap_AddPendingSlot, Node, SlotNum, int8_t*, int8_t);
+FAKE_VALUE_FUNC(int16_t, SlotMap_RemoveExpiredPendingSlots, Node, SlotNum*, int16_t);
+FAKE_VALUE_FUNC(int16_t, SlotMap_RemoveExpiredOwnSlots, Node, SlotNum*, int16_t);
 FAKE_VALUE_FUNC(bool, SlotMap_ClearToSend, Node);
 FAKE_VALUE_FUNC(int64_t, SlotMap_GetLastReservationTime, Node);
-FAKE_VALUE_FUNC(int8_t, SlotMap_GetOwnSlots, Node, int8_t*, int8_t);
-FAKE_VALUE_FUNC(int8_t, SlotMap_GetPendingSlots, Node, int8_t*, int8_t);
+FAKE_VALUE_FUNC(int8_t, SlotMap_GetOwnSlots, Node, SlotNum*, int16_t);
+FAKE_VALUE_FUNC(int8_t, SlotMap_GetPendingSlots, Node, SlotNum*, int16_t);
 
-FAKE_VOID_FUNC(SlotMap_UpdateOneHopSlotMap, Node, Message, int8_t);
+FAKE_VOID_FUNC(SlotMap_UpdateOneHopSlotMap, Node, Message, SlotNum);
 FAKE_VOID_FUNC(SlotMap_UpdateTwoHopSlotMap, Node, Message);
 FAKE_VOID_FUNC(SlotMap_UpdateThreeHopSlotMap, Node, Message);
 FAKE_VOID_FUNC(SlotMap_UpdatePendingSlotAcks, Node, Message);
@@ -72,6 +74,7 @@ class SchedulerTestGeneral : public ::testing::Test {
     neighborhood = Neighborhood_Create();
     networkManager = NetworkManager_Create();
     conf = Config_Create();
+    timerWheel = TimerWheel_Create();
     
     int64_t *time = (int64_t *)malloc(1);
     *time = 5;
@@ -84,6 +87,7 @@ class SchedulerTestGeneral : public ::testing::Test {
     Node_SetNeighborhood(node, neighborhood);
     Node_SetNetworkManager(node, networkManager);
     Node_SetConfig(node, conf);
+    Node_SetTimerWheel(node, timerWheel);
   }
 
    //void TearDown() override {}
@@ -96,6 +100,7 @@ class SchedulerTestGeneral : public ::testing::Test {
   Neighborhood neighborhood;
   NetworkManager networkManager;
   Config conf;
+  TimerWheel timerWheel;
 };
 
 TEST_F(SchedulerTestGeneral, noScheduleAfterCreation) {
@@ -0,0 +1,306 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include "../include/Simulator.h"
+#include "../include/Node.h"
+#include "../include/StateMachine.h"
+#include "../include/NetworkManager.h"
+#include "../include/Neighborhood.h"
+#include "../include/SlotMap.h"
+#include "../include/Driver.h"
+#include "../include/Message.h"
+#include "../include/Trace.h"
+}
+
+class SimulatorTestGeneral : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    sim = Simulator_Create(MAX_NUM_NODES, 42);
+    Simulator_SetRadioRange(sim, 1.5);
+  }
+
+  void TearDown() override {
+    Simulator_Destroy(sim);
+  }
+
+  /** let a node put a ping on the channel without going through its state machine */
+  void transmitPing(int16_t nodeIdx) {
+    struct MessageStruct message = {};
+    message.type = PING;
+    message.senderId = Simulator_GetNode(sim, nodeIdx)->id;
+    message.networkId = Simulator_GetNode(sim, nodeIdx)->id;
+    Driver_TransmitPing(Simulator_GetNode(sim, nodeIdx), &message);
+  }
+
+  /** add count nodes with consecutive IDs on a circle, turned on one after another */
+  void addNodesOnCircle(int16_t count, double radius, double centerX) {
+    for (int16_t i = 0; i < count; ++i) {
+      double angle = 2 * M_PI * i / count;
+      int16_t idx = sim->numNodes;
+      Simulator_AddNode(sim, idx + 1, centerX + radius * cos(angle), radius * sin(angle), 37 * idx);
+    };
+  }
+
+  /** let all nodes range and duty cycle, and let their clocks drift apart; the frames and slots are twice as long as in the 
+  *   test config, so that there is time for ranging after the ping in most slots */
+  void enableRangingIdleingAndDrift() {
+    for (int16_t i = 0; i < sim->numNodes; ++i) {
+      Config config = Simulator_GetNode(sim, i)->config;
+      config->frameLength *= 2;
+      config->slotLength *= 2;
+      config->slotExpirationTimeOut *= 2;
+      config->ownSlotExpirationTimeOut *= 2;
+      config->occupiedTimeout *= 2;
+      config->occupiedToFreeTimeoutMultiHop *= 2;
+      config->collidingTimeoutMultiHop *= 2;
+      config->collidingTimeout *= 2;
+      // neighbors are not seen while they sleep
+      config->absentNeighborTimeOut = 3 * config->frameLength;
+      config->rangingRefreshTime = 1630;
+      config->sleepFrames = 1;
+      Simulator_SetClockDrift(sim, i, 120.0 * (i % 3) - 120.0, 2.0 * (i % 2), 30, 15000, 500 + 17 * i);
+    };
+  }
+
+  /** run a fork of the simulator that skips idle tics next to the simulator itself, which executes every tic, and compare 
+  *   the traces of both (a tic that is skipped by mistake mostly delays a state change, without a difference in the state of 
+  *   the nodes later on) and the state at the end; the nodes from firstMovedNode on are moved by moveX at moveTime (e.g. so 
+  *   that two networks merge) */
+  void expectIdleSkippingDoesNotChangeResult(int64_t endTime, int64_t moveTime, int16_t firstMovedNode, double moveX) {
+    Simulator skipping = Simulator_Fork(sim);
+    Simulator_SetIdleSkipping(skipping, true);
+
+    Simulator runs[2] = {sim, skipping};
+    std::string paths[2];
+    TraceWriter traces[2];
+    for (int r = 0; r < 2; ++r) {
+      paths[r] = testing::TempDir() + testing::UnitTest::GetInstance()->current_test_info()->name() + std::to_string(r) + ".bin";
+      traces[r] = TraceWriter_Create(paths[r].c_str());
+      ASSERT_TRUE(traces[r] != NULL);
+      Simulator_SetTrace(runs[r], traces[r]);
+
+      Simulator_RunUntil(runs[r], moveTime);
+      for (int16_t i = firstMovedNode; i < runs[r]->numNodes; ++i) {
+        Simulator_MoveNode(runs[r], i, runs[r]->posX[i] + moveX, runs[r]->posY[i]);
+      };
+      Simulator_RunUntil(runs[r], endTime);
+
+      Simulator_SetTrace(runs[r], NULL);
+      TraceWriter_Destroy(traces[r]);
+    };
+
+    EXPECT_EQ(Simulator_GetTime(sim), Simulator_GetTime(skipping));
+    EXPECT_EQ(0, memcmp(&sim->stats, &skipping->stats, sizeof(SimulatorStatsStruct)));
+    for (int16_t i = 0; i < sim->numNodes; ++i) {
+      Node node = Simulator_GetNode(sim, i);
+      Node skippingNode = Simulator_GetNode(skipping, i);
+      EXPECT_EQ(sim->localTimes[i], skipping->localTimes[i]);
+      EXPECT_EQ(StateMachine_GetState(node), StateMachine_GetState(skippingNode));
+      EXPECT_EQ(NetworkManager_GetNetworkId(node), NetworkManager_GetNetworkId(skippingNode));
+      EXPECT_EQ(0, memcmp(node->slotMap, skippingNode->slotMap, sizeof(SlotMapStruct)));
+      EXPECT_EQ(0, memcmp(node->neighborhood, skippingNode->neighborhood, sizeof(NeighborhoodStruct)));
+      EXPECT_EQ(node->lcg->next, skippingNode->lcg->next);
+    };
+    Simulator_Destroy(skipping);
+
+    // every state change, message and slot reservation happened at the same local time
+    std::vector<TraceRecordStruct> records = readTrace(paths[0]);
+    std::vector<TraceRecordStruct> skippingRecords = readTrace(paths[1]);
+    ASSERT_EQ(records.size(), skippingRecords.size());
+    for (size_t i = 0; i < records.size(); ++i) {
+      ASSERT_EQ(0, memcmp(&records[i], &skippingRecords[i], sizeof(TraceRecordStruct))) << "record " << i << " of node " 
+        << (int) records[i].nodeId << " at " << records[i].localTime << " differs";
+    };
+  }
+
+  std::vector<TraceRecordStruct> readTrace(const std::string &path) {
+    std::vector<TraceRecordStruct> records;
+    FILE *file = fopen(path.c_str(), "rb");
+    EXPECT_TRUE(file != NULL && Trace_ReadHeader(file));
+
+    TraceRecordStruct record;
+    while (file != NULL && fread(&record, sizeof(TraceRecordStruct), 1, file) == 1) {
+      records.push_back(record);
+    };
+    if (file != NULL) {
+      fclose(file);
+    };
+    remove(path.c_str());
+    return records;
+  }
+
+  Simulator sim;
+};
+
+TEST_F(SimulatorTestGeneral, nodesAreTurnedOnAtTheirTime) {
+  Simulator_AddNode(sim, 1, 0, 0, 0);
+  Simulator_AddNode(sim, 2, 1, 0, 10);
+
+  Simulator_RunUntil(sim, 5);
+  EXPECT_EQ(LISTENING_UNCONNECTED, StateMachine_GetState(Simulator_GetNode(sim, 0)));
+  EXPECT_EQ(OFF, StateMachine_GetState(Simulator_GetNode(sim, 1)));
+  EXPECT_EQ(5, sim->localTimes[0]);
+  EXPECT_EQ(0, sim->localTimes[1]);
+
+  Simulator_RunUntil(sim, 15);
+  EXPECT_EQ(LISTENING_UNCONNECTED, StateMachine_GetState(Simulator_GetNode(sim, 1)));
+  EXPECT_EQ(5, sim->localTimes[1]);
+}
+
+TEST_F(SimulatorTestGeneral, pingIsDeliveredAfterAirTime) {
+  Simulator_AddNode(sim, 1, 0, 0, 0);
+  Simulator_AddNode(sim, 2, 1, 0, 0);
+  Simulator_Step(sim);
+
+  transmitPing(0);
+  Simulator_Step(sim);
+  EXPECT_EQ(1, sim->stats.numTransmissions[PING]);
+  EXPECT_TRUE(sim->isReceiving[1]);
+  EXPECT_FALSE(sim->txFinished[0]);
+
+  Simulator_RunUntil(sim, 1 + PING_SIZE);
+  EXPECT_EQ(0, sim->stats.numDelivered);
+
+  Simulator_Step(sim);
+  EXPECT_EQ(1, sim->stats.numDelivered);
+  EXPECT_FALSE(sim->isReceiving[1]);
+  EXPECT_TRUE(sim->txFinished[0]);
+
+  // the receiving node joined the network of the sender
+  EXPECT_EQ(LISTENING_CONNECTED, StateMachine_GetState(Simulator_GetNode(sim, 1)));
+  EXPECT_EQ(1, NetworkManager_GetNetworkId(Simulator_GetNode(sim, 1)));
+}
+
+TEST_F(SimulatorTestGeneral, messagesSentBeforeTheyAreTakenAreQueued) {
+  Simulator_AddNode(sim, 1, 0, 0, 0);
+  Simulator_AddNode(sim, 2, 1, 0, 0);
+  Simulator_Step(sim);
+
+  for (int i = 0; i < DRIVER_TX_RING_SIZE + 1; ++i) {
+    transmitPing(0);
+  };
+  EXPECT_EQ(DRIVER_TX_RING_SIZE, sim->txRings[0].count);
+  EXPECT_EQ(1, sim->txRings[0].numDropped);
+
+  Simulator_Step(sim);
+  EXPECT_EQ(DRIVER_TX_RING_SIZE, sim->stats.numTransmissions[PING]);
+  EXPECT_EQ(0, sim->txRings[0].count);
+  EXPECT_FALSE(Driver_GetMessageSentFlag(Simulator_GetNode(sim, 0)));
+}
+
+TEST_F(SimulatorTestGeneral, nodesOutOfRangeDoNotReceive) {
+  Simulator_AddNode(sim, 1, 0, 0, 0);
+  Simulator_AddNode(sim, 2, 5, 0, 0);
+  Simulator_Step(sim);
+
+  transmitPing(0);
+  Simulator_RunUntil(sim, 50);
+  EXPECT_EQ(1, sim->stats.numTransmissions[PING]);
+  EXPECT_EQ(0, sim->stats.numDelivered);
+  EXPECT_EQ(LISTENING_UNCONNECTED, StateMachine_GetState(Simulator_GetNode(sim, 1)));
+}
+
+TEST_F(SimulatorTestGeneral, overlappingTransmissionsCollide) {
+  Simulator_AddNode(sim, 1, 0, 0, 0);
+  Simulator_AddNode(sim, 2, 2, 0, 0);
+  Simulator_AddNode(sim, 3, 1, 0, 0);
+  Simulator_Step(sim);
+
+  // node 1 and 2 cannot hear each other, but node 3 hears both
+  transmitPing(0);
+  transmitPing(1);
+  Simulator_RunUntil(sim, 50);
+
+  EXPECT_EQ(2, sim->stats.numTransmissions[PING]);
+  EXPECT_EQ(0, sim->stats.numDelivered);
+  EXPECT_EQ(1, sim->stats.numCollisions);
+  EXPECT_EQ(LISTENING_UNCONNECTED, StateMachine_GetState(Simulator_GetNode(sim, 2)));
+}
+
+TEST_F(SimulatorTestGeneral, twoNodesFormOneNetwork) {
+  Simulator_AddNode(sim, 1, 0, 0, 0);
+  Simulator_AddNode(sim, 2, 1, 0, 0);
+
+  Simulator_RunUntil(sim, 20000);
+
+  Node node1 = Simulator_GetNode(sim, 0);
+  Node node2 = Simulator_GetNode(sim, 1);
+  EXPECT_EQ(CONNECTED, NetworkManager_GetNetworkStatus(node1));
+  EXPECT_NE(0, NetworkManager_GetNetworkId(node1));
+  EXPECT_EQ(NetworkManager_GetNetworkId(node1), NetworkManager_GetNetworkId(node2));
+
+  SlotNum ownSlots1[MAX_NUM_OWN_SLOTS];
+  SlotNum ownSlots2[MAX_NUM_OWN_SLOTS];
+  ASSERT_EQ(1, SlotMap_GetOwnSlots(node1, &ownSlots1[0], MAX_NUM_OWN_SLOTS));
+  ASSERT_EQ(1, SlotMap_GetOwnSlots(node2, &ownSlots2[0], MAX_NUM_OWN_SLOTS));
+  EXPECT_NE(ownSlots1[0], ownSlots2[0]);
+}
+
+TEST_F(SimulatorTestGeneral, deadlineOfUnconnectedNodeIsEndOfInitialWaitTime) {
+  Simulator_AddNode(sim, 1, 0, 0, 0);
+  Simulator_Step(sim);
+
+  Node node = Simulator_GetNode(sim, 0);
+  EXPECT_EQ(node->config->initialWaitTime, Node_NextDeadline(node));
+}
+
+TEST_F(SimulatorTestGeneral, deadlineOfNodeThatIsOffIsNoDeadline) {
+  Simulator_AddNode(sim, 1, 0, 0, 100);
+  Simulator_Step(sim);
+
+  EXPECT_EQ(NODE_NO_DEADLINE, Node_NextDeadline(Simulator_GetNode(sim, 0)));
+}
+
+TEST_F(SimulatorTestGeneral, idleSkippingDoesNotChangeResult) {
+  int skews[4] = {50, -50, 70, 0};
+  for (int i = 0; i < 4; ++i) {
+    Simulator_AddNode(sim, i + 1, i, 0, 10 * i);
+    Simulator_SetClockSkew(sim, i, skews[i]);
+  };
+
+  expectIdleSkippingDoesNotChangeResult(20000, 0, sim->numNodes, 0);
+}
+
+TEST_F(SimulatorTestGeneral, idleSkippingDoesNotChangeResultOfLineWithDrift) {
+  for (int i = 0; i < 4; ++i) {
+    Simulator_AddNode(sim, i + 1, i, 0, 23 * i);
+  };
+  enableRangingIdleingAndDrift();
+
+  expectIdleSkippingDoesNotChangeResult(40000, 0, sim->numNodes, 0);
+}
+
+TEST_F(SimulatorTestGeneral, idleSkippingDoesNotChangeResultOfCliqueWithDrift) {
+  addNodesOnCircle(3, 0.375, 0);
+  enableRangingIdleingAndDrift();
+
+  expectIdleSkippingDoesNotChangeResult(40000, 0, sim->numNodes, 0);
+}
+
+TEST_F(SimulatorTestGeneral, idleSkippingDoesNotChangeResultOfRingWithDrift) {
+  // sides of 0.9 radio ranges, so only adjacent nodes are in range
+  addNodesOnCircle(4, 0.9546, 0);
+  enableRangingIdleingAndDrift();
+
+  expectIdleSkippingDoesNotChangeResult(40000, 0, sim->numNodes, 0);
+}
+
+TEST_F(SimulatorTestGeneral, idleSkippingDoesNotChangeResultOfNetworkMerge) {
+  // two cliques that are out of range of each other form two networks, which merge when the second clique is moved next 
+  // to the first one
+  addNodesOnCircle(2, 0.375, 0);
+  addNodesOnCircle(2, 0.375, 10);
+  enableRangingIdleingAndDrift();
+
+  expectIdleSkippingDoesNotChangeResult(60000, 20000, 2, -9.5);
+
+  // the merge happened and all nodes ended up in the same network
+  for (int16_t i = 1; i < sim->numNodes; ++i) {
+    EXPECT_EQ(NetworkManager_GetNetworkId(Simulator_GetNode(sim, 0)), NetworkManager_GetNetworkId(Simulator_GetNode(sim, i)));
+  };
+}
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+
+extern "C" {
+#include "../include/Node.h"
+#include "../include/SlotMap.h"
+#include "../include/LCG.h"
+}
+
+// compiled with NUM_SLOTS=300 (see CMakeLists.txt), so the bit sets of the slot maps have 5 words
+class SlotMapTestLargeFrame : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    node = Node_Create();
+    node->id = 1;
+    slotMap = SlotMap_Create();
+    timeKeeping = TimeKeeping_Create();
+    config = Config_Create();
+    lcg = LCG_Create(42);
+    timerWheel = TimerWheel_Create();
+
+    time = 0;
+    clock = ProtocolClock_Create(&time);
+
+    Node_SetSlotMap(node, slotMap);
+    Node_SetClock(node, clock);
+    Node_SetTimeKeeping(node, timeKeeping);
+    Node_SetConfig(node, config);
+    Node_SetLCG(node, lcg);
+    Node_SetTimerWheel(node, timerWheel);
+
+    // a frame holds all NUM_SLOTS slots
+    config->frameLength = NUM_SLOTS * config->slotLength;
+    timeKeeping->frameStartSet = true;
+    timeKeeping->frameStartTime = 0;
+  }
+
+  /** set the local time to the middle of a slot */
+  void setCurrentSlot(SlotNum slotNum) {
+    time = (slotNum - 1) * config->slotLength + config->slotLength / 2;
+  }
+
+  /** occupy all slots of the one hop slot map by another node, except for the given ones */
+  void occupyAllSlotsExcept(SlotNum *freeSlots, int16_t numFreeSlots) {
+    for (int s = 0; s < NUM_SLOTS; ++s) {
+      SlotStatus_Set(&slotMap->oneHopSlotsStatus, s, OCCUPIED);
+      slotMap->oneHopSlotsIds[s] = 2;
+    };
+    for (int i = 0; i < numFreeSlots; ++i) {
+      SlotStatus_Set(&slotMap->oneHopSlotsStatus, freeSlots[i] - 1, FREE);
+      slotMap->oneHopSlotsIds[freeSlots[i] - 1] = 0;
+    };
+    SlotMap_RebuildMasks(node);
+  }
+
+  int64_t time;
+  Node node;
+  SlotMap slotMap;
+  ProtocolClock clock;
+  TimeKeeping timeKeeping;
+  Config config;
+  LCG lcg;
+  TimerWheel timerWheel;
+};
+
+TEST_F(SlotMapTestLargeFrame, masksSpanSeveralWords) {
+  EXPECT_EQ(5, SLOT_MASK_WORDS);
+  EXPECT_TRUE(SlotMap_SlotIsFree(node, 300));
+  EXPECT_FALSE(SlotMap_SlotIsFree(node, 301));
+
+  int8_t neighbors[1] = {2};
+  SlotMap_AddPendingSlot(node, 64, &neighbors[0], 1);
+  SlotMap_AddPendingSlot(node, 65, &neighbors[0], 1);
+  SlotMap_AddPendingSlot(node, 300, &neighbors[0], 1);
+  EXPECT_EQ(1ull << 63, slotMap->pendingSlotsMask.words[0]);
+  EXPECT_EQ(1ull, slotMap->pendingSlotsMask.words[1]);
+  EXPECT_EQ(1ull << 43, slotMap->pendingSlotsMask.words[4]);
+
+  EXPECT_TRUE(SlotMap_ChangePendingToOwn(node, 300));
+  EXPECT_TRUE(SlotMap_IsOwnSlot(node, 300));
+  EXPECT_FALSE(SlotMap_IsPendingSlot(node, 300));
+  EXPECT_TRUE(SlotMap_IsPendingSlot(node, 65));
+
+  SlotNum buffer[MAX_NUM_OWN_SLOTS];
+  EXPECT_EQ(1, SlotMap_GetOwnSlots(node, &buffer[0], MAX_NUM_OWN_SLOTS));
+  EXPECT_EQ(300, buffer[0]);
+
+  int statusBuffer[NUM_SLOTS];
+  EXPECT_TRUE(SlotMap_GetOneHopSlotMapStatus(node, &statusBuffer[0], NUM_SLOTS));
+}
+
+TEST_F(SlotMapTestLargeFrame, reservableSlotIsFoundInAnyWord) {
+  SlotNum freeSlots[2] = {200, 290};
+  occupyAllSlotsExcept(&freeSlots[0], 2);
+
+  for (int i = 0; i < 20; ++i) {
+    SlotNum slot = SlotMap_GetReservableSlot(node);
+    EXPECT_TRUE(slot == 200 || slot == 290);
+  };
+
+  // a colliding slot is reservable as well, if no other node occupies it
+  SlotNum moreFreeSlots[3] = {150, 200, 290};
+  occupyAllSlotsExcept(&moreFreeSlots[0], 3);
+  SlotStatus_Set(&slotMap->threeHopSlotsStatus, 149, COLLIDING);
+  SlotMap_RebuildMasks(node);
+  bool collidingChosen = false;
+  for (int i = 0; i < 50; ++i) {
+    SlotNum slot = SlotMap_GetReservableSlot(node);
+    EXPECT_TRUE(slot == 150 || slot == 200 || slot == 290);
+    collidingChosen = collidingChosen || (slot == 150);
+  };
+  EXPECT_TRUE(collidingChosen);
+
+  occupyAllSlotsExcept(NULL, 0);
+  EXPECT_EQ(-1, SlotMap_GetReservableSlot(node));
+}
+
+TEST_F(SlotMapTestLargeFrame, nextOwnOrPendingSlotWrapsAround) {
+  EXPECT_EQ(-1, SlotMap_CalculateNextOwnOrPendingSlotNum(node, 1));
+
+  int8_t neighbors[1] = {2};
+  SlotMap_AddPendingSlot(node, 70, &neighbors[0], 1);
+  SlotMap_AddPendingSlot(node, 250, &neighbors[0], 1);
+  SlotMap_ChangePendingToOwn(node, 250);
+
+  setCurrentSlot(1);
+  EXPECT_EQ(70, SlotMap_CalculateNextOwnOrPendingSlotNum(node, 1));
+  setCurrentSlot(70);
+  EXPECT_EQ(250, SlotMap_CalculateNextOwnOrPendingSlotNum(node, 70));
+  setCurrentSlot(128);
+  EXPECT_EQ(250, SlotMap_CalculateNextOwnOrPendingSlotNum(node, 128));
+  setCurrentSlot(260);
+  EXPECT_EQ(70, SlotMap_CalculateNextOwnOrPendingSlotNum(node, 260));
+
+  // the only own slot is the current one, so it comes next in the next frame
+  SlotMap_ReleasePendingSlot(node, 70);
+  setCurrentSlot(250);
+  EXPECT_EQ(250, SlotMap_CalculateNextOwnOrPendingSlotNum(node, 250));
+}
+
+TEST_F(SlotMapTestLargeFrame, clearToSendInHighSlots) {
+  SlotNum freeSlots[1] = {200};
+  occupyAllSlotsExcept(&freeSlots[0], 1);
+
+  setCurrentSlot(200);
+  EXPECT_TRUE(SlotMap_ClearToSend(node));
+  setCurrentSlot(201);
+  EXPECT_FALSE(SlotMap_ClearToSend(node));
+
+  SlotNum collidingSlots[1] = {201};
+  EXPECT_TRUE(SlotMap_OwnNetworkExists(node, &collidingSlots[0], 1));
+}
@@ -14,6 +14,7 @@ class SlotMapTestGeneral : public ::testing::Test {
     slotMap = SlotMap_Create();
     timeKeeping = TimeKeeping_Create();
     config = Config_Create();
+    timerWheel = TimerWheel_Create();
 
     int64_t *time = (int64_t *)malloc(1);
     *time = 5;
@@ -23,11 +24,13 @@ class SlotMapTestGeneral : public ::testing::Test {
     Node_SetClock(node, clock);
     Node_SetTimeKeeping(node, timeKeeping);
     Node_SetConfig(node, config);
+    Node_SetTimerWheel(node, timerWheel);
   }
   
   // void TearDown() override {}
   Node node;
   SlotMap slotMap;
+  TimerWheel timerWheel;
   ProtocolClock clock;
   TimeKeeping timeKeeping;
   Config config;
@@ -35,9 +38,9 @@ class SlotMapTestGeneral : public ::testing::Test {
 
 TEST_F(SlotMapTestGeneral, getPendingSlotsChecksSize) {
   //#define MAX_NUM_PENDING_SLOTS 5
-  int8_t test[1] = { 23 };
+  SlotNum test[1] = { 23 };
 
-  int8_t newPendingSlot = 1;
+  SlotNum newPendingSlot = 1;
   int8_t neighborIds[1] = {2};
   int8_t neighborsArraySize = 1;
   SlotMap_AddPendingSlot(node, 1, &neighborIds[0], neighborsArraySize);
@@ -48,7 +51,7 @@ TEST_F(SlotMapTestGeneral, getPendingSlotsChecksSize) {
 
 TEST_F(SlotMapTestGeneral, getPendingSlotsRespectsArrayBounds) {
   //#define MAX_NUM_PENDING_SLOTS 5
-  int8_t test[6] = { 23, 24, 25, 26, 27, 28 };
+  SlotNum test[6] = { 23, 24, 25, 26, 27, 28 };
   
   EXPECT_EQ(0, SlotMap_GetPendingSlots(node, &test[0], 5));
   EXPECT_EQ(23, test[0]);
@@ -57,9 +60,9 @@ TEST_F(SlotMapTestGeneral, getPendingSlotsRespectsArrayBounds) {
 
 TEST_F(SlotMapTestGeneral, addOnePendingSlot) {
   //#define MAX_NUM_PENDING_SLOTS 5
-  int8_t test[5];
+  SlotNum test[5];
   
-  int8_t newPendingSlot = 1;
+  SlotNum newPendingSlot = 1;
   int8_t neighborIds[2] = {2, 3};
   int8_t neighborsArraySize = 2;
   SlotMap_AddPendingSlot(node, newPendingSlot, &neighborIds[0], neighborsArraySize);
@@ -70,7 +73,7 @@ TEST_F(SlotMapTestGeneral, addOnePendingSlot) {
 
 TEST_F(SlotMapTestGeneral, addTwoPendingSlots) {
   //#define MAX_NUM_PENDING_SLOTS 5
-  int8_t test[5];
+  SlotNum test[5];
   
   int8_t neighborIds[2] = {2, 3};
   int8_t neighborsArraySize = 2;
@@ -85,9 +88,9 @@ TEST_F(SlotMapTestGeneral, addTwoPendingSlots) {
 TEST_F(SlotMapTestGeneral, addTooManyPendingSlots) {
   #define MAX_NUM_PENDING_SLOTS 5
 
-  int8_t test[6] = {-1, -1, -1, -1, -1, -1};
+  SlotNum test[6] = {-1, -1, -1, -1, -1, -1};
   
-  int8_t newPendingSlot = 1;
+  SlotNum newPendingSlot = 1;
   int8_t neighborIds[2] = {2, 3};
   int8_t neighborsArraySize = 2;
   SlotMap_AddPendingSlot(node, 1, &neighborIds[0], neighborsArraySize);
@@ -109,7 +112,7 @@ TEST_F(SlotMapTestGeneral, acknowledgePendingSlot) {
   #define NUM_SLOTS 5
   node->id = 4;
 
-  int8_t newPendingSlot = 1;
+  SlotNum newPendingSlot = 1;
   int8_t neighborIds[1] = {2};
   int8_t neighborsArraySize = 1;
   SlotMap_AddPendingSlot(node, newPendingSlot, &neighborIds[0], neighborsArraySize);
@@ -124,7 +127,7 @@ TEST_F(SlotMapTestGeneral, acknowledgePendingSlot) {
   //printf("pendingSlots: %" PRId8 "\n", node->slotMap->pendingSlots[0]);
   //printf("acknowledgedBy: %" PRId8 "\n", node->slotMap->pendingSlotAcknowledgedBy[0][0]);
   
-  int8_t buffer[5] = {-1, -1, -1, -1, -1}; 
+  SlotNum buffer[5] = {-1, -1, -1, -1, -1}; 
   SlotMap_GetAcknowledgedPendingSlots(node, &buffer[0], 5);
   EXPECT_EQ(1, buffer[0]);
   EXPECT_EQ(-1, buffer[1]);
@@ -135,7 +138,7 @@ TEST_F(SlotMapTestGeneral, acknowledgePendingSlotTwoNeighbors) {
   #define NUM_SLOTS 5
   node->id = 4;
 
-  int8_t newPendingSlot = 1;
+  SlotNum newPendingSlot = 1;
   int8_t neighborIds[2] = {2, 3};
   int8_t neighborsArraySize = 2;
   SlotMap_AddPendingSlot(node, newPendingSlot, &neighborIds[0], neighborsArraySize);
@@ -148,7 +151,7 @@ TEST_F(SlotMapTestGeneral, acknowledgePendingSlotTwoNeighbors) {
   SlotMap_UpdatePendingSlotAcks(node, msg);
   
   // should not be acknowledged yet (only one neighbor acked)
-  int8_t buffer[5] = {-1, -1, -1, -1, -1}; 
+  SlotNum buffer[5] = {-1, -1, -1, -1, -1}; 
   SlotMap_GetAcknowledgedPendingSlots(node, &buffer[0], 5);
   EXPECT_EQ(-1, buffer[0]);
   EXPECT_EQ(-1, buffer[1]);
@@ -171,12 +174,12 @@ TEST_F(SlotMapTestGeneral, acknowledgeTwoPendingSlots) {
   #define NUM_SLOTS 5
   node->id = 4;
 
-  int8_t newPendingSlot = 1;
+  SlotNum newPendingSlot = 1;
   int8_t neighborIds[1] = {2};
   int8_t neighborsArraySize = 1;
   SlotMap_AddPendingSlot(node, newPendingSlot, &neighborIds[0], neighborsArraySize);
 
-  int8_t newPendingSlot2 = 3;
+  SlotNum newPendingSlot2 = 3;
   SlotMap_AddPendingSlot(node, newPendingSlot2, &neighborIds[0], neighborsArraySize);
   
   Message msg = Message_Create(PING);
@@ -191,7 +194,7 @@ TEST_F(SlotMapTestGeneral, acknowledgeTwoPendingSlots) {
   //printf("pendingSlots: %" PRId8 "\n", node->slotMap->pendingSlots[0]);
   //printf("acknowledgedBy: %" PRId8 "\n", node->slotMap->pendingSlotAcknowledgedBy[0][0]);
   
-  int8_t buffer[5] = {-1, -1, -1, -1, -1}; 
+  SlotNum buffer[5] = {-1, -1, -1, -1, -1}; 
   SlotMap_GetAcknowledgedPendingSlots(node, &buffer[0], 5);
   EXPECT_EQ(3, buffer[0]);
   EXPECT_EQ(-1, buffer[1]);
@@ -199,13 +202,13 @@ TEST_F(SlotMapTestGeneral, acknowledgeTwoPendingSlots) {
 
 TEST_F(SlotMapTestGeneral, changePendingToOwnAddsOwn) {
   //#define MAX_NUM_PENDING_SLOTS 5
-  int8_t test[5];
+  SlotNum test[5];
   int8_t neighborIds1[1] = {1};
   int8_t neighborsArraySize = 1;
   SlotMap_AddPendingSlot(node, 1, &neighborIds1[0], neighborsArraySize);
   bool result = SlotMap_ChangePendingToOwn(node, 1);
   
-  int8_t buffer[5] = {-1, -1, -1, -1, -1}; 
+  SlotNum buffer[5] = {-1, -1, -1, -1, -1}; 
   SlotMap_GetOwnSlots(node, &buffer[0], 5);
   EXPECT_EQ(true, result);
   EXPECT_EQ(1, buffer[0]);
@@ -214,7 +217,7 @@ TEST_F(SlotMapTestGeneral, changePendingToOwnAddsOwn) {
 
 TEST_F(SlotMapTestGeneral, changeTwoPendingSlotsToOwn) {
   //#define MAX_NUM_PENDING_SLOTS 5
-  int8_t test[5];
+  SlotNum test[5];
   int8_t neighborIds1[1] = {1};
   int8_t neighborsArraySize = 1;
   SlotMap_AddPendingSlot(node, 3, &neighborIds1[0], neighborsArraySize);
@@ -222,7 +225,7 @@ TEST_F(SlotMapTestGeneral, changeTwoPendingSlotsToOwn) {
   SlotMap_ChangePendingToOwn(node, 1);
   SlotMap_ChangePendingToOwn(node, 3);
   
-  int8_t buffer[5] = {-1, -1, -1, -1, -1}; 
+  SlotNum buffer[5] = {-1, -1, -1, -1, -1}; 
   SlotMap_GetOwnSlots(node, &buffer[0], 5);
   EXPECT_EQ(1, buffer[0]);
   EXPECT_EQ(3, buffer[1]);
@@ -230,13 +233,13 @@ TEST_F(SlotMapTestGeneral, changeTwoPendingSlotsToOwn) {
 
 TEST_F(SlotMapTestGeneral, changePendingToOwnRemovesPending) {
   //#define MAX_NUM_PENDING_SLOTS 5
-  int8_t test[5];
+  SlotNum test[5];
   int8_t neighborIds1[1] = {1};
   int8_t neighborsArraySize = 1;
   SlotMap_AddPendingSlot(node, 1, &neighborIds1[0], neighborsArraySize);
   SlotMap_ChangePendingToOwn(node, 1);
   
-  int8_t buffer[5] = {-1, -1, -1, -1, -1}; 
+  SlotNum buffer[5] = {-1, -1, -1, -1, -1}; 
   int8_t numPending = SlotMap_GetPendingSlots(node, &buffer[0], 5);
   EXPECT_EQ(0, numPending);
   EXPECT_EQ(-1, buffer[0]);
@@ -245,7 +248,7 @@ TEST_F(SlotMapTestGeneral, changePendingToOwnRemovesPending) {
 TEST_F(SlotMapTestGeneral, changePendingToOwnRetainsNeighborsOfOtherPendingSlots) {
   //#define MAX_NUM_PENDING_SLOTS 5
   node->id = 5;
-  int8_t test[5];
+  SlotNum test[5];
   
   int8_t neighborIds1[1] = {1};
   int8_t neighborIds2[1] = {2};
@@ -264,7 +267,7 @@ TEST_F(SlotMapTestGeneral, changePendingToOwnRetainsNeighborsOfOtherPendingSlots
   EXPECT_EQ(3, test[2]);
   EXPECT_EQ(4, test[3]);
 
-  int8_t test2[5];
+  SlotNum test2[5];
   bool result = SlotMap_ChangePendingToOwn(node, 2);
   EXPECT_EQ(true, result);
   EXPECT_EQ(3, SlotMap_GetPendingSlots(node, &test2[0], 5));
@@ -282,7 +285,7 @@ TEST_F(SlotMapTestGeneral, changePendingToOwnRetainsNeighborsOfOtherPendingSlots
   msg->oneHopSlotIds[3] = 5;
   SlotMap_UpdatePendingSlotAcks(node, msg);
 
-  int8_t buffer[5] = {-1, -1, -1, -1, -1}; 
+  SlotNum buffer[5] = {-1, -1, -1, -1, -1}; 
   SlotMap_GetAcknowledgedPendingSlots(node, &buffer[0], 5);
   EXPECT_EQ(4, buffer[0]);
   EXPECT_EQ(-1, buffer[1]);
@@ -291,7 +294,7 @@ TEST_F(SlotMapTestGeneral, changePendingToOwnRetainsNeighborsOfOtherPendingSlots
 TEST_F(SlotMapTestGeneral, updateOneHopSlotMapToOccupied) {
   Message msg = Message_Create(PING);
   msg->senderId = 2;
-  int8_t currentSlot = 1;
+  SlotNum currentSlot = 1;
 
   SlotMap_UpdateOneHopSlotMap(node, msg, currentSlot);
 
@@ -322,7 +325,7 @@ TEST_F(SlotMapTestGeneral, updateOneHopSlotMapNotTimedout) {
 
   Message msg = Message_Create(PING);
   msg->senderId = 2;
-  int8_t currentSlot = 1;
+  SlotNum currentSlot = 1;
 
   SlotMap_UpdateOneHopSlotMap(node, msg, currentSlot);
 
@@ -362,7 +365,7 @@ TEST_F(SlotMapTestGeneral, updateOneHopSlotMapTimedout) {
 
   Message msg = Message_Create(PING);
   msg->senderId = 2;
-  int8_t currentSlot = 1;
+  SlotNum currentSlot = 1;
 
   SlotMap_UpdateOneHopSlotMap(node, msg, currentSlot);
 
@@ -401,7 +404,7 @@ TEST_F(SlotMapTestGeneral, updateOneHopSlotMapToOccupiedCollisionTimedout) {
   Node_SetClock(node, clock);
 
   Message msg = Message_Create(COLLISION);
-  int8_t currentSlot = 1;
+  SlotNum currentSlot = 1;
 
   SlotMap_UpdateOneHopSlotMap(node, msg, currentSlot);
 
@@ -443,10 +446,10 @@ TEST_F(SlotMapTestGeneral, updateOneHopSlotMapToOccupiedCollisionTimedout) {
 TEST_F(SlotMapTestGeneral, updateMultiHopSlotMapToOccupied) {
   Message msg = Message_Create(PING);
   msg->senderId = 2;
-  msg->oneHopSlotStatus[0] = 0;
-  msg->oneHopSlotStatus[1] = 1;
-  msg->oneHopSlotStatus[2] = 0;
-  msg->oneHopSlotStatus[3] = 1;
+  SlotStatus_Set(&msg->oneHopSlotStatus, 0, FREE);
+  SlotStatus_Set(&msg->oneHopSlotStatus, 1, OCCUPIED);
+  SlotStatus_Set(&msg->oneHopSlotStatus, 2, FREE);
+  SlotStatus_Set(&msg->oneHopSlotStatus, 3, OCCUPIED);
   msg->oneHopSlotIds[0] = 0;
   msg->oneHopSlotIds[1] = 1;
   msg->oneHopSlotIds[2] = 0;
@@ -481,10 +484,10 @@ TEST_F(SlotMapTestGeneral, multiHopIsOccupiedSetColliding) {
 
   Message msg = Message_Create(PING);
   msg->senderId = 2;
-  msg->oneHopSlotStatus[0] = 0;
-  msg->oneHopSlotStatus[1] = 1;
-  msg->oneHopSlotStatus[2] = 0;
-  msg->oneHopSlotStatus[3] = 1;
+  SlotStatus_Set(&msg->oneHopSlotStatus, 0, FREE);
+  SlotStatus_Set(&msg->oneHopSlotStatus, 1, OCCUPIED);
+  SlotStatus_Set(&msg->oneHopSlotStatus, 2, FREE);
+  SlotStatus_Set(&msg->oneHopSlotStatus, 3, OCCUPIED);
   msg->oneHopSlotIds[0] = 0;
   msg->oneHopSlotIds[1] = 1;
   msg->oneHopSlotIds[2] = 0;
@@ -495,7 +498,7 @@ TEST_F(SlotMapTestGeneral, multiHopIsOccupiedSetColliding) {
   time = 404;
   
   msg->senderId = 4;
-  msg->oneHopSlotStatus[1] = 1;
+  SlotStatus_Set(&msg->oneHopSlotStatus, 1, OCCUPIED);
   msg->oneHopSlotIds[1] = 3;
 
   SlotMap_UpdateTwoHopSlotMap(node, msg);
@@ -527,10 +530,10 @@ TEST_F(SlotMapTestGeneral, multiHopIsOccupiedButTimedout) {
 
   Message msg = Message_Create(PING);
   msg->senderId = 2;
-  msg->oneHopSlotStatus[0] = 0;
-  msg->oneHopSlotStatus[1] = 1;
-  msg->oneHopSlotStatus[2] = 0;
-  msg->oneHopSlotStatus[3] = 1;
+  SlotStatus_Set(&msg->oneHopSlotStatus, 0, FREE);
+  SlotStatus_Set(&msg->oneHopSlotStatus, 1, OCCUPIED);
+  SlotStatus_Set(&msg->oneHopSlotStatus, 2, FREE);
+  SlotStatus_Set(&msg->oneHopSlotStatus, 3, OCCUPIED);
   msg->oneHopSlotIds[0] = 0;
   msg->oneHopSlotIds[1] = 1;
   msg->oneHopSlotIds[2] = 0;
@@ -540,7 +543,7 @@ TEST_F(SlotMapTestGeneral, multiHopIsOccupiedButTimedout) {
 
   time = 805;
 
-  msg->oneHopSlotStatus[1] = 1;
+  SlotStatus_Set(&msg->oneHopSlotStatus, 1, OCCUPIED);
   msg->oneHopSlotIds[1] = 3;
 
   SlotMap_UpdateTwoHopSlotMap(node, msg);
@@ -562,17 +565,17 @@ TEST_F(SlotMapTestGeneral, multiHopIsOccupiedButTimedout) {
 TEST_F(SlotMapTestGeneral, multiHopPendingSlotReportedOccupied) {
 
   node->id = 1;
-  int8_t slotNum = 1;
+  SlotNum slotNum = 1;
   int8_t neighbors[1] = {2};
 
   SlotMap_AddPendingSlot(node, slotNum, &neighbors[0], 1);
 
   Message msg = Message_Create(PING);
   msg->senderId = 2;
-  msg->oneHopSlotStatus[0] = 1;
-  msg->oneHopSlotStatus[1] = 0;
-  msg->oneHopSlotStatus[2] = 0;
-  msg->oneHopSlotStatus[3] = 0;
+  SlotStatus_Set(&msg->oneHopSlotStatus, 0, OCCUPIED);
+  SlotStatus_Set(&msg->oneHopSlotStatus, 1, FREE);
+  SlotStatus_Set(&msg->oneHopSlotStatus, 2, FREE);
+  SlotStatus_Set(&msg->oneHopSlotStatus, 3, FREE);
   msg->oneHopSlotIds[0] = 3;
   msg->oneHopSlotIds[1] = 0;
   msg->oneHopSlotIds[2] = 0;
@@ -603,16 +606,16 @@ TEST_F(SlotMapTestGeneral, checkOwnSlotsForCollisions) {
 
   Message msg = Message_Create(PING);
   msg->senderId = 2;
-  msg->oneHopSlotStatus[0] = 0;
-  msg->oneHopSlotStatus[1] = 1;
-  msg->oneHopSlotStatus[2] = 0;
-  msg->oneHopSlotStatus[3] = 0;
+  SlotStatus_Set(&msg->oneHopSlotStatus, 0, FREE);
+  SlotStatus_Set(&msg->oneHopSlotStatus, 1, OCCUPIED);
+  SlotStatus_Set(&msg->oneHopSlotStatus, 2, FREE);
+  SlotStatus_Set(&msg->oneHopSlotStatus, 3, FREE);
   msg->oneHopSlotIds[0] = 0;
   msg->oneHopSlotIds[1] = 3; // colliding because reserved by other node
   msg->oneHopSlotIds[2] = 0;
   msg->oneHopSlotIds[3] = 0;
 
-  int8_t collidingOwnSlots[2];
+  SlotNum collidingOwnSlots[2];
   int8_t numCollidingOwn = SlotMap_CheckOwnSlotsForCollisions(node, msg, &collidingOwnSlots[0], 2);
 
   EXPECT_EQ(2, collidingOwnSlots[0]);
@@ -626,7 +629,7 @@ TEST_F(SlotMapTestGeneral, ownNetworkShouldExist) {
   SlotMap_AddPendingSlot(node, 2, &neighbors[0], 1);
   SlotMap_ChangePendingToOwn(node, 2);
 
-  int8_t collidingSlots[2] = {3, 4};
+  SlotNum collidingSlots[2] = {3, 4};
   
   bool exists = SlotMap_OwnNetworkExists(node, &collidingSlots[0], 2);
 
@@ -640,7 +643,7 @@ TEST_F(SlotMapTestGeneral, ownNetworkShouldNotExist) {
   SlotMap_AddPendingSlot(node, 2, &neighbors[0], 1);
   SlotMap_ChangePendingToOwn(node, 2);
 
-  int8_t collidingSlots[2] = {2, 4};
+  SlotNum collidingSlots[2] = {2, 4};
   
   bool exists = SlotMap_OwnNetworkExists(node, &collidingSlots[0], 2);
 
@@ -653,7 +656,7 @@ TEST_F(SlotMapTestGeneral, ownNetworkShouldNotExist2) {
   int8_t neighbors[1] = {2};
   SlotMap_AddPendingSlot(node, 2, &neighbors[0], 1); // do not change to own
 
-  int8_t collidingSlots[2] = {2, 4};
+  SlotNum collidingSlots[2] = {2, 4};
   
   bool exists = SlotMap_OwnNetworkExists(node, &collidingSlots[0], 2);
 
@@ -663,7 +666,7 @@ TEST_F(SlotMapTestGeneral, ownNetworkShouldNotExist2) {
 TEST_F(SlotMapTestGeneral, ownNetworkShouldExistDueToOtherNode) {
   Message msg = Message_Create(PING);
   msg->senderId = 3;
-  int8_t currentSlot = 1;
+  SlotNum currentSlot = 1;
   SlotMap_UpdateOneHopSlotMap(node, msg, currentSlot); // other node has slot, so network should still exist
 
   node->id = 1;
@@ -671,7 +674,7 @@ TEST_F(SlotMapTestGeneral, ownNetworkShouldExistDueToOtherNode) {
   SlotMap_AddPendingSlot(node, 2, &neighbors[0], 1);
   SlotMap_ChangePendingToOwn(node, 2);
 
-  int8_t collidingSlots[2] = {2, 4};
+  SlotNum collidingSlots[2] = {2, 4};
   
   bool exists = SlotMap_OwnNetworkExists(node, &collidingSlots[0], 2);
 
@@ -735,17 +738,17 @@ TEST_F(SlotMapTestGeneral, clearToSendSlotFree) {
   Message msg = Message_Create(PING);
   msg->senderId = 2;
 
-  msg->oneHopSlotStatus[0] = FREE;
-  msg->oneHopSlotStatus[1] = FREE;
-  msg->oneHopSlotStatus[2] = FREE;
-  msg->oneHopSlotStatus[3] = OCCUPIED;
+  SlotStatus_Set(&msg->oneHopSlotStatus, 0, FREE);
+  SlotStatus_Set(&msg->oneHopSlotStatus, 1, FREE);
+  SlotStatus_Set(&msg->oneHopSlotStatus, 2, FREE);
+  SlotStatus_Set(&msg->oneHopSlotStatus, 3, OCCUPIED);
 
-  msg->twoHopSlotStatus[0] = FREE;
-  msg->twoHopSlotStatus[1] = OCCUPIED;
-  msg->twoHopSlotStatus[2] = COLLIDING;
-  msg->twoHopSlotStatus[3] = FREE;
+  SlotStatus_Set(&msg->twoHopSlotStatus, 0, FREE);
+  SlotStatus_Set(&msg->twoHopSlotStatus, 1, OCCUPIED);
+  SlotStatus_Set(&msg->twoHopSlotStatus, 2, COLLIDING);
+  SlotStatus_Set(&msg->twoHopSlotStatus, 3, FREE);
 
-  int8_t currentSlot = 1;
+  SlotNum currentSlot = 1;
   SlotMap_UpdateOneHopSlotMap(node, msg, currentSlot);
   SlotMap_UpdateTwoHopSlotMap(node, msg);
   SlotMap_UpdateThreeHopSlotMap(node, msg);
@@ -770,6 +773,94 @@ TEST_F(SlotMapTestGeneral, clearToSendSlotFree) {
 
 
 
+TEST_F(SlotMapTestGeneral, masksFollowSlotMaps) {
+  node->id = 1;
+  Message msg = Message_Create(PING);
+  msg->senderId = 2;
+  SlotStatus_Set(&msg->oneHopSlotStatus, 1, OCCUPIED);
+  msg->oneHopSlotIds[1] = 1;
+  SlotStatus_Set(&msg->oneHopSlotStatus, 2, COLLIDING);
+  SlotStatus_Set(&msg->twoHopSlotStatus, 3, OCCUPIED);
+  msg->twoHopSlotIds[3] = 3;
+
+  SlotMap_UpdateOneHopSlotMap(node, msg, 1);
+  SlotMap_UpdateTwoHopSlotMap(node, msg);
+  SlotMap_UpdateThreeHopSlotMap(node, msg);
+  int8_t neighbors[1] = {2};
+  SlotMap_AddPendingSlot(node, 2, &neighbors[0], 1);
+  SlotMap_AddPendingSlot(node, 3, &neighbors[0], 1);
+  SlotMap_ChangePendingToOwn(node, 3);
+
+  EXPECT_EQ(0x1u, slotMap->oneHopSlotsMasks.occupied.words[0]);
+  EXPECT_EQ(0x2u, slotMap->twoHopSlotsMasks.occupiedByThisNode.words[0]);
+  EXPECT_EQ(0x4u, slotMap->twoHopSlotsMasks.colliding.words[0]);
+  EXPECT_EQ(0x8u, slotMap->threeHopSlotsMasks.occupied.words[0]);
+  EXPECT_EQ(0x2u, slotMap->pendingSlotsMask.words[0]);
+  EXPECT_EQ(0x4u, slotMap->ownSlotsMask.words[0]);
+
+  // rebuilding from the arrays gives the same bit sets
+  SlotMapStruct updated = *slotMap;
+  SlotMap_RebuildMasks(node);
+  EXPECT_EQ(0, memcmp(&updated, slotMap, sizeof(SlotMapStruct)));
+
+  // slot 2 is free for this node, slot 3 is colliding and slot numbers outside of the frame are neither
+  EXPECT_TRUE(SlotMap_SlotIsFreeForThisNode(node, 2));
+  EXPECT_FALSE(SlotMap_SlotIsFree(node, 2));
+  EXPECT_TRUE(SlotMap_SlotIsColliding(node, 3));
+  EXPECT_FALSE(SlotMap_SlotIsFree(node, 0));
+  EXPECT_FALSE(SlotMap_SlotIsColliding(node, 127));
+
+  SlotMap_ReleaseOwnSlot(node, 3);
+  SlotMap_ReleasePendingSlot(node, 2);
+  EXPECT_EQ(0u, slotMap->ownSlotsMask.words[0] | slotMap->pendingSlotsMask.words[0]);
+  Message_Destroy(msg);
+}
+
+TEST_F(SlotMapTestGeneral, combinedMasksFollowSlotMaps) {
+  node->id = 1;
+  EXPECT_EQ(0xFu, slotMap->combinedMasks.reservable.words[0]);
+
+  Message msg = Message_Create(PING);
+  msg->senderId = 2;
+  SlotStatus_Set(&msg->oneHopSlotStatus, 1, OCCUPIED);
+  msg->oneHopSlotIds[1] = 1;
+  SlotStatus_Set(&msg->oneHopSlotStatus, 2, COLLIDING);
+  SlotStatus_Set(&msg->twoHopSlotStatus, 3, OCCUPIED);
+  msg->twoHopSlotIds[3] = 3;
+
+  SlotMap_UpdateOneHopSlotMap(node, msg, 1);
+  SlotMap_UpdateTwoHopSlotMap(node, msg);
+  SlotMap_UpdateThreeHopSlotMap(node, msg);
+  EXPECT_TRUE(SlotMap_CombinedMasksAreConsistent(node));
+
+  // slot 1 and 4 are occupied by other nodes, slot 2 is occupied by this node and slot 3 is colliding
+  EXPECT_EQ(0x9u, slotMap->combinedMasks.occupiedByOtherNodes.words[0]);
+  EXPECT_EQ(0x2u, slotMap->combinedMasks.freeForThisNode.words[0]);
+  EXPECT_EQ(0x4u, slotMap->combinedMasks.colliding.words[0]);
+  EXPECT_EQ(0x6u, slotMap->combinedMasks.reservable.words[0]);
+  EXPECT_EQ(0x6u, slotMap->combinedMasks.clearToSend.words[0]);
+
+  // own and pending slots are clear to send even if another node occupies them
+  int8_t neighbors[1] = {2};
+  SlotMap_AddPendingSlot(node, 4, &neighbors[0], 1);
+  EXPECT_EQ(0xEu, slotMap->combinedMasks.clearToSend.words[0]);
+  SlotMap_ChangePendingToOwn(node, 4);
+  EXPECT_EQ(0xEu, slotMap->combinedMasks.clearToSend.words[0]);
+  SlotMap_ReleaseOwnSlot(node, 4);
+  EXPECT_EQ(0x6u, slotMap->combinedMasks.clearToSend.words[0]);
+  EXPECT_TRUE(SlotMap_CombinedMasksAreConsistent(node));
+
+  // a slot map changed without the SlotMap functions is detected until the bit sets are rebuilt
+  SlotStatus_Set(&slotMap->twoHopSlotsStatus, 2, FREE);
+  slotMap->twoHopSlotsMasks.colliding.words[0] = 0;
+  slotMap->twoHopSlotsMasks.free.words[0] |= 0x4u;
+  EXPECT_FALSE(SlotMap_CombinedMasksAreConsistent(node));
+  SlotMap_RebuildMasks(node);
+  EXPECT_TRUE(SlotMap_CombinedMasksAreConsistent(node));
+  EXPECT_EQ(0x6u, slotMap->combinedMasks.freeForThisNode.words[0]);
+  Message_Destroy(msg);
+}
+
 TEST(UtilTest, intersect) {
   int8_t array1[5] = {1,2,3,4,5};
   //int8_t array2[7] = {2,1,6,5,8,9,0};
@@ -789,4 +880,25 @@ TEST(UtilTest, sort) {
   EXPECT_EQ(4, array1[1]);
   EXPECT_EQ(5, array1[2]);
   EXPECT_EQ(9, array1[3]);
-};
\ No newline at end of file
+};
+TEST(SlotStatusTest, packsFourSlotsPerByte) {
+  SlotStatusArray statuses;
+  memset(&statuses, 0, sizeof(SlotStatusArray));
+
+  SlotStatus_Set(&statuses, 0, COLLIDING);
+  SlotStatus_Set(&statuses, 1, OCCUPIED);
+  SlotStatus_Set(&statuses, 3, COLLIDING);
+  EXPECT_EQ(0x86u, statuses.bytes[0]);
+  EXPECT_EQ(COLLIDING, SlotStatus_Get(&statuses, 0));
+  EXPECT_EQ(OCCUPIED, SlotStatus_Get(&statuses, 1));
+  EXPECT_EQ(FREE, SlotStatus_Get(&statuses, 2));
+  EXPECT_EQ(COLLIDING, SlotStatus_Get(&statuses, 3));
+
+  // setting a slot leaves its neighbors in the same byte unchanged
+  SlotStatus_Set(&statuses, 0, FREE);
+  SlotStatus_Set(&statuses, 2, OCCUPIED);
+  EXPECT_EQ(FREE, SlotStatus_Get(&statuses, 0));
+  EXPECT_EQ(OCCUPIED, SlotStatus_Get(&statuses, 1));
+  EXPECT_EQ(OCCUPIED, SlotStatus_Get(&statuses, 2));
+  EXPECT_EQ(COLLIDING, SlotStatus_Get(&statuses, 3));
+};
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+extern "C" {
+#include "../include/Snapshot.h"
+#include "../include/Simulator.h"
+#include "../include/Node.h"
+#include "../include/StateMachine.h"
+#include "../include/NetworkManager.h"
+#include "../include/TimeKeeping.h"
+#include "../include/SlotMap.h"
+}
+
+class SnapshotTestGeneral : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    sim = Simulator_Create(MAX_NUM_NODES, 42);
+    Simulator_SetRadioRange(sim, 1.5);
+  }
+
+  void TearDown() override {
+    Simulator_Destroy(sim);
+  }
+
+  Simulator sim;
+};
+
+TEST_F(SnapshotTestGeneral, snapshotOfNodeThatIsOffIsEmpty) {
+  Simulator_AddNode(sim, 1, 0, 0, 100);
+  Snapshot snapshot = Snapshot_Create(1);
+
+  Simulator_Snapshot(sim, snapshot);
+  EXPECT_EQ(OFF, snapshot->state[0]);
+  EXPECT_EQ(0, snapshot->localTime[0]);
+  EXPECT_EQ(0, snapshot->networkId[0]);
+  for (int8_t slot = 0; slot < MAX_NUM_OWN_SLOTS; ++slot) {
+    EXPECT_EQ(0, snapshot->ownSlots[slot]);
+  };
+
+  Snapshot_Destroy(snapshot);
+}
+
+TEST_F(SnapshotTestGeneral, snapshotMatchesStateOfEveryNode) {
+  Simulator_AddNode(sim, 1, 0, 0, 0);
+  Simulator_AddNode(sim, 2, 1, 0, 0);
+  Simulator_AddNode(sim, 3, 2, 0, 0);
+  Simulator_RunUntil(sim, 20000);
+
+  int16_t numNodes = 3;
+  Snapshot snapshot = Snapshot_Create(numNodes);
+  Simulator_Snapshot(sim, snapshot);
+
+  for (int16_t i = 0; i < numNodes; ++i) {
+    Node node = Simulator_GetNode(sim, i);
+    EXPECT_EQ(StateMachine_GetState(node), snapshot->state[i]);
+    EXPECT_EQ(ProtocolClock_GetLocalTime(node->clock), snapshot->localTime[i]);
+    EXPECT_EQ(NetworkManager_GetNetworkId(node), snapshot->networkId[i]);
+    EXPECT_EQ(NetworkManager_CalculateNetworkAge(node), snapshot->networkAge[i]);
+    EXPECT_EQ(TimeKeeping_CalculateCurrentSlotNum(node), snapshot->currentSlot[i]);
+
+    // column-major: value of column c of node i is at i + c * numNodes
+    SlotNum ownSlots[MAX_NUM_OWN_SLOTS] = {};
+    int8_t numOwn = SlotMap_GetOwnSlots(node, &ownSlots[0], MAX_NUM_OWN_SLOTS);
+    EXPECT_GT(numOwn, 0);
+    for (int8_t slot = 0; slot < MAX_NUM_OWN_SLOTS; ++slot) {
+      EXPECT_EQ(ownSlots[slot], snapshot->ownSlots[i + slot * numNodes]);
+    };
+
+    for (int16_t slot = 0; slot < NUM_SLOTS; ++slot) {
+      EXPECT_EQ(SlotStatus_Get(&node->slotMap->oneHopSlotsStatus, slot), snapshot->oneHopSlotsStatus[i + slot * numNodes]);
+      EXPECT_EQ(node->slotMap->oneHopSlotsIds[slot], snapshot->oneHopSlotsIds[i + slot * numNodes]);
+      EXPECT_EQ(SlotStatus_Get(&node->slotMap->twoHopSlotsStatus, slot), snapshot->twoHopSlotsStatus[i + slot * numNodes]);
+      EXPECT_EQ(node->slotMap->twoHopSlotsIds[slot], snapshot->twoHopSlotsIds[i + slot * numNodes]);
+      EXPECT_EQ(SlotStatus_Get(&node->slotMap->threeHopSlotsStatus, slot), snapshot->threeHopSlotsStatus[i + slot * numNodes]);
+      EXPECT_EQ(node->slotMap->threeHopSlotsIds[slot], snapshot->threeHopSlotsIds[i + slot * numNodes]);
+    };
+  };
+
+  Snapshot_Destroy(snapshot);
+}
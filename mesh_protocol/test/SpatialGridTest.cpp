@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+extern "C" {
+#include "../include/SpatialGrid.h"
+}
+
+/** all nodes within range of a node, found by checking every node */
+static std::vector<int16_t> bruteForce(SpatialGrid grid, int16_t nodeIdx, double range) {
+  std::vector<int16_t> result;
+  for (int16_t i = 0; i < grid->numNodes; ++i) {
+    double dx = grid->posX[i] - grid->posX[nodeIdx];
+    double dy = grid->posY[i] - grid->posY[nodeIdx];
+    if (i != nodeIdx && sqrt(dx * dx + dy * dy) <= range) {
+      result.push_back(i);
+    };
+  };
+  return result;
+}
+
+static std::vector<int16_t> query(SpatialGrid grid, int16_t nodeIdx, double range) {
+  std::vector<int16_t> buffer(grid->numNodes);
+  int16_t numFound = SpatialGrid_QueryRange(grid, nodeIdx, range, buffer.data(), grid->numNodes);
+  buffer.resize(numFound);
+  return buffer;
+}
+
+TEST(SpatialGridTest, queryFindsNodesInRangeOnly) {
+  SpatialGrid grid = SpatialGrid_Create(4, 1.5);
+  SpatialGrid_Insert(grid, 0, 0);
+  SpatialGrid_Insert(grid, 1, 0);
+  SpatialGrid_Insert(grid, 1.5, 0);
+  SpatialGrid_Insert(grid, 1.6, 0);
+
+  EXPECT_EQ(std::vector<int16_t>({1, 2}), query(grid, 0, 1.5));
+  EXPECT_EQ(std::vector<int16_t>({0, 2, 3}), query(grid, 1, 1.5));
+
+  SpatialGrid_Destroy(grid);
+}
+
+TEST(SpatialGridTest, queryMatchesBruteForceForManyNodes) {
+  int16_t numNodes = 500;
+  double range = 7.0;
+  SpatialGrid grid = SpatialGrid_Create(numNodes, range);
+
+  uint32_t state = 12345;
+  for (int16_t i = 0; i < numNodes; ++i) {
+    state = state * 1103515245u + 12345u;
+    double x = (state >> 8) % 10000 / 100.0 - 50.0;
+    state = state * 1103515245u + 12345u;
+    double y = (state >> 8) % 10000 / 100.0 - 50.0;
+    SpatialGrid_Insert(grid, x, y);
+  };
+
+  for (int16_t i = 0; i < numNodes; ++i) {
+    ASSERT_EQ(bruteForce(grid, i, range), query(grid, i, range));
+  };
+
+  // ranges that are different from the cell size work as well
+  EXPECT_EQ(bruteForce(grid, 0, 2.5), query(grid, 0, 2.5));
+  EXPECT_EQ(bruteForce(grid, 0, 20.0), query(grid, 0, 20.0));
+
+  SpatialGrid_Destroy(grid);
+}
+
+TEST(SpatialGridTest, movedNodesAreFoundAtTheirNewPosition) {
+  SpatialGrid grid = SpatialGrid_Create(20, 1.0);
+  for (int16_t i = 0; i < 20; ++i) {
+    SpatialGrid_Insert(grid, 3.0 * i, 0);
+  };
+  EXPECT_TRUE(query(grid, 0, 1.0).empty());
+
+  // move within a cell and across cells
+  SpatialGrid_Move(grid, 5, 0.5, 0.2);
+  SpatialGrid_Move(grid, 7, -0.9, -0.1);
+  EXPECT_EQ(std::vector<int16_t>({5, 7}), query(grid, 0, 1.0));
+
+  SpatialGrid_Move(grid, 5, 15.0, 0);
+  EXPECT_EQ(std::vector<int16_t>({7}), query(grid, 0, 1.0));
+  for (int16_t i = 0; i < 20; ++i) {
+    ASSERT_EQ(bruteForce(grid, i, 1.0), query(grid, i, 1.0));
+  };
+
+  // changing the cell size keeps all nodes
+  SpatialGrid_SetCellSize(grid, 4.0);
+  for (int16_t i = 0; i < 20; ++i) {
+    ASSERT_EQ(bruteForce(grid, i, 3.0), query(grid, i, 3.0));
+  };
+
+  SpatialGrid_Destroy(grid);
+}
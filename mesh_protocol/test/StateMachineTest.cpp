@@ -9,6 +9,7 @@ extern "C" {
 #include "../include/TimeKeeping.h"
 #include "../include/GuardConditions.h"
 #include "../include/Driver.h"
+#include "../include/TimerWheel.h"
 #include "../test/fff.h"
 }
 
@@ -38,38 +39,42 @@ FAKE_VALUE_FUNC(bool, GuardConditions_SendingConToListeningConAllowed, Node);
 FAKE_VALUE_FUNC(bool, GuardConditions_IdleToListeningConAllowed, Node);
 FAKE_VALUE_FUNC(bool, GuardConditions_IdleToListeningConAllowedIncomingMsg, Node, Message);
 FAKE_VALUE_FUNC(bool, GuardConditions_IdleingAllowed, Node);
+FAKE_VALUE_FUNC(int64_t, GuardConditions_EarliestRangingPollTime, Node);
+FAKE_VALUE_FUNC(int64_t, GuardConditions_EarliestIdleingTime, Node);
 
 FAKE_VALUE_FUNC(int64_t, RandomNumbers_GetRandomIntBetween, Node, int64_t, int64_t);
 FAKE_VALUE_FUNC(bool, SlotMap_SlotReservationGoalMet, Node);
-FAKE_VALUE_FUNC(int8_t, SlotMap_GetReservableSlot, Node);
-FAKE_VALUE_FUNC(int8_t, SlotMap_CalculateNextOwnOrPendingSlotNum, Node, int8_t);
-FAKE_VALUE_FUNC(int8_t, SlotMap_GetAcknowledgedPendingSlots, Node, int8_t*, int8_t);
-FAKE_VALUE_FUNC(bool, SlotMap_ChangePendingToOwn, Node, int8_t);
-FAKE_VALUE_FUNC(int8_t, SlotMap_CheckOwnSlotsForCollisions, Node, Message, int8_t*, int8_t);
-FAKE_VALUE_FUNC(int8_t, SlotMap_CheckPendingSlotsForCollisions, Node, Message, int8_t*, int8_t);
-FAKE_VALUE_FUNC(bool, SlotMap_OwnNetworkExists, Node, int8_t*, int8_t);
-FAKE_VALUE_FUNC(bool, SlotMap_IsOwnSlot, Node, int8_t);
-FAKE_VALUE_FUNC(bool, SlotMap_IsPendingSlot, Node, int8_t);
-FAKE_VALUE_FUNC(bool, SlotMap_ReleasePendingSlot, Node, int8_t);
-FAKE_VALUE_FUNC(bool, SlotMap_ReleaseOwnSlot, Node, int8_t);
-FAKE_VALUE_FUNC(bool, SlotMap_GetOneHopSlotMapStatus, Node, int*, int8_t);
-FAKE_VALUE_FUNC(bool, SlotMap_GetOneHopSlotMapIds, Node, int8_t*, int8_t);
-FAKE_VALUE_FUNC(bool, SlotMap_GetOneHopSlotMapLastUpdated, Node, int64_t*, int8_t);
-FAKE_VALUE_FUNC(bool, SlotMap_GetTwoHopSlotMapStatus, Node, int*, int8_t);
-FAKE_VALUE_FUNC(bool, SlotMap_GetTwoHopSlotMapIds, Node, int8_t*, int8_t);
-FAKE_VALUE_FUNC(bool, SlotMap_GetTwoHopSlotMapLastUpdated, Node, int64_t*, int8_t);
-FAKE_VALUE_FUNC(bool, SlotMap_GetThreeHopSlotMapStatus, Node, int*, int8_t);
-FAKE_VALUE_FUNC(bool, SlotMap_GetThreeHopSlotMapIds, Node, int8_t*, int8_t);
-FAKE_VALUE_FUNC(bool, SlotMap_GetThreeHopSlotMapLastUpdated, Node, int64_t*, int8_t);
+FAKE_VALUE_FUNC(SlotNum, SlotMap_GetReservableSlot, Node);
+FAKE_VALUE_FUNC(SlotNum, SlotMap_CalculateNextOwnOrPendingSlotNum, Node, SlotNum);
+FAKE_VALUE_FUNC(int8_t, SlotMap_GetAcknowledgedPendingSlots, Node, SlotNum*, int16_t);
+FAKE_VALUE_FUNC(bool, SlotMap_ChangePendingToOwn, Node, SlotNum);
+FAKE_VALUE_FUNC(int8_t, SlotMap_CheckOwnSlotsForCollisions, Node, Message, SlotNum*, int16_t);
+FAKE_VALUE_FUNC(int8_t, SlotMap_CheckPendingSlotsForCollisions, Node, Message, SlotNum*, int16_t);
+FAKE_VALUE_FUNC(bool, SlotMap_OwnNetworkExists, Node, SlotNum*, int16_t);
+FAKE_VALUE_FUNC(bool, SlotMap_IsOwnSlot, Node, SlotNum);
+FAKE_VALUE_FUNC(bool, SlotMap_IsPendingSlot, Node, SlotNum);
+FAKE_VALUE_FUNC(bool, SlotMap_ReleasePendingSlot, Node, SlotNum);
+FAKE_VALUE_FUNC(bool, SlotMap_ReleaseOwnSlot, Node, SlotNum);
+FAKE_VALUE_FUNC(bool, SlotMap_GetOneHopSlotMapStatus, Node, int*, int16_t);
+FAKE_VOID_FUNC(SlotMap_GetOneHopSlotMapPackedStatus, Node, SlotStatusArray*);
+FAKE_VALUE_FUNC(bool, SlotMap_GetOneHopSlotMapIds, Node, int8_t*, int16_t);
+FAKE_VALUE_FUNC(bool, SlotMap_GetOneHopSlotMapLastUpdated, Node, int64_t*, int16_t);
+FAKE_VALUE_FUNC(bool, SlotMap_GetTwoHopSlotMapStatus, Node, int*, int16_t);
+FAKE_VOID_FUNC(SlotMap_GetTwoHopSlotMapPackedStatus, Node, SlotStatusArray*);
+FAKE_VALUE_FUNC(bool, SlotMap_GetTwoHopSlotMapIds, Node, int8_t*, int16_t);
+FAKE_VALUE_FUNC(bool, SlotMap_GetTwoHopSlotMapLastUpdated, Node, int64_t*, int16_t);
+FAKE_VALUE_FUNC(bool, SlotMap_GetThreeHopSlotMapStatus, Node, int*, int16_t);
+FAKE_VALUE_FUNC(bool, SlotMap_GetThreeHopSlotMapIds, Node, int8_t*, int16_t);
+FAKE_VALUE_FUNC(bool, SlotMap_GetThreeHopSlotMapLastUpdated, Node, int64_t*, int16_t);
 FAKE_VALUE_FUNC(int8_t, SlotMap_GetCollisionTimes, Node, int64_t*, int8_t);
-FAKE_VALUE_FUNC(bool, SlotMap_AddPendingSlot, Node, int8_t, int8_t*, int8_t);
-FAKE_VALUE_FUNC(int16_t, SlotMap_RemoveExpiredPendingSlots, Node, int8_t*, int8_t);
-FAKE_VALUE_FUNC(int16_t, SlotMap_RemoveExpiredOwnSlots, Node, int8_t*, int8_t);
-FAKE_VALUE_FUNC(int8_t, SlotMap_GetOwnSlots, Node, int8_t*, int8_t);
-FAKE_VALUE_FUNC(int8_t, SlotMap_GetPendingSlots, Node, int8_t*, int8_t);
+FAKE_VALUE_FUNC(bool, SlotMap_AddPendingSlot, Node, SlotNum, int8_t*, int8_t);
+FAKE_VALUE_FUNC(int16_t, SlotMap_RemoveExpiredPendingSlots, Node, SlotNum*, int16_t);
+FAKE_VALUE_FUNC(int16_t, SlotMap_RemoveExpiredOwnSlots, Node, SlotNum*, int16_t);
+FAKE_VALUE_FUNC(int8_t, SlotMap_GetOwnSlots, Node, SlotNum*, int16_t);
+FAKE_VALUE_FUNC(int8_t, SlotMap_GetPendingSlots, Node, SlotNum*, int16_t);
 
 FAKE_VOID_FUNC(SlotMap_UpdatePendingSlotAcks, Node, Message);
-FAKE_VOID_FUNC(SlotMap_UpdateOneHopSlotMap, Node, Message, int8_t)
+FAKE_VOID_FUNC(SlotMap_UpdateOneHopSlotMap, Node, Message, SlotNum)
 FAKE_VOID_FUNC(SlotMap_UpdateTwoHopSlotMap, Node, Message);
 FAKE_VOID_FUNC(SlotMap_UpdateThreeHopSlotMap, Node, Message);
 FAKE_VOID_FUNC(SlotMap_RecordCollisionTime, Node);
@@ -311,8 +316,10 @@ class StateMachineTestListeningConnected : public ::testing::Test {
     timekeeping = TimeKeeping_Create();
     config = Config_Create();
     neighborhood = Neighborhood_Create();
+    timerWheel = TimerWheel_Create();
 
     Node_SetStateMachine(node, sm);
+    Node_SetTimerWheel(node, timerWheel);
 
     // set to listining connected by triggering an incoming msg event
     StateMachine_Run(node, TURN_ON, NULL);
@@ -327,6 +334,7 @@ class StateMachineTestListeningConnected : public ::testing::Test {
   TimeKeeping timekeeping;
   Config config;
   Neighborhood neighborhood;
+  TimerWheel timerWheel;
 };
 
 TEST_F(StateMachineTestListeningConnected, stateActionCalledIncomingPing) {
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+
+extern "C" {
+#include "../include/Sweep.h"
+#include "../include/Config.h"
+}
+
+class SweepTestGeneral : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    Config testConfig = Config_Create();
+    config = *testConfig;
+    free(testConfig);
+  }
+
+  ConfigStruct config;
+};
+
+TEST_F(SweepTestGeneral, scenarioMatrixContainsAllCombinations) {
+  uint32_t seeds[3] = {1, 2, 3};
+  int16_t nodeCounts[2] = {2, 4};
+  SweepTopology topologies[2] = {TOPOLOGY_LINE, TOPOLOGY_GRID};
+  int32_t numScenarios = 0;
+
+  SweepScenarioStruct *scenarios = Sweep_CreateScenarioMatrix(&seeds[0], 3, &nodeCounts[0], 2, &topologies[0], 2, &config, 1, 
+    1.0, 1.5, 1000, &numScenarios);
+
+  ASSERT_EQ(12, numScenarios);
+  for (int32_t i = 0; i < numScenarios; ++i) {
+    EXPECT_EQ(i, scenarios[i].id);
+    EXPECT_EQ(seeds[i % 3], scenarios[i].seed);
+  };
+  EXPECT_EQ(4, scenarios[11].numNodes);
+  EXPECT_EQ(TOPOLOGY_GRID, scenarios[11].topology);
+  free(scenarios);
+}
+
+TEST_F(SweepTestGeneral, setConfigValueByName) {
+  EXPECT_TRUE(Sweep_SetConfigValue(&config, "slotGoal", 2));
+  EXPECT_EQ(2, config.slotGoal);
+  EXPECT_TRUE(Sweep_SetConfigValue(&config, "rangingRefreshTime", 1234));
+  EXPECT_EQ(1234, config.rangingRefreshTime);
+  EXPECT_FALSE(Sweep_SetConfigValue(&config, "noSuchField", 1));
+}
+
+TEST_F(SweepTestGeneral, scenarioReportsFormationAndSlotGoal) {
+  SweepScenarioStruct scenario = {};
+  scenario.seed = 7;
+  scenario.numNodes = 3;
+  scenario.topology = TOPOLOGY_LINE;
+  scenario.spacing = 1.0;
+  scenario.radioRange = 1.5;
+  scenario.duration = 20000;
+  scenario.config = config;
+
+  SweepResultStruct result;
+  Sweep_RunScenario(&scenario, &result);
+
+  EXPECT_GT(result.networkFormationTime, 0);
+  EXPECT_GE(result.slotGoalTime, result.networkFormationTime);
+  EXPECT_LT(result.slotGoalTime, scenario.duration);
+  EXPECT_GT(result.numPings, 0);
+  EXPECT_GT(result.numRangings, 0);
+}
+
+TEST_F(SweepTestGeneral, topologyNamesRoundTrip) {
+  for (int i = 0; i < NUM_TOPOLOGIES; ++i) {
+    SweepTopology topology;
+    ASSERT_NE(nullptr, Sweep_GetTopologyName((SweepTopology) i));
+    EXPECT_TRUE(Sweep_ParseTopology(Sweep_GetTopologyName((SweepTopology) i), &topology));
+    EXPECT_EQ(i, topology);
+  };
+  SweepTopology topology;
+  EXPECT_FALSE(Sweep_ParseTopology("torus", &topology));
+  EXPECT_EQ(nullptr, Sweep_GetTopologyName(NUM_TOPOLOGIES));
+}
+
+TEST_F(SweepTestGeneral, cliqueReachesFirstSlotBeforeSlotGoal) {
+  SweepScenarioStruct scenario = {};
+  scenario.seed = 3;
+  scenario.numNodes = 2;
+  scenario.topology = TOPOLOGY_CLIQUE;
+  scenario.spacing = 1.0;
+  scenario.radioRange = 1.5;
+  scenario.duration = 30000;
+  scenario.config = config;
+  scenario.config.slotGoal = 2;
+
+  SweepResultStruct result;
+  Sweep_RunScenario(&scenario, &result);
+
+  EXPECT_GT(result.firstSlotTime, result.networkFormationTime);
+  EXPECT_GE(result.slotGoalTime, result.firstSlotTime);
+  EXPECT_EQ(0, result.numNetworkSwitches);
+}
+
+TEST_F(SweepTestGeneral, mergingClustersSwitchNetworks) {
+  SweepScenarioStruct scenario = {};
+  scenario.seed = 5;
+  scenario.numNodes = 4;
+  scenario.topology = TOPOLOGY_MERGE;
+  scenario.spacing = 1.0;
+  scenario.radioRange = 1.5;
+  scenario.duration = 40000;
+  scenario.config = config;
+
+  SweepResultStruct result;
+  Sweep_RunScenario(&scenario, &result);
+
+  // the clusters form two networks before they are merged; one of them joins the other afterwards
+  EXPECT_GE(result.networkFormationTime, scenario.duration / 2);
+  EXPECT_LT(result.firstSlotTime, scenario.duration / 2);
+  EXPECT_GT(result.numNetworkSwitches, 0);
+}
+
+TEST_F(SweepTestGeneral, disconnectedNodesNeverFormOneNetwork) {
+  SweepScenarioStruct scenario = {};
+  scenario.seed = 7;
+  scenario.numNodes = 2;
+  scenario.topology = TOPOLOGY_LINE;
+  scenario.spacing = 10.0;
+  scenario.radioRange = 1.5;
+  scenario.duration = 5000;
+  scenario.config = config;
+
+  SweepResultStruct result;
+  Sweep_RunScenario(&scenario, &result);
+
+  EXPECT_EQ(-1, result.networkFormationTime);
+  EXPECT_EQ(0, result.numRangings);
+}
+
+TEST_F(SweepTestGeneral, resultsDoNotDependOnNumberOfThreads) {
+  uint32_t seeds[5] = {1, 2, 3, 4, 5};
+  int16_t nodeCounts[2] = {2, 4};
+  SweepTopology topologies[2] = {TOPOLOGY_LINE, TOPOLOGY_RANDOM};
+  int32_t numScenarios = 0;
+  SweepScenarioStruct *scenarios = Sweep_CreateScenarioMatrix(&seeds[0], 5, &nodeCounts[0], 2, &topologies[0], 2, &config, 1, 
+    1.0, 1.5, 5000, &numScenarios);
+
+  SweepResultStruct *sequential = (SweepResultStruct *) calloc(numScenarios, sizeof(SweepResultStruct));
+  SweepResultStruct *parallel = (SweepResultStruct *) calloc(numScenarios, sizeof(SweepResultStruct));
+  Sweep_Run(scenarios, numScenarios, sequential, 1);
+  Sweep_Run(scenarios, numScenarios, parallel, 7);
+
+  for (int32_t i = 0; i < numScenarios; ++i) {
+    EXPECT_EQ(i, parallel[i].scenarioId);
+    EXPECT_EQ(sequential[i].networkFormationTime, parallel[i].networkFormationTime);
+    EXPECT_EQ(sequential[i].firstSlotTime, parallel[i].firstSlotTime);
+    EXPECT_EQ(sequential[i].slotGoalTime, parallel[i].slotGoalTime);
+    EXPECT_EQ(sequential[i].numCollisions, parallel[i].numCollisions);
+    EXPECT_EQ(sequential[i].numRangings, parallel[i].numRangings);
+    EXPECT_EQ(sequential[i].numPings, parallel[i].numPings);
+    EXPECT_EQ(sequential[i].numSlotReleases, parallel[i].numSlotReleases);
+    EXPECT_EQ(sequential[i].numNetworkSwitches, parallel[i].numNetworkSwitches);
+  };
+
+  free(sequential);
+  free(parallel);
+  free(scenarios);
+}
@@ -52,22 +52,30 @@
 #define DEBUG 0
 #define DEBUG_VERBOSE 0
 
-/** Number of slots per frame */
+/** Number of slots per frame (can be overridden at compile time, see mesh_benchmarks in CMakeLists.txt) */
+#ifndef NUM_SLOTS
 #define NUM_SLOTS 4
+#endif
 
-/** Maximum number of pending slots per node */
+/** Maximum number of pending slots per node (can be overridden at compile time, see memory_footprint in CMakeLists.txt) */
+#ifndef MAX_NUM_PENDING_SLOTS
 #define MAX_NUM_PENDING_SLOTS 5
+#endif
 
 /** Maximum number of own slots per node */
 #define MAX_NUM_OWN_SLOTS 5
 
-/** Maximum number of nodes */
+/** Maximum number of nodes (can be overridden at compile time, see mesh_benchmarks in CMakeLists.txt) */
+#ifndef MAX_NUM_NODES
 #define MAX_NUM_NODES 6
+#endif
 
 /** Maximum number of collisions that are recorded for the current frame
-* If more collisions occur, the oldest will be overwritten
+* If more collisions occur, the oldest will be overwritten (can be overridden at compile time, see memory_footprint in CMakeLists.txt)
 */
+#ifndef MAX_NUM_COLLISIONS_RECORDED
 #define MAX_NUM_COLLISIONS_RECORDED 8
+#endif
 
 // 32767 is what LCG assumes as RAND_MAX, but MATLAB seems to use 2^32-1 as RAND_MAX; so the number had to be hardcoded here to work in simulation
 #define RAND_MAX_LCG 32767
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+
+extern "C" {
+#include "../include/TimerWheel.h"
+}
+
+class TimerWheelTestGeneral : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    wheel = TimerWheel_Create();
+    for (int16_t i = 0; i < TIMER_WHEEL_NUM_TIMERS; ++i) {
+      expirationTimes[i] = -1;
+      expiredAt[i] = -1;
+    };
+  }
+
+  void TearDown() override {
+    free(wheel);
+  }
+
+  void schedule(int16_t timer, int64_t expirationTime) {
+    expirationTimes[timer] = expirationTime;
+    TimerWheel_Schedule(wheel, timer, expirationTime);
+  }
+
+  /** pop the fired timers like the SlotMap does: a timer that fired early is scheduled again */
+  void popAt(int64_t now) {
+    int16_t buffer[TIMER_WHEEL_NUM_TIMERS];
+    int16_t numFired = TimerWheel_PopExpired(wheel, now, 0, TIMER_WHEEL_NUM_TIMERS, &buffer[0]);
+    for (int16_t k = 0; k < numFired; ++k) {
+      int16_t timer = buffer[k];
+      if (now >= expirationTimes[timer]) {
+        EXPECT_EQ(-1, expiredAt[timer]);
+        expiredAt[timer] = now;
+      } else {
+        TimerWheel_Schedule(wheel, timer, expirationTimes[timer]);
+      };
+    };
+  }
+
+  TimerWheel wheel;
+  int64_t expirationTimes[TIMER_WHEEL_NUM_TIMERS];
+  int64_t expiredAt[TIMER_WHEEL_NUM_TIMERS];
+};
+
+TEST_F(TimerWheelTestGeneral, timersExpireExactlyOnTime) {
+  // expiration times on all levels and beyond the range of the wheel
+  int64_t times[6] = {1, 31, 100, 5000, 40000, 2000000};
+  for (int16_t i = 0; i < 6; ++i) {
+    schedule(i, times[i]);
+    EXPECT_TRUE(TimerWheel_IsScheduled(wheel, i));
+  };
+
+  for (int64_t now = 1; now <= 2000000; ++now) {
+    popAt(now);
+  };
+  for (int16_t i = 0; i < 6; ++i) {
+    EXPECT_EQ(times[i], expiredAt[i]);
+    EXPECT_FALSE(TimerWheel_IsScheduled(wheel, i));
+  };
+  EXPECT_EQ(TIMER_WHEEL_NO_TIMER, TimerWheel_NextFireTime(wheel));
+}
+
+TEST_F(TimerWheelTestGeneral, skippingToNextFireTimeIsNeverLate) {
+  // same as stepping through every tic, but only the tics at which a bucket fires are visited
+  uint32_t state = 12345;
+  for (int16_t i = 0; i < TIMER_WHEEL_NUM_TIMERS; ++i) {
+    state = state * 1103515245 + 12345;
+    schedule(i, 1 + (state >> 8) % 50000);
+  };
+
+  int64_t now = 0;
+  int numVisited = 0;
+  while (TimerWheel_NextFireTime(wheel) != TIMER_WHEEL_NO_TIMER) {
+    int64_t fireTime = TimerWheel_NextFireTime(wheel);
+    now = (fireTime > now) ? fireTime : now;
+    popAt(now);
+    ++numVisited;
+  };
+  for (int16_t i = 0; i < TIMER_WHEEL_NUM_TIMERS; ++i) {
+    EXPECT_EQ(expirationTimes[i], expiredAt[i]);
+  };
+  EXPECT_LT(numVisited, 50000);
+}
+
+TEST_F(TimerWheelTestGeneral, rescheduleAndCancelReplaceTheExpiration) {
+  schedule(0, 50);
+  schedule(1, 60);
+  schedule(0, 70);
+  TimerWheel_Cancel(wheel, 1);
+  EXPECT_FALSE(TimerWheel_IsScheduled(wheel, 1));
+
+  for (int64_t now = 1; now <= 100; ++now) {
+    popAt(now);
+  };
+  EXPECT_EQ(70, expiredAt[0]);
+  EXPECT_EQ(-1, expiredAt[1]);
+}
+
+TEST_F(TimerWheelTestGeneral, popOnlyReturnsTimersOfGroup) {
+  schedule(TIMER_WHEEL_PENDING_SLOTS, 10);
+  schedule(TIMER_WHEEL_NEIGHBORS, 10);
+
+  int16_t buffer[MAX_NUM_PENDING_SLOTS];
+  EXPECT_EQ(1, TimerWheel_PopExpired(wheel, 10, TIMER_WHEEL_PENDING_SLOTS, MAX_NUM_PENDING_SLOTS, &buffer[0]));
+  EXPECT_EQ(TIMER_WHEEL_PENDING_SLOTS, buffer[0]);
+
+  // the neighbor timer has fired and waits to be popped
+  EXPECT_TRUE(TimerWheel_IsScheduled(wheel, TIMER_WHEEL_NEIGHBORS));
+  EXPECT_EQ(TIMER_WHEEL_FIRED, TimerWheel_NextFireTime(wheel));
+  EXPECT_EQ(0, TimerWheel_PopExpired(wheel, 10, TIMER_WHEEL_PENDING_SLOTS, MAX_NUM_PENDING_SLOTS, &buffer[0]));
+}
+
+TEST_F(TimerWheelTestGeneral, timeGoingBackwardsIsNeverLate) {
+  popAt(1000);
+  schedule(0, 1010);
+  schedule(1, 1040);
+  schedule(2, 3000);
+
+  // a correction of the local time moves it back, so the timers are further ahead than before
+  for (int64_t now = 900; now <= 3000; ++now) {
+    popAt(now);
+  };
+  EXPECT_EQ(1010, expiredAt[0]);
+  EXPECT_EQ(1040, expiredAt[1]);
+  EXPECT_EQ(3000, expiredAt[2]);
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include "../include/Trace.h"
+#include "../include/Simulator.h"
+#include "../include/StateMachine.h"
+}
+
+static std::vector<TraceRecordStruct> readTrace(const std::string &path) {
+  std::vector<TraceRecordStruct> records;
+  FILE *file = fopen(path.c_str(), "rb");
+  EXPECT_TRUE(file != NULL);
+  EXPECT_TRUE(Trace_ReadHeader(file));
+
+  TraceRecordStruct record;
+  while (fread(&record, sizeof(TraceRecordStruct), 1, file) == 1) {
+    records.push_back(record);
+  };
+  fclose(file);
+  return records;
+}
+
+static int countRecords(const std::vector<TraceRecordStruct> &records, int8_t nodeId, uint8_t type, int8_t arg0) {
+  int count = 0;
+  for (const TraceRecordStruct &record : records) {
+    if (record.nodeId == nodeId && record.type == type && record.arg0 == arg0) {
+      ++count;
+    };
+  };
+  return count;
+}
+
+TEST(TraceTest, recordsAreWrittenInOrderAcrossBufferFlushes) {
+  std::string path = testing::TempDir() + "trace_order.bin";
+  TraceWriter writer = TraceWriter_Create(path.c_str());
+  ASSERT_TRUE(writer != NULL);
+
+  int32_t numRecords = TRACE_BUFFER_SIZE * 2 + 17;
+  for (int32_t i = 0; i < numRecords; ++i) {
+    TraceRecordStruct record = {};
+    record.localTime = i;
+    record.value = -i;
+    record.type = TRACE_TX;
+    record.nodeId = (int8_t) (i % 7);
+    TraceWriter_Write(writer, &record);
+  };
+  EXPECT_EQ((uint64_t) numRecords, writer->numRecords);
+  TraceWriter_Destroy(writer);
+
+  std::vector<TraceRecordStruct> records = readTrace(path);
+  ASSERT_EQ((size_t) numRecords, records.size());
+  for (int32_t i = 0; i < numRecords; ++i) {
+    EXPECT_EQ(i, records[i].localTime);
+    EXPECT_EQ(-i, records[i].value);
+    EXPECT_EQ(i % 7, records[i].nodeId);
+  };
+  remove(path.c_str());
+}
+
+TEST(TraceTest, simulatedNodesTraceTransitionsMessagesAndSlots) {
+  std::string path = testing::TempDir() + "trace_sim.bin";
+  TraceWriter writer = TraceWriter_Create(path.c_str());
+  ASSERT_TRUE(writer != NULL);
+
+  Simulator sim = Simulator_Create(2, 42);
+  Simulator_SetRadioRange(sim, 1.5);
+  Simulator_SetTrace(sim, writer);
+  Simulator_AddNode(sim, 1, 0, 0, 0);
+  Simulator_AddNode(sim, 2, 1, 0, 0);
+  Simulator_RunUntil(sim, 20000);
+  uint64_t numPings = sim->stats.numTransmissions[PING];
+  Simulator_Destroy(sim);
+  TraceWriter_Destroy(writer);
+
+  std::vector<TraceRecordStruct> records = readTrace(path);
+  ASSERT_FALSE(records.empty());
+
+  // both nodes were turned on first
+  EXPECT_EQ(TRACE_STATE_CHANGE, records[0].type);
+  EXPECT_EQ(OFF, records[0].arg0);
+  EXPECT_EQ(LISTENING_UNCONNECTED, records[0].arg1);
+
+  // every ping on the channel was traced by its sender
+  EXPECT_EQ((int) numPings, countRecords(records, 1, TRACE_TX, PING) + countRecords(records, 2, TRACE_TX, PING));
+  EXPECT_GT(countRecords(records, 1, TRACE_RX, PING) + countRecords(records, 2, TRACE_RX, PING), 0);
+
+  // one node joined the network of the other and both reserved slots
+  int numJoins = 0;
+  int numReserved = 0;
+  for (const TraceRecordStruct &record : records) {
+    numJoins += (record.type == TRACE_JOIN);
+    numReserved += (record.type == TRACE_SLOT_RESERVED);
+  };
+  EXPECT_GE(numJoins, 1);
+  EXPECT_GE(numReserved, 2);
+  remove(path.c_str());
+}
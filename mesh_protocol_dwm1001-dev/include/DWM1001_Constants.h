@@ -48,6 +48,7 @@
 #include "../deca_driver/deca_device_api.h"
 
 #define EVAL 1
+#define EVAL_REPLAY 0 // with EVAL, also print received ranging messages and the content of received pings so the output can be replayed (see mesh_protocol/include/Replay.h)
 #define DEBUG 0
 #define DEBUG_VERBOSE 0
 
@@ -90,6 +91,10 @@ static uint8 rx_result_msg[] = {0x41, 0x88, 0, 0xCA, 0xDE, 'W', 'A', 'V', 'E', 0
 // to convert from regular microseconds to DWT (e.g. timestamps read from DW1000) or the other way round (dive DWT by this to get us)
 #define US_TO_DWT 63897.6
 
+// bytes that the protocol structs of the node (allocated on the stack in main.c) may use; checked at compile time in main.c,
+// see mesh_protocol/include/Footprint.h and the memory_footprint tool for the sizes as a function of the constants
+#define NODE_RAM_BUDGET 16384
+
 // number of time tics per second (how often the timer counts the time up within one second); current max is 1000
 #define TICS_PER_SECOND 1000
 
@@ -70,6 +70,15 @@ typedef struct DriverStruct{
   bool sentMessage; 
 
   int64_t lastTxStartTime;
+
+  /** number of pings this node has sent; included in every ping */
+  int16_t pingsSent;
+
+  /** frame sequence number of the ranging messages, incremented after each response (modulo 256) */
+  uint8_t frameSeqNum;
+
+  /** DW1000 timestamp of the reception of the last poll; needed to calculate the distance when the final arrives */
+  uint64_t pollRxTimestamp;
 } DriverStruct;
 
 /** Constructor 
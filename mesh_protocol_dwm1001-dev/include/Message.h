@@ -56,6 +56,11 @@ enum MessageSizes {
   PING_SIZE = 20
 };
 
+/** Number of bytes the status of all slots takes in a ping frame; the status of slot index i is sent in bits 
+* 2 * (i % 4) and 2 * (i % 4) + 1 of byte i / 4
+*/
+#define SLOT_STATUS_BYTES ((NUM_SLOTS + 3) / 4)
+
 typedef struct MessageStruct * Message;
 typedef enum MessageTypes MessageTypes;
 typedef enum MessageSizes MessageSizes;
@@ -45,25 +45,12 @@
 
 /** DECAWAVE RANGING VARIABLES */
 
-/* Frame sequence number, incremented after each transmission. */
-static uint8 frame_seq_nb = 0;
+/* The frame sequence number and the timestamps that are needed across messages are kept in the DriverStruct, 
+*  so that every node has its own copy. */
 
 /* Hold copy of status register state here for reference so that it can be examined at a debug breakpoint. */
 static uint32 status_reg = 0;
 
-/* Timestamps of frames transmission/reception. */
-static uint64 poll_tx_ts;
-static uint64 resp_rx_ts;
-static uint64 final_tx_ts;
-
-static uint64 poll_rx_ts;
-static uint64 resp_tx_ts;
-static uint64 final_rx_ts;
-
-/* Hold copies of computed time of flight and distance here for reference so that it can be examined at a debug breakpoint. */
-static double tof;
-static double distance;
-
 /*Transactions Counters */
 static volatile int tx_count = 0 ; // Successful transmit counter
 static volatile int rx_count = 0 ; // Successful receive counter 
@@ -74,6 +61,7 @@ static uint64 get_tx_timestamp_u64(void);
 static uint64 get_rx_timestamp_u64(void);
 static void final_msg_set_ts(uint8 *ts_field, uint64 ts);
 static void final_msg_get_ts(const uint8 *ts_field, uint32 *ts);
+static void packSlotStatus(uint8_t *bytes, const int *slotStatus);
 
 
 Driver Driver_Create(bool *txFinishedFlag, bool *isReceiving) {
@@ -82,6 +70,9 @@ Driver Driver_Create(bool *txFinishedFlag, bool *isReceiving) {
   
   self->txFinishedFlag = txFinishedFlag;
   self->sentMessage = false;
+  self->pingsSent = 0;
+  self->frameSeqNum = 0;
+  self->pollRxTimestamp = 0;
 
   return self;
 };
@@ -98,8 +89,6 @@ bool Driver_SendingFinished(Node node) {
 
 void Driver_TransmitPing(Node node, Message msg) {
 
-  static int16_t pingsSent = 0;
-
   /* Turn off the receiver, so that a message can be sent */
   dwt_forcetrxoff();
 
@@ -129,21 +118,21 @@ void Driver_TransmitPing(Node node, Message msg) {
   // write timeSinceFrameStart
   offset += sizeof(int64_t);
   memcpy(&buffer[offset], &msg->timeSinceFrameStart, sizeof(int64_t));
-  // write oneHopSlotStatus
+  // write oneHopSlotStatus (packed into 2 bits per slot)
   offset += sizeof(int64_t);
-  memcpy(&buffer[offset], &msg->oneHopSlotStatus, sizeof(int) * NUM_SLOTS);
+  packSlotStatus(&buffer[offset], &msg->oneHopSlotStatus[0]);
   // write oneHopSlotIds
-  offset += (sizeof(int) * NUM_SLOTS);
+  offset += SLOT_STATUS_BYTES;
   memcpy(&buffer[offset], &msg->oneHopSlotIds, sizeof(int8_t) * NUM_SLOTS);
-  // write twoHopSlotStatus
+  // write twoHopSlotStatus (packed into 2 bits per slot)
   offset += (sizeof(int8_t) * NUM_SLOTS);
-  memcpy(&buffer[offset], &msg->twoHopSlotStatus, sizeof(int) * NUM_SLOTS);
+  packSlotStatus(&buffer[offset], &msg->twoHopSlotStatus[0]);
   // write twoHopSlotIds
-  offset += (sizeof(int) * NUM_SLOTS);
+  offset += SLOT_STATUS_BYTES;
   memcpy(&buffer[offset], &msg->twoHopSlotIds, sizeof(int8_t) * NUM_SLOTS);
   offset += (sizeof(int8_t) * NUM_SLOTS);
 
-  memcpy(&buffer[offset], &pingsSent, sizeof(int16_t));
+  memcpy(&buffer[offset], &node->driver->pingsSent, sizeof(int16_t));
   offset += (sizeof(int16_t));
 
   // clear TXFRS
@@ -180,14 +169,14 @@ void Driver_TransmitPing(Node node, Message msg) {
   uint8_t slotNum = TimeKeeping_CalculateCurrentSlotNum(node);
 
 #if DEBUG
-  printf("%d: Node %" PRId8 " sent ping %d in slot %" PRIu8 " \n", (int) localTime, node->id, pingsSent, slotNum);
+  printf("%d: Node %" PRId8 " sent ping %d in slot %" PRIu8 " \n", (int) localTime, node->id, node->driver->pingsSent, slotNum);
 #endif
 
 #if EVAL
-  printf("TX PING %d 0 %d %d %d \n", (int) node->id, (int) localTime, (int) slotNum, (int) pingsSent);
+  printf("TX PING %d 0 %d %d %d \n", (int) node->id, (int) localTime, (int) slotNum, (int) node->driver->pingsSent);
 #endif
 
-  pingsSent += 1;
+  node->driver->pingsSent += 1;
 };
 
 void Driver_TransmitPoll(Node node, Message msg) {
@@ -197,7 +186,7 @@ void Driver_TransmitPoll(Node node, Message msg) {
   /** See description in Driver_TransmitPing */
 
   /* Write frame data to DW1000 and prepare transmission. See NOTE 8 below. */
-  tx_poll_msg[ALL_MSG_SN_IDX] = frame_seq_nb;
+  tx_poll_msg[ALL_MSG_SN_IDX] = node->driver->frameSeqNum;
 
   // write ID of source (own ID) and destination (intended recipient's ID); only one of the bytes is currently used
   // source:
@@ -244,10 +233,10 @@ void Driver_TransmitResponse(Node node, Message msg) {
   int ret;
 
   /* Retrieve poll reception timestamp. */
-  poll_rx_ts = get_rx_timestamp_u64();
+  node->driver->pollRxTimestamp = get_rx_timestamp_u64();
 
   /* Set send time for response. See NOTE 9 below. */
-  resp_tx_time = (poll_rx_ts + (POLL_RX_TO_RESP_TX_DLY_UUS * UUS_TO_DWT_TIME)) >> 8;
+  resp_tx_time = (node->driver->pollRxTimestamp + (POLL_RX_TO_RESP_TX_DLY_UUS * UUS_TO_DWT_TIME)) >> 8;
   dwt_setdelayedtrxtime(resp_tx_time);
 
   /* Set expected delay and timeout for final message reception. See NOTE 4 and 5 below. */
@@ -255,7 +244,7 @@ void Driver_TransmitResponse(Node node, Message msg) {
   dwt_setrxtimeout(FINAL_RX_TIMEOUT_UUS);
 
   /* Write and send the response message. See NOTE 10 below.*/
-  tx_resp_msg[ALL_MSG_SN_IDX] = frame_seq_nb;
+  tx_resp_msg[ALL_MSG_SN_IDX] = node->driver->frameSeqNum;
 
   // write ID of source (own ID) and destination (intended recipient's ID); only one of the bytes is currently used
   // source:
@@ -288,7 +277,7 @@ void Driver_TransmitResponse(Node node, Message msg) {
     *node->driver->txFinishedFlag = true;
 
     /* Increment frame sequence number after transmission of the poll message (modulo 256). */
-    frame_seq_nb++;
+    node->driver->frameSeqNum++;
 
     int64_t localTime = ProtocolClock_GetLocalTime(node->clock);
 #if DEBUG_VERBOSE
@@ -322,6 +311,7 @@ void Driver_TransmitFinal(Node node, Message msg) {
   dwt_forcetrxoff();
 
   uint32 final_tx_time;
+  uint64 poll_tx_ts, resp_rx_ts, final_tx_ts;
   int ret;
 
   /* Retrieve poll transmission and response reception timestamp. */
@@ -341,7 +331,7 @@ void Driver_TransmitFinal(Node node, Message msg) {
   final_msg_set_ts(&tx_final_msg[FINAL_MSG_FINAL_TX_TS_IDX], final_tx_ts);
 
   /* Write and send final message. See NOTE 8 below. */
-  tx_final_msg[ALL_MSG_SN_IDX] = frame_seq_nb;
+  tx_final_msg[ALL_MSG_SN_IDX] = node->driver->frameSeqNum;
 
   // write ID of source (own ID) and destination (intended recipient's ID); only one of the bytes is currently used
   // source:
@@ -379,8 +369,10 @@ void Driver_TransmitResult(Node node, Message msg) {
 
   // calculate and print distance
   uint32 poll_tx_ts, resp_rx_ts, final_tx_ts;
+  uint64 resp_tx_ts, final_rx_ts;
   uint32 poll_rx_ts_32, resp_tx_ts_32, final_rx_ts_32;
   double Ra, Rb, Da, Db;
+  double tof, distance;
   int64 tof_dtu;
 
   /* Retrieve response transmission and final reception timestamps. */
@@ -393,7 +385,7 @@ void Driver_TransmitResult(Node node, Message msg) {
   final_msg_get_ts(&msg->rx_buffer[FINAL_MSG_FINAL_TX_TS_IDX], &final_tx_ts);
 
   /* Compute time of flight. 32-bit subtractions give correct answers even if clock has wrapped. See NOTE 12 below. */
-  poll_rx_ts_32 = (uint32)poll_rx_ts;
+  poll_rx_ts_32 = (uint32)node->driver->pollRxTimestamp;
   resp_tx_ts_32 = (uint32)resp_tx_ts;
   final_rx_ts_32 = (uint32)final_rx_ts;
   Ra = (double)(resp_rx_ts - poll_tx_ts);
@@ -407,7 +399,7 @@ void Driver_TransmitResult(Node node, Message msg) {
 
   /* Transmit distance back to the other node */
   
-  tx_result_msg[ALL_MSG_SN_IDX] = frame_seq_nb;
+  tx_result_msg[ALL_MSG_SN_IDX] = node->driver->frameSeqNum;
 
   // write ID of source (own ID) and destination (intended recipient's ID); only one of the bytes is currently used
   // source:
@@ -569,3 +561,14 @@ static void final_msg_get_ts(const uint8 *ts_field, uint32 *ts)
         *ts += ts_field[i] << (i * 8);
     }
 }
+
+/** Pack the status of every slot into 2 bits, four slots per byte (see SLOT_STATUS_BYTES in Message.h)
+* @param bytes is the buffer of SLOT_STATUS_BYTES bytes the packed status is written to
+* @param slotStatus is the status of each slot (FREE, OCCUPIED or COLLIDING)
+*/
+static void packSlotStatus(uint8_t *bytes, const int *slotStatus) {
+  memset(bytes, 0, SLOT_STATUS_BYTES);
+  for (int i = 0; i < NUM_SLOTS; ++i) {
+    bytes[i / 4] |= (uint8_t) ((slotStatus[i] & 0x3) << (2 * (i % 4)));
+  };
+};
@@ -85,6 +85,13 @@ typedef struct TimerContextStruct{
   int64_t *time;
 } TimerContextStruct;
 
+_Static_assert(sizeof(struct NodeStruct) + sizeof(struct StateMachineStruct) + sizeof(struct SchedulerStruct) 
+  + sizeof(struct ProtocolClockStruct) + sizeof(struct TimeKeepingStruct) + sizeof(struct NetworkManagerStruct) 
+  + sizeof(struct MessageHandlerStruct) + sizeof(struct SlotMapStruct) + sizeof(struct NeighborhoodStruct) 
+  + sizeof(struct RangingManagerStruct) + sizeof(struct LCGStruct) + sizeof(struct ConfigStruct) 
+  + sizeof(struct DriverStruct) + sizeof(struct MessageStruct) <= NODE_RAM_BUDGET, 
+  "the protocol structs of the node exceed NODE_RAM_BUDGET; reduce NUM_SLOTS or MAX_NUM_NODES");
+
 
 /**@brief Function starting the internal LFCLK oscillator.
  *
@@ -341,6 +348,9 @@ int main(void) {
               // add pointer to rx_buffer to the message so the Driver can access it
               msg->rx_buffer = &rx_buffer[0];
               msg->frame_len = frame_len;
+  #if EVAL && EVAL_REPLAY
+              printf("RX POLL %d 0 %d %d 0 \n", msg->senderId, (int) (currentTime - timediffToNow), (int) TimeKeeping_CalculateCurrentSlotNum(&node));
+  #endif
         
               // run state machine (happens after this if/else structure)
 
@@ -369,6 +379,9 @@ int main(void) {
               // add pointer to rx_buffer to the message so the Driver can access it
               msg->rx_buffer = &rx_buffer[0];
               msg->frame_len = frame_len;
+  #if EVAL && EVAL_REPLAY
+              printf("RX RESP %d 0 %d %d 0 \n", msg->senderId, (int) (currentTime - timediffToNow), (int) TimeKeeping_CalculateCurrentSlotNum(&node));
+  #endif
 
               // run state machine (happens after this if/else structure
 
@@ -396,6 +409,9 @@ int main(void) {
               // add pointer to rx_buffer to the message so the Driver can access it
               msg->rx_buffer = &rx_buffer[0];
               msg->frame_len = frame_len;
+  #if EVAL && EVAL_REPLAY
+              printf("RX FINAL %d 0 %d %d 0 \n", msg->senderId, (int) (currentTime - timediffToNow), (int) TimeKeeping_CalculateCurrentSlotNum(&node));
+  #endif
 
               // run state machine (happens after this if/else structure
                     
@@ -493,21 +509,23 @@ int main(void) {
             + (rx_buffer[offset + 4] << 32) + (rx_buffer[offset + 5] << 40) + (rx_buffer[offset + 6] << 48) + (rx_buffer[offset + 7] << 56);
 
           offset += sizeof(int64_t);
+          // the status is packed into 2 bits per slot
           for(int i = 0; i < NUM_SLOTS; ++i) {
-            msg->oneHopSlotStatus[i] = (rx_buffer[offset + i*sizeof(int)]) + (rx_buffer[offset + i*sizeof(int) + 1] << 8) + (rx_buffer[offset + i*sizeof(int) + 2] << 16) + (rx_buffer[offset + i*sizeof(int) + 3] << 24);
+            msg->oneHopSlotStatus[i] = (rx_buffer[offset + i / 4] >> (2 * (i % 4))) & 0x3;
           };
 
-          offset += (sizeof(int) * NUM_SLOTS);
+          offset += SLOT_STATUS_BYTES;
           for(int i = 0; i < NUM_SLOTS; ++i) {
             msg->oneHopSlotIds[i] = rx_buffer[offset + i];
           };
 
           offset += sizeof(int8_t) * NUM_SLOTS;
+          // the status is packed into 2 bits per slot
           for(int i = 0; i < NUM_SLOTS; ++i) {
-            msg->twoHopSlotStatus[i] = (rx_buffer[offset + i*sizeof(int)]) + (rx_buffer[offset + i*sizeof(int) + 1] << 8) + (rx_buffer[offset + i*sizeof(int) + 2] << 16) + (rx_buffer[offset + i*sizeof(int) + 3] << 24);
+            msg->twoHopSlotStatus[i] = (rx_buffer[offset + i / 4] >> (2 * (i % 4))) & 0x3;
           };
 
-          offset += sizeof(int) * NUM_SLOTS;
+          offset += SLOT_STATUS_BYTES;
           for(int i = 0; i < NUM_SLOTS; ++i) {
             msg->twoHopSlotIds[i] = rx_buffer[offset + i];
           };
@@ -548,7 +566,24 @@ int main(void) {
         
   #if EVAL
           uint8_t slotNum = TimeKeeping_CalculateCurrentSlotNum(&node);
-          printf("RX PING %d 0 %d %d %d \n", msg->senderId, (int) (currentTime - timediffToNow), (int) slotNum, (int) msg->pingNum);
+          printf("RX PING %d 0 %d %d %d ", msg->senderId, (int) (currentTime - timediffToNow), (int) slotNum, (int) msg->pingNum);
+    #if EVAL_REPLAY
+          // content of the ping, in the order Replay_ParseLine expects it
+          printf("%d %d %d ", (int) msg->networkId, (int) msg->networkAge, (int) msg->timeSinceFrameStart);
+          for(int i = 0; i < NUM_SLOTS; ++i) {
+            printf("%d ", msg->oneHopSlotStatus[i]);
+          };
+          for(int i = 0; i < NUM_SLOTS; ++i) {
+            printf("%d ", (int) msg->oneHopSlotIds[i]);
+          };
+          for(int i = 0; i < NUM_SLOTS; ++i) {
+            printf("%d ", msg->twoHopSlotStatus[i]);
+          };
+          for(int i = 0; i < NUM_SLOTS; ++i) {
+            printf("%d ", (int) msg->twoHopSlotIds[i]);
+          };
+    #endif
+          printf("\n");
   #endif
 
         };